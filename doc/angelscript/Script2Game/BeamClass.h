@@ -186,6 +186,30 @@ public:
 	 * @return a vector3 representing the G-forces
 	 */
 	vector3 getGForces();
+
+	/**
+	 * CPU time spent on this truck's physics, averaged over the last second.
+	 * @return milliseconds per second
+	 */
+	float getPhysicsCostMs();
+
+	/**
+	 * CPU time spent on this truck's collisions with other trucks, averaged over the last second.
+	 * @return milliseconds per second
+	 */
+	float getCollisionCostMs();
+
+	/**
+	 * CPU time spent on deforming and uploading this truck's flexbodies, averaged over the last second.
+	 * @return milliseconds per second
+	 */
+	float getFlexbodyCostMs();
+
+	/**
+	 * The most expensive frame of this truck (all costs combined) within the last second.
+	 * @return milliseconds
+	 */
+	float getWorstFrameCostMs();
    /**
 	* Returns the position of the node
 	* @param the nuber of the node
@@ -440,6 +440,36 @@ public:
 	 * @param factor This factor determines by how much that the RPM of the truck will be increased ( rpm += 2000.0f * factor ).
 	 */
 	void boostCurrentTruck(float factor);
+
+	/**
+	 * Finds all actor nodes within a radius. Node positions are refreshed once per physics frame.
+	 * @param center Center of the search sphere, in world coordinates
+	 * @param radius Search radius in meters; negative or non-finite values find nothing
+	 * @param out_actor_ids Receives the instance IDs of the actors, one per found node
+	 * @param out_node_ids Receives the node numbers, paired with out_actor_ids
+	 * @return number of nodes found
+	 */
+	int findNodesInRadius(const vector3 &in center, float radius, array<int> &inout out_actor_ids, array<int> &inout out_node_ids);
+
+	/**
+	 * Like findNodesInRadius(), but returns only the nearest nodes, nearest first.
+	 * @param count Maximum number of nodes to return
+	 * @param max_radius Nodes farther than this (in meters) are ignored
+	 * @return number of nodes found
+	 */
+	int findNearestNodes(const vector3 &in center, int count, float max_radius, array<int> &inout out_actor_ids, array<int> &inout out_node_ids);
+
+	/**
+	 * Casts a ray against actor nodes, each treated as a sphere - like grabbing with the mouse.
+	 * @param origin Start of the ray, in world coordinates
+	 * @param direction Direction of the ray; doesn't need to be normalized
+	 * @param max_dist Length of the ray in meters
+	 * @param node_radius Radius of the node spheres in meters
+	 * @param out_actor_id Receives the instance ID of the hit actor
+	 * @param out_node_id Receives the number of the hit node
+	 * @return true if a node was hit
+	 */
+	bool pickNode(const vector3 &in origin, const vector3 &in direction, float max_dist, float node_radius, int &out out_actor_id, int &out out_node_id);
 	
     ///@}
 
@@ -23,6 +23,7 @@
 
 #include "AdvancedScreen.h"
 #include "Actor.h"
+#include "AsyncLogger.h"
 #include "CameraManager.h"
 #include "ChatSystem.h"
 #include "Console.h"
@@ -461,6 +462,8 @@ void AppContext::SetUpLogging()
     rorlog->stream() << "[RoR] Current date: " << std::put_time(std::localtime(&t), "%Y-%m-%d");
 
     rorlog->addListener(App::GetConsole());  // Allow console to intercept log messages
+
+    App::GetAsyncLogger()->Start(logs_dir); // Formatting and writing happens in background, see 'diag_log_async'
 }
 
 bool AppContext::SetUpResourcesDir()
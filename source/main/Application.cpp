@@ -26,6 +26,7 @@
 #include "Application.h"
 
 #include "AppContext.h"
+#include "AsyncLogger.h"
 #include "CacheSystem.h"
 #include "CameraManager.h"
 #include "Console.h"
@@ -40,6 +41,7 @@
 #include "OverlayWrapper.h"
 #include "MumbleIntegration.h"
 #include "Network.h"
+#include "PerfHarness.h"
 #include "ScriptEngine.h"
 #include "SoundScriptManager.h"
 #include "Terrain.h"
@@ -71,6 +73,8 @@ static Network          g_network;
 static GameContext      g_game_context;
 static OutGauge         g_out_gauge;
 static DiscordRpc       g_discord_rpc;
+static PerfHarness      g_perf_harness;
+static AsyncLogger      g_async_logger;
 
 // App
 CVar* app_state;
@@ -104,6 +108,12 @@ CVar* sim_no_self_collisions;
 CVar* sim_gearbox_mode;
 CVar* sim_soft_reset_mode;
 CVar* sim_quickload_dialog;
+CVar* sim_arena_huge_pages;
+CVar* sim_spawn_sort_beams;
+CVar* sim_integrator;
+CVar* sim_implicit_substep;
+CVar* sim_adaptive_substeps;
+CVar* sim_deterministic;
 
 // Multiplayer
 CVar* mp_state;
@@ -137,6 +147,7 @@ CVar* diag_preset_vehicle;
 CVar* diag_preset_veh_config;
 CVar* diag_preset_veh_enter;
 CVar* diag_log_console_echo;
+CVar* diag_log_async;
 CVar* diag_log_beam_break;
 CVar* diag_log_beam_deform;
 CVar* diag_log_beam_trigger;
@@ -149,6 +160,8 @@ CVar* diag_hide_wheels;
 CVar* diag_hide_nodes;
 CVar* diag_terrn_log_roads;
 CVar* diag_actor_dump;
+CVar* diag_sim_checksums;
+CVar* diag_actor_budget_ms;
 
 // System
 CVar* sys_process_dir;
@@ -174,6 +187,10 @@ CVar* cli_preset_veh_enter;
 CVar* cli_force_cache_update;
 CVar* cli_resume_autosave;
 CVar* cli_custom_scripts;
+CVar* cli_perftest_vehicles;
+CVar* cli_perftest_seconds;
+CVar* cli_perftest_baseline;
+CVar* cli_perftest_report;
 
 // Input - Output
 CVar* io_analog_smoothing;
@@ -268,6 +285,8 @@ Network*               GetNetwork            () { return &g_network; }
 GameContext*           GetGameContext        () { return &g_game_context; }
 OutGauge*              GetOutGauge           () { return &g_out_gauge; }
 DiscordRpc*            GetDiscordRpc         () { return &g_discord_rpc; }
+PerfHarness*           GetPerfHarness        () { return &g_perf_harness; }
+AsyncLogger*           GetAsyncLogger        () { return &g_async_logger; }
 
 // Factories
 void CreateOverlayWrapper()
@@ -339,18 +358,35 @@ void DestroyOverlayWrapper()
 // Global logging
 // ------------------------------------------------------------------------------------------------
 
+static bool IsAsyncLogEnabled()
+{
+    // The cvar doesn't exist yet during early startup
+    return g_async_logger.IsRunning() && App::diag_log_async && App::diag_log_async->getBool();
+}
+
 void Log(const char* msg)
 {
+    if (IsAsyncLogEnabled())
+    {
+        g_async_logger.PushText(msg);
+        return;
+    }
     Ogre::LogManager::getSingleton().logMessage(msg);
 }
 
 void LogFormat(const char* format, ...)
 {
-    char buffer[2000] = {};
-
     va_list args;
     va_start(args, format);
-        vsprintf(buffer, format, args);
+    if (IsAsyncLogEnabled())
+    {
+        g_async_logger.PushFormat(format, args);
+        va_end(args);
+        return;
+    }
+
+    char buffer[2000] = {};
+    vsnprintf(buffer, sizeof(buffer), format, args);
     va_end(args);
 
     RoR::Log(buffer);
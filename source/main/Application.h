@@ -296,6 +296,12 @@ extern CVar* sim_no_self_collisions;
 extern CVar* sim_gearbox_mode;
 extern CVar* sim_soft_reset_mode;
 extern CVar* sim_quickload_dialog;
+extern CVar* sim_arena_huge_pages;
+extern CVar* sim_spawn_sort_beams;
+extern CVar* sim_integrator;
+extern CVar* sim_implicit_substep;
+extern CVar* sim_adaptive_substeps;
+extern CVar* sim_deterministic;
 
 // Multiplayer
 extern CVar* mp_state;
@@ -330,6 +336,7 @@ extern CVar* diag_preset_vehicle;
 extern CVar* diag_preset_veh_config;
 extern CVar* diag_preset_veh_enter;
 extern CVar* diag_log_console_echo;
+extern CVar* diag_log_async;
 extern CVar* diag_log_beam_break;
 extern CVar* diag_log_beam_deform;
 extern CVar* diag_log_beam_trigger;
@@ -342,6 +349,8 @@ extern CVar* diag_hide_wheels;
 extern CVar* diag_hide_nodes;
 extern CVar* diag_terrn_log_roads;
 extern CVar* diag_actor_dump;
+extern CVar* diag_sim_checksums;
+extern CVar* diag_actor_budget_ms;
 
 // System
 extern CVar* sys_process_dir;
@@ -367,6 +376,10 @@ extern CVar* cli_preset_veh_enter;
 extern CVar* cli_force_cache_update;
 extern CVar* cli_resume_autosave;
 extern CVar* cli_custom_scripts;
+extern CVar* cli_perftest_vehicles;
+extern CVar* cli_perftest_seconds;
+extern CVar* cli_perftest_baseline;
+extern CVar* cli_perftest_report;
 
 // Input - Output
 extern CVar* io_analog_smoothing;
@@ -462,6 +475,8 @@ Network*             GetNetwork();
 GameContext*         GetGameContext();
 OutGauge*            GetOutGauge();
 DiscordRpc*          GetDiscordRpc();
+PerfHarness*         GetPerfHarness();
+AsyncLogger*         GetAsyncLogger();
 
 // Factories
 void CreateOverlayWrapper();
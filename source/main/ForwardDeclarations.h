@@ -38,6 +38,7 @@ namespace RoR
     class  Airbrake;
     class  Airfoil;
     class  AppContext;
+    class  AsyncLogger;
     class  Autopilot;
     class  Buoyance;
     class  CacheEntry;
@@ -61,6 +62,7 @@ namespace RoR
     struct FlexBodyCacheData;
     class  FlexFactory;
     class  FlexMeshWheel;
+    class  FlexMeshWheelBatch;
     class  FlexObj;
     class  ForceFeedback;
     class  GameContext;
@@ -73,6 +75,7 @@ namespace RoR
     struct GuiManagerImpl;
     class  HydraxWater;
     class  InputEngine;
+    class  IntraCollisionPairs;
     class  IWater;
     class  Landusemap;
     class  LanguageEngine;
@@ -80,7 +83,9 @@ namespace RoR
     class  MumbleIntegration;
     class  OutGauge;
     class  OverlayWrapper;
+    class  PerfHarness;
     class  Network;
+    struct NodeSB;
     class  OgreSubsystem;
     struct PlatformUtils;
     class  PointColDetector;
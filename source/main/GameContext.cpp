@@ -37,6 +37,7 @@
 #include "GUI_SurveyMap.h"
 #include "InputEngine.h"
 #include "OverlayWrapper.h"
+#include "PerfHarness.h"
 #include "Replay.h"
 #include "ScrewProp.h"
 #include "ScriptEngine.h"
@@ -198,6 +199,7 @@ Actor* GameContext::SpawnActor(ActorSpawnRequest& rq)
     }
 
     LOG(" ===== LOADING VEHICLE: " + rq.asr_filename);
+    PerfHarnessScope perf_scope(PerfHarness::METRIC_ACTOR_SPAWN);
 
     if (rq.asr_cache_entry != nullptr)
     {
@@ -26,6 +26,7 @@
 #include "CameraManager.h"
 #include "Sound.h"
 #include "SoundManager.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
 #include <OgreResourceGroupManager.h>
@@ -94,6 +95,8 @@ SoundScriptManager::SoundScriptManager() :
 
 SoundScriptManager::~SoundScriptManager()
 {
+    this->JoinPendingScripts(); // Workers reference `this`
+
     if (sound_manager != nullptr)
         delete sound_manager;
 }
@@ -337,22 +340,37 @@ Real SoundScriptManager::getLoadingOrder(void) const
     return 1000.0f;
 }
 
-SoundScriptTemplate* SoundScriptManager::createTemplate(String name, String groupname, String filename)
+void SoundScriptManager::addTemplates(std::vector<SoundScriptTemplate*> const& new_templates)
 {
-    // first, search if there is a template name collision
-    if (templates.find(name) != templates.end())
+    for (SoundScriptTemplate* ssi : new_templates)
     {
-        LOG("SoundScriptManager::createTemplate(): SoundScript with name [" + name + "] already exists, skipping...");
-        return nullptr;
+        // first, search if there is a template name collision
+        if (templates.find(ssi->name) != templates.end())
+        {
+            LOG("SoundScriptManager::addTemplates(): SoundScript with name [" + ssi->name + "] already exists, skipping...");
+            delete ssi;
+            continue;
+        }
+
+        templates[ssi->name] = ssi;
     }
+}
 
-    SoundScriptTemplate* ssi = new SoundScriptTemplate(name, groupname, filename, loading_base);
-    templates[name] = ssi;
-    return ssi;
+void SoundScriptManager::JoinPendingScripts()
+{
+    // Register in submission order, so that name collisions resolve the same as with sequential parsing
+    for (auto& pending : pending_scripts)
+    {
+        pending->task->join();
+        this->addTemplates(pending->templates);
+    }
+    pending_scripts.clear();
 }
 
 SoundScriptInstance* SoundScriptManager::createInstance(Ogre::String templatename, int actor_id, Ogre::SceneNode* toAttach, int soundLinkType, int soundLinkItemId)
 {
+    this->JoinPendingScripts();
+
     //first, search template
     SoundScriptTemplate* templ = NULL;
 
@@ -404,10 +422,31 @@ SoundScriptInstance* SoundScriptManager::createInstance(Ogre::String templatenam
 }
 
 void SoundScriptManager::parseScript(DataStreamPtr& stream, const String& groupName)
+{
+    if (loading_base && App::GetThreadPool())
+    {
+        // Base sounds are loaded during startup - parse them on worker threads while OGRE
+        // continues with other scripts. The file is read here, OGRE archives are not thread safe.
+        auto pending = std::make_shared<PendingScript>();
+        DataStreamPtr mem_stream(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+        pending->task = App::GetThreadPool()->RunTask([this, pending, mem_stream, groupName]() mutable
+            {
+                this->parseTemplates(mem_stream, groupName, /*base_template=*/true, pending->templates);
+            });
+        pending_scripts.push_back(pending);
+        return;
+    }
+
+    this->JoinPendingScripts();
+    std::vector<SoundScriptTemplate*> new_templates;
+    this->parseTemplates(stream, groupName, loading_base, new_templates);
+    this->addTemplates(new_templates);
+}
+
+void SoundScriptManager::parseTemplates(DataStreamPtr& stream, const String& groupName, bool base_template, std::vector<SoundScriptTemplate*>& out_templates)
 {
     SoundScriptTemplate* sst = 0;
     String line = "";
-    std::vector<String> vecparams;
 
     LOG("SoundScriptManager: Parsing script "+stream->getName());
 
@@ -422,15 +461,8 @@ void SoundScriptManager::parseScript(DataStreamPtr& stream, const String& groupN
                 // no current SoundScript
                 // so first valid data should be a SoundScript name
                 LOG("SoundScriptManager: creating template "+line);
-                sst = createTemplate(line, groupName, stream->getName());
-                if (!sst)
-                {
-                    // there is a name collision for this Sound Script
-                    LOG("SoundScriptManager: Error, this sound script is already defined: "+line);
-                    skipToNextOpenBrace(stream);
-                    skipToNextCloseBrace(stream);
-                    continue;
-                }
+                sst = new SoundScriptTemplate(line, groupName, stream->getName(), base_template);
+                out_templates.push_back(sst);
                 // skip to and over next {
                 skipToNextOpenBrace(stream);
             }
@@ -458,16 +490,6 @@ void SoundScriptManager::parseScript(DataStreamPtr& stream, const String& groupN
     }
 }
 
-void SoundScriptManager::skipToNextCloseBrace(DataStreamPtr& stream)
-{
-    String line = "";
-
-    while (!stream->eof() && line != "}")
-    {
-        line = stream->getLine();
-    }
-}
-
 void SoundScriptManager::skipToNextOpenBrace(DataStreamPtr& stream)
 {
     String line = "";
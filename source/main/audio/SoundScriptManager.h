@@ -26,6 +26,8 @@
 #include "Application.h"
 
 #include <OgreScriptLoader.h>
+#include <memory>
+#include <vector>
 
 #define SOUND_PLAY_ONCE(_ACTOR_, _TRIG_)        App::GetSoundScriptManager()->trigOnce    ( (_ACTOR_), (_TRIG_) )
 #define SOUND_START(_ACTOR_, _TRIG_)            App::GetSoundScriptManager()->trigStart   ( (_ACTOR_), (_TRIG_) )
@@ -264,6 +266,10 @@ public:
 
     SoundScriptInstance* createInstance(Ogre::String templatename, int actor_id, Ogre::SceneNode *toAttach=NULL, int soundLinkType=SL_DEFAULT, int soundLinkItemId=-1);
 
+    /// Registers templates of base sound scripts parsed on worker threads (see `parseScript()`).
+    /// Called during startup; also done implicitly before any template lookup.
+    void JoinPendingScripts();
+
     // functions
     void trigOnce    (int actor_id, int trig, int linkType = SL_DEFAULT, int linkItemID=-1);
     void trigOnce    (Actor* actor, int trig, int linkType = SL_DEFAULT, int linkItemID=-1);
@@ -291,8 +297,14 @@ public:
 
 private:
 
-    SoundScriptTemplate* createTemplate(Ogre::String name, Ogre::String groupname, Ogre::String filename);
-    void skipToNextCloseBrace(Ogre::DataStreamPtr& chunk);
+    struct PendingScript
+    {
+        std::shared_ptr<Task>             task;
+        std::vector<SoundScriptTemplate*> templates;
+    };
+
+    void parseTemplates(Ogre::DataStreamPtr& stream, const Ogre::String& groupName, bool base_template, std::vector<SoundScriptTemplate*>& out_templates);
+    void addTemplates(std::vector<SoundScriptTemplate*> const& new_templates); //!< Takes ownership; duplicates are deleted
     void skipToNextOpenBrace(Ogre::DataStreamPtr& chunk);
 
     bool disabled;
@@ -304,6 +316,7 @@ private:
     Ogre::StringVector script_patterns;
 
     std::map <Ogre::String, SoundScriptTemplate*> templates;
+    std::vector<std::shared_ptr<PendingScript>> pending_scripts; //!< In submission order
 
     // instances lookup tables
     int free_trigs[SS_MAX_TRIG];
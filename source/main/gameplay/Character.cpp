@@ -46,6 +46,7 @@ Character::Character(int source, unsigned int streamid, UTFString player_name, i
     , m_character_rotation(0.0f)
     , m_character_h_speed(2.0f)
     , m_character_v_speed(0.0f)
+    , m_character_radius(0.25f)
     , m_color_number(color_number)
     , m_anim_time(0.f)
     , m_net_last_anim_time(0.f)
@@ -114,97 +115,163 @@ void Character::SetAnimState(std::string mode, float time)
     }
 }
 
-float calculate_collision_depth(Vector3 pos)
+/// Moves a sphere from `start` along `path`; cab tris are two-sided, the sphere hits the side it approaches from.
+static bool sweep_sphere_tri(Vector3 start, Vector3 path, float radius, Vector3 a, Vector3 b, Vector3 c, float* out_t)
 {
-    Vector3 query = pos + 0.3f * Vector3::UNIT_Y;
-    while (query.y > pos.y)
+    Vector3 normal = (b - a).crossProduct(c - a);
+    if (normal.normalise() == 0.f)
+        return false;
+
+    const float side = (normal.dotProduct(start - a) < 0.f) ? -1.f : 1.f;
+    const float dist = side * normal.dotProduct(start - a);
+    const float approach = -side * normal.dotProduct(path);
+    if (approach <= 0.f)
+        return false; // moving along or away from the plane
+
+    const float t = std::max(0.f, (dist - radius) / approach);
+    if (t > 1.f)
+        return false;
+
+    // Where the sphere touches the plane; must lie within the tri grown by the radius
+    const Vector3 contact = start + path * t - normal * (side * (dist - approach * t));
+    const Vector3 verts[3] = { a, b, c };
+    for (int i = 0; i < 3; i++)
     {
-        if (App::GetGameContext()->GetTerrain()->GetCollisions()->collisionCorrect(&query, false))
-            break;
-        query.y -= 0.001f;
+        Vector3 inward = normal.crossProduct(verts[(i + 1) % 3] - verts[i]);
+        inward.normalise();
+        if (inward.dotProduct(contact - verts[i]) < -radius)
+            return false;
     }
-    return query.y - pos.y;
+
+    *out_t = t;
+    return true;
 }
 
-void Character::update(float dt)
+/// Like `Collisions::sweepCapsule()`, for the collision cabs of actors
+static bool sweep_actor_cabs(std::vector<Actor*> const& actors, Vector3 start, Vector3 end, float radius, float* out_t)
 {
-    if (!m_is_remote && (m_actor_coupling == nullptr) && (App::sim_state->getEnum<SimState>() != SimState::PAUSED))
+    Vector3 lo = start;
+    Vector3 hi = start;
+    lo.makeFloor(end);
+    hi.makeCeil(end);
+    lo -= Vector3(radius);
+    hi += Vector3(radius);
+    const AxisAlignedBox sweep_box(lo, hi);
+
+    bool hit = false;
+    for (Actor* actor : actors)
     {
-        // disable character movement when using the free camera mode or when the menu is opened
-        // TODO: check for menu being opened
-        if (App::GetCameraManager()->GetCurrentBehavior() == CameraManager::CAMERA_BEHAVIOR_FREE)
+        if (actor->ar_num_collcabs == 0 || !actor->ar_bounding_box.intersects(sweep_box))
+            continue;
+
+        for (int i = 0; i < actor->ar_num_collcabs; i++)
         {
-            return;
+            int tmpv = actor->ar_collcabs[i] * 3;
+            Vector3 a = actor->ar_nodes[actor->ar_cabs[tmpv + 0]].AbsPosition;
+            Vector3 b = actor->ar_nodes[actor->ar_cabs[tmpv + 1]].AbsPosition;
+            Vector3 c = actor->ar_nodes[actor->ar_cabs[tmpv + 2]].AbsPosition;
+            if (hi.x < std::min({a.x, b.x, c.x}) || lo.x > std::max({a.x, b.x, c.x}) ||
+                hi.y < std::min({a.y, b.y, c.y}) || lo.y > std::max({a.y, b.y, c.y}) ||
+                hi.z < std::min({a.z, b.z, c.z}) || lo.z > std::max({a.z, b.z, c.z}))
+                continue;
+
+            float t = 0.f;
+            if (sweep_sphere_tri(start, end - start, radius, a, b, c, &t) && (!hit || t < *out_t))
+            {
+                *out_t = t;
+                hit = true;
+            }
         }
+    }
+    return hit;
+}
 
-        Vector3 position = m_character_position; //ASYNCSCENE OLD m_character_scenenode->getPosition();
+static float calculate_collision_depth(Collisions* collisions, Vector3 pos, float radius)
+{
+    // Highest surface up to 0.3m above the feet; the sphere rests on it with its bottom at the feet
+    const float reach = 0.3f;
+    float hit_t = 0.f;
+    if (!collisions->sweepCapsule(pos + (reach + radius) * Vector3::UNIT_Y, pos + radius * Vector3::UNIT_Y, radius, &hit_t))
+        return 0.f;
+    return reach * (1.f - hit_t);
+}
 
-        // gravity force is always on
-        position.y += m_character_v_speed * dt;
-        m_character_v_speed += dt * -9.8f;
+static float calculate_cab_depth(std::vector<Actor*> const& actors, Vector3 pos, float radius)
+{
+    // Highest cab surface up to 1.8m above the feet - moving vehicles may push into the character
+    const float reach = 1.8f;
+    float hit_t = 0.f;
+    if (!sweep_actor_cabs(actors, pos + (reach + radius) * Vector3::UNIT_Y, pos + radius * Vector3::UNIT_Y, radius, &hit_t))
+        return 0.f;
+    return reach * (1.f - hit_t);
+}
+
+void Character::ResolveCollisions(float dt, Collisions* collisions, std::vector<Actor*> const& actors)
+{
+    Vector3 position = m_character_position;
 
-        // Trigger script events and handle mesh (ground) collision
-        Vector3 query = position;
-        App::GetGameContext()->GetTerrain()->GetCollisions()->collisionCorrect(&query);
+    // gravity force is always on
+    position.y += m_character_v_speed * dt;
+    m_character_v_speed += dt * -9.8f;
 
-        // Auto compensate minor height differences
-        float depth = calculate_collision_depth(position);
+    // Trigger script events and handle mesh (ground) collision
+    Vector3 query = position;
+    collisions->collisionCorrect(&query);
+
+    // Auto compensate minor height differences
+    float depth = calculate_collision_depth(collisions, position, m_character_radius);
+    if (depth > 0.0f)
+    {
+        m_can_jump = true;
+        m_character_v_speed = std::max(0.0f, m_character_v_speed);
+        position.y += std::min(depth, 2.0f * dt);
+    }
+
+    // Submesh "collision"
+    {
+        float depth = calculate_cab_depth(actors, position, m_character_radius);
         if (depth > 0.0f)
         {
             m_can_jump = true;
             m_character_v_speed = std::max(0.0f, m_character_v_speed);
-            position.y += std::min(depth, 2.0f * dt);
+            position.y += std::min(depth, 0.05f);
         }
+    }
 
-        // Submesh "collision"
+    // Obstacle detection - the bottom of the swept sphere stays 0.25m above the feet, lower obstacles are stepped onto
+    if (position != m_prev_position)
+    {
+        Vector3 diff = position - m_prev_position;
+        Vector3 base = m_prev_position + Vector3::UNIT_Y * (0.25f + m_character_radius);
+        float hit_t = 1.f;
+        float cab_t = 1.f;
+        const bool hit = collisions->sweepCapsule(base, base + diff, m_character_radius, &hit_t);
+        if (sweep_actor_cabs(actors, base, base + diff, m_character_radius, &cab_t) || hit)
         {
-            float depth = 0.0f;
-            for (auto actor : App::GetGameContext()->GetActorManager()->GetActors())
-            {
-                if (actor->ar_bounding_box.contains(position))
-                {
-                    for (int i = 0; i < actor->ar_num_collcabs; i++)
-                    {
-                        int tmpv = actor->ar_collcabs[i] * 3;
-                        Vector3 a = actor->ar_nodes[actor->ar_cabs[tmpv + 0]].AbsPosition;
-                        Vector3 b = actor->ar_nodes[actor->ar_cabs[tmpv + 1]].AbsPosition;
-                        Vector3 c = actor->ar_nodes[actor->ar_cabs[tmpv + 2]].AbsPosition;
-                        auto result = Math::intersects(Ray(position, Vector3::UNIT_Y), a, b, c);
-                        if (result.first && result.second < 1.8f)
-                        {
-                            depth = std::max(depth, result.second);
-                        }
-                    }
-                }
-            }
-            if (depth > 0.0f)
-            {
-                m_can_jump = true;
-                m_character_v_speed = std::max(0.0f, m_character_v_speed);
-                position.y += std::min(depth, 0.05f);
-            }
+            // Stop 1% of the step short, like the former 100-step probe did
+            m_character_v_speed = std::max(0.0f, m_character_v_speed);
+            position = m_prev_position + diff * std::max(0.0f, std::min(hit_t, cab_t) - 0.01f);
+            position.y += 0.025f;
         }
+    }
+
+    m_prev_position = position;
+    m_character_position = position;
+}
 
-        // Obstacle detection
-        if (position != m_prev_position)
+void Character::update(float dt)
+{
+    if (!m_is_remote && (m_actor_coupling == nullptr) && (App::sim_state->getEnum<SimState>() != SimState::PAUSED))
+    {
+        // disable character movement when using the free camera mode or when the menu is opened
+        // TODO: check for menu being opened
+        if (App::GetCameraManager()->GetCurrentBehavior() == CameraManager::CAMERA_BEHAVIOR_FREE)
         {
-            const int numstep = 100;
-            Vector3 diff = position - m_prev_position;
-            Vector3 base = m_prev_position + Vector3::UNIT_Y * 0.25f;
-            for (int i = 1; i < numstep; i++)
-            {
-                Vector3 query = base + diff * ((float)i / numstep);
-                if (App::GetGameContext()->GetTerrain()->GetCollisions()->collisionCorrect(&query, false))
-                {
-                    m_character_v_speed = std::max(0.0f, m_character_v_speed);
-                    position = m_prev_position + diff * ((float)(i - 1) / numstep);
-                    position.y += 0.025f;
-                    break;
-                }
-            }
+            return;
         }
 
-        m_prev_position = position;
+        this->ResolveCollisions(dt, App::GetGameContext()->GetTerrain()->GetCollisions(), App::GetGameContext()->GetActorManager()->GetActors());
+        Vector3 position = m_character_position; //ASYNCSCENE OLD m_character_scenenode->getPosition();
 
         // ground contact
         float pheight = App::GetGameContext()->GetTerrain()->GetHeightAt(position.x, position.z);
@@ -27,6 +27,7 @@
 #include <OgreMeshManager.h>
 #include <OgreTimer.h>
 #include <string>
+#include <vector>
 
 namespace RoR {
 
@@ -58,6 +59,7 @@ public:
     void           setRotation(Ogre::Radian rotation);
     void           move(Ogre::Vector3 offset);
     void           update(float dt);
+    void           ResolveCollisions(float dt, Collisions* collisions, std::vector<Actor*> const& actors); //!< Gravity, step-up and obstacles (terrain collisions and actor cabs) for the on-foot character; part of `update()`
     void           updateCharacterRotation();
     void           receiveStreamData(unsigned int& type, int& source, unsigned int& streamid, char* buffer);
     void           SetActorCoupling(bool enabled, Actor* actor);
@@ -74,6 +76,7 @@ private:
     Ogre::Radian     m_character_rotation;
     float            m_character_h_speed;
     float            m_character_v_speed;
+    float            m_character_radius; //!< Horizontal extent of the body, for collision sweeps
     Ogre::Vector3    m_character_position;
     Ogre::Vector3    m_prev_position;
     int              m_color_number;
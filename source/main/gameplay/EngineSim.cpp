@@ -375,7 +375,7 @@ void EngineSim::UpdateEngineSim(float dt, int doUpdate)
                 // anti lag
                 if (m_turbo_has_antilag && m_cur_acc < 0.5)
                 {
-                    float f = frand();
+                    float f = frand(m_actor->ar_rand_seed);
                     if (m_cur_engine_rpm > m_antilag_min_rpm && f > m_antilag_rand_chance)
                     {
                         if (m_cur_turbo_rpm[i] > m_max_turbo_rpm * 0.35 && m_cur_turbo_rpm[i] < m_max_turbo_rpm)
@@ -610,7 +610,7 @@ void EngineSim::UpdateEngineSim(float dt, int doUpdate)
             velocity = hdir.dotProduct(m_actor->ar_nodes[0].Velocity);
         }
 
-        if (m_actor->ar_wheels[0].wh_radius != 0)
+        if (m_actor->ar_num_wheels > 0 && m_actor->ar_wheels[0].wh_radius != 0)
         {
             m_ref_wheel_revolutions = velocity / m_actor->ar_wheels[0].wh_radius * RAD_PER_SEC_TO_RPM;
         }
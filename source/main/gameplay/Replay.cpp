@@ -180,7 +180,7 @@ unsigned long Replay::getLastReadTime()
  
 void Replay::onPhysicsStep()
 {
-    m_replay_timer += PHYSICS_DT;
+    m_replay_timer += m_actor->getPhysicsDt();
     if (m_replay_timer >= ar_replay_precision)
     {
         // store nodes
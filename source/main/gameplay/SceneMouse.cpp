@@ -122,37 +122,21 @@ bool SceneMouse::mouseMoved(const OIS::MouseEvent& _arg)
 
         Ray mouseRay = getMouseRay();
 
-        // walk all trucks
+        // find the nearest grabbable node along the ray
         minnode = NODENUM_INVALID;
         grab_truck = NULL;
-        for (auto actor : App::GetGameContext()->GetActorManager()->GetActors())
+        NodeSpatialIndex::NodeRef hit;
+        float hit_dist = 0.f;
+        auto is_grabbable = [](NodeSpatialIndex::NodeRef const& ref)
         {
-            if (actor->ar_state == ActorState::LOCAL_SIMULATED)
-            {
-                // check if our ray intersects with the bounding box of the truck
-                std::pair<bool, Real> pair = mouseRay.intersects(actor->ar_bounding_box);
-                if (!pair.first)
-                    continue;
-
-                for (int j = 0; j < actor->ar_num_nodes; j++)
-                {
-                    if (actor->ar_nodes[j].nd_no_mouse_grab)
-                        continue;
-
-                    // check if our ray intersects with the node
-                    std::pair<bool, Real> pair = mouseRay.intersects(Sphere(actor->ar_nodes[j].AbsPosition, 0.1f));
-                    if (pair.first)
-                    {
-                        // we hit it, check if its the nearest node
-                        if (pair.second < mindist)
-                        {
-                            mindist = pair.second;
-                            minnode = (NodeNum_t)j;
-                            grab_truck = actor;
-                        }
-                    }
-                }
-            }
+            return ref.actor->ar_state == ActorState::LOCAL_SIMULATED
+                && !ref.actor->ar_nodes[ref.node_num].nd_no_mouse_grab;
+        };
+        if (App::GetGameContext()->GetActorManager()->GetNodeIndex().QueryRay(mouseRay, mindist, 0.1f, hit, hit_dist, is_grabbable))
+        {
+            mindist = hit_dist;
+            minnode = hit.node_num;
+            grab_truck = hit.actor;
         }
 
         // check if we hit a node
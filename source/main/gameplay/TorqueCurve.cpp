@@ -21,6 +21,7 @@
 #include "TorqueCurve.h"
 
 #include "Application.h"
+#include "PlatformUtils.h"
 #include "Utils.h"
 
 #include <Ogre.h>
@@ -30,6 +31,9 @@ using namespace RoR;
 
 const String TorqueCurve::customModel = "CustomModel";
 
+std::map<Ogre::String, Ogre::SimpleSpline> TorqueCurve::s_default_splines;
+bool TorqueCurve::s_default_splines_loaded = false;
+
 TorqueCurve::TorqueCurve() : usedSpline(0), usedModel("")
 {
     loadDefaultTorqueModels();
@@ -55,27 +59,21 @@ Real TorqueCurve::getEngineTorque(Real rpm)
     return usedSpline->interpolate(t).y;
 }
 
-int TorqueCurve::loadDefaultTorqueModels()
+void TorqueCurve::PreloadDefaultTorqueModels()
 {
-    //LOG("loading default torque Curves");
-    // check if we have a config file
-    String group = "";
-    try
-    {
-        group = ResourceGroupManager::getSingleton().findGroupContainingResource("torque_models.cfg");
-    }
-    catch (...)
-    {
-    }
-    // emit a warning if we did not found the file
-    if (group.empty())
+    // Read directly from config dir, this runs on a worker thread during startup
+    DataStreamPtr ds = OpenFileDirect(PathCombine(App::sys_config_dir->getStr(), "torque_models.cfg"));
+    if (!ds)
     {
         LOG("torque_models.cfg not found");
-        return 1;
+        return;
     }
+    parseTorqueModels(ds, s_default_splines);
+    s_default_splines_loaded = true;
+}
 
-    // open the file for reading
-    DataStreamPtr ds = ResourceGroupManager::getSingleton().openResource("torque_models.cfg", group);
+void TorqueCurve::parseTorqueModels(Ogre::DataStreamPtr ds, std::map<Ogre::String, Ogre::SimpleSpline>& out_splines)
+{
     String line = "";
     String currentModel = "";
 
@@ -95,40 +93,44 @@ int TorqueCurve::loadDefaultTorqueModels()
             continue;
         }
 
-        // process the line if we got a model
-        if (!currentModel.empty())
-            processLine(args, currentModel);
+        // we only accept 2 arguments, and only once we got a model
+        if (args.size() != 2 || currentModel.empty())
+            continue;
+
+        // attach the point to the spline (created on first use)
+        float pointx = StringConverter::parseReal(args[0]);
+        float pointy = StringConverter::parseReal(args[1]);
+        out_splines[currentModel].addPoint(Vector3(pointx, pointy, 0));
     }
-    return 0;
 }
 
-int TorqueCurve::processLine(Ogre::StringVector args, String model)
+int TorqueCurve::loadDefaultTorqueModels()
 {
-    // if its just one arguments, it must be a known model
-    if (args.size() == 1)
-        return setTorqueModel(args[0]);
+    if (s_default_splines_loaded)
+    {
+        splines = s_default_splines; // Parsed once at startup
+        return 0;
+    }
 
-    // we only accept 2 arguments
-    if (args.size() != 2)
+    // check if we have a config file
+    String group = "";
+    try
+    {
+        group = ResourceGroupManager::getSingleton().findGroupContainingResource("torque_models.cfg");
+    }
+    catch (...)
+    {
+    }
+    // emit a warning if we did not found the file
+    if (group.empty())
+    {
+        LOG("torque_models.cfg not found");
         return 1;
-    // parse the data
-    float pointx = StringConverter::parseReal(args[0]);
-    float pointy = StringConverter::parseReal(args[1]);
-    Vector3 point = Vector3(pointx, pointy, 0);
-
-    // find the spline to attach the points
-    if (splines.find(model) == splines.end())
-        splines[model] = SimpleSpline();
-
-    // attach the points to the spline
-    // LOG("curve "+model+" : " + TOSTRING(point));
-    splines[model].addPoint(point);
-
-    // special case for custom model:
-    // we set it as active curve as well!
-    if (model == TorqueCurve::customModel)
-        setTorqueModel(TorqueCurve::customModel);
+    }
 
+    // open the file for reading
+    DataStreamPtr ds = ResourceGroupManager::getSingleton().openResource("torque_models.cfg", group);
+    parseTorqueModels(ds, splines);
     return 0;
 }
 
@@ -22,6 +22,8 @@
 
 #include "Application.h"
 
+#include <OgreDataStream.h>
+
 /// @file
 /// @version 1
 /// @brief torquecurve loader.
@@ -47,6 +49,12 @@ public:
     TorqueCurve(); //!< Constructor
     ~TorqueCurve(); //!< Destructor
 
+    /**
+     * Parses 'torque_models.cfg' once for all future instances; thread safe, doesn't use OGRE resource system.
+     * Must finish before the first instance is created.
+     */
+    static void PreloadDefaultTorqueModels();
+
     /**
      * Returns the calculated engine torque based on the given RPM, interpolating the torque curve spline.
      * @param The current engine RPM.
@@ -102,17 +110,17 @@ protected:
     int loadDefaultTorqueModels();
 
     /**
-     * Processes the given vector.
-     * Adds points to a torque curve spline; or if a new model is found, generating a new spline.
-     * @param args Vector of arguments of the line which should be processed.
-     * @param model Torque model name (i.e. 'turbodiesel')
-     * @return setTorqueModel() called if one argument given, 1 on error, 0 on success
+     * Reads torque models from a 'torque_models.cfg' file.
+     * A line with one argument starts a new model; lines with 2 arguments add points to its spline.
      */
-    int processLine(Ogre::StringVector args, Ogre::String model);
+    static void parseTorqueModels(Ogre::DataStreamPtr ds, std::map<Ogre::String, Ogre::SimpleSpline>& out_splines);
 
     Ogre::SimpleSpline* usedSpline; //!< spline which is used for calculating the torque, set by setTorqueModel().
     Ogre::String usedModel; //!< name of the torque model used by the truck.
     std::map<Ogre::String, Ogre::SimpleSpline> splines; //!< container were all torque curve splines are stored in.
+
+    static std::map<Ogre::String, Ogre::SimpleSpline> s_default_splines; //!< Parsed by `PreloadDefaultTorqueModels()`
+    static bool s_default_splines_loaded;
 };
 
 /// @} // addtogroup Trucks
@@ -44,6 +44,7 @@ public:
     TyrePressure(Actor* a): m_actor(a) {}
 
     void                AddBeam(int beam_id) { m_pressure_beams.push_back(beam_id); }
+    std::vector<int> const& GetBeams() const { return m_pressure_beams; }
     bool                IsEnabled() const { return m_pressure_beams.size() != 0; }
     void                UpdateInputEvents(float dt);
     bool                ModifyTyrePressure(float v);
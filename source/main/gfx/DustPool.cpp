@@ -21,6 +21,7 @@
 #include "DustPool.h"
 
 #include <Ogre.h>
+#include <OgreBillboardParticleRenderer.h>
 
 #include "Application.h"
 #include "GameContext.h"
@@ -35,28 +36,77 @@ using namespace RoR;
   const int DustPool::MAX_DUSTS;
 #endif // !_WIN32
 
+namespace {
+
+/// Billboard set which asks the pool for its particles whenever it's rendered
+class DustBillboardSet: public Ogre::BillboardSet
+{
+public:
+    DustBillboardSet(DustPool* pool, Ogre::String const& name, unsigned int pool_size)
+        : Ogre::BillboardSet(name, pool_size, /*externalData=*/true)
+        , m_pool(pool)
+    {}
+
+    virtual void _updateRenderQueue(Ogre::RenderQueue* queue) override
+    {
+        m_pool->InjectBillboards(this);
+        Ogre::BillboardSet::_updateRenderQueue(queue);
+    }
+
+private:
+    DustPool* m_pool;
+};
+
+} // namespace
+
 DustPool::DustPool(Ogre::SceneManager* sm, const char* dname, int dsize):
 	allocated(0),
 	size(std::min(dsize, static_cast<int>(MAX_DUSTS))),
+	m_num_particles(0),
+	m_max_particles(0),
+	m_billboards(nullptr),
+	m_scene_node(nullptr),
+	m_is_valid(false),
 	m_is_discarded(false)
 {
-    for (int i = 0; i < size; i++)
+    ParticleSystem* templ = ParticleSystemManager::getSingleton().getTemplate(dname);
+    if (!templ)
     {
-        char dename[256];
-        sprintf(dename, "Dust %s %i", dname, i);
-        sns[i] = sm->getRootSceneNode()->createChildSceneNode();
-        pss[i] = sm->createParticleSystem(dename, dname);
-        if (pss[i])
-        {
-            sns[i]->attachObject(pss[i]);
-            pss[i]->setCastShadows(false);
-            pss[i]->setVisibilityFlags(RoR::DEPTHMAP_DISABLED);
-            if (pss[i]->getNumEmitters() > 0)
-            {
-                pss[i]->getEmitter(0)->setEnabled(false);
-            }
-        }
+        LOG(fmt::format("[RoR] DustPool: particle system template '{}' not found", dname));
+        return;
+    }
+    this->LoadEffectDef(templ);
+
+    m_max_particles = static_cast<size_t>(m_def.quota) * size;
+    m_particle_pos.resize(m_max_particles);
+    m_particle_vel.resize(m_max_particles);
+    m_particle_colour.resize(m_max_particles);
+    m_particle_ttl.resize(m_max_particles);
+    m_particle_size.resize(m_max_particles);
+    m_particle_rot.resize(m_max_particles);
+    m_particle_rot_speed.resize(m_max_particles);
+
+    m_billboards = OGRE_NEW DustBillboardSet(this, fmt::format("Dust {}", dname), static_cast<unsigned int>(m_max_particles));
+    m_billboards->setMaterialName(templ->getMaterialName());
+    m_billboards->setDefaultDimensions(m_def.width, m_def.height);
+    m_billboards->setBillboardsInWorldSpace(true);
+    m_billboards->setCullIndividually(false);
+    m_billboards->setAutoextend(false);
+    m_billboards->setCastShadows(false);
+    m_billboards->setVisibilityFlags(RoR::DEPTHMAP_DISABLED);
+    if (templ->getRendererName() == "billboard")
+    {
+        BillboardParticleRenderer* renderer = static_cast<BillboardParticleRenderer*>(templ->getRenderer());
+        m_billboards->setBillboardType(renderer->getBillboardType());
+        m_billboards->setCommonDirection(renderer->getCommonDirection());
+        m_billboards->setCommonUpVector(renderer->getCommonUpVector());
     }
+    m_bounds.setNull();
+    m_billboards->setBounds(m_bounds, 0.f);
+
+    m_scene_node = sm->getRootSceneNode()->createChildSceneNode();
+    m_scene_node->attachObject(m_billboards);
+    m_is_valid = true;
 }
 
 DustPool::~DustPool()
@@ -66,26 +116,111 @@ DustPool::~DustPool()
 
 void DustPool::Discard(Ogre::SceneManager* sm)
 {
-	for (int i = 0; i < size; i++)
+	if (m_scene_node)
+	{
+		m_scene_node->detachAllObjects();
+		sm->destroySceneNode(m_scene_node);
+		m_scene_node = nullptr;
+	}
+	if (m_billboards)
 	{
-		sns[i]->removeAndDestroyAllChildren();
-		sm->destroySceneNode(sns[i]);
-		sns[i] = nullptr;
-
-		if (pss[i])
-		{
-			sm->destroyParticleSystem(pss[i]);
-			pss[i] = nullptr;
-		}
+		OGRE_DELETE m_billboards;
+		m_billboards = nullptr;
 	}
+	m_num_particles = 0;
+	m_is_valid = false;
 	m_is_discarded = true;
 }
 
+void DustPool::LoadEffectDef(Ogre::ParticleSystem* templ)
+{
+    m_def.width  = templ->getDefaultWidth();
+    m_def.height = templ->getDefaultHeight();
+    m_def.quota  = static_cast<int>(templ->getParticleQuota());
+
+    // Defaults of `Ogre::ParticleEmitter`
+    m_def.box_emitter   = false;
+    m_def.box_size      = Vector3::ZERO;
+    m_def.angle         = Radian(0);
+    m_def.emission_rate = 10.f;
+    m_def.ttl_min       = m_def.ttl_max = 5.f;
+    m_def.velocity_min  = m_def.velocity_max = 1.f;
+    m_def.direction     = Vector3::UNIT_X;
+    m_def.colour        = ColourValue::White;
+    if (templ->getNumEmitters() > 0)
+    {
+        ParticleEmitter* emitter = templ->getEmitter(0);
+        m_def.box_emitter   = (emitter->getType() == "Box");
+        if (m_def.box_emitter)
+        {
+            m_def.box_size = Vector3(StringConverter::parseReal(emitter->getParameter("width")),
+                                     StringConverter::parseReal(emitter->getParameter("height")),
+                                     StringConverter::parseReal(emitter->getParameter("depth")));
+        }
+        m_def.angle         = emitter->getAngle();
+        m_def.emission_rate = emitter->getEmissionRate();
+        m_def.ttl_min       = emitter->getMinTimeToLive();
+        m_def.ttl_max       = emitter->getMaxTimeToLive();
+        m_def.velocity_min  = emitter->getMinParticleVelocity();
+        m_def.velocity_max  = emitter->getMaxParticleVelocity();
+        m_def.direction     = emitter->getDirection();
+        m_def.colour        = emitter->getColourRangeStart();
+    }
+
+    m_def.force            = Vector3::ZERO;
+    m_def.force_average    = false;
+    m_def.fade             = ColourValue::ZERO;
+    m_def.scale_rate       = 0.f;
+    m_def.has_rotator      = false;
+    m_def.has_deflector    = false;
+    m_def.deflector_bounce = 0.f;
+    for (unsigned short i = 0; i < templ->getNumAffectors(); i++)
+    {
+        ParticleAffector* affector = templ->getAffector(i);
+        const String& type = affector->getType();
+        if (type == "LinearForce")
+        {
+            m_def.force = StringConverter::parseVector3(affector->getParameter("force_vector"));
+            m_def.force_average = (affector->getParameter("force_application") == "average");
+        }
+        else if (type == "ColourFader")
+        {
+            m_def.fade = ColourValue(StringConverter::parseReal(affector->getParameter("red")),
+                                     StringConverter::parseReal(affector->getParameter("green")),
+                                     StringConverter::parseReal(affector->getParameter("blue")),
+                                     StringConverter::parseReal(affector->getParameter("alpha")));
+        }
+        else if (type == "Scaler")
+        {
+            m_def.scale_rate = StringConverter::parseReal(affector->getParameter("rate"));
+        }
+        else if (type == "Rotator")
+        {
+            m_def.has_rotator        = true;
+            m_def.rotation_min       = Degree(StringConverter::parseReal(affector->getParameter("rotation_range_start")));
+            m_def.rotation_max       = Degree(StringConverter::parseReal(affector->getParameter("rotation_range_end")));
+            m_def.rotation_speed_min = Degree(StringConverter::parseReal(affector->getParameter("rotation_speed_range_start")));
+            m_def.rotation_speed_max = Degree(StringConverter::parseReal(affector->getParameter("rotation_speed_range_end")));
+        }
+        else if (type == "DeflectorPlane")
+        {
+            m_def.has_deflector    = true;
+            m_def.deflector_plane  = Plane(StringConverter::parseVector3(affector->getParameter("plane_normal")),
+                                           StringConverter::parseVector3(affector->getParameter("plane_point")));
+            m_def.deflector_bounce = StringConverter::parseReal(affector->getParameter("bounce"));
+        }
+        else
+        {
+            LOG(fmt::format("[RoR] DustPool: particle system '{}' - affector '{}' is not supported, ignoring", templ->getName(), type));
+        }
+    }
+}
+
 void DustPool::setVisible(bool s)
 {
-    for (int i = 0; i < size; i++)
+    if (m_billboards)
     {
-        pss[i]->setVisible(s);
+        m_billboards->setVisible(s);
     }
 }
 
@@ -122,6 +257,7 @@ void DustPool::allocSmoke(Vector3 pos, Vector3 vel)
     {
         positions[allocated] = pos;
         velocities[allocated] = vel;
+        colours[allocated] = m_def.colour;
         types[allocated] = DUST_RUBBER;
         allocated++;
     }
@@ -136,6 +272,7 @@ void DustPool::allocSparks(Vector3 pos, Vector3 vel)
     {
         positions[allocated] = pos;
         velocities[allocated] = vel;
+        colours[allocated] = m_def.colour;
         types[allocated] = DUST_SPARKS;
         allocated++;
     }
@@ -148,6 +285,7 @@ void DustPool::allocVapour(Vector3 pos, Vector3 vel, float time)
     {
         positions[allocated] = pos;
         velocities[allocated] = vel;
+        colours[allocated] = m_def.colour;
         types[allocated] = DUST_VAPOUR;
         rates[allocated] = 5.0 - time;
         allocated++;
@@ -160,6 +298,7 @@ void DustPool::allocDrip(Vector3 pos, Vector3 vel, float time)
     {
         positions[allocated] = pos;
         velocities[allocated] = vel;
+        colours[allocated] = m_def.colour;
         types[allocated] = DUST_DRIP;
         rates[allocated] = 5.0 - time;
         allocated++;
@@ -172,6 +311,7 @@ void DustPool::allocSplash(Vector3 pos, Vector3 vel)
     {
         positions[allocated] = pos;
         velocities[allocated] = vel;
+        colours[allocated] = m_def.colour;
         types[allocated] = DUST_SPLASH;
         allocated++;
     }
@@ -183,112 +323,253 @@ void DustPool::allocRipple(Vector3 pos, Vector3 vel)
     {
         positions[allocated] = pos;
         velocities[allocated] = vel;
+        colours[allocated] = m_def.colour;
         types[allocated] = DUST_RIPPLE;
         allocated++;
     }
 }
 
-void DustPool::update()
+void DustPool::Emit(int i, float dt_sec)
 {
-    for (int i = 0; i < allocated; i++)
+    // Emitter setup per dust type; starts from the template like a fresh OGRE emitter
+    Vector3 pos = positions[i];
+    Vector3 dir = m_def.direction;
+    Real vel_min = m_def.velocity_min;
+    Real vel_max = m_def.velocity_max;
+    Real ttl_min = m_def.ttl_min;
+    Real ttl_max = m_def.ttl_max;
+    Real rate = m_def.emission_rate;
+
+    Vector3 ndir = velocities[i];
+    Real vel = ndir.length();
+    ColourValue col = colours[i];
+
+    if (vel == 0)
+        vel += 0.0001;
+    ndir = ndir / vel;
+
+    if (types[i] != DUST_RIPPLE)
     {
-        ParticleEmitter* emit = pss[i]->getEmitter(0);
-        Vector3 ndir = velocities[i];
-        Real vel = ndir.length();
-        ColourValue col = colours[i];
+        dir = ndir;
+        vel_min = vel_max = vel;
+    }
 
-        if (vel == 0)
-            vel += 0.0001;
-        ndir = ndir / vel;
+    if (types[i] == DUST_NORMAL)
+    {
+        col.a = vel * 0.05;
+        ttl_min = ttl_max = vel * 0.05 / 0.1;
+    }
+    else if (types[i] == DUST_CLUMP)
+    {
+        col.a = 1.0;
+    }
+    else if (types[i] == DUST_RUBBER)
+    {
+        col.a = sqrt(vel) * 0.1;
+        col.b = 0.9;
+        col.g = 0.9;
+        col.r = 0.9;
 
-        emit->setEnabled(true);
+        ttl_min = ttl_max = vel * 0.025 / 0.1;
+    }
+    else if (types[i] == DUST_SPARKS)
+    {
+        //ugh
+    }
+    else if (types[i] == DUST_VAPOUR)
+    {
+        vel_min = vel_max = vel / 2.0;
 
-        if (types[i] != DUST_RIPPLE)
-        {
-            emit->setDirection(ndir);
-            emit->setParticleVelocity(vel);
-            sns[i]->setPosition(positions[i]);
-        }
+        col.a = rates[i] * 0.03;
+        col.b = 0.9;
+        col.g = 0.9;
+        col.r = 0.9;
 
-        if (types[i] == DUST_NORMAL)
-        {
-            ndir.y = 0;
-            ndir = ndir / 2.0;
+        ttl_min = ttl_max = rates[i] * 0.03 / 0.1;
+    }
+    else if (types[i] == DUST_DRIP)
+    {
+        rate = rates[i];
+    }
+    else if (types[i] == DUST_SPLASH)
+    {
+        if (ndir.y < 0)
+            ndir.y = -ndir.y / 2.0;
 
-            col.a = vel * 0.05;
-            emit->setTimeToLive(vel * 0.05 / 0.1);
-        }
-        else if (types[i] == DUST_CLUMP)
-        {
-            ndir = ndir / 2.0;
-            if (ndir.y < 0)
-                ndir.y = -ndir.y;
+        dir = ndir;
 
-            col.a = 1.0;
-        }
-        else if (types[i] == DUST_RUBBER)
-        {
-            ndir.y = 0;
-            ndir = ndir / 4.0;
+        col.a = sqrt(vel) * 0.04;
+        col.b = 0.9;
+        col.g = 0.9;
+        col.r = 0.9;
+
+        ttl_min = ttl_max = vel * 0.025 / 0.1;
+    }
+    else if (types[i] == DUST_RIPPLE)
+    {
+        pos.y = RoR::App::GetGameContext()->GetTerrain()->getWater()->GetStaticWaterHeight() - 0.02;
 
-            col.a = sqrt(vel) * 0.1;
-            col.b = 0.9;
-            col.g = 0.9;
-            col.r = 0.9;
+        col.a = vel * 0.04;
+        col.b = 0.9;
+        col.g = 0.9;
+        col.r = 0.9;
 
-            emit->setTimeToLive(vel * 0.025 / 0.1);
-        }
-        else if (types[i] == DUST_SPARKS)
+        ttl_min = ttl_max = vel * 0.04 / 0.1;
+    }
+
+    // Same conventions as `Ogre::ParticleEmitter`: normalized direction, box axes follow the direction
+    dir.normalise();
+    const Vector3 up = dir.perpendicular();
+    const Vector3 left = up.crossProduct(dir);
+
+    const Real num_emitted = rate * dt_sec + m_emit_remainder[i];
+    int count = static_cast<int>(num_emitted);
+    m_emit_remainder[i] = num_emitted - count;
+
+    for (; count > 0 && m_num_particles < m_max_particles; count--)
+    {
+        const size_t p = m_num_particles++;
+
+        m_particle_pos[p] = pos;
+        if (m_def.box_emitter)
         {
-            //ugh
+            m_particle_pos[p] += left * (Math::SymmetricRandom() * m_def.box_size.x * 0.5f)
+                               + up   * (Math::SymmetricRandom() * m_def.box_size.y * 0.5f)
+                               + dir  * (Math::SymmetricRandom() * m_def.box_size.z * 0.5f);
         }
-        else if (types[i] == DUST_VAPOUR)
+
+        const Vector3 emit_dir = (m_def.angle != Radian(0)) ? dir.randomDeviant(m_def.angle * Math::UnitRandom()) : dir;
+        m_particle_vel[p] = emit_dir * Math::RangeRandom(vel_min, vel_max);
+        m_particle_colour[p] = col;
+        m_particle_ttl[p] = Math::RangeRandom(ttl_min, ttl_max);
+        m_particle_size[p] = 0.f;
+        m_particle_rot[p] = 0.f;
+        m_particle_rot_speed[p] = 0.f;
+        if (m_def.has_rotator)
         {
-            emit->setParticleVelocity(vel / 2.0);
+            m_particle_rot[p] = Math::RangeRandom(m_def.rotation_min.valueRadians(), m_def.rotation_max.valueRadians());
+            m_particle_rot_speed[p] = Math::RangeRandom(m_def.rotation_speed_min.valueRadians(), m_def.rotation_speed_max.valueRadians());
+        }
+    }
+}
+
+void DustPool::KillParticle(size_t i)
+{
+    // Move the last particle into the hole; order doesn't matter
+    const size_t last = --m_num_particles;
+    m_particle_pos[i]       = m_particle_pos[last];
+    m_particle_vel[i]       = m_particle_vel[last];
+    m_particle_colour[i]    = m_particle_colour[last];
+    m_particle_ttl[i]       = m_particle_ttl[last];
+    m_particle_size[i]      = m_particle_size[last];
+    m_particle_rot[i]       = m_particle_rot[last];
+    m_particle_rot_speed[i] = m_particle_rot_speed[last];
+}
 
-            col.a = rates[i] * 0.03;
-            col.b = 0.9;
-            col.g = 0.9;
-            col.r = 0.9;
+void DustPool::update(float dt_sec)
+{
+    if (!m_is_valid)
+    {
+        allocated = 0;
+        return;
+    }
 
-            emit->setTimeToLive(rates[i] * 0.03 / 0.1);
-        }
-        else if (types[i] == DUST_DRIP)
+    for (int i = 0; i < allocated; i++)
+    {
+        this->Emit(i, dt_sec);
+    }
+    for (int i = allocated; i < size; i++)
+    {
+        m_emit_remainder[i] = 0.f;
+    }
+    allocated = 0;
+
+    // Advance particles: affectors first, then motion - same order as `Ogre::ParticleSystem`
+    const Vector3 force_step = m_def.force * dt_sec;
+    const ColourValue fade_step = m_def.fade * dt_sec;
+    const float scale_step = m_def.scale_rate * dt_sec;
+    float max_size = 0.f;
+    m_bounds.setNull();
+
+    size_t i = 0;
+    while (i < m_num_particles)
+    {
+        m_particle_ttl[i] -= dt_sec;
+        if (m_particle_ttl[i] <= 0.f)
         {
-            emit->setEmissionRate(rates[i]);
+            this->KillParticle(i);
+            continue;
         }
-        else if (types[i] == DUST_SPLASH)
-        {
-            if (ndir.y < 0)
-                ndir.y = -ndir.y / 2.0;
 
-            emit->setDirection(ndir);
+        Vector3& pos = m_particle_pos[i];
+        Vector3& vel = m_particle_vel[i];
 
-            col.a = sqrt(vel) * 0.04;
-            col.b = 0.9;
-            col.g = 0.9;
-            col.r = 0.9;
+        if (m_def.force_average)
+            vel = (vel + m_def.force) / 2.f;
+        else
+            vel += force_step;
 
-            emit->setTimeToLive(vel * 0.025 / 0.1);
-        }
-        else if (types[i] == DUST_RIPPLE)
-        {
-            positions[i].y = RoR::App::GetGameContext()->GetTerrain()->getWater()->GetStaticWaterHeight() - 0.02;
-            sns[i]->setPosition(positions[i]);
+        ColourValue& col = m_particle_colour[i];
+        col += fade_step;
+        col.saturate();
 
-            col.a = vel * 0.04;
-            col.b = 0.9;
-            col.g = 0.9;
-            col.r = 0.9;
+        m_particle_size[i] = std::max(m_particle_size[i] + scale_step, -std::min(m_def.width, m_def.height));
+        m_particle_rot[i] += m_particle_rot_speed[i] * dt_sec;
 
-            emit->setTimeToLive(vel * 0.04 / 0.1);
+        if (m_def.has_deflector)
+        {
+            const Vector3 step = vel * dt_sec;
+            const Real dist = m_def.deflector_plane.getDistance(pos);
+            if (dist > 0.f && m_def.deflector_plane.getDistance(pos + step) <= 0.f)
+            {
+                // Move onto the plane and bounce off
+                const Vector3& n = m_def.deflector_plane.normal;
+                pos += step * (-dist / step.dotProduct(n));
+                vel = (vel - (2.f * vel.dotProduct(n) * n)) * m_def.deflector_bounce;
+            }
         }
 
-        emit->setColour(col);
+        pos += vel * dt_sec;
+
+        m_bounds.merge(pos);
+        max_size = std::max(max_size, m_particle_size[i]);
+        i++;
     }
-    for (int i = allocated; i < size; i++)
+
+    if (!m_bounds.isNull())
     {
-        pss[i]->getEmitter(0)->setEnabled(false);
+        // Account for billboard extents
+        const float half_extent = (std::max(m_def.width, m_def.height) + max_size) * 0.5f;
+        m_bounds.setExtents(m_bounds.getMinimum() - half_extent, m_bounds.getMaximum() + half_extent);
+        m_billboards->setBounds(m_bounds, m_bounds.getHalfSize().length());
     }
-    allocated = 0;
+    else
+    {
+        m_billboards->setBounds(m_bounds, 0.f);
+    }
+}
+
+void DustPool::InjectBillboards(Ogre::BillboardSet* bbs)
+{
+    if (m_def.has_rotator)
+        bbs->_notifyBillboardRotated();
+    if (m_def.scale_rate != 0.f)
+        bbs->_notifyBillboardResized();
+
+    // One pass over the particle arrays fills the whole vertex buffer
+    Billboard bb(Vector3::ZERO, bbs);
+    bbs->beginBillboards(m_num_particles);
+    for (size_t i = 0; i < m_num_particles; i++)
+    {
+        bb.mPosition = m_particle_pos[i];
+        bb.mDirection = m_particle_vel[i];
+        bb.mColour = m_particle_colour[i];
+        bb.mRotation = Radian(m_particle_rot[i]);
+        if (m_def.scale_rate != 0.f)
+        {
+            bb.setDimensions(m_def.width + m_particle_size[i], m_def.height + m_particle_size[i]);
+        }
+        bbs->injectBillboard(bb);
+    }
+    bbs->endBillboards();
 }
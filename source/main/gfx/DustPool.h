@@ -30,6 +30,11 @@ namespace RoR {
 /// @addtogroup Gfx
 /// @{
 
+/// Pooled CPU particle effect, one per effect type (dust, splash...).
+/// Emission and particle parameters are read from the OGRE particle system template (`.particle` script),
+/// the supported emitters are 'Point' and 'Box' and the supported affectors are 'LinearForce', 'ColourFader',
+/// 'Scaler', 'Rotator' and 'DeflectorPlane'. Emitters are requested every frame with the `alloc*()` functions,
+/// particles are kept in flat per-field arrays and drawn with a single billboard set.
 class DustPool : public ZeroedMemoryAllocator
 {
 public:
@@ -57,7 +62,11 @@ public:
 
     void allocRipple(Ogre::Vector3 pos, Ogre::Vector3 vel);
 
-    void update();
+    /// Emits from all emitters allocated since the last call, then advances all particles.
+    void update(float dt_sec);
+
+    /// Fills the billboard set; called by it for every camera which renders it.
+    void InjectBillboards(Ogre::BillboardSet* bbs);
 
 protected:
 
@@ -75,15 +84,61 @@ protected:
         DUST_CLUMP
     };
 
+    struct EffectDef //!< Read from the particle system template
+    {
+        float             width, height;
+        int               quota;             //!< Per emitter
+        bool              box_emitter;
+        Ogre::Vector3     box_size;
+        Ogre::Radian      angle;
+        float             emission_rate;
+        float             ttl_min, ttl_max;
+        float             velocity_min, velocity_max;
+        Ogre::Vector3     direction;
+        Ogre::ColourValue colour;            //!< Start of the colour range
+
+        Ogre::Vector3     force;             //!< 'LinearForce'
+        bool              force_average;
+        Ogre::ColourValue fade;              //!< 'ColourFader'
+        float             scale_rate;        //!< 'Scaler'
+        bool              has_rotator;       //!< 'Rotator'
+        Ogre::Radian      rotation_min, rotation_max, rotation_speed_min, rotation_speed_max;
+        bool              has_deflector;     //!< 'DeflectorPlane'
+        Ogre::Plane       deflector_plane;
+        float             deflector_bounce;
+    };
+
+    void LoadEffectDef(Ogre::ParticleSystem* templ);
+    void Emit(int emitter, float dt_sec);
+    void KillParticle(size_t index);
+
+    EffectDef m_def;
+
+    // Emitters requested this frame
     Ogre::ColourValue colours[MAX_DUSTS];
-    Ogre::ParticleSystem* pss[MAX_DUSTS];
-    Ogre::SceneNode* sns[MAX_DUSTS];
     Ogre::Vector3 positions[MAX_DUSTS];
     Ogre::Vector3 velocities[MAX_DUSTS];
     float rates[MAX_DUSTS];
+    float m_emit_remainder[MAX_DUSTS]; //!< Fractional particles carried over to the next frame
     int allocated;
     int size;
     int types[MAX_DUSTS];
+
+    // Particles
+    std::vector<Ogre::Vector3>     m_particle_pos;
+    std::vector<Ogre::Vector3>     m_particle_vel;
+    std::vector<Ogre::ColourValue> m_particle_colour;
+    std::vector<float>             m_particle_ttl;
+    std::vector<float>             m_particle_size;     //!< Added to the default width and height (Scaler)
+    std::vector<float>             m_particle_rot;      //!< Radians
+    std::vector<float>             m_particle_rot_speed;
+    size_t                         m_num_particles;
+    size_t                         m_max_particles;
+    Ogre::AxisAlignedBox           m_bounds;
+
+    Ogre::BillboardSet* m_billboards;
+    Ogre::SceneNode* m_scene_node;
+    bool m_is_valid;
     bool m_is_discarded;
 };
 
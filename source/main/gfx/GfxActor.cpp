@@ -178,6 +178,12 @@ RoR::GfxActor::~GfxActor()
     // Delete old cab mesh
     if (m_cab_mesh != nullptr)
     {
+        if (m_cab_mesh_task)
+        {
+            m_cab_mesh_task->join(); // Computes into `m_cab_mesh`
+            m_cab_mesh_task.reset();
+        }
+
         m_cab_scene_node->detachAllObjects();
         m_cab_scene_node->getParentSceneNode()->removeAndDestroyChild(m_cab_scene_node);
         m_cab_scene_node = nullptr;
@@ -577,6 +583,17 @@ const ImU32 NODE_MASS_TEXT_COLOR     (0xff77bb66);
 const ImU32 NODE_IMMOVABLE_COLOR     (0xff0033ff);
 const float NODE_IMMOVABLE_RADIUS    (2.8f);
 
+const float DEBUGVIEW_SCREEN_MARGIN   (100.f); // Pixels; nodes just off-screen still draw their labels
+const float DEBUGVIEW_MIN_BEAM_LENGTH (0.5f);  // Pixels; shorter beams are culled
+
+// Per-node culling bits
+const uint8_t DEBUGCLIP_LEFT         (1 << 0);
+const uint8_t DEBUGCLIP_RIGHT        (1 << 1);
+const uint8_t DEBUGCLIP_TOP          (1 << 2);
+const uint8_t DEBUGCLIP_BOTTOM       (1 << 3);
+const uint8_t DEBUGCLIP_BEHIND       (1 << 4); // Behind the camera
+const uint8_t DEBUGCLIP_WHEEL        (1 << 5); // Tyre or rim node
+
 void RoR::GfxActor::UpdateDebugView()
 {
     if (m_debug_view == DebugViewType::DEBUGVIEW_NONE && !m_actor->ar_physics_paused)
@@ -591,6 +608,40 @@ void RoR::GfxActor::UpdateDebugView()
 
     ImDrawList* drawlist = GetImDummyFullscreenWindow();
 
+    // Project all nodes once, from the sim snapshot (the live `ar_nodes` may be mid-update)
+    const NodeSB* sim_nodes = m_simbuf.simbuf_nodes.data();
+    const size_t num_nodes = m_simbuf.simbuf_nodes.size();
+    if (num_nodes != static_cast<size_t>(m_actor->ar_num_nodes))
+    {
+        return; // Snapshot not taken yet
+    }
+    m_debug_screen_pos.resize(num_nodes);
+    m_debug_node_clip.resize(num_nodes);
+    if (num_nodes > 0)
+    {
+        world2screen.ConvertBatch(&sim_nodes[0].AbsPosition, num_nodes, sizeof(NodeSB), m_debug_screen_pos.data());
+    }
+    const node_t* nodes = m_actor->ar_nodes;
+    for (size_t i = 0; i < num_nodes; ++i)
+    {
+        const Ogre::Vector3& p = m_debug_screen_pos[i];
+        uint8_t clip = 0;
+        clip |= (p.x < -DEBUGVIEW_SCREEN_MARGIN)                 ? DEBUGCLIP_LEFT   : 0;
+        clip |= (p.x > screen_size.x + DEBUGVIEW_SCREEN_MARGIN) ? DEBUGCLIP_RIGHT  : 0;
+        clip |= (p.y < -DEBUGVIEW_SCREEN_MARGIN)                 ? DEBUGCLIP_TOP    : 0;
+        clip |= (p.y > screen_size.y + DEBUGVIEW_SCREEN_MARGIN) ? DEBUGCLIP_BOTTOM : 0;
+        clip |= (p.z >= 0.f)                                     ? DEBUGCLIP_BEHIND : 0;
+        clip |= (nodes[i].nd_tyre_node || nodes[i].nd_rim_node)  ? DEBUGCLIP_WHEEL  : 0;
+        m_debug_node_clip[i] = clip;
+    }
+
+    // Evaluate the cvars once, not per element
+    const uint8_t hide_mask = DEBUGCLIP_BEHIND | (App::diag_hide_wheels->getBool() ? DEBUGCLIP_WHEEL : 0);
+    const uint8_t hide_info_mask = DEBUGCLIP_BEHIND | ((App::diag_hide_wheels->getBool() || App::diag_hide_wheel_info->getBool()) ? DEBUGCLIP_WHEEL : 0);
+    const uint8_t offscreen_mask = DEBUGCLIP_LEFT | DEBUGCLIP_RIGHT | DEBUGCLIP_TOP | DEBUGCLIP_BOTTOM;
+    const bool hide_broken_beams = App::diag_hide_broken_beams->getBool();
+    const bool hide_beam_stress = App::diag_hide_beam_stress->getBool();
+
     if (m_actor->ar_physics_paused && !App::GetGuiManager()->IsGuiHidden())
     {
         // Should we replace this circle with a proper bounding box?
@@ -600,9 +651,9 @@ void RoR::GfxActor::UpdateDebugView()
             ImVec2 pos(pos_xyz.x, pos_xyz.y);
 
             float radius = 0.0f;
-            for (int i = 0; i < m_actor->ar_num_nodes; ++i)
+            for (size_t i = 0; i < num_nodes; ++i)
             {
-                radius = std::max(radius, pos_xyz.distance(world2screen.Convert(m_actor->ar_nodes[i].AbsPosition)));
+                radius = std::max(radius, pos_xyz.distance(m_debug_screen_pos[i]));
             }
 
             drawlist->AddCircleFilled(pos, radius * 1.05f, 0x22222222, 36);
@@ -614,84 +665,101 @@ void RoR::GfxActor::UpdateDebugView()
         (m_debug_view == DebugViewType::DEBUGVIEW_NODES) ||
         (m_debug_view == DebugViewType::DEBUGVIEW_BEAMS))
     {
-        // Beams
-        const beam_t* beams = m_actor->ar_beams;
-        const size_t num_beams = static_cast<size_t>(m_actor->ar_num_beams);
+        // Beams - culled and colored first, then submitted as a single batch of quads.
+        // Read from the sim snapshot, like the nodes; it's empty until the first snapshot after switching the view.
+        const BeamSB* beams = m_simbuf.simbuf_beams.data();
+        const size_t num_beams = m_simbuf.simbuf_beams.size();
+        m_debug_beam_lines.clear();
         for (size_t i = 0; i < num_beams; ++i)
         {
-            if (App::diag_hide_wheels->getBool() &&
-                    (beams[i].p1->nd_tyre_node || beams[i].p1->nd_rim_node ||
-                     beams[i].p2->nd_tyre_node || beams[i].p2->nd_rim_node))
-                continue;
-
-            Ogre::Vector3 pos1 = world2screen.Convert(beams[i].p1->AbsPosition);
-            Ogre::Vector3 pos2 = world2screen.Convert(beams[i].p2->AbsPosition);
-
-            if ((pos1.z < 0.f) && (pos2.z < 0.f))
+            const NodeNum_t n1 = beams[i].simbuf_beam_node1;
+            const NodeNum_t n2 = beams[i].simbuf_beam_node2;
+            const uint8_t clip1 = m_debug_node_clip[n1];
+            const uint8_t clip2 = m_debug_node_clip[n2];
+            if (((clip1 | clip2) & hide_mask) || (clip1 & clip2 & offscreen_mask))
+                continue; // Behind the camera, hidden, or fully off-screen on one side
+
+            const Ogre::Vector3& pos1 = m_debug_screen_pos[n1];
+            const Ogre::Vector3& pos2 = m_debug_screen_pos[n2];
+            const float dx = pos2.x - pos1.x;
+            const float dy = pos2.y - pos1.y;
+            if (dx * dx + dy * dy < DEBUGVIEW_MIN_BEAM_LENGTH * DEBUGVIEW_MIN_BEAM_LENGTH)
+                continue; // Sub-pixel; the node dots cover it
+
+            DebugLine line;
+            line.a = Ogre::Vector2(pos1.x, pos1.y);
+            line.b = Ogre::Vector2(pos2.x, pos2.y);
+            if (beams[i].simbuf_beam_broken)
             {
-                ImVec2 pos1xy(pos1.x, pos1.y);
-                ImVec2 pos2xy(pos2.x, pos2.y);
-
-                if (beams[i].bm_broken)
-                {
-                    if (!App::diag_hide_broken_beams->getBool())
-                    {
-                        drawlist->AddLine(pos1xy, pos2xy, BEAM_BROKEN_COLOR, BEAM_BROKEN_THICKNESS);
-                    }
-                }
-                else if (beams[i].bm_type == BEAM_HYDRO)
+                if (hide_broken_beams)
+                    continue;
+                line.color = BEAM_BROKEN_COLOR;
+                line.thickness = BEAM_BROKEN_THICKNESS;
+            }
+            else if (beams[i].simbuf_beam_hydro)
+            {
+                if (beams[i].simbuf_beam_disabled)
+                    continue;
+                line.color = BEAM_HYDRO_COLOR;
+                line.thickness = BEAM_HYDRO_THICKNESS;
+            }
+            else
+            {
+                ImU32 color = BEAM_COLOR;
+                if (!hide_beam_stress)
                 {
-                    if (!beams[i].bm_disabled)
+                    if (beams[i].simbuf_beam_stress > 0)
                     {
-                        drawlist->AddLine(pos1xy, pos2xy, BEAM_HYDRO_COLOR, BEAM_HYDRO_THICKNESS);
+                        float s = std::min(beams[i].simbuf_beam_stress_ratio, 1.0f);
+                        color = Ogre::ColourValue(0.2f * (1 + 2.0f * s), 0.4f * (1.0f - s), 0.33f, 1.0f).getAsABGR();
                     }
-                }
-                else
-                {
-                    ImU32 color = BEAM_COLOR;
-                    if (!App::diag_hide_beam_stress->getBool())
+                    else if (beams[i].simbuf_beam_stress < 0)
                     {
-                        if (beams[i].stress > 0)
-                        {
-                            float stress_ratio = pow(beams[i].stress / beams[i].maxposstress, 2.0f);
-                            float s = std::min(stress_ratio, 1.0f);
-                            color = Ogre::ColourValue(0.2f * (1 + 2.0f * s), 0.4f * (1.0f - s), 0.33f, 1.0f).getAsABGR();
-                        }
-                        else if (beams[i].stress < 0)
-                        {
-                            float stress_ratio = pow(beams[i].stress / beams[i].maxnegstress, 2.0f);
-                            float s = std::min(stress_ratio, 1.0f);
-                            color = Ogre::ColourValue(0.2f, 0.4f * (1.0f - s), 0.33f * (1 + 1.0f * s), 1.0f).getAsABGR();
-                        }
+                        float s = std::min(beams[i].simbuf_beam_stress_ratio, 1.0f);
+                        color = Ogre::ColourValue(0.2f, 0.4f * (1.0f - s), 0.33f * (1 + 1.0f * s), 1.0f).getAsABGR();
                     }
-                    drawlist->AddLine(pos1xy, pos2xy, color, BEAM_THICKNESS);
                 }
+                line.color = color;
+                line.thickness = BEAM_THICKNESS;
+            }
+            m_debug_beam_lines.push_back(line);
+        }
+
+        if (!m_debug_beam_lines.empty())
+        {
+            // Plain quads, like non-antialiased `AddLine()`, written straight into the draw list
+            const ImVec2 uv = ImGui::GetFontTexUvWhitePixel();
+            drawlist->PrimReserve(static_cast<int>(m_debug_beam_lines.size()) * 6, static_cast<int>(m_debug_beam_lines.size()) * 4);
+            for (const DebugLine& line : m_debug_beam_lines)
+            {
+                float dx = line.b.x - line.a.x;
+                float dy = line.b.y - line.a.y;
+                const float scale = (line.thickness * 0.5f) / std::sqrt(dx * dx + dy * dy);
+                dx *= scale;
+                dy *= scale;
+                drawlist->PrimQuadUV(
+                    ImVec2(line.a.x - dy, line.a.y + dx), ImVec2(line.b.x - dy, line.b.y + dx),
+                    ImVec2(line.b.x + dy, line.b.y - dx), ImVec2(line.a.x + dy, line.a.y - dx),
+                    uv, uv, uv, uv, line.color);
             }
         }
 
         if (!App::diag_hide_nodes->getBool())
         {
             // Nodes
-            const node_t* nodes = m_actor->ar_nodes;
-            const size_t num_nodes = static_cast<size_t>(m_actor->ar_num_nodes);
             for (size_t i = 0; i < num_nodes; ++i)
             {
-                if (App::diag_hide_wheels->getBool() && (nodes[i].nd_tyre_node || nodes[i].nd_rim_node))
+                if (m_debug_node_clip[i] & (hide_mask | offscreen_mask))
                     continue;
 
-                Ogre::Vector3 pos_xyz = world2screen.Convert(nodes[i].AbsPosition);
-
-                if (pos_xyz.z < 0.f)
+                ImVec2 pos(m_debug_screen_pos[i].x, m_debug_screen_pos[i].y);
+                if (nodes[i].nd_immovable)
                 {
-                    ImVec2 pos(pos_xyz.x, pos_xyz.y);
-                    if (nodes[i].nd_immovable)
-                    {
-                        drawlist->AddCircleFilled(pos, NODE_IMMOVABLE_RADIUS, NODE_IMMOVABLE_COLOR);
-                    }
-                    else
-                    {
-                        drawlist->AddCircleFilled(pos, NODE_RADIUS, NODE_COLOR);
-                    }
+                    drawlist->AddCircleFilled(pos, NODE_IMMOVABLE_RADIUS, NODE_IMMOVABLE_COLOR);
+                }
+                else
+                {
+                    drawlist->AddCircleFilled(pos, NODE_RADIUS, NODE_COLOR);
                 }
             }
 
@@ -700,26 +768,21 @@ void RoR::GfxActor::UpdateDebugView()
             {
                 for (size_t i = 0; i < num_nodes; ++i)
                 {
-                    if ((App::diag_hide_wheels->getBool() || App::diag_hide_wheel_info->getBool()) && 
-                            (nodes[i].nd_tyre_node || nodes[i].nd_rim_node))
+                    if (m_debug_node_clip[i] & (hide_info_mask | offscreen_mask))
                         continue;
 
-                    Ogre::Vector3 pos = world2screen.Convert(nodes[i].AbsPosition);
+                    const Ogre::Vector3& pos = m_debug_screen_pos[i];
+                    ImVec2 pos_xy(pos.x, pos.y);
+                    Str<25> id_buf;
+                    id_buf << nodes[i].pos;
+                    drawlist->AddText(pos_xy, NODE_TEXT_COLOR, id_buf.ToCStr());
 
-                    if (pos.z < 0.f)
+                    if (m_debug_view != DebugViewType::DEBUGVIEW_BEAMS)
                     {
-                        ImVec2 pos_xy(pos.x, pos.y);
-                        Str<25> id_buf;
-                        id_buf << nodes[i].pos;
-                        drawlist->AddText(pos_xy, NODE_TEXT_COLOR, id_buf.ToCStr());
-
-                        if (m_debug_view != DebugViewType::DEBUGVIEW_BEAMS)
-                        {
-                            char mass_buf[50];
-                            snprintf(mass_buf, 50, "|%.1fKg", nodes[i].mass);
-                            ImVec2 offset = ImGui::CalcTextSize(id_buf.ToCStr());
-                            drawlist->AddText(ImVec2(pos.x + offset.x, pos.y), NODE_MASS_TEXT_COLOR, mass_buf);
-                        }
+                        char mass_buf[50];
+                        snprintf(mass_buf, 50, "|%.1fKg", nodes[i].mass);
+                        ImVec2 offset = ImGui::CalcTextSize(id_buf.ToCStr());
+                        drawlist->AddText(ImVec2(pos.x + offset.x, pos.y), NODE_MASS_TEXT_COLOR, mass_buf);
                     }
                 }
             }
@@ -730,13 +793,13 @@ void RoR::GfxActor::UpdateDebugView()
         {
             for (size_t i = 0; i < num_beams; ++i)
             {
-                if ((App::diag_hide_wheels->getBool() || App::diag_hide_wheel_info->getBool()) &&
-                        (beams[i].p1->nd_tyre_node || beams[i].p1->nd_rim_node ||
-                         beams[i].p2->nd_tyre_node || beams[i].p2->nd_rim_node))
+                const uint8_t clip1 = m_debug_node_clip[beams[i].simbuf_beam_node1];
+                const uint8_t clip2 = m_debug_node_clip[beams[i].simbuf_beam_node2];
+                if (((clip1 | clip2) & hide_info_mask) || (clip1 & clip2 & offscreen_mask))
                     continue;
 
                 // Position
-                Ogre::Vector3 world_pos = (beams[i].p1->AbsPosition + beams[i].p2->AbsPosition) / 2.f;
+                Ogre::Vector3 world_pos = (sim_nodes[beams[i].simbuf_beam_node1].AbsPosition + sim_nodes[beams[i].simbuf_beam_node2].AbsPosition) / 2.f;
                 Ogre::Vector3 pos_xyz = world2screen.Convert(world_pos);
                 if (pos_xyz.z >= 0.f)
                 {
@@ -747,31 +810,31 @@ void RoR::GfxActor::UpdateDebugView()
                 // Strength is usually in thousands or millions - we shorten it.
                 const size_t BUF_LEN = 50;
                 char buf[BUF_LEN];
-                if (beams[i].strength >= 1000000000000.f)
+                if (beams[i].simbuf_beam_strength >= 1000000000000.f)
                 {
-                    snprintf(buf, BUF_LEN, "%.1fT", (beams[i].strength / 1000000000000.f));
+                    snprintf(buf, BUF_LEN, "%.1fT", (beams[i].simbuf_beam_strength / 1000000000000.f));
                 }
-                else if (beams[i].strength >= 1000000000.f)
+                else if (beams[i].simbuf_beam_strength >= 1000000000.f)
                 {
-                    snprintf(buf, BUF_LEN, "%.1fG", (beams[i].strength / 1000000000.f));
+                    snprintf(buf, BUF_LEN, "%.1fG", (beams[i].simbuf_beam_strength / 1000000000.f));
                 }
-                else if (beams[i].strength >= 1000000.f)
+                else if (beams[i].simbuf_beam_strength >= 1000000.f)
                 {
-                    snprintf(buf, BUF_LEN, "%.1fM", (beams[i].strength / 1000000.f));
+                    snprintf(buf, BUF_LEN, "%.1fM", (beams[i].simbuf_beam_strength / 1000000.f));
                 }
-                else if (beams[i].strength >= 1000.f)
+                else if (beams[i].simbuf_beam_strength >= 1000.f)
                 {
-                    snprintf(buf, BUF_LEN, "%.1fK", (beams[i].strength / 1000.f));
+                    snprintf(buf, BUF_LEN, "%.1fK", (beams[i].simbuf_beam_strength / 1000.f));
                 }
                 else
                 {
-                    snprintf(buf, BUF_LEN, "%.1f", beams[i].strength);
+                    snprintf(buf, BUF_LEN, "%.1f", beams[i].simbuf_beam_strength);
                 }
                 const ImVec2 stren_text_size = ImGui::CalcTextSize(buf);
                 drawlist->AddText(ImVec2(pos.x - stren_text_size.x, pos.y), BEAM_STRENGTH_TEXT_COLOR, buf);
 
                 // Stress
-                snprintf(buf, BUF_LEN, "|%.1f",  beams[i].stress);
+                snprintf(buf, BUF_LEN, "|%.1f",  beams[i].simbuf_beam_stress);
                 drawlist->AddText(pos, BEAM_STRESS_TEXT_COLOR, buf);
             }
         }
@@ -1670,6 +1733,35 @@ void RoR::GfxActor::UpdateSimDataBuffer()
         m_simbuf.simbuf_nodes[nx.nx_node_idx].nd_is_wet = (nx.nx_wet_time_sec != -1.f);
     }
 
+    // Elements: beams (debug view only)
+    if (m_debug_view == DebugViewType::DEBUGVIEW_SKELETON ||
+        m_debug_view == DebugViewType::DEBUGVIEW_NODES ||
+        m_debug_view == DebugViewType::DEBUGVIEW_BEAMS)
+    {
+        m_simbuf.simbuf_beams.resize(m_actor->ar_num_beams);
+        for (int i = 0; i < m_actor->ar_num_beams; ++i)
+        {
+            const beam_t& beam = m_actor->ar_beams[i];
+            BeamSB& sb = m_simbuf.simbuf_beams[i];
+            sb.simbuf_beam_node1 = beam.p1->pos;
+            sb.simbuf_beam_node2 = beam.p2->pos;
+            sb.simbuf_beam_stress = beam.stress;
+            sb.simbuf_beam_stress_ratio = 0.f;
+            if (beam.stress > 0)
+                sb.simbuf_beam_stress_ratio = pow(beam.stress / beam.maxposstress, 2.0f);
+            else if (beam.stress < 0)
+                sb.simbuf_beam_stress_ratio = pow(beam.stress / beam.maxnegstress, 2.0f);
+            sb.simbuf_beam_strength = beam.strength;
+            sb.simbuf_beam_broken = beam.bm_broken;
+            sb.simbuf_beam_disabled = beam.bm_disabled;
+            sb.simbuf_beam_hydro = (beam.bm_type == BEAM_HYDRO);
+        }
+    }
+    else
+    {
+        m_simbuf.simbuf_beams.clear();
+    }
+
     // Elements: beams
     for (BeamGfx& rod: m_gfx_beams)
     {
@@ -1812,19 +1904,41 @@ bool RoR::GfxActor::IsActorLive() const
 
 void RoR::GfxActor::UpdateCabMesh()
 {
+    this->FinishCabMesh(); // The task works on the mesh's own buffers - never run two at once
+
     if ((m_cab_entity != nullptr) && (m_cab_mesh != nullptr))
     {
-        m_cab_scene_node->setPosition(m_cab_mesh->UpdateFlexObj());
+        FlexObj* cab_mesh = m_cab_mesh;
+        auto func = std::function<void()>([cab_mesh]()
+            {
+                cab_mesh->ComputeFlexObj();
+            });
+        m_cab_mesh_task = App::GetThreadPool()->RunTask(func);
     }
 }
 
-void RoR::GfxActor::UpdateWheelVisuals()
+void RoR::GfxActor::FinishCabMesh()
+{
+    if (m_cab_mesh_task)
+    {
+        m_cab_mesh_task->join();
+        m_cab_mesh_task.reset();
+        m_cab_scene_node->setPosition(m_cab_mesh->UpdateFlexObjBuffers());
+    }
+}
+
+void RoR::GfxActor::UpdateWheelVisuals(FlexMeshWheelBatch& batch)
 {
     m_flexwheel_tasks.clear();
 
     for (WheelGfx& w: m_wheels)
     {
-        if (w.wx_flex_mesh != nullptr && w.wx_flex_mesh->flexitPrepare())
+        if (w.wx_flexmesh_wheel != nullptr)
+        {
+            w.wx_flexmesh_wheel->flexitPrepare();
+            batch.AddWheel(w.wx_flexmesh_wheel);
+        }
+        else if (w.wx_flex_mesh != nullptr && w.wx_flex_mesh->flexitPrepare())
         {
             auto func = std::function<void()>([this, w]()
                 {
@@ -2976,8 +3090,10 @@ void RoR::GfxActor::UpdateFlexbodies()
         const int camera_mode = fb->getCameraMode();
         if ((camera_mode == -2) || (camera_mode == m_simbuf.simbuf_cur_cinecam))
         {
-            auto func = std::function<void()>([fb]()
+            ActorPerfStats* perf_stats = &m_actor->ar_perf_stats;
+            auto func = std::function<void()>([fb, perf_stats]()
                 {
+                    ActorPerfScope perf_scope(*perf_stats, ActorPerfStats::FLEXBODY);
                     fb->computeFlexbody();
                 });
             auto task_handle = App::GetThreadPool()->RunTask(func);
@@ -3012,6 +3128,7 @@ void RoR::GfxActor::FinishFlexbodyTasks()
     {
         task->join();
     }
+    ActorPerfScope perf_scope(m_actor->ar_perf_stats, ActorPerfStats::FLEXBODY);
     for (FlexBody* fb: m_flexbodies)
     {
         fb->updateFlexbodyVertexBuffers();
@@ -3195,6 +3312,14 @@ void RoR::GfxActor::SetNodeHot(NodeNum_t nodenum, bool value)
     }
 }
 
+void RoR::GfxActor::RemapBeamIndices(std::vector<int> const& new_index)
+{
+    for (BeamGfx& rod: m_gfx_beams)
+    {
+        rod.rod_beam_index = static_cast<uint16_t>(new_index[rod.rod_beam_index]);
+    }
+}
+
 void RoR::GfxActor::RemoveBeam(int beam_index)
 {
     auto itor = m_gfx_beams.begin();
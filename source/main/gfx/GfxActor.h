@@ -80,6 +80,7 @@ public:
     void                 SetDebugView(DebugViewType dv);
     void                 SetNodeHot(NodeNum_t nodenum, bool value);
     void                 RemoveBeam(int beam_index);
+    void                 RemapBeamIndices(std::vector<int> const& new_index); //!< After `ActorSpawner::OptimizeBeamOrder()`
 
     // Visibility
 
@@ -98,7 +99,7 @@ public:
     void                 UpdateVideoCameras(float dt_sec);
     void                 UpdateParticles(float dt_sec);
     void                 UpdateRods();
-    void                 UpdateWheelVisuals();
+    void                 UpdateWheelVisuals(FlexMeshWheelBatch& batch); //!< Flexmesh wheels go to the batch, other wheels to own tasks
     void                 UpdateFlexbodies();
     void                 UpdateDebugView();
     void                 UpdateCabMesh();
@@ -123,6 +124,7 @@ public:
 
     void                 FinishWheelUpdates();
     void                 FinishFlexbodyTasks();
+    void                 FinishCabMesh();
 
     // Helpers
 
@@ -175,6 +177,7 @@ private:
     // Threaded tasks
     std::vector<std::shared_ptr<Task>> m_flexwheel_tasks;
     std::vector<std::shared_ptr<Task>> m_flexbody_tasks;
+    std::shared_ptr<Task>              m_cab_mesh_task;
 
     // Elements
     std::vector<NodeGfx>        m_gfx_nodes;
@@ -208,6 +211,17 @@ private:
     Ogre::MaterialPtr           m_help_mat;
     Ogre::TexturePtr            m_help_tex;
 
+    // Debug view; per-frame scratch, kept to avoid reallocating
+    struct DebugLine
+    {
+        Ogre::Vector2           a, b;
+        uint32_t                color;
+        float                   thickness;
+    };
+    std::vector<Ogre::Vector3>  m_debug_screen_pos;  //!< Per node: X,Y = screen pos, Z = view space depth
+    std::vector<uint8_t>        m_debug_node_clip;   //!< Per node: DEBUGCLIP_* bits
+    std::vector<DebugLine>      m_debug_beam_lines;
+
     ActorSB                     m_simbuf;
 };
 
@@ -260,6 +260,7 @@ struct BeamGfx
 struct WheelGfx
 {
     Flexable*        wx_flex_mesh        = nullptr;
+    FlexMeshWheel*   wx_flexmesh_wheel   = nullptr;  //!< Set if `wx_flex_mesh` is a FlexMeshWheel; updated by `FlexMeshWheelBatch`
     Ogre::SceneNode* wx_scenenode        = nullptr;
     bool             wx_is_meshwheel     = false;
 };
@@ -83,18 +83,22 @@ void GfxScene::Init()
 {
     ROR_ASSERT(!m_scene_manager);
     m_scene_manager = App::GetAppContext()->GetOgreRoot()->createSceneManager(Ogre::ST_EXTERIOR_CLOSE, "main_scene_manager");
-
-    m_skidmark_conf.LoadDefaultSkidmarkDefs();
 }
 
 void GfxScene::UpdateScene(float dt_sec)
 {
     // Actors - start threaded tasks
+    m_flexwheel_batch.Clear();
     for (GfxActor* gfx_actor: m_live_gfx_actors)
     {
         gfx_actor->UpdateFlexbodies(); // Push flexbody tasks to threadpool
-        gfx_actor->UpdateWheelVisuals(); // Push flexwheel tasks to threadpool
+        gfx_actor->UpdateWheelVisuals(m_flexwheel_batch); // Push flexwheel tasks to threadpool
+        if (gfx_actor->IsActorLive())
+        {
+            gfx_actor->UpdateCabMesh(); // Push cab mesh task to threadpool
+        }
     }
+    m_flexwheel_batch.StartTask(); // Flexmesh wheels of all actors in one go
 
     // Var
     GfxActor* player_gfx_actor = nullptr;
@@ -123,7 +127,7 @@ void GfxScene::UpdateScene(float dt_sec)
         }
         for (auto itor : m_dustpools)
         {
-            itor.second->update();
+            itor.second->update(dt_sec);
         }
     }
 
@@ -212,7 +216,6 @@ void GfxScene::UpdateScene(float dt_sec)
         if (gfx_actor->IsActorLive())
         {
             gfx_actor->UpdateRods();
-            gfx_actor->UpdateCabMesh();
             gfx_actor->UpdateWingMeshes();
             gfx_actor->UpdateAirbrakes();
             gfx_actor->UpdateCParticles();
@@ -245,10 +248,12 @@ void GfxScene::UpdateScene(float dt_sec)
     App::GetGameContext()->GetSceneMouse().UpdateVisuals();
 
     // Actors - finalize threaded tasks
+    m_flexwheel_batch.FinishTask();
     for (GfxActor* gfx_actor: m_live_gfx_actors)
     {
         gfx_actor->FinishWheelUpdates();
         gfx_actor->FinishFlexbodyTasks();
+        gfx_actor->FinishCabMesh();
     }
 }
 
@@ -28,6 +28,7 @@
 #include "CameraManager.h"
 #include "ForwardDeclarations.h"
 #include "EnvironmentMap.h" // RoR::GfxEnvmap
+#include "FlexMeshWheel.h"
 #include "SimBuffers.h"
 #include "Skidmark.h"
 
@@ -75,6 +76,7 @@ private:
     RoR::GfxEnvmap                    m_envmap;
     GameContextSB                     m_simbuf;
     SkidmarkConfig                    m_skidmark_conf;
+    FlexMeshWheelBatch                m_flexwheel_batch;
 };
 
 /// @} // addtogroup Gfx
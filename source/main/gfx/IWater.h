@@ -45,6 +45,11 @@ public:
     virtual void           SetWaterBottomHeight(float value) {};
     virtual void           SetWavesHeight(float value) {};
     virtual float          CalcWavesHeight(Ogre::Vector3 pos) = 0;
+    virtual void           CalcWavesHeightBatch(Ogre::Vector3 const* pos, float* out_height, size_t count) //!< Same as `CalcWavesHeight()` for many points; implementations can hoist per-query setup.
+    {
+        for (size_t i = 0; i < count; i++)
+            out_height[i] = this->CalcWavesHeight(pos[i]);
+    }
     virtual Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos) = 0;
     virtual void           SetWaterVisible(bool value) = 0;
     virtual void           WaterSetSunPosition(Ogre::Vector3) {}
@@ -52,7 +52,7 @@
         GameContext (gamecontext.h)  /  GameContextSB  /  GfxScene    (gfxscene.h)
         Actor       (actor.h)        /  ActorSB        /  GfxActor    (gfxactor.h)
         node_t      (simdata.h)      /  NodeSB         /  NodeGfx     (gfxdata.h)
-        beam_t      (simdata.h)      /  -              /  BeamGfx         (gfxdata.h)
+        beam_t      (simdata.h)      /  BeamSB         /  BeamGfx         (gfxdata.h)
         command_t   (simdata.h)      /  CommandKeySB   /  -
         wheel_t     (simdata.h)      /  -              /  WheelGfx    (gfxdata.h)
         wing_t      (simdata.h)      /  -              /  -
@@ -71,6 +71,19 @@ struct NodeSB
     bool              nd_is_wet:1;
 };
 
+/// Only filled while a skeleton debug view is active, see `GfxActor::UpdateSimDataBuffer()`
+struct BeamSB
+{
+    NodeNum_t         simbuf_beam_node1;
+    NodeNum_t         simbuf_beam_node2;
+    float             simbuf_beam_stress;
+    float             simbuf_beam_stress_ratio;    //!< Squared `stress` relative to `maxposstress` or `maxnegstress`
+    float             simbuf_beam_strength;
+    bool              simbuf_beam_broken:1;
+    bool              simbuf_beam_disabled:1;
+    bool              simbuf_beam_hydro:1;
+};
+
 struct ScrewpropSB
 {
     float             simbuf_sp_rudder;
@@ -132,6 +145,7 @@ struct ActorSB
 
     // Elements
     std::vector<NodeSB>       simbuf_nodes;
+    std::vector<BeamSB>       simbuf_beams;
     std::vector<ScrewpropSB>  simbuf_screwprops;
     std::vector<CommandKeySB> simbuf_commandkey;
     std::vector<PropAnimKeySB> simbuf_prop_anim_keys;
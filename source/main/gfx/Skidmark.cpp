@@ -22,8 +22,8 @@
 
 #include "Application.h"
 #include "SimData.h"
-#include "ContentManager.h" // RGN_CONFIG
 #include "GfxScene.h"
+#include "PlatformUtils.h"
 #include "Utils.h"
 
 #include <Ogre.h>
@@ -35,7 +35,13 @@ void RoR::SkidmarkConfig::LoadDefaultSkidmarkDefs()
     LOG("[RoR] Loading skidmarks.cfg...");
     try
     {
-        Ogre::DataStreamPtr ds = Ogre::ResourceGroupManager::getSingleton().openResource("skidmarks.cfg", RGN_CONFIG);
+        // Read directly from config dir, this runs on a worker thread during startup
+        Ogre::DataStreamPtr ds = RoR::OpenFileDirect(RoR::PathCombine(RoR::App::sys_config_dir->getStr(), "skidmarks.cfg"));
+        if (!ds)
+        {
+            RoR::Log("[RoR] Error loading skidmarks.cfg (file not found)");
+            return;
+        }
         Ogre::String currentModel = "";
 
         while (!ds->eof())
@@ -77,8 +83,20 @@ int RoR::SkidmarkConfig::ProcessSkidmarkConfLine(Ogre::StringVector args, Ogre::
     SkidmarkDef cfg;
     cfg.ground = args[0];
     Ogre::StringUtil::trim(cfg.ground);
-    cfg.texture = args[1];
-    Ogre::StringUtil::trim(cfg.texture);
+    Ogre::String texture = args[1];
+    Ogre::StringUtil::trim(texture);
+
+    auto itor = std::find(m_atlas_textures.begin(), m_atlas_textures.end(), texture);
+    if (itor == m_atlas_textures.end())
+    {
+        if ((int)m_atlas_textures.size() >= ATLAS_MAX_TILES)
+        {
+            RoR::LogFormat("[RoR] skidmarks.cfg: too many textures (max %d), ignoring '%s'", ATLAS_MAX_TILES, texture.c_str());
+            return 1;
+        }
+        itor = m_atlas_textures.insert(m_atlas_textures.end(), texture);
+    }
+    cfg.tile = static_cast<int>(itor - m_atlas_textures.begin());
 
     cfg.slipFrom = Ogre::StringConverter::parseReal(args[2]);
     cfg.slipTo = Ogre::StringConverter::parseReal(args[3]);
@@ -90,115 +108,223 @@ int RoR::SkidmarkConfig::ProcessSkidmarkConfLine(Ogre::StringVector args, Ogre::
     return 0;
 }
 
-int RoR::SkidmarkConfig::getTexture(Ogre::String model, Ogre::String ground, float slip, Ogre::String& texture)
+int RoR::SkidmarkConfig::getTextureTile(Ogre::String const& model, Ogre::String const& ground, float slip)
 {
-    if (m_models.find(model) == m_models.end())
-        return 1;
-    for (std::vector<SkidmarkDef>::iterator it = m_models[model].begin(); it != m_models[model].end(); it++)
+    auto model_itor = m_models.find(model);
+    if (model_itor == m_models.end())
+        return -1;
+    for (SkidmarkDef const& def : model_itor->second)
     {
-        if (it->ground == ground && it->slipFrom <= slip && it->slipTo > slip)
+        if (def.ground == ground && def.slipFrom <= slip && def.slipTo > slip)
         {
-            texture = it->texture.c_str();
-            return 0;
+            return def.tile;
         }
     }
-    return 2;
+    return -1;
 }
 
-// this is a hardcoded array which we use to map ground types to a certain texture with UV/ coords
-Ogre::Vector2 RoR::Skidmark::m_tex_coords[4] = {Ogre::Vector2(0, 0), Ogre::Vector2(0, 1), Ogre::Vector2(1, 0), Ogre::Vector2(1, 1)};
+Ogre::MaterialPtr RoR::SkidmarkConfig::GetAtlasMaterial()
+{
+    if (m_atlas_material.isNull())
+    {
+        this->BuildAtlas();
+    }
+    return m_atlas_material;
+}
+
+void RoR::SkidmarkConfig::BuildAtlas()
+{
+    // All textures are stacked vertically into one, so that trails can change ground texture per vertex.
+    const int num_tiles = this->GetAtlasTileCount();
+    const size_t tile_bytes = ATLAS_TILE_SIZE * ATLAS_TILE_SIZE * Ogre::PixelUtil::getNumElemBytes(Ogre::PF_BYTE_RGBA);
+    std::vector<Ogre::uchar> pixels(tile_bytes * num_tiles, 0); // Missing textures stay transparent
+
+    for (int i = 0; i < (int)m_atlas_textures.size(); i++)
+    {
+        Ogre::Image img;
+        try
+        {
+            img.load(m_atlas_textures[i], Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+        }
+        catch (Ogre::Exception& e)
+        {
+            RoR::LogFormat("[RoR] Error loading skidmark texture '%s' (%s)", m_atlas_textures[i].c_str(), e.getFullDescription().c_str());
+            continue;
+        }
+        if (img.getWidth() != ATLAS_TILE_SIZE || img.getHeight() != ATLAS_TILE_SIZE)
+            img.resize(ATLAS_TILE_SIZE, ATLAS_TILE_SIZE);
+
+        Ogre::PixelBox tile_box(ATLAS_TILE_SIZE, ATLAS_TILE_SIZE, 1, Ogre::PF_BYTE_RGBA, &pixels[tile_bytes * i]);
+        Ogre::PixelUtil::bulkPixelConversion(img.getPixelBox(), tile_box);
+    }
+
+    Ogre::TexturePtr tex = Ogre::TextureManager::getSingleton().createManual("skidmark-atlas",
+        Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_2D,
+        ATLAS_TILE_SIZE, ATLAS_TILE_SIZE * num_tiles, Ogre::MIP_DEFAULT, Ogre::PF_BYTE_RGBA);
+    tex->getBuffer()->blitFromMemory(Ogre::PixelBox(Ogre::Box(0, 0, ATLAS_TILE_SIZE, ATLAS_TILE_SIZE * num_tiles), Ogre::PF_BYTE_RGBA, pixels.data()));
+
+    m_atlas_material = Ogre::MaterialManager::getSingleton().create("mat-skidmark-atlas", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Ogre::Pass* p = m_atlas_material->getTechnique(0)->getPass(0);
+
+    Ogre::TextureUnitState* tus = p->createTextureUnitState(tex->getName());
+    tus->setTextureAddressingMode(Ogre::TextureUnitState::TAM_WRAP, Ogre::TextureUnitState::TAM_CLAMP, Ogre::TextureUnitState::TAM_CLAMP);
+    p->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
+    p->setLightingEnabled(false);
+    p->setDepthWriteEnabled(false);
+    p->setDepthBias(3, 3);
+    p->setCullingMode(Ogre::CULL_NONE);
+}
 
 RoR::Skidmark::Skidmark(RoR::SkidmarkConfig* config, wheel_t* m_wheel, 
         Ogre::SceneNode* snode, int m_length /* = 500 */, int m_bucket_count /* = 20 */)
     : m_scene_node(snode)
-    , m_is_dirty(true)
-    , m_length(m_length)
-    , m_bucket_count(m_bucket_count)
     , m_wheel(m_wheel)
     , m_min_distance(0.25f)
     , m_max_distance(std::max(0.5f, m_wheel->wh_width * 1.1f))
     , m_config(config)
 {
-    if (m_length % 2)
-    {
-        m_length--;
-    }
+    // Same amount of points as the former `m_bucket_count` trail segments of `m_length` points each
+    m_capacity = std::min(static_cast<size_t>(MAX_CAPACITY), static_cast<size_t>(std::max(2, (m_length / 2) * m_bucket_count)));
+    m_bounds.setNull();
+}
+
+void RoR::Skidmark::CreateMesh()
+{
+    const size_t num_vertices = m_capacity * 2;
+    const int id = m_instance_counter++;
+
+    m_mesh = Ogre::MeshManager::getSingleton().createManual("skidmark-mesh-" + TOSTRING(id), Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Ogre::SubMesh* submesh = m_mesh->createSubMesh();
+    submesh->setMaterialName(m_config->GetAtlasMaterial()->getName());
+
+    m_mesh->sharedVertexData = new Ogre::VertexData();
+    m_mesh->sharedVertexData->vertexCount = num_vertices;
+    Ogre::VertexDeclaration* decl = m_mesh->sharedVertexData->vertexDeclaration;
+    size_t offset = 0;
+    decl->addElement(0, offset, Ogre::VET_FLOAT3, Ogre::VES_POSITION);
+    offset += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT3);
+    decl->addElement(0, offset, Ogre::VET_FLOAT2, Ogre::VES_TEXTURE_COORDINATES, 0);
+    offset += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT2);
+
+    // Written piecewise as points are added, so the buffers must not be discardable
+    m_vertices.assign(num_vertices * VERTEX_FLOATS, 0.f);
+    m_hw_vbuf = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+        offset, num_vertices, Ogre::HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY);
+    m_hw_vbuf->writeData(0, m_hw_vbuf->getSizeInBytes(), m_vertices.data(), true);
+    m_mesh->sharedVertexData->vertexBufferBinding->setBinding(0, m_hw_vbuf);
+
+    // One quad (2 triangles) per slot, joining it with the previous slot
+    m_indices.assign(m_capacity * 6, 0);
+    m_hw_ibuf = Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+        Ogre::HardwareIndexBuffer::IT_16BIT, m_capacity * 6, Ogre::HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY);
+    submesh->useSharedVertices = true;
+    submesh->operationType = Ogre::RenderOperation::OT_TRIANGLE_LIST;
+    submesh->indexData->indexBuffer = m_hw_ibuf;
+    submesh->indexData->indexStart = 0;
+    submesh->indexData->indexCount = 0;
+
+    m_mesh->_setBounds(m_bounds, false);
+    m_mesh->load();
+
+    m_entity = App::GetGfxScene()->GetSceneManager()->createEntity("skidmark" + TOSTRING(id), m_mesh->getName());
+    m_entity->setRenderingDistance(800); // 800m view distance
+    m_entity->setCastShadows(false);
+    m_scene_node->attachObject(m_entity);
 }
 
 RoR::Skidmark::~Skidmark()
 {
-    this->reset();
+    if (!m_entity)
+        return; // Never skidded
+
+    m_scene_node->detachObject(m_entity);
+    App::GetGfxScene()->GetSceneManager()->destroyEntity(m_entity);
+    m_hw_vbuf.setNull();
+    m_hw_ibuf.setNull();
+    Ogre::MeshManager::getSingleton().remove(m_mesh->getHandle());
+    m_mesh.setNull();
 }
 
-void RoR::Skidmark::AddObject(Ogre::Vector3 start, Ogre::String texture)
+void RoR::Skidmark::WriteQuad(size_t slot, size_t prev_slot)
 {
-    SkidmarkSegment skid;
-    skid.pos = 0;
-    skid.lastPointAv = start;
-    skid.facecounter = 0;
-
-    // new material
-    char bname[256] = "";
-    sprintf(bname, "mat-skidmark-%d", m_instance_counter);
-    skid.material = Ogre::MaterialManager::getSingleton().create(bname, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-    Ogre::Pass* p = skid.material->getTechnique(0)->getPass(0);
-
-    p->createTextureUnitState(texture);
-    p->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
-    p->setLightingEnabled(false);
-    p->setDepthWriteEnabled(false);
-    p->setDepthBias(3, 3);
-    p->setCullingMode(Ogre::CULL_NONE);
+    const Ogre::uint16 p0 = static_cast<Ogre::uint16>(prev_slot * 2), p1 = p0 + 1;
+    const Ogre::uint16 s0 = static_cast<Ogre::uint16>(slot * 2),      s1 = s0 + 1;
+    const Ogre::uint16 indices[6] = { p0, p1, s0, p1, s1, s0 };
+    std::copy(indices, indices + 6, m_indices.begin() + slot * 6);
 
-    skid.points.resize(m_length);
-    skid.faceSizes.resize(m_length);
-    skid.groundTexture.resize(m_length);
-    skid.obj = App::GetGfxScene()->GetSceneManager()->createManualObject("skidmark" + TOSTRING(m_instance_counter++));
-    skid.obj->setDynamic(true);
-    skid.obj->setRenderingDistance(800); // 800m view distance
-    skid.obj->begin(bname, Ogre::RenderOperation::OT_TRIANGLE_STRIP);
-    for (int i = 0; i < m_length; i++)
+    if (m_dirty_begin == m_dirty_end)
     {
-        skid.points[i] = start;
-        skid.faceSizes[i] = 0;
-        skid.groundTexture[i] = "0.png";
-        skid.obj->position(start);
-        skid.obj->textureCoord(0, 0);
+        m_dirty_begin = slot;
+        m_dirty_end = slot + 1;
+    }
+    else
+    {
+        // Slots written in one update are consecutive; across the ring's end this covers the whole buffer, once per lap
+        m_dirty_begin = std::min(m_dirty_begin, slot);
+        m_dirty_end = std::max(m_dirty_end, slot + 1);
     }
-    skid.obj->end();
-    m_scene_node->attachObject(skid.obj);
-
-    m_objects.push(skid);
-
-    this->LimitObjects();
 }
 
-void RoR::Skidmark::PopSegment()
+void RoR::Skidmark::FlushBuffers()
 {
-    SkidmarkSegment& skid = m_objects.front();
-    skid.points.clear();
-    skid.faceSizes.clear();
-    Ogre::MaterialManager::getSingleton().remove(skid.material->getName());
-    skid.material.setNull();
-    App::GetGfxScene()->GetSceneManager()->destroyManualObject(skid.obj);
-    m_objects.pop();
+    if (m_dirty_begin == m_dirty_end)
+        return;
+
+    const size_t vertex_bytes = 2 * VERTEX_FLOATS * sizeof(float); // Per slot
+    m_hw_vbuf->writeData(m_dirty_begin * vertex_bytes, (m_dirty_end - m_dirty_begin) * vertex_bytes,
+        &m_vertices[m_dirty_begin * 2 * VERTEX_FLOATS]);
+    const size_t index_bytes = 6 * sizeof(Ogre::uint16);
+    m_hw_ibuf->writeData(m_dirty_begin * index_bytes, (m_dirty_end - m_dirty_begin) * index_bytes,
+        &m_indices[m_dirty_begin * 6]);
+    m_dirty_begin = m_dirty_end = 0;
+
+    m_mesh->getSubMesh(0)->indexData->indexCount = m_count * 6;
+    m_mesh->_setBounds(m_bounds, false);
 }
 
-void RoR::Skidmark::LimitObjects()
+void RoR::Skidmark::PushPair(Ogre::Vector3 const& left, Ogre::Vector3 const& right, int tile, float tex_u, bool connect)
 {
-    if ((int)m_objects.size() > m_bucket_count)
+    if (!m_entity)
     {
-        this->PopSegment();
+        this->CreateMesh();
     }
-}
 
-void RoR::Skidmark::SetPointInt(unsigned short index, const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture)
-{
-    m_objects.back().points[index] = value;
-    m_objects.back().faceSizes[index] = fsize;
-    m_objects.back().groundTexture[index] = texture;
+    const size_t slot = m_head;
+    const size_t prev_slot = (slot + m_capacity - 1) % m_capacity;
+    connect = connect && (m_count > 0);
+
+    // Map `v` into the atlas tile, half a texel inside to avoid bleeding from the neighbour tiles
+    const float tile_h = 1.f / m_config->GetAtlasTileCount();
+    const float inset = 0.5f / (SkidmarkConfig::ATLAS_TILE_SIZE * m_config->GetAtlasTileCount());
+    const float v0 = tile * tile_h + inset;
+    const float v1 = (tile + 1) * tile_h - inset;
 
-    m_is_dirty = true;
+    const float vertices[2 * VERTEX_FLOATS] =
+    {
+        left.x,  left.y,  left.z,  tex_u, v0,
+        right.x, right.y, right.z, tex_u, v1,
+    };
+    std::copy(vertices, vertices + 2 * VERTEX_FLOATS, m_vertices.begin() + slot * 2 * VERTEX_FLOATS);
+    this->WriteQuad(slot, connect ? prev_slot : slot);
+
+    m_head = (m_head + 1) % m_capacity;
+    if (m_count < m_capacity)
+    {
+        m_count++;
+    }
+    else
+    {
+        // The oldest remaining pair must not join the one we just overwrote
+        this->WriteQuad(m_head, m_head);
+    }
+
+    m_last_left = left;
+    m_last_right = right;
+    m_last_tile = tile;
+
+    // Bounds only grow until `reset()`, old trails are usually still nearby
+    m_bounds.merge(left);
+    m_bounds.merge(right);
 }
 
 void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float slip, Ogre::String ground_model_name)
@@ -212,170 +338,65 @@ void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float sl
     Ogre::Vector3 thisPointAV = thisPoint + axis * 0.5f;
     Ogre::Real distance = 0;
     Ogre::Real maxDist = m_max_distance;
-    Ogre::String texture = "none";
-    m_config->getTexture("default", ground_model_name, slip, texture);
+    const int tile = m_config->getTextureTile("default", ground_model_name, slip);
 
     // dont add points with no texture
-    if (texture == "none")
+    if (tile < 0)
         return;
 
     if (m_wheel->wh_speed > 1)
         maxDist *= m_wheel->wh_speed;
 
-    if (!m_objects.size())
+    bool connect = false;
+    if (m_count > 0)
     {
-        // add first bucket
-        this->AddObject(thisPoint, texture);
-    }
-    else
-    {
-        // check existing buckets
-        SkidmarkSegment skid = m_objects.back();
-
-        distance = skid.lastPointAv.distance(thisPointAV);
+        distance = m_last_point_av.distance(thisPointAV);
         // too near to update?
         if (distance < m_min_distance)
         {
-            //LOG("E: too near for update");
             return;
         }
 
-        // change ground texture if required
-        if (skid.pos > 0 && skid.groundTexture[0] != texture)
+        connect = (distance <= maxDist);
+        if (connect && tile != m_last_tile)
         {
-            // new object with new texture
-            if (distance > maxDist)
-            {
-                // to far away for connection
-                this->AddObject(thisPoint, texture);
-            }
-            else
-            {
-                // add new bucket with connection to last bucket
-                Ogre::Vector3 lp1 = m_objects.back().points[m_objects.back().pos - 1];
-                Ogre::Vector3 lp2 = m_objects.back().points[m_objects.back().pos - 2];
-                this->AddObject(lp1, texture);
-                this->AddPoint(lp2, distance, texture);
-                this->AddPoint(lp1, distance, texture);
-            }
-        }
-        else
-        {
-            // no texture change required :D
-
-            // far enough for new bucket?
-            if (skid.pos >= (int)skid.points.size())
-            {
-                if (distance > maxDist)
-                {
-                    // to far away for connection
-                    this->AddObject(thisPoint, texture);
-                }
-                else
-                {
-                    // add new bucket with connection to last bucket
-                    Ogre::Vector3 lp1 = m_objects.back().points[m_objects.back().pos - 1];
-                    Ogre::Vector3 lp2 = m_objects.back().points[m_objects.back().pos - 2];
-                    this->AddObject(lp1, texture);
-                    this->AddPoint(lp2, distance, texture);
-                    this->AddPoint(lp1, distance, texture);
-                }
-            }
-            else if (distance > m_max_distance)
-            {
-                // just new bucket, no connection to last bucket
-                this->AddObject(thisPoint, texture);
-            }
+            // change ground texture: repeat the last pair with the new texture, so the trail continues
+            this->PushPair(m_last_left, m_last_right, tile, 0.f, false);
+            m_last_pair_odd = false;
         }
     }
 
+    // scale texture according face size, mirrored on every other pair
+    m_last_pair_odd = !m_last_pair_odd;
+    const float tex_u = m_last_pair_odd ? (distance / m_min_distance) : 0.f;
+
     const float overaxis = 0.2f;
 
-    this->AddPoint(contact_point - (axis * overaxis), distance, texture);
-    this->AddPoint(contact_point + axis + (axis * overaxis), distance, texture);
+    this->PushPair(contact_point - (axis * overaxis), contact_point + axis + (axis * overaxis), tile, tex_u, connect);
 
     // save as last point (in the middle of the m_wheel)
-    m_objects.back().lastPointAv = thisPointAV;
+    m_last_point_av = thisPointAV;
 }
 
-void RoR::Skidmark::AddPoint(const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture)
+void RoR::Skidmark::reset()
 {
-    if (m_objects.back().pos >= m_length)
+    m_head = 0;
+    m_count = 0;
+    m_last_tile = -1;
+    m_last_pair_odd = false;
+    m_bounds.setNull();
+    if (m_entity)
     {
-        return;
+        m_mesh->getSubMesh(0)->indexData->indexCount = 0;
+        m_mesh->_setBounds(m_bounds, false);
     }
-    this->SetPointInt(m_objects.back().pos, value, fsize, texture);
-    m_objects.back().pos++;
-}
-
-void RoR::Skidmark::reset()
-{
-    while (m_objects.size() != 0) // Remove all skid segments
-        this->PopSegment();
 }
 
 void RoR::Skidmark::update(Ogre::Vector3 contact_point, int index, float slip, Ogre::String ground_model_name)
 {
     this->UpdatePoint(contact_point, index, slip, ground_model_name);
-    if (!m_is_dirty)
-        return;
-    if (!m_objects.size())
-        return;
-    SkidmarkSegment skid = m_objects.back();
-    Ogre::Vector3 vaabMin = skid.points[0];
-    Ogre::Vector3 vaabMax = skid.points[0];
-    skid.obj->beginUpdate(0);
-    bool behindEnd = false;
-    Ogre::Vector3 lastValid = Ogre::Vector3::ZERO;
-    int to_counter = 0;
-    float tcox_counter = 0;
-
-    for (int i = 0; i < m_length; i++ , to_counter++)
+    if (m_entity)
     {
-        if (i >= skid.pos)
-            behindEnd = true;
-
-        if (to_counter > 3)
-            to_counter = 0;
-
-        if (!behindEnd)
-            tcox_counter += skid.faceSizes[i] / m_min_distance;
-
-        while (tcox_counter > 1)
-            tcox_counter--;
-
-        if (behindEnd)
-        {
-            skid.obj->position(lastValid);
-            skid.obj->textureCoord(0, 0);
-        }
-        else
-        {
-            skid.obj->position(skid.points[i]);
-
-            Ogre::Vector2 tco = m_tex_coords[to_counter];
-            tco.x *= skid.faceSizes[i] / m_min_distance; // scale texture according face size
-            skid.obj->textureCoord(tco);
-
-            lastValid = skid.points[i];
-        }
-
-        if (skid.points[i].x < vaabMin.x)
-            vaabMin.x = skid.points[i].x;
-        if (skid.points[i].y < vaabMin.y)
-            vaabMin.y = skid.points[i].y;
-        if (skid.points[i].z < vaabMin.z)
-            vaabMin.z = skid.points[i].z;
-        if (skid.points[i].x > vaabMax.x)
-            vaabMax.x = skid.points[i].x;
-        if (skid.points[i].y > vaabMax.y)
-            vaabMax.y = skid.points[i].y;
-        if (skid.points[i].z > vaabMax.z)
-            vaabMax.z = skid.points[i].z;
+        this->FlushBuffers();
     }
-    skid.obj->end();
-
-    skid.obj->setBoundingBox(Ogre::AxisAlignedBox(vaabMin, vaabMax));
-
-    m_is_dirty = false;
 }
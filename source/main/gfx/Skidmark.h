@@ -22,44 +22,63 @@
 
 #include "Application.h"
 
+#include <OgreAxisAlignedBox.h>
+#include <OgreHardwareIndexBuffer.h>
+#include <OgreHardwareVertexBuffer.h>
 #include <OgreMaterial.h>
+#include <OgreMesh.h>
 #include <OgreString.h>
 #include <OgreVector2.h>
 #include <OgreVector3.h>
+#include <vector>
 
 namespace RoR {
 
 class SkidmarkConfig //!< Skidmark config file parser and data container
 {
 public:
+    static const int ATLAS_TILE_SIZE = 256; //!< Pixels; every skidmark texture is scaled to this size
+    static const int ATLAS_MAX_TILES = 16;  //!< Tiles are stacked vertically, keeps the atlas within 4096px
 
-    void LoadDefaultSkidmarkDefs();
+    void LoadDefaultSkidmarkDefs(); //!< Thread safe, doesn't use OGRE resource system
 
-    int getTexture(Ogre::String model, Ogre::String ground, float slip, Ogre::String& texture);
+    /// @return Atlas tile of the matching skidmark texture, or -1 if no skidmark should be drawn.
+    int getTextureTile(Ogre::String const& model, Ogre::String const& ground, float slip);
+
+    /// Material shared by all skidmarks; the texture atlas is built on first use.
+    Ogre::MaterialPtr GetAtlasMaterial();
+    int               GetAtlasTileCount() const { return std::max(1, static_cast<int>(m_atlas_textures.size())); }
 
 private:
 
     struct SkidmarkDef
     {
         Ogre::String ground; //!< Ground model name, see `struct ground_model_t`
-        Ogre::String texture;
+        int tile;       //!< Index into `m_atlas_textures`
         float slipFrom; //!< Minimum slipping velocity
         float slipTo;   //!< Maximum slipping velocity
     };
 
     int ProcessSkidmarkConfLine(Ogre::StringVector args, Ogre::String model);
+    void BuildAtlas();
 
     std::map<Ogre::String, std::vector<SkidmarkDef>> m_models;
+    std::vector<Ogre::String> m_atlas_textures; //!< Unique texture names, in atlas tile order
+    Ogre::MaterialPtr         m_atlas_material;
 };
 
 /// @addtogroup Gfx
 /// @{
 
+/// Skid trail of a single wheel, drawn as a ring buffer of point pairs in one dynamic mesh.
+/// Each pair is joined with the previous one by a quad; when the buffer is full, the oldest pair is overwritten.
+/// The mesh is only created when the wheel first skids - most wheels never do. Points are staged in
+/// CPU-side copies of the buffers and the changed range is uploaded once per `update()`.
 class Skidmark
 {
 public:
 
-    /// Constructor - see setOperationType() for description of argument.
+    /// @param m_length Points per former trail segment; together with `m_bucket_count` determines the ring buffer capacity.
     Skidmark(SkidmarkConfig* config,  wheel_t* m_wheel, Ogre::SceneNode* snode, int m_length = 500, int m_bucket_count = 20);
     virtual ~Skidmark();
 
@@ -68,36 +87,43 @@ public:
 
 private:
 
-    struct SkidmarkSegment //!< Also reffered to as 'bucket'
-    {
-        Ogre::ManualObject* obj;
-        Ogre::MaterialPtr material;
-        std::vector<Ogre::Vector3> points;
-        std::vector<Ogre::Real> faceSizes;
-        std::vector<Ogre::String> groundTexture;
-        Ogre::Vector3 lastPointAv;
-        int pos;
-        int facecounter;
-    };
+    static const size_t VERTEX_FLOATS = 5; //!< Position (3) + texture coords (2)
+    static const size_t MAX_CAPACITY = 32768; //!< Keeps vertex numbers within 16-bit indices
 
-    void PopSegment();
-    void LimitObjects();
-    void AddObject(Ogre::Vector3 start, Ogre::String texture);
-    void SetPointInt(unsigned short index, const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture);
-    void AddPoint(const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture);
+    void CreateMesh();
+    void FlushBuffers(); //!< Uploads the dirty slot range, if any
     void UpdatePoint(Ogre::Vector3 contact_point, int index, float slip, Ogre::String ground_model_name);
+    void PushPair(Ogre::Vector3 const& left, Ogre::Vector3 const& right, int tile, float tex_u, bool connect);
+    void WriteQuad(size_t slot, size_t prev_slot); //!< `prev_slot == slot` writes a degenerate quad (trail break)
 
     static int           m_instance_counter;
-    bool                 m_is_dirty;
-    std::queue<SkidmarkSegment> m_objects;
     float                m_max_distance;
     float                m_min_distance;
-    static Ogre::Vector2 m_tex_coords[4];
-    int                  m_bucket_count;
-    int                  m_length;
     wheel_t*             m_wheel;
     Ogre::SceneNode*     m_scene_node;  
     SkidmarkConfig*      m_config;
+
+    // Ring buffer
+    size_t               m_capacity = 0;    //!< Max. point pairs
+    size_t               m_head = 0;        //!< Slot to be written next
+    size_t               m_count = 0;       //!< Slots in use
+    int                  m_last_tile = -1;  //!< Atlas tile of the newest pair
+    Ogre::Vector3        m_last_left;       //!< Newest pair, for bridging texture changes
+    Ogre::Vector3        m_last_right;
+    Ogre::Vector3        m_last_point_av;   //!< Middle of the wheel at the newest pair
+    bool                 m_last_pair_odd = false;
+    Ogre::AxisAlignedBox m_bounds;
+
+    // CPU copies of the hardware buffers; slots [m_dirty_begin, m_dirty_end) await upload
+    std::vector<float>         m_vertices;
+    std::vector<Ogre::uint16>  m_indices;
+    size_t                     m_dirty_begin = 0;
+    size_t                     m_dirty_end = 0;
+
+    Ogre::MeshPtr                       m_mesh;
+    Ogre::Entity*                       m_entity = nullptr;
+    Ogre::HardwareVertexBufferSharedPtr m_hw_vbuf;
+    Ogre::HardwareIndexBufferSharedPtr  m_hw_ibuf;
 };
 
 /// @} // addtogroup Gfx
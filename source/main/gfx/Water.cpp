@@ -21,8 +21,10 @@
 
 #include "Water.h"
 
+#include "ActorManager.h"
 #include "AppContext.h"
 #include "CameraManager.h"
+#include "GameContext.h"
 #include "GfxScene.h"
 #include "PlatformUtils.h" // PathCombine
 #include "Terrain.h"
@@ -515,6 +517,15 @@ void Water::SetWaterBottomHeight(float value)
     m_bottom_height = value;
 }
 
+/// Waves move with wall-clock time, or with physics time in deterministic mode (so that runs can be compared).
+static float CalcWaveTime()
+{
+    if (App::sim_deterministic->getBool())
+        return static_cast<float>(App::GetGameContext()->GetActorManager()->GetPhysicsClock());
+
+    return (float)(App::GetAppContext()->GetOgreRoot()->getTimer()->getMilliseconds() * 0.001);
+}
+
 float Water::CalcWavesHeight(Vector3 pos)
 {
     // no waves?
@@ -524,7 +535,7 @@ float Water::CalcWavesHeight(Vector3 pos)
         return m_water_height;
     }
 
-    const float time_sec = (float)(App::GetAppContext()->GetOgreRoot()->getTimer()->getMilliseconds() * 0.001);
+    const float time_sec = CalcWaveTime();
 
     // uh, some upper limit?!
     if (pos.y > m_water_height + m_max_ampl)
@@ -547,6 +558,33 @@ float Water::CalcWavesHeight(Vector3 pos)
     return result;
 }
 
+void Water::CalcWavesHeightBatch(Ogre::Vector3 const* pos, float* out_height, size_t count)
+{
+    // Same math as `CalcWavesHeight()`, with the settings and clock read once for all points
+    if (!RoR::App::gfx_water_waves->getBool() || RoR::App::mp_state->getEnum<MpState>() == RoR::MpState::CONNECTED)
+    {
+        std::fill(out_height, out_height + count, m_water_height);
+        return;
+    }
+
+    const float time_sec = CalcWaveTime();
+
+    for (size_t p = 0; p < count; p++)
+    {
+        float result = m_water_height;
+        if (pos[p].y <= m_water_height + m_max_ampl)
+        {
+            const float waveheight = GetWaveHeight(pos[p]);
+            for (size_t i = 0; i < m_wavetrain_defs.size(); i++)
+            {
+                float amp = std::min(m_wavetrain_defs[i].amplitude * waveheight, m_wavetrain_defs[i].maxheight);
+                result += amp * sin(Math::TWO_PI * ((time_sec * m_wavetrain_defs[i].wavespeed + m_wavetrain_defs[i].dir_sin * pos[p].x + m_wavetrain_defs[i].dir_cos * pos[p].z) / m_wavetrain_defs[i].wavelength));
+            }
+        }
+        out_height[p] = result;
+    }
+}
+
 bool Water::IsUnderWater(Vector3 pos)
 {
     float waterheight = m_water_height;
@@ -576,7 +614,7 @@ Vector3 Water::CalcWavesVelocity(Vector3 pos)
 
     Vector3 result(Vector3::ZERO);
 
-    const float time_sec = (float)(App::GetAppContext()->GetOgreRoot()->getTimer()->getMilliseconds() * 0.001);
+    const float time_sec = CalcWaveTime();
 
     for (size_t i = 0; i < m_wavetrain_defs.size(); i++)
     {
@@ -50,6 +50,7 @@ public:
     void           SetWaterBottomHeight(float value) override;
     void           SetWavesHeight(float value) override;
     float          CalcWavesHeight(Ogre::Vector3 pos) override;
+    void           CalcWavesHeightBatch(Ogre::Vector3 const* pos, float* out_height, size_t count) override;
     Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos) override;
     void           SetWaterVisible(bool value) override;
     bool           IsUnderWater(Ogre::Vector3 pos) override;
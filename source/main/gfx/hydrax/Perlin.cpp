@@ -37,7 +37,6 @@ namespace Hydrax{namespace Noise
 	Perlin::Perlin()
 		: Noise("Perlin", true)
 		, time(0)
-		, r_noise(0)
 		, magnitude(n_dec_magn * 0.085f)
 		, mGPUNormalMapManager(0)
 	{
@@ -47,7 +46,6 @@ namespace Hydrax{namespace Noise
 		: Noise("Perlin", true)
 		, mOptions(Options)
 		, time(0)
-		, r_noise(0)
 		, magnitude(n_dec_magn * Options.Scale)
 		, mGPUNormalMapManager(0)
 	{
@@ -523,7 +521,7 @@ namespace Hydrax{namespace Noise
 		}
 	}
 
-	int Perlin::_readTexelLinearDual(const int &u, const int &v,const int &o)
+	int Perlin::_readTexelLinearDual(const int *r_noise, const int &u, const int &v,const int &o)
 	{
 		int iu, iup, iv, ivp, fu, fv,
 			ut01, ut23, ut;
@@ -546,8 +544,8 @@ namespace Hydrax{namespace Noise
 
 	float Perlin::_getHeigthDual(float u, float v)
 	{
-		// Pointer to the current noise source octave
-		r_noise = p_noise;
+		// Pointer to the current noise source octave (local, so that sampling is thread-safe)
+		const int *r_noise = p_noise;
 
 		int ui = u*magnitude,
 		    vi = v*magnitude,
@@ -557,7 +555,7 @@ namespace Hydrax{namespace Noise
 
 		for(i=0; i<hoct; i++)
 		{
-			value += _readTexelLinearDual(ui,vi,0);
+			value += _readTexelLinearDual(r_noise,ui,vi,0);
 			ui = ui << n_packsize;
 			vi = vi << n_packsize;
 			r_noise += np_size_sq;
@@ -242,12 +242,13 @@ namespace Hydrax{ namespace Noise
 		void _updateGPUNormalMapResources();
 
 		/** Read texel linear dual
+		    @param r_noise Current noise source octave
 		    @param u u
 			@param v v
 			@param o Octave
 			@return int
 		 */
-	    int _readTexelLinearDual(const int &u, const int &v, const int &o);
+	    int _readTexelLinearDual(const int *r_noise, const int &u, const int &v, const int &o);
 
 		/** Read texel linear
 		    @param u u
@@ -269,7 +270,6 @@ namespace Hydrax{ namespace Noise
 		int noise[n_size_sq*noise_frames];
 		int o_noise[n_size_sq*max_octaves];
 		int p_noise[np_size_sq*(max_octaves>>(n_packsize-1))];
-		int *r_noise;
 		float magnitude;
 
 		/// Elapsed time
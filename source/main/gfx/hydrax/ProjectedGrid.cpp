@@ -30,8 +30,13 @@ http://www.cnblogs.com/ArenAK/archive/2007/11/07/951713.html
 
 #include <ProjectedGrid.h>
 
+#include "ThreadPool.h"
+
 #define _def_MaxFarClipDistance 99999
 
+// Grid rows per thread pool task
+#define _def_RowsPerTask 16
+
 namespace Hydrax{namespace Module
 {
 	Mesh::VertexType _PG_getVertexTypeFromNormalMode(const MaterialManager::NormalMode& NormalMode)
@@ -291,30 +296,24 @@ namespace Hydrax{namespace Module
 			{
 				Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-				if (mOptions.ChoppyWaves)
+				RoR::App::GetThreadPool()->ParallelFor(mOptions.Complexity, _def_RowsPerTask, [this, Vertices, &RenderingCameraPos](int RowBegin, int RowEnd)
 				{
-					for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		            {
-			            Vertices[i] = mVerticesChoppyBuffer[i];
-						Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		            }
-				}
-				else
-				{
-					for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		            {
-						Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		            }
-				}
+					if (mOptions.ChoppyWaves)
+					{
+						// Restore undisplaced positions
+						std::copy(mVerticesChoppyBuffer + RowBegin*mOptions.Complexity, mVerticesChoppyBuffer + RowEnd*mOptions.Complexity, Vertices + RowBegin*mOptions.Complexity);
+					}
+					_sampleHeights(Vertices, RowBegin, RowEnd, RenderingCameraPos);
+				});
 			}
 			else if (getNormalMode() == MaterialManager::NM_RTT)
 			{
 				Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
 
-				for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		        {
-				    Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		        }
+				RoR::App::GetThreadPool()->ParallelFor(mOptions.Complexity, _def_RowsPerTask, [this, Vertices, &RenderingCameraPos](int RowBegin, int RowEnd)
+				{
+					_sampleHeights(Vertices, RowBegin, RowEnd, RenderingCameraPos);
+				});
 			}
 
 			// Smooth the heightdata
@@ -376,84 +375,30 @@ namespace Hydrax{namespace Module
 		t_corners2 = _calculeWorldPosition(Ogre::Vector2( 0.0f,+1.0f),m,_viewMat);
 		t_corners3 = _calculeWorldPosition(Ogre::Vector2(+1.0f,+1.0f),m,_viewMat);
 
-		float du  = 1.0f/(mOptions.Complexity-1),
-			  dv  = 1.0f/(mOptions.Complexity-1),
-			  u,v = 0.0f,
-			  // _1_u = (1.0f-u)
-			  _1_u, _1_v = 1.0f,
-			  divide;
-
-		Ogre::Vector4 result;
-
-		int i = 0, iv, iu;
-
 		if (getNormalMode() == MaterialManager::NM_VERTEX)
 		{
 			Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-			for(iv=0; iv<mOptions.Complexity; iv++)
+			RoR::App::GetThreadPool()->ParallelFor(mOptions.Complexity, _def_RowsPerTask, [this, Vertices, &WorldPos](int RowBegin, int RowEnd)
 			{
-				u = 0.0f;
-				_1_u = 1.0f;
-				for(iu=0; iu<mOptions.Complexity; iu++)
-				{
-					result.x = _1_v*(_1_u*t_corners0.x + u*t_corners1.x) + v*(_1_u*t_corners2.x + u*t_corners3.x);
-					result.z = _1_v*(_1_u*t_corners0.z + u*t_corners1.z) + v*(_1_u*t_corners2.z + u*t_corners3.z);
-					result.w = _1_v*(_1_u*t_corners0.w + u*t_corners1.w) + v*(_1_u*t_corners2.w + u*t_corners3.w);
-
-					divide = 1.0f/result.w;
-					result.x *= divide;
-					result.z *= divide;
-
-					Vertices[i].x = result.x;
-					Vertices[i].z = result.z;
-					Vertices[i].y = -mBasePlane.d + mNoise->getValue(WorldPos.x + result.x, WorldPos.z + result.z)*mOptions.Strength;
+				_projectRows(Vertices, RowBegin, RowEnd);
+				_sampleHeights(Vertices, RowBegin, RowEnd, WorldPos);
 
-					i++;
-					u += du;
-					_1_u = 1.0f-u;
+				if (mOptions.ChoppyWaves)
+				{
+					std::copy(Vertices + RowBegin*mOptions.Complexity, Vertices + RowEnd*mOptions.Complexity, mVerticesChoppyBuffer + RowBegin*mOptions.Complexity);
 				}
-				v += dv;
-				_1_v = 1.0f-v;
-			}
-
-			if (mOptions.ChoppyWaves)
-			{
-				for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		        {
-			        mVerticesChoppyBuffer[i] = Vertices[i];
-		        }
-			}
+			});
 		}
 		else if(getNormalMode() == MaterialManager::NM_RTT)
 		{
 			Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
 
-			for(iv=0; iv<mOptions.Complexity; iv++)
+			RoR::App::GetThreadPool()->ParallelFor(mOptions.Complexity, _def_RowsPerTask, [this, Vertices, &WorldPos](int RowBegin, int RowEnd)
 			{
-				u = 0.0f;
-				_1_u = 1.0f;
-				for(iu=0; iu<mOptions.Complexity; iu++)
-				{
-					result.x = _1_v*(_1_u*t_corners0.x + u*t_corners1.x) + v*(_1_u*t_corners2.x + u*t_corners3.x);
-					result.z = _1_v*(_1_u*t_corners0.z + u*t_corners1.z) + v*(_1_u*t_corners2.z + u*t_corners3.z);
-					result.w = _1_v*(_1_u*t_corners0.w + u*t_corners1.w) + v*(_1_u*t_corners2.w + u*t_corners3.w);
-
-					divide = 1.0f/result.w;
-					result.x *= divide;
-					result.z *= divide;
-
-					Vertices[i].x = result.x;
-					Vertices[i].z = result.z;
-					Vertices[i].y = -mBasePlane.d + mNoise->getValue(WorldPos.x + result.x, WorldPos.z + result.z)*mOptions.Strength;
-
-					i++;
-					u += du;
-					_1_u = 1.0f-u;
-				}
-				v += dv;
-				_1_v = 1.0f-v;
-			}
+				_projectRows(Vertices, RowBegin, RowEnd);
+				_sampleHeights(Vertices, RowBegin, RowEnd, WorldPos);
+			});
 		}
 
 		// Smooth the heightdata
@@ -463,9 +408,9 @@ namespace Hydrax{namespace Module
 			{
 				Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-				for(iv=1; iv<(mOptions.Complexity-1); iv++)
+				for(int iv=1; iv<(mOptions.Complexity-1); iv++)
 				{
-					for(iu=1; iu<(mOptions.Complexity-1); iu++)
+					for(int iu=1; iu<(mOptions.Complexity-1); iu++)
 					{
 						Vertices[iv*mOptions.Complexity + iu].y =
 							 0.2f *
@@ -481,9 +426,9 @@ namespace Hydrax{namespace Module
 			{
 				Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
 
-				for(iv=1; iv<(mOptions.Complexity-1); iv++)
+				for(int iv=1; iv<(mOptions.Complexity-1); iv++)
 				{
-					for(iu=1; iu<(mOptions.Complexity-1); iu++)
+					for(int iu=1; iu<(mOptions.Complexity-1); iu++)
 					{
 						Vertices[iv*mOptions.Complexity + iu].y =
 							 0.2f *
@@ -511,32 +456,36 @@ namespace Hydrax{namespace Module
 			return;
 		}
 
-		int v, u;
-		Ogre::Vector3 vec1, vec2, normal;
-
 		Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-		for(v=1; v<(mOptions.Complexity-1); v++)
+		// Inner rows only; normals are computed from positions, which aren't written here
+		RoR::App::GetThreadPool()->ParallelFor(mOptions.Complexity-2, _def_RowsPerTask, [this, Vertices](int RowBegin, int RowEnd)
 		{
-			for(u=1; u<(mOptions.Complexity-1); u++)
+			int v, u;
+			Ogre::Vector3 vec1, vec2, normal;
+
+			for(v=RowBegin+1; v<RowEnd+1; v++)
 			{
-				vec1 = Ogre::Vector3(
-					Vertices[v*mOptions.Complexity + u + 1].x-Vertices[v*mOptions.Complexity + u - 1].x,
-					Vertices[v*mOptions.Complexity + u + 1].y-Vertices[v*mOptions.Complexity + u - 1].y,
-					Vertices[v*mOptions.Complexity + u + 1].z-Vertices[v*mOptions.Complexity + u - 1].z);
+				for(u=1; u<(mOptions.Complexity-1); u++)
+				{
+					vec1 = Ogre::Vector3(
+						Vertices[v*mOptions.Complexity + u + 1].x-Vertices[v*mOptions.Complexity + u - 1].x,
+						Vertices[v*mOptions.Complexity + u + 1].y-Vertices[v*mOptions.Complexity + u - 1].y,
+						Vertices[v*mOptions.Complexity + u + 1].z-Vertices[v*mOptions.Complexity + u - 1].z);
 
-				vec2 = Ogre::Vector3(
-					Vertices[(v+1)*mOptions.Complexity + u].x - Vertices[(v-1)*mOptions.Complexity + u].x,
-					Vertices[(v+1)*mOptions.Complexity + u].y - Vertices[(v-1)*mOptions.Complexity + u].y,
-					Vertices[(v+1)*mOptions.Complexity + u].z - Vertices[(v-1)*mOptions.Complexity + u].z);
+					vec2 = Ogre::Vector3(
+						Vertices[(v+1)*mOptions.Complexity + u].x - Vertices[(v-1)*mOptions.Complexity + u].x,
+						Vertices[(v+1)*mOptions.Complexity + u].y - Vertices[(v-1)*mOptions.Complexity + u].y,
+						Vertices[(v+1)*mOptions.Complexity + u].z - Vertices[(v-1)*mOptions.Complexity + u].z);
 
-				normal = vec2.crossProduct(vec1);
+					normal = vec2.crossProduct(vec1);
 
-				Vertices[v*mOptions.Complexity + u].nx = normal.x;
-				Vertices[v*mOptions.Complexity + u].ny = normal.y;
-				Vertices[v*mOptions.Complexity + u].nz = normal.z;
+					Vertices[v*mOptions.Complexity + u].nx = normal.x;
+					Vertices[v*mOptions.Complexity + u].ny = normal.y;
+					Vertices[v*mOptions.Complexity + u].nz = normal.z;
+				}
 			}
-		}
+		});
 	}
 
 	void ProjectedGrid::_performChoppyWaves()
@@ -546,19 +495,15 @@ namespace Hydrax{namespace Module
 			return;
 		}
 
-		int v, u,
-		    Underwater = 1;
+		int Underwater = 1;
 
 		if (mHydrax->_isCurrentFrameUnderwater())
 		{
 			Underwater = -1;
 		}
 
-		float Dis1,  Dis2;//,
-		   // Dis1_, Dis2_;
-
-		Ogre::Vector3 CameraDir, Norm;
-		Ogre::Vector2 Dir, Perp, Norm2;
+		Ogre::Vector3 CameraDir;
+		Ogre::Vector2 Dir, Perp;
 
 		CameraDir = mRenderingCamera->getDerivedDirection();
 		Dir       = Ogre::Vector2(CameraDir.x, CameraDir.z).normalisedCopy();
@@ -572,50 +517,82 @@ namespace Hydrax{namespace Module
 
 		Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-		for(v=1; v<(mOptions.Complexity-1); v++)
+		// Reads only the undisplaced positions and the vertex's own normal - rows are independent
+		RoR::App::GetThreadPool()->ParallelFor(mOptions.Complexity-2, _def_RowsPerTask, [this, Vertices, Underwater, Dir, Perp](int RowBegin, int RowEnd)
 		{
-			Dis1 =  (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + 1].x,
-					               mVerticesChoppyBuffer[v*mOptions.Complexity + 1].z) -
-					 Ogre::Vector2(mVerticesChoppyBuffer[(v+1)*mOptions.Complexity + 1].x,
-				                   mVerticesChoppyBuffer[(v+1)*mOptions.Complexity + 1].z)).length();
+			int v, u;
+			float Dis1, Dis2;
+			Ogre::Vector3 Norm;
+			Ogre::Vector2 Norm2;
 
-			/*Dis1_ = (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + 1].x,
-                                   mVerticesChoppyBuffer[v*mOptions.Complexity + 1].z) -
-				   	 Ogre::Vector2(mVerticesChoppyBuffer[(v-1)*mOptions.Complexity + 1].x,
-					               mVerticesChoppyBuffer[(v-1)*mOptions.Complexity + 1].z)).length();
+			for(v=RowBegin+1; v<RowEnd+1; v++)
+			{
+				Dis1 =  (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + 1].x,
+						               mVerticesChoppyBuffer[v*mOptions.Complexity + 1].z) -
+						 Ogre::Vector2(mVerticesChoppyBuffer[(v+1)*mOptions.Complexity + 1].x,
+					                   mVerticesChoppyBuffer[(v+1)*mOptions.Complexity + 1].z)).length();
 
-			Dis1 = (Dis1+Dis1_)/2;*/
+				for(u=1; u<(mOptions.Complexity-1); u++)
+				{
+					Dis2 = (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u].x,
+						                  mVerticesChoppyBuffer[v*mOptions.Complexity + u].z) -
+						    Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u+1].x,
+						                  mVerticesChoppyBuffer[v*mOptions.Complexity + u+1].z)).length();
+
+					Norm = Ogre::Vector3(Vertices[v*mOptions.Complexity + u].nx,
+						                 Vertices[v*mOptions.Complexity + u].ny,
+									     Vertices[v*mOptions.Complexity + u].nz).
+						   			     normalisedCopy();
+
+					Norm2 = Ogre::Vector2(Norm.x, Norm.z)  *
+						                 ( (Dir  * Dis1)   +
+						                   (Perp * Dis2))  *
+					 				      mOptions.ChoppyStrength;
+
+					Vertices[v*mOptions.Complexity + u].x = mVerticesChoppyBuffer[v*mOptions.Complexity + u].x + Norm2.x * Underwater;
+					Vertices[v*mOptions.Complexity + u].z = mVerticesChoppyBuffer[v*mOptions.Complexity + u].z + Norm2.y * Underwater;
+				}
+			}
+		});
+	}
 
-			for(u=1; u<(mOptions.Complexity-1); u++)
-			{
-				Dis2 = (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u].x,
-					                  mVerticesChoppyBuffer[v*mOptions.Complexity + u].z) -
-					    Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u+1].x,
-					                  mVerticesChoppyBuffer[v*mOptions.Complexity + u+1].z)).length();
-/*
-				Dis2_ = (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u].x,
-					                   mVerticesChoppyBuffer[v*mOptions.Complexity + u].z) -
-					     Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u-1].x,
-				                       mVerticesChoppyBuffer[v*mOptions.Complexity + u-1].z)).length();
+	template <typename VertexType>
+	void ProjectedGrid::_projectRows(VertexType* Vertices, const int &RowBegin, const int &RowEnd)
+	{
+		const float du = 1.0f/(mOptions.Complexity-1),
+		            dv = 1.0f/(mOptions.Complexity-1);
+
+		for(int iv=RowBegin; iv<RowEnd; iv++)
+		{
+			const float v = iv*dv, _1_v = 1.0f-v;
 
-				Dis2 = (Dis2+Dis2_)/2;*/
+			// Interpolate the row ends once, then only along the row
+			const Ogre::Vector4 Left  = t_corners0*_1_v + t_corners2*v,
+			                    Right = t_corners1*_1_v + t_corners3*v;
 
-				Norm = Ogre::Vector3(Vertices[v*mOptions.Complexity + u].nx,
-					                 Vertices[v*mOptions.Complexity + u].ny,
-								     Vertices[v*mOptions.Complexity + u].nz).
-					   			     normalisedCopy();
+			VertexType* Row = Vertices + iv*mOptions.Complexity;
 
-				Norm2 = Ogre::Vector2(Norm.x, Norm.z)  *
-					                 ( (Dir  * Dis1)   +
-					                   (Perp * Dis2))  *
-				 				      mOptions.ChoppyStrength;
+			// Straight-line arithmetic without calls, so that the compiler can vectorise it
+			for(int iu=0; iu<mOptions.Complexity; iu++)
+			{
+				const float u = iu*du, _1_u = 1.0f-u;
+				const float divide = 1.0f/(_1_u*Left.w + u*Right.w);
 
-				Vertices[v*mOptions.Complexity + u].x = mVerticesChoppyBuffer[v*mOptions.Complexity + u].x + Norm2.x * Underwater;
-				Vertices[v*mOptions.Complexity + u].z = mVerticesChoppyBuffer[v*mOptions.Complexity + u].z + Norm2.y * Underwater;
+				Row[iu].x = (_1_u*Left.x + u*Right.x)*divide;
+				Row[iu].z = (_1_u*Left.z + u*Right.z)*divide;
 			}
 		}
 	}
 
+	template <typename VertexType>
+	void ProjectedGrid::_sampleHeights(VertexType* Vertices, const int &RowBegin, const int &RowEnd, const Ogre::Vector3& WorldPos)
+	{
+		for(int i = RowBegin*mOptions.Complexity; i < RowEnd*mOptions.Complexity; i++)
+		{
+			Vertices[i].y = -mBasePlane.d + mNoise->getValue(WorldPos.x + Vertices[i].x, WorldPos.z + Vertices[i].z)*mOptions.Strength;
+		}
+	}
+
 	// Check the point of intersection with the plane (0,1,0,0) and return the position in homogenous coordinates
 	Ogre::Vector4 ProjectedGrid::_calculeWorldPosition(const Ogre::Vector2 &uv, const Ogre::Matrix4& m, const Ogre::Matrix4& _viewMat)
 	{
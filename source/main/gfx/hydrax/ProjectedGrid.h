@@ -215,6 +215,23 @@ namespace Hydrax{ namespace Module
 		 */
 		void _performChoppyWaves();
 
+		/** Project a band of grid rows onto the base plane (x/z only)
+		    @param Vertices Mesh::POS_NORM_VERTEX or Mesh::POS_VERTEX array
+			@param RowBegin First row
+			@param RowEnd One past the last row
+		 */
+		template <typename VertexType>
+		void _projectRows(VertexType* Vertices, const int &RowBegin, const int &RowEnd);
+
+		/** Sample noise heights for a band of grid rows
+		    @param Vertices Mesh::POS_NORM_VERTEX or Mesh::POS_VERTEX array
+			@param RowBegin First row
+			@param RowEnd One past the last row
+			@param WorldPos Origin world position
+		 */
+		template <typename VertexType>
+		void _sampleHeights(VertexType* Vertices, const int &RowBegin, const int &RowEnd, const Ogre::Vector3& WorldPos);
+
 		/** Render geometry
 		    @param m Range
 			@param _viewMat View matrix
@@ -26,13 +26,32 @@ http://www.gnu.org/copyleft/lesser.txt.
 #include "VClouds.h"
 #include "Ellipsoid.h"
 
+#include "ThreadPool.h"
+
+// Cell columns (one y row of a x slab) per thread pool task
+#define _def_ColumnsPerTask 32
+// Slab padding granularity, in cells; a multiple of the cache line for every field type
+#define _def_SlabAlignment 64
+
 namespace SkyX { namespace VClouds
 {
+	/** Stateless random number for a cell
+	    @param seed Cell index mixed with the generation
+		@return Random number in [0,1) range
+		@remarks Replaces a sequential random generator, so cells can be processed in any order and thread
+	 */
+	static inline float _cellRandom(unsigned int seed)
+	{
+		seed ^= seed >> 16; seed *= 0x7feb352dU;
+		seed ^= seed >> 15; seed *= 0x846ca68bU;
+		seed ^= seed >> 16;
+
+		return static_cast<float>(seed >> 8) * (1.0f / 16777216.0f);
+	}
+
 	DataManager::DataManager(VClouds *vc)
 		: mVClouds(vc)
-		, mCellsCurrent(0)
-		, mCellsTmp(0)
-		, mFFRandom(0)
+		, mGeneration(0)
 		, mNx(0), mNy(0), mNz(0)
 		, mCurrentTransition(0)
 		, mUpdateTime(10.0f)
@@ -65,10 +84,7 @@ namespace SkyX { namespace VClouds
 			mVolTextures[k].setNull();
 		}
 
-		_delete3DCellArray(mCellsCurrent, mNx, mNy);
-		_delete3DCellArray(mCellsTmp, mNx, mNy);
-
-		delete mFFRandom;
+		_deleteCellGrid(mCells);
 
 		mNx = mNy = mNz = 0;
 
@@ -108,7 +124,7 @@ namespace SkyX { namespace VClouds
 			
 			if (mCurrentTransition >= mUpdateTime)
 			{
-				_updateVolTextureData(mCellsCurrent, VOL_TEX0, mNx, mNy, mNz);
+				_updateVolTextureData(mCells, VOL_TEX0, mNx, mNy, mNz);
 
 				mCurrentTransition = mUpdateTime;
 				mVolTexToUpdate = !mVolTexToUpdate;
@@ -146,7 +162,7 @@ namespace SkyX { namespace VClouds
 
 			if (mCurrentTransition <= 0)
 			{
-				_updateVolTextureData(mCellsCurrent, VOL_TEX1, mNx, mNy, mNz);
+				_updateVolTextureData(mCells, VOL_TEX1, mNx, mNy, mNz);
 
 				mCurrentTransition = 0;
 				mVolTexToUpdate = !mVolTexToUpdate;
@@ -161,8 +177,6 @@ namespace SkyX { namespace VClouds
 
 		mNx = nx; mNy = ny; mNz = nz;
 
-		mFFRandom = new FastFakeRandom(1024, 0, 1);
-
 		_initData(nx, ny, nz);
 
 		for (int k = 0; k < 2; k++)
@@ -170,8 +184,8 @@ namespace SkyX { namespace VClouds
 			_createVolTexture(static_cast<VolTextureId>(k), nx, ny, nz);
 		}
 
-		_updateVolTextureData(mCellsCurrent, VOL_TEX0, mNx, mNy, mNz);
-		_updateVolTextureData(mCellsCurrent, VOL_TEX1, mNx, mNy, mNz);
+		_updateVolTextureData(mCells, VOL_TEX0, mNx, mNy, mNz);
+		_updateVolTextureData(mCells, VOL_TEX1, mNx, mNy, mNz);
 
 		mCreated = true;
 	}
@@ -188,12 +202,12 @@ namespace SkyX { namespace VClouds
 
 		if (mVolTexToUpdate)
 		{
-			_updateVolTextureData(mCellsCurrent, VOL_TEX0, mNx, mNy, mNz);
+			_updateVolTextureData(mCells, VOL_TEX0, mNx, mNy, mNz);
 			mCurrentTransition = mUpdateTime;
 		}
 		else
 		{
-			_updateVolTextureData(mCellsCurrent, VOL_TEX1, mNx, mNy, mNz);
+			_updateVolTextureData(mCells, VOL_TEX1, mNx, mNy, mNz);
 			mCurrentTransition = 0;
 		}
 
@@ -202,94 +216,48 @@ namespace SkyX { namespace VClouds
 
 	void DataManager::_initData(const int& nx, const int& ny, const int& nz)
 	{
-		mCellsCurrent = _create3DCellArray(nx, ny, nz);
-		mCellsTmp     = _create3DCellArray(nx, ny, nz, false);
+		_createCellGrid(mCells, nx, ny, nz);
+		mGeneration = 0;
 	}
 
-	DataManager::Cell *** DataManager::_create3DCellArray(const int& nx, const int& ny, const int& nz, const bool& init)
+	void DataManager::_createCellGrid(CellGrid& c, const int& nx, const int& ny, const int& nz)
 	{
-		Cell ***c = new Cell** [nx];
+		c.nx = nx; c.ny = ny; c.nz = nz;
 
-		int u, v, w;
+		// Pad every x slab, so slabs never share a cache line
+		c.slabStride = ((ny*nz + _def_SlabAlignment - 1) / _def_SlabAlignment) * _def_SlabAlignment;
 
-		for (u = 0; u < nx; u++)
-		{
-			c[u] = new Cell* [ny];
+		const size_t size = static_cast<size_t>(nx) * c.slabStride;
 
-			for (v = 0; v < ny; v++)
-			{
-				 c[u][v] = new Cell[nz];
-			}
-		}
-
-		if (!init)
-		{
-			return c;
-		}
-
-		for (u = 0; u < nx; u++)
-		{
-			for (v = 0; v < ny; v++)
-			{
-				for (w = 1; w < nz; w++)
-				{
-					c[u][v][w].act = false;
-					c[u][v][w].cld = false;
-					c[u][v][w].hum = false;
+		c.act.assign(size, 0);
+		c.actNext.assign(size, 0);
+		c.cld.assign(size, 0);
+		c.hum.assign(size, 0);
 
-					c[u][v][w].pact = 0;
-					c[u][v][w].pext = 1;
-					c[u][v][w].phum = 0;
+		c.pact.assign(size, 0);
+		c.pext.assign(size, 1);
+		c.phum.assign(size, 0);
 
-					c[u][v][w].dens = 0.0f;
-					c[u][v][w].light = 1.0f;
-				}
-			}
-		}
-
-		return c;
-	}
-
-	void DataManager::_delete3DCellArray(Cell ***c, const int& nx, const int& ny)
-	{
-		int u, v;
-
-		for (u = 0; u < nx; u++)
-		{
-			for (v = 0; v < ny; v++)
-			{
-				delete [] c[u][v];
-			}
-
-			delete [] c[u];
-		}
-
-		delete [] c;
+		c.dens.assign(size, 0.0f);
+		c.light.assign(size, 1.0f);
 	}
 
-	void DataManager::_copy3DCellArraysData(Cell ***src, Cell ***dest, const int& nx, const int& ny, const int& nz)
+	void DataManager::_deleteCellGrid(CellGrid& c)
 	{
-		int u, v, w;
+		// Swap with empty vectors to actually release the memory
+		std::vector<unsigned char>().swap(c.act);
+		std::vector<unsigned char>().swap(c.actNext);
+		std::vector<unsigned char>().swap(c.cld);
+		std::vector<unsigned char>().swap(c.hum);
 
-		for (u = 0; u < nx; u++)
-		{
-			for (v = 0; v < ny; v++)
-			{
-				for (w = 0; w < nz; w++)
-				{
-					dest[u][v][w].act = src[u][v][w].act;
-					dest[u][v][w].cld = src[u][v][w].cld;
-					dest[u][v][w].hum = src[u][v][w].hum;
+		std::vector<float>().swap(c.pact);
+		std::vector<float>().swap(c.pext);
+		std::vector<float>().swap(c.phum);
 
-					dest[u][v][w].pact = src[u][v][w].pact;
-					dest[u][v][w].pext = src[u][v][w].pext;
-					dest[u][v][w].phum = src[u][v][w].phum;
+		std::vector<float>().swap(c.dens);
+		std::vector<float>().swap(c.light);
 
-					dest[u][v][w].dens = src[u][v][w].dens;
-					dest[u][v][w].light = src[u][v][w].light;
-				}
-			}
-		}
+		c.nx = c.ny = c.nz = c.slabStride = 0;
 	}
 
 	void DataManager::setWheater(const float& Humidity, const float& AverageCloudsSize, const bool& delayedResponse)
@@ -340,7 +308,7 @@ namespace SkyX { namespace VClouds
 			addEllipsoid(new Ellipsoid(newclouddimensions.x,  newclouddimensions.y,  newclouddimensions.z, mNx, mNy, mNz, (int)Ogre::Math::RangeRandom(0, mNx), (int)Ogre::Math::RangeRandom(0, mNy), static_cast<int>(Ogre::Math::RangeRandom(newclouddimensions.z+2,mNz-newclouddimensions.z-2)), Ogre::Math::RangeRandom(1,5.0f)), false);
 		}
 
-		_updateProbabilities(mCellsCurrent, mNx, mNy, mNz, delayedResponse);
+		_updateProbabilities(mCells, mNx, mNy, mNz, delayedResponse);
 
 		if (!delayedResponse)
 		{
@@ -350,8 +318,8 @@ namespace SkyX { namespace VClouds
 			}
 			mStep = mXStart = mXEnd = 0;
 
-			_updateVolTextureData(mCellsCurrent, VOL_TEX0, mNx, mNy, mNz);
-			_updateVolTextureData(mCellsCurrent, VOL_TEX1, mNx, mNy, mNz);
+			_updateVolTextureData(mCells, VOL_TEX0, mNx, mNy, mNz);
+			_updateVolTextureData(mCells, VOL_TEX1, mNx, mNy, mNz);
 		}
 	}
 
@@ -361,39 +329,30 @@ namespace SkyX { namespace VClouds
 
 		if (UpdateProbabilities)
 		{
-			e->updateProbabilities(mCellsCurrent,mNx,mNy,mNz);
+			e->updateProbabilities(mCells,mNx,mNy,mNz);
 		}
 	}
 
-	void DataManager::_clearProbabilities(Cell*** c, const int& nx, const int& ny, const int& nz, const bool& clearData)
+	void DataManager::_clearProbabilities(CellGrid& c, const int& nx, const int& ny, const int& nz, const bool& clearData)
 	{
-		int u, v, w;
+		// Padding cells are never read, so the whole arrays can be cleared at once
+		std::fill(c.pact.begin(), c.pact.end(), 0.0f);
+		std::fill(c.pext.begin(), c.pext.end(), 1.0f);
+		std::fill(c.phum.begin(), c.phum.end(), 0.0f);
 
-		for (u = 0; u < nx; u++)
+		if (clearData)
 		{
-			for (v = 0; v < ny; v++)
-			{
-				for (w = 0; w < nz; w++)
-				{
-					c[u][v][w].pact = 0;
-					c[u][v][w].pext = 1;
-					c[u][v][w].phum = 0;
+			std::fill(c.act.begin(), c.act.end(), 0);
+			std::fill(c.actNext.begin(), c.actNext.end(), 0);
+			std::fill(c.cld.begin(), c.cld.end(), 0);
+			std::fill(c.hum.begin(), c.hum.end(), 0);
 
-					if (clearData)
-					{
-						c[u][v][w].act = false;
-						c[u][v][w].cld = false;
-						c[u][v][w].hum = false;
-
-						c[u][v][w].dens = 0;
-						c[u][v][w].light = 0;
-					}
-				}
-			}
+			std::fill(c.dens.begin(), c.dens.end(), 0.0f);
+			std::fill(c.light.begin(), c.light.end(), 0.0f);
 		}
 	}
 
-	void DataManager::_updateProbabilities(Cell*** c, const int& nx, const int& ny, const int& nz, const bool& delayedResponse)
+	void DataManager::_updateProbabilities(CellGrid& c, const int& nx, const int& ny, const int& nz, const bool& delayedResponse)
 	{
 		_clearProbabilities(c,nx,ny,nz,!delayedResponse);
 
@@ -405,7 +364,7 @@ namespace SkyX { namespace VClouds
 		}
 	}
 
-	const Ogre::Real DataManager::_getLightAbsorcionAt(Cell*** c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const Ogre::Vector3& d, const float& att) const
+	const Ogre::Real DataManager::_getLightAbsorcionAt(const CellGrid& c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const Ogre::Vector3& d, const float& att) const
 	{
 		Ogre::Real step = 1, factor = 1;
 		Ogre::Vector3 pos = Ogre::Vector3(x, y, z);
@@ -426,7 +385,7 @@ namespace SkyX { namespace VClouds
 				uu = (u<0) ? (u + nx) : u; if (u>=nx) { uu-= nx; }
 				vv = (v<0) ? (v + ny) : v; if (v>=ny) { vv-= ny; }
 
-				factor -= c[uu][vv][(int)pos.z].dens*att*(1-static_cast<float>(current_iteration)/max_iterations);
+				factor -= c.dens[c.index(uu, vv, (int)pos.z)]*att*(1-static_cast<float>(current_iteration)/max_iterations);
 				pos += step*(-d);
 
 				current_iteration++;
@@ -438,108 +397,113 @@ namespace SkyX { namespace VClouds
 
 	void DataManager::_performCalculations(const int& nx, const int& ny, const int& nz, const int& step, const int& xStart, const int& xEnd)
 	{
-		int u, v, w;
+		if (step < 0 || step > 3 || xStart >= xEnd)
+		{
+			return;
+		}
 
-		switch (step)
+		CellGrid& c = mCells;
+		const unsigned int generation = mGeneration;
+		// Light scattering
+		const Ogre::Vector3 SunDir = Ogre::Vector3(mVClouds->getSunDirection().x, mVClouds->getSunDirection().z, mVClouds->getSunDirection().y);
+
+		RoR::App::GetThreadPool()->ParallelFor((xEnd-xStart)*ny, _def_ColumnsPerTask, [this, &c, nx, ny, nz, step, xStart, generation, &SunDir](int ColumnBegin, int ColumnEnd)
 		{
-			case 0:
+			int u, v, w, i;
+
+			for (int col = ColumnBegin; col < ColumnEnd; col++)
 			{
-				for (u = xStart; u < xEnd; u++)
+				u = xStart + col / ny;
+				v = col % ny;
+
+				switch (step)
 				{
-					for (v = 0; v < ny; v++)
+					case 0:
 					{
 						for (w = 0; w < nz; w++)
 						{
-							// ti+1                       ti
-							mCellsCurrent[u][v][w].hum = mCellsCurrent[u][v][w].hum || (mFFRandom->get() < mCellsCurrent[u][v][w].phum);
-							mCellsCurrent[u][v][w].cld = mCellsCurrent[u][v][w].cld && (mFFRandom->get() > mCellsCurrent[u][v][w].pext);
-							mCellsCurrent[u][v][w].act = mCellsCurrent[u][v][w].act || (mFFRandom->get() < mCellsCurrent[u][v][w].pact);
+							i = c.index(u, v, w);
+							const unsigned int seed = static_cast<unsigned int>(i)*3 + generation*0x9e3779b9U;
 
-							// Copy act in the temporal buffer, for _fact(...)
-							mCellsTmp[u][v][w].act = mCellsCurrent[u][v][w].act;
+							// ti+1                       ti
+							c.hum[i] = c.hum[i] || (_cellRandom(seed)   < c.phum[i]);
+							c.cld[i] = c.cld[i] && (_cellRandom(seed+1) > c.pext[i]);
+							c.act[i] = c.act[i] || (_cellRandom(seed+2) < c.pact[i]);
 						}
 					}
-				}
-			}
-			break;
-			case 1:
-			{
-				for (u = xStart; u < xEnd; u++)
-				{
-					for (v = 0; v < ny; v++)
+					break;
+					case 1:
 					{
+						// act keeps the current generation for _fact(...) until the whole step is done
 						for (w = 0; w < nz; w++)
 						{
+							i = c.index(u, v, w);
+
 							// ti+1                       ti
-							mCellsCurrent[u][v][w].hum =  mCellsCurrent[u][v][w].hum && !mCellsCurrent[u][v][w].act;
-							mCellsCurrent[u][v][w].cld =  mCellsCurrent[u][v][w].cld ||  mCellsCurrent[u][v][w].act;
-							mCellsCurrent[u][v][w].act = !mCellsCurrent[u][v][w].act &&  mCellsCurrent[u][v][w].hum && _fact(mCellsTmp, nx, ny, nz, u,v,w);
+							c.hum[i]     =  c.hum[i] && !c.act[i];
+							c.cld[i]     =  c.cld[i] ||  c.act[i];
+							c.actNext[i] = !c.act[i] &&  c.hum[i] && _fact(c, nx, ny, nz, u,v,w);
 						}
 					}
-				}
-			}
-			break;
-			case 2:
-			{
-				// Continous density
-				for (u = xStart; u < xEnd; u++)
-				{
-					for (v = 0; v < ny; v++)
+					break;
+					case 2:
 					{
+						// Continous density
 						for (w = 0; w < nz; w++)
 						{
-						   mCellsCurrent[u][v][w].dens = _getDensityAt(mCellsCurrent, nx, ny, nz, u,v,w, 1/*TODOOOO!!!*/, 1.15f);
-						  // mCellsCurrent[u][v][w].dens = _getDensityAt(mCellsCurrent,u,v,w);
+						   c.dens[c.index(u, v, w)] = _getDensityAt(c, nx, ny, nz, u,v,w, 1/*TODOOOO!!!*/, 1.15f);
+						  // c.dens[c.index(u, v, w)] = _getDensityAt(c,u,v,w);
 						}
 					}
-				}
-			}
-			break;
-			case 3:
-			{
-				// Light scattering
-				Ogre::Vector3 SunDir = Ogre::Vector3(mVClouds->getSunDirection().x, mVClouds->getSunDirection().z, mVClouds->getSunDirection().y);
-
-				for (u = xStart; u < xEnd; u++)
-				{
-					for (v = 0; v < ny; v++)
+					break;
+					case 3:
 					{
 						for (w = 0; w < nz; w++)
 						{
-							mCellsCurrent[u][v][w].light = _getLightAbsorcionAt(mCellsCurrent, nx, ny, nz, u,v,w, SunDir, 0.15f/*TODO!!!!*/);
+							c.light[c.index(u, v, w)] = _getLightAbsorcionAt(c, nx, ny, nz, u,v,w, SunDir, 0.15f/*TODO!!!!*/);
 						}
 					}
+					break;
 				}
 			}
-			break;
+		});
+
+		if (step == 1 && xEnd == nx)
+		{
+			// The next generation is complete
+			c.act.swap(c.actNext);
+			mGeneration++;
 		}
 	}
 
-	const bool DataManager::_fact(Cell ***c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z) const
+	const bool DataManager::_fact(const CellGrid& c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z) const
 	{
 		bool i1m, j1m, k1m, 
 			 i1r, j1r, k1r, 
 			 i2r, i2m, j2r, j2m, k2r;
 
-		i1m = ((x+1)>=nx) ? c[0][y][z].act : c[x+1][y][z].act;
-		j1m = ((y+1)>=ny) ? c[x][0][z].act : c[x][y+1][z].act;
-		k1m = ((z+1)>=nz) ? false : c[x][y][z+1].act;
+		const unsigned char *act = &c.act[0];
+		const int i = c.index(x, y, z);
+
+		i1m = ((x+1)>=nx) ? act[c.index(0, y, z)] : act[i + c.slabStride];
+		j1m = ((y+1)>=ny) ? act[c.index(x, 0, z)] : act[i + nz];
+		k1m = ((z+1)>=nz) ? false : act[i + 1];
 
-		i1r = ((x-1)<0) ? c[nx-1][y][z].act : c[x-1][y][z].act;
-		j1r = ((y-1)<0) ? c[x][ny-1][z].act : c[x][y-1][z].act;
-		k1r = ((z-1)<0) ? false : c[x][y][z-1].act;
+		i1r = ((x-1)<0) ? act[c.index(nx-1, y, z)] : act[i - c.slabStride];
+		j1r = ((y-1)<0) ? act[c.index(x, ny-1, z)] : act[i - nz];
+		k1r = ((z-1)<0) ? false : act[i - 1];
 
-		i2r = ((x-2)<0) ? c[nx-2][y][z].act : c[x-2][y][z].act;
-		j2r = ((y-2)<0) ? c[x][ny-2][z].act : c[x][y-2][z].act;
-		k2r = ((z-2)<0) ? false : c[x][y][z-2].act;
+		i2r = ((x-2)<0) ? act[c.index(x-2+nx, y, z)] : act[i - 2*c.slabStride];
+		j2r = ((y-2)<0) ? act[c.index(x, y-2+ny, z)] : act[i - 2*nz];
+		k2r = ((z-2)<0) ? false : act[i - 2];
 
-		i2m = ((x+2)>=nx) ? c[1][y][z].act : c[x+2][y][z].act;
-		j2m = ((y+2)>=ny) ? c[x][1][z].act : c[x][y+2][z].act;
+		i2m = ((x+2)>=nx) ? act[c.index(x+2-nx, y, z)] : act[i + 2*c.slabStride];
+		j2m = ((y+2)>=ny) ? act[c.index(x, y+2-ny, z)] : act[i + 2*nz];
 
 		return i1m || j1m || k1m  || i1r || j1r || k1r || i2r || i2m || j2r || j2m || k2r;
 	}
 
-	const float DataManager::_getDensityAt(Cell ***c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const int& r, const float& strength) const
+	const float DataManager::_getDensityAt(const CellGrid& c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const int& r, const float& strength) const
 	{		
 		int zr = ((z-r)<0) ? 0 : z-r,
 			zm = ((z+r)>=nz) ? nz : z+r,
@@ -556,7 +520,7 @@ namespace SkyX { namespace VClouds
 					uu = (u<0) ? (u + nx) : u; if (u>=nx) { uu-= nx; }
 					vv = (v<0) ? (v + ny) : v; if (v>=ny) { vv-= ny; }
 
-					clouds += c[uu][vv][w].cld ? 1 : 0;
+					clouds += c.cld[c.index(uu, vv, w)] ? 1 : 0;
 					div++;
 				}
 			}
@@ -565,9 +529,9 @@ namespace SkyX { namespace VClouds
 		return Ogre::Math::Clamp<float>(strength*((float)clouds)/div, 0, 1);
 	}
 
-	const float DataManager::_getDensityAt(Cell ***c, const int& x, const int& y, const int& z) const
+	const float DataManager::_getDensityAt(const CellGrid& c, const int& x, const int& y, const int& z) const
 	{
-		return c[x][y][z].cld ? 1.0f : 0.0f;
+		return c.cld[c.index(x, y, z)] ? 1.0f : 0.0f;
 	}
 
 	void DataManager::_createVolTexture(const VolTextureId& TexId, const int& nx, const int& ny, const int& nz)
@@ -592,28 +556,35 @@ namespace SkyX { namespace VClouds
 				->setTextureName("_SkyX_VolCloudsData"+Ogre::StringConverter::toString(TexId), Ogre::TEX_TYPE_3D);
 	}
 
-	void DataManager::_updateVolTextureData(Cell ***c, const VolTextureId& TexId, const int& nx, const int& ny, const int& nz)
+	void DataManager::_updateVolTextureData(const CellGrid& c, const VolTextureId& TexId, const int& nx, const int& ny, const int& nz)
 	{
 		Ogre::HardwarePixelBufferSharedPtr buffer = mVolTextures[TexId]->getBuffer(0,0);
 		
 		buffer->lock(Ogre::HardwareBuffer::HBL_DISCARD);
 		const Ogre::PixelBox &pb = buffer->getCurrentLock();
 
-                 Ogre::uint32 *pbptr = reinterpret_cast<Ogre::uint32*>(pb.data);
-                 size_t x, y, z;
-
-                 for (z = pb.front; z < pb.back; z++)
-            {
-                for (y = pb.top; y < pb.bottom; y++)
-                {
-                    for (x = pb.left; x < pb.right; x++)
-                    {
-                        Ogre::PixelUtil::packColour (c[x][y][z].dens/* TODO!!!! */, c[x][y][z].light, 0, 0, pb.format, &pbptr[x]);
-                    }
-                    pbptr += pb.rowPitch;
-                }
-                pbptr += pb.getSliceSkip ();
-            }
+		Ogre::uint32 *data = reinterpret_cast<Ogre::uint32*>(pb.data);
+
+		// One z slice per task, slices don't overlap in the locked box
+		RoR::App::GetThreadPool()->ParallelFor(static_cast<int>(pb.back - pb.front), 1, [&c, &pb, data](int SliceBegin, int SliceEnd)
+		{
+			size_t x, y, z;
+
+			for (z = pb.front + SliceBegin; z < pb.front + SliceEnd; z++)
+			{
+				Ogre::uint32 *pbptr = data + (z - pb.front)*pb.slicePitch;
+
+				for (y = pb.top; y < pb.bottom; y++)
+				{
+					for (x = pb.left; x < pb.right; x++)
+					{
+						const int i = c.index(x, y, z);
+						Ogre::PixelUtil::packColour (c.dens[i]/* TODO!!!! */, c.light[i], 0, 0, pb.format, &pbptr[x]);
+					}
+					pbptr += pb.rowPitch;
+				}
+			}
+		});
 
 		buffer->unlock();
 	}
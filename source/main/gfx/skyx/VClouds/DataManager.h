@@ -26,7 +26,7 @@ http://www.gnu.org/copyleft/lesser.txt.
 
 #include "Prerequisites.h"
 
-#include "FastFakeRandom.h"
+#include <vector>
 
 namespace SkyX { namespace VClouds{
 
@@ -36,21 +36,40 @@ namespace SkyX { namespace VClouds{
 	class DataManager 
 	{
 	public:
-		/** Cell struct
+		/** Cell grid: one flat array per cell field, x slabs first, then y rows, then z
 		 */
-		struct Cell
+		struct CellGrid
 		{
 			/// Humidity, phase and cloud
-			bool hum, act, cld;
+			std::vector<unsigned char> hum, act, cld;
+
+			/// Phase of the next generation, written by the automaton and swapped with act
+			std::vector<unsigned char> actNext;
 
 			/// Probabilities
-			float phum, pext, pact;
+			std::vector<float> phum, pext, pact;
 
 			/// Continous density
-			float dens;
+			std::vector<float> dens;
 
 			/// Light absorcion
-			float light;
+			std::vector<float> light;
+
+			/// Complexities
+			int nx, ny, nz;
+
+			/// Distance between two x slabs, padded to whole cache lines
+			int slabStride;
+
+			/** Get the flat index of a cell
+			    @param x x Coord
+				@param y y Coord
+				@param z z Coord
+			 */
+			inline int index(const int& x, const int& y, const int& z) const
+			{
+				return x*slabStride + y*nz + z;
+			}
 		};
 
 		/** Volumetric textures enumeration
@@ -149,30 +168,18 @@ namespace SkyX { namespace VClouds{
 		 */
 		void _initData(const int& nx, const int& ny, const int& nz);
 
-		/** Create tridimensional cell array
+		/** Create cell grid
+			@param c Cell grid to be (re)allocated
 			@param nx X size
 			@param ny Y size
 			@param nz Z size
-			@param init Initialize values
-			@return Cell 3d pointer
 		 */
-		Cell *** _create3DCellArray(const int& nx, const int& ny, const int& nz, const bool& init = true);
+		void _createCellGrid(CellGrid& c, const int& nx, const int& ny, const int& nz);
 
-		/** Delete tridimensional cell array
-			@param c Cell pointer to be deleted
-			@param nx X size
-			@param ny Y size
+		/** Delete cell grid
+			@param c Cell grid to be freed
 		 */
-		void _delete3DCellArray(Cell ***c, const int& nx, const int& ny);
-
-		/** Copy 3d cells arrays data
-			@param src Source
-			@param dest Dest
-			@param nx X size
-			@param ny Y size
-			@param nz Z size
-		*/
-		void _copy3DCellArraysData(Cell ***src, Cell ***dest, const int& nx, const int& ny, const int& nz);
+		void _deleteCellGrid(CellGrid& c);
 
 		/** Perform celullar automata simulation
 		    @param nx X size
@@ -181,6 +188,7 @@ namespace SkyX { namespace VClouds{
 			@param step Calculation step. Valid steps are 0,1,2,3.
 			@param xStart x start cell (included)
 			@param xEnd x end cell (not included, until xEnd-1)
+			@remarks Cell columns are distributed over the thread pool, every step only writes to the cells being processed
 		 */
 		void _performCalculations(const int& nx, const int& ny, const int& nz, const int& step, const int& xStart, const int& xEnd);
 
@@ -191,7 +199,7 @@ namespace SkyX { namespace VClouds{
 			@param ny Y size
 			@param nz Z size
 		 */
-		void _updateVolTextureData(Cell ***c, const VolTextureId& TexId, const int& nx, const int& ny, const int& nz);
+		void _updateVolTextureData(const CellGrid& c, const VolTextureId& TexId, const int& nx, const int& ny, const int& nz);
 
 		/** Get continous density at a point
 		    @param c Cells data
@@ -204,7 +212,7 @@ namespace SkyX { namespace VClouds{
 			@param r Radius
 			@param sgtrength Strength
 		 */	
-		const float _getDensityAt(Cell ***c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const int& r, const float& strength) const;
+		const float _getDensityAt(const CellGrid& c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const int& r, const float& strength) const;
 
 		/** Get discrete density at a point
 		    @param c Cells data
@@ -212,7 +220,7 @@ namespace SkyX { namespace VClouds{
 			@param y y Coord
 			@param z z Coord 
 		 */	
-		const float _getDensityAt(Cell ***c, const int& x, const int& y, const int& z) const;
+		const float _getDensityAt(const CellGrid& c, const int& x, const int& y, const int& z) const;
 
 		/** Fact funtion
 		    @param c Cells data
@@ -223,7 +231,7 @@ namespace SkyX { namespace VClouds{
 			@param y y Coord
 			@param z z Coord 
 		 */
-		const bool _fact(Cell ***c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z) const;
+		const bool _fact(const CellGrid& c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z) const;
 
 		/** Clear probabilities
 		    @param c Cells data
@@ -232,7 +240,7 @@ namespace SkyX { namespace VClouds{
 			@param nz Z size
 			@param clearData Clear data?
 		 */
-		void _clearProbabilities(Cell*** c, const int& nx, const int& ny, const int& nz, const bool& clearData);
+		void _clearProbabilities(CellGrid& c, const int& nx, const int& ny, const int& nz, const bool& clearData);
 
 		/** Update probabilities based from the Ellipsoid vector
 		    @param c Cells data
@@ -241,7 +249,7 @@ namespace SkyX { namespace VClouds{
 			@param nz Z size
 			@param delayedResponse false to change wheather conditions over several updates, true to change it at the moment
 		 */
-		void _updateProbabilities(Cell*** c, const int& nx, const int& ny, const int& nz, const bool& delayedResponse);
+		void _updateProbabilities(CellGrid& c, const int& nx, const int& ny, const int& nz, const bool& delayedResponse);
 
 		/** Get light absorcion factor at a point
 			@param c Cells data
@@ -254,7 +262,7 @@ namespace SkyX { namespace VClouds{
 			@param d Light direction
 			@param att Attenuation factor
 		 */
-		const Ogre::Real _getLightAbsorcionAt(Cell*** c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const Ogre::Vector3& d, const float& att) const;
+		const Ogre::Real _getLightAbsorcionAt(const CellGrid& c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const Ogre::Vector3& d, const float& att) const;
 
 		/** Create volumetric texture
 			@param TexId Texture Id
@@ -265,8 +273,9 @@ namespace SkyX { namespace VClouds{
 		void _createVolTexture(const VolTextureId& TexId, const int& nx, const int& ny, const int& nz);
 
 		/// Simulation data
-		Cell ***mCellsCurrent,
-			 ***mCellsTmp;
+		CellGrid mCells;
+		/// Automaton generation, seeds the per-cell random numbers
+		unsigned int mGeneration;
 
 		/// Current transition
 		float mCurrentTransition;
@@ -286,9 +295,6 @@ namespace SkyX { namespace VClouds{
 		/// Has been create(...) already called?
 		bool mCreated;
 
-		/// Fast fake random
-		FastFakeRandom *mFFRandom;
-
 		/// Max number of clouds(Ellipsoids)
 		int mMaxNumberOfClouds;
 		/// Ellipsoids
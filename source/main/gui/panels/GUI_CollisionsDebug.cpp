@@ -195,7 +195,8 @@ void CollisionsDebug::AddCollisionMeshDebugMesh(collision_mesh_t const& coll_mes
     debugmo->begin("tracks/debug/collision/triangle", RenderOperation::OT_TRIANGLE_LIST);
     for (int i = 0; i < coll_mesh.collision_tri_count; i++)
     {
-        collision_tri_t const& ctri = ctris[i + coll_mesh.collision_tri_start];
+        const int ctri_index = (coll_mesh.collision_tris.empty()) ? (i + coll_mesh.collision_tri_start) : coll_mesh.collision_tris[i];
+        collision_tri_t const& ctri = ctris[ctri_index];
         // The collision triangle vertices are in world coords, we want local coords.
         debugmo->position(ctri.a - coll_mesh.position);
         debugmo->position(ctri.b - coll_mesh.position);
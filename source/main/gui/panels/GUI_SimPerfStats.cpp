@@ -21,9 +21,13 @@
 
 #include "GUI_SimPerfStats.h"
 
+#include "Actor.h"
+#include "ActorManager.h"
 #include "AppContext.h"
+#include "GameContext.h"
 #include "GUIManager.h"
 #include "Language.h"
+#include <algorithm>
 #include <iomanip>
 
 #include <imgui.h>
@@ -80,6 +84,87 @@ void SimPerfStats::Draw()
     ImGui::Text("%s%zu", _LC("SimPerfStats", "Triangle count: "), stats.triangleCount);
     ImGui::Text("%s%zu", _LC("SimPerfStats", "Batch count: "),    stats.batchCount);
 
+    const ImVec2 actor_costs_pos(ImGui::GetWindowPos().x, ImGui::GetWindowPos().y + ImGui::GetWindowSize().y + theme.screen_edge_padding.y);
+    ImGui::End();
+    ImGui::PopStyleColor(1); // WindowBg
+
+    this->DrawActorCosts(actor_costs_pos);
+}
+
+void SimPerfStats::DrawActorCosts(ImVec2 pos)
+{
+    std::vector<Actor*> actors = App::GetGameContext()->GetActorManager()->GetActors();
+    if (actors.empty())
+        return;
+
+    GUIManager::GuiTheme const& theme = App::GetGuiManager()->GetTheme();
+    ImGuiWindowFlags flags = ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoMove |
+        ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoTitleBar;
+    ImGui::SetNextWindowPos(pos);
+    ImGui::PushStyleColor(ImGuiCol_WindowBg, theme.semitransparent_window_bg);
+    ImGui::Begin("ActorCosts", nullptr, flags);
+
+    ImGui::Text("%s", _LC("SimPerfStats", "CPU cost per actor (ms per second, ms per frame)"));
+
+    auto get_value = [](Actor* actor, int column) -> float
+    {
+        switch (column)
+        {
+        case COLUMN_PHYSICS:     return actor->getPhysicsCostMs();
+        case COLUMN_COLLISION:   return actor->getCollisionCostMs();
+        case COLUMN_FLEXBODY:    return actor->getFlexbodyCostMs();
+        case COLUMN_AVG_FRAME:   return actor->ar_perf_stats.last_avg_frame_ms;
+        case COLUMN_WORST_FRAME: return actor->getWorstFrameCostMs();
+        default:                 return 0.f;
+        }
+    };
+    const int sort_column = m_actor_sort_column;
+    std::sort(actors.begin(), actors.end(), [&](Actor* a, Actor* b)
+        {
+            if (sort_column == COLUMN_NAME)
+                return a->ar_design_name < b->ar_design_name;
+            return get_value(a, sort_column) > get_value(b, sort_column);
+        });
+
+    const char* headers[COLUMN_COUNT] =
+    {
+        _LC("SimPerfStats", "Actor"),
+        _LC("SimPerfStats", "Physics"),
+        _LC("SimPerfStats", "Collisions"),
+        _LC("SimPerfStats", "Flexbodies"),
+        _LC("SimPerfStats", "Avg frame"),
+        _LC("SimPerfStats", "Worst frame"),
+    };
+    ImGui::Columns(COLUMN_COUNT, "ActorCostColumns");
+    ImGui::Separator();
+    for (int i = 0; i < COLUMN_COUNT; i++)
+    {
+        if (ImGui::Selectable(headers[i], m_actor_sort_column == i))
+        {
+            m_actor_sort_column = i;
+        }
+        ImGui::NextColumn();
+    }
+    ImGui::Separator();
+
+    const float budget_ms = App::diag_actor_budget_ms->getFloat();
+    for (Actor* actor : actors)
+    {
+        ImGui::Text("%s", actor->ar_design_name.c_str());
+        ImGui::NextColumn();
+        for (int i = COLUMN_PHYSICS; i < COLUMN_COUNT; i++)
+        {
+            const float value = get_value(actor, i);
+            const bool over_budget = (budget_ms > 0.f && i == COLUMN_WORST_FRAME && value > budget_ms);
+            if (over_budget)
+                ImGui::TextColored(theme.warning_text_color, "%.2f", value);
+            else
+                ImGui::Text("%.2f", value);
+            ImGui::NextColumn();
+        }
+    }
+    ImGui::Columns(1);
+
     ImGui::End();
     ImGui::PopStyleColor(1); // WindowBg
 }
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <imgui.h>
 #include <string>
 
 namespace RoR {
@@ -35,7 +36,20 @@ public:
     void Draw();
 
 private:
+    enum ActorCostColumn
+    {
+        COLUMN_NAME,
+        COLUMN_PHYSICS,
+        COLUMN_COLLISION,
+        COLUMN_FLEXBODY,
+        COLUMN_AVG_FRAME,
+        COLUMN_WORST_FRAME,
+        COLUMN_COUNT
+    };
+
+    void DrawActorCosts(ImVec2 pos); //!< Separate window - the FPS window doesn't take inputs.
     bool         m_is_visible = false;
+    int          m_actor_sort_column = COLUMN_WORST_FRAME; //!< Descending, except names
     std::string Convert(const float f); // converts const float to std::string with precision
 };
 
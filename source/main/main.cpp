@@ -21,6 +21,7 @@
 
 #include "Application.h"
 #include "AppContext.h"
+#include "AsyncLogger.h"
 #include "CacheSystem.h"
 #include "CameraManager.h"
 #include "ChatSystem.h"
@@ -48,13 +49,17 @@
 #include "MumbleIntegration.h"
 #include "OutGauge.h"
 #include "OverlayWrapper.h"
+#include "PerfHarness.h"
 #include "PlatformUtils.h"
 #include "RoRVersion.h"
 #include "ScriptEngine.h"
 #include "Skidmark.h"
 #include "SoundScriptManager.h"
+#include "StartupGraph.h"
 #include "Terrain.h"
+#include "TorqueCurve.h"
 #include "Utils.h"
+#include <imgui.h>
 #include <Overlay/OgreOverlaySystem.h>
 #include <ctime>
 #include <iomanip>
@@ -118,93 +123,184 @@ int main(int argc, char *argv[])
             return 0;
         }
 
-        // Find resources dir, update cvar 'sys_resources_dir'
-        if (!App::GetAppContext()->SetUpResourcesDir())
-        {
-            return -1; // Error already displayed
-        }
+        App::GetPerfHarness()->Configure();
 
-        // Make sure config directory exists - to save 'ogre.cfg'
-        CreateFolder(App::sys_config_dir->getStr());
+        App::CreateThreadPool(); // Needs 'app_num_workers' from RoR.cfg
 
-        // Load and start OGRE renderer, uses config directory
-        if (!App::GetAppContext()->SetUpRendering())
-        {
-            return -1; // Error already displayed
-        }
+        const bool load_modcache = !App::app_force_cache_purge->getBool() &&
+                                   !App::cli_force_cache_update->getBool() && !App::app_force_cache_update->getBool();
 
-        Ogre::TextureManager::getSingleton().setDefaultNumMipmaps(5);
+        // Startup tasks; independent ones run in parallel, see RoR.log for timeline.
+        // Worker tasks must not use OGRE resource system, renderer, GUI or translations.
+        typedef StartupGraph::TaskThread TaskThread;
+        StartupGraph startup;
+        Ogre::OverlaySystem* overlay_system = nullptr;
 
-        // Deploy base config files from 'skeleton.zip'
-        if (!App::GetAppContext()->SetUpConfigSkeleton())
-        {
-            return -1; // Error already displayed
-        }
-
-        Ogre::OverlaySystem* overlay_system = new Ogre::OverlaySystem(); //Overlay init
-
-        Ogre::ConfigOptionMap ropts = App::GetAppContext()->GetOgreRoot()->getRenderSystem()->getConfigOptions();
-        int resolution = Ogre::StringConverter::parseInt(Ogre::StringUtil::split(ropts["Video Mode"].currentValue, " x ")[0], 1024);
-        int fsaa = 2 * (Ogre::StringConverter::parseInt(ropts["FSAA"].currentValue, 0) / 4);
-        int res = std::pow(2, std::floor(std::log2(resolution)));
-
-        Ogre::TextureManager::getSingleton().createManual ("EnvironmentTexture",
-            Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_CUBE_MAP, res / 4, res / 4, 0,
-            Ogre::PF_R8G8B8, Ogre::TU_RENDERTARGET, 0, false, fsaa);
-        Ogre::TextureManager::getSingleton ().createManual ("Refraction",
-            Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_2D, res / 2, res / 2, 0,
-            Ogre::PF_R8G8B8, Ogre::TU_RENDERTARGET, 0, false, fsaa);
-        Ogre::TextureManager::getSingleton ().createManual ("Reflection",
-            Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_2D, res / 2, res / 2, 0,
-            Ogre::PF_R8G8B8, Ogre::TU_RENDERTARGET, 0, false, fsaa);
-
-        if (!App::diag_warning_texture->getBool())
+        startup.AddTask("resources_dir", TaskThread::MAIN, {}, []()
+            {
+                // Find resources dir, update cvar 'sys_resources_dir'
+                return App::GetAppContext()->SetUpResourcesDir();
+            });
+        startup.AddTask("language_list", TaskThread::WORKER, {}, []()
+            {
+#ifndef NOLANG
+                App::GetLanguageEngine()->scanLanguages();
+#endif // NOLANG
+                return true;
+            });
+        if (load_modcache)
         {
-            // We overwrite the default warning texture (yellow stripes) with something unobtrusive
-            Ogre::uchar data[3] = {0};
-            Ogre::PixelBox pixels(1, 1, 1, Ogre::PF_BYTE_RGB, &data);
-            Ogre::TextureManager::getSingleton()._getWarningTexture()->getBuffer()->blitFromMemory(pixels);
+            startup.AddTask("modcache_prefetch", TaskThread::WORKER, {}, []()
+                {
+                    App::GetContentManager()->PrefetchModCache();
+                    return true;
+                });
         }
+        startup.AddTask("rendering", TaskThread::MAIN, {"resources_dir"}, []()
+            {
+                // Make sure config directory exists - to save 'ogre.cfg'
+                CreateFolder(App::sys_config_dir->getStr());
 
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::FLAGS);
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::FONTS);
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::ICONS);
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::OGRE_CORE);
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::WALLPAPERS);
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::SCRIPTS);
+                // Load and start OGRE renderer, uses config directory
+                if (!App::GetAppContext()->SetUpRendering())
+                {
+                    return false; // Error already displayed
+                }
 
+                Ogre::TextureManager::getSingleton().setDefaultNumMipmaps(5);
+                return true;
+            });
+        startup.AddTask("config_skeleton", TaskThread::MAIN, {"rendering"}, []()
+            {
+                // Deploy base config files from 'skeleton.zip'
+                return App::GetAppContext()->SetUpConfigSkeleton();
+            });
+        startup.AddTask("ground_models", TaskThread::WORKER, {"config_skeleton"}, []()
+            {
+                Collisions::PreloadDefaultModels();
+                return true;
+            });
+        startup.AddTask("skidmark_config", TaskThread::WORKER, {"config_skeleton"}, []()
+            {
+                App::GetGfxScene()->GetSkidmarkConf()->LoadDefaultSkidmarkDefs();
+                return true;
+            });
+        startup.AddTask("inertia_models", TaskThread::WORKER, {"config_skeleton"}, []()
+            {
+                App::GetGameContext()->GetActorManager()->GetInertiaConfig().LoadDefaultInertiaModels();
+                return true;
+            });
+        startup.AddTask("torque_models", TaskThread::WORKER, {"config_skeleton"}, []()
+            {
+                TorqueCurve::PreloadDefaultTorqueModels();
+                return true;
+            });
+        startup.AddTask("render_targets", TaskThread::MAIN, {"rendering"}, [&overlay_system]()
+            {
+                overlay_system = new Ogre::OverlaySystem(); //Overlay init
+
+                Ogre::ConfigOptionMap ropts = App::GetAppContext()->GetOgreRoot()->getRenderSystem()->getConfigOptions();
+                int resolution = Ogre::StringConverter::parseInt(Ogre::StringUtil::split(ropts["Video Mode"].currentValue, " x ")[0], 1024);
+                int fsaa = 2 * (Ogre::StringConverter::parseInt(ropts["FSAA"].currentValue, 0) / 4);
+                int res = std::pow(2, std::floor(std::log2(resolution)));
+
+                Ogre::TextureManager::getSingleton().createManual ("EnvironmentTexture",
+                    Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_CUBE_MAP, res / 4, res / 4, 0,
+                    Ogre::PF_R8G8B8, Ogre::TU_RENDERTARGET, 0, false, fsaa);
+                Ogre::TextureManager::getSingleton ().createManual ("Refraction",
+                    Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_2D, res / 2, res / 2, 0,
+                    Ogre::PF_R8G8B8, Ogre::TU_RENDERTARGET, 0, false, fsaa);
+                Ogre::TextureManager::getSingleton ().createManual ("Reflection",
+                    Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, Ogre::TEX_TYPE_2D, res / 2, res / 2, 0,
+                    Ogre::PF_R8G8B8, Ogre::TU_RENDERTARGET, 0, false, fsaa);
+
+                if (!App::diag_warning_texture->getBool())
+                {
+                    // We overwrite the default warning texture (yellow stripes) with something unobtrusive
+                    Ogre::uchar data[3] = {0};
+                    Ogre::PixelBox pixels(1, 1, 1, Ogre::PF_BYTE_RGB, &data);
+                    Ogre::TextureManager::getSingleton()._getWarningTexture()->getBuffer()->blitFromMemory(pixels);
+                }
+                return true;
+            });
+        startup.AddTask("resource_packs", TaskThread::MAIN, {"config_skeleton"}, []()
+            {
+                App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::FLAGS);
+                App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::FONTS);
+                App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::ICONS);
+                App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::OGRE_CORE);
+                App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::WALLPAPERS);
+                App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::SCRIPTS);
+                return true;
+            });
+        startup.AddTask("language", TaskThread::MAIN, {"language_list", "rendering"}, []()
+            {
 #ifndef NOLANG
-        App::GetLanguageEngine()->setup();
+                App::GetLanguageEngine()->loadActiveLanguage();
 #endif // NOLANG
-        App::GetConsole()->regBuiltinCommands(); // Call after localization had been set up
-
-        App::GetContentManager()->InitContentManager();
-
-        // Set up rendering
-        App::CreateGfxScene(); // Creates OGRE SceneManager, needs content manager
-        App::GetGfxScene()->GetSceneManager()->addRenderQueueListener(overlay_system);
-        App::CreateCameraManager(); // Creates OGRE Camera
-        App::GetGfxScene()->GetEnvMap().SetupEnvMap(); // Needs camera
-
-        App::CreateGuiManager(); // Needs scene manager
-
-        App::GetDiscordRpc()->Init();
-
-        App::GetAppContext()->SetUpInput();
-
+                App::GetConsole()->regBuiltinCommands(); // Call after localization had been set up
+                return true;
+            });
+        startup.AddTask("content_manager", TaskThread::MAIN, {"resource_packs", "language"}, []()
+            {
+                App::GetContentManager()->InitContentManager(); // Base soundscripts are parsed on workers, see "soundscripts"
+                return true;
+            });
+        startup.AddTask("scene", TaskThread::MAIN, {"content_manager", "render_targets"}, [&overlay_system]()
+            {
+                // Set up rendering
+                App::CreateGfxScene(); // Creates OGRE SceneManager, needs content manager
+                App::GetGfxScene()->GetSceneManager()->addRenderQueueListener(overlay_system);
+                App::CreateCameraManager(); // Creates OGRE Camera
+                App::GetGfxScene()->GetEnvMap().SetupEnvMap(); // Needs camera
+                return true;
+            });
+        startup.AddTask("gui", TaskThread::MAIN, {"scene"}, []()
+            {
+                App::CreateGuiManager(); // Needs scene manager
+                return true;
+            });
+        startup.AddTask("discord", TaskThread::MAIN, {}, []()
+            {
+                App::GetDiscordRpc()->Init();
+                return true;
+            });
+        // Reads the input map from RGN_CONFIG, which `InitContentManager()` creates
+        startup.AddTask("input", TaskThread::MAIN, {"rendering", "content_manager", "gui"}, []()
+            {
+                App::GetAppContext()->SetUpInput();
+                return true;
+            });
 #ifdef USE_ANGELSCRIPT
-        App::CreateScriptEngine();
+        startup.AddTask("script_engine", TaskThread::MAIN, {"content_manager"}, []()
+            {
+                App::CreateScriptEngine();
+                return true;
+            });
 #endif
+        startup.AddTask("menu_wallpaper", TaskThread::MAIN, {"gui"}, []()
+            {
+                App::GetGuiManager()->SetUpMenuWallpaper();
+                return true;
+            });
+        startup.AddTask("obsolete_conf_marker", TaskThread::MAIN, {"resources_dir"}, []()
+            {
+                // Add "this is obsolete" marker file to old config location
+                App::GetAppContext()->SetUpObsoleteConfMarker();
+                return true;
+            });
+#ifdef USE_OPENAL
+        startup.AddTask("soundscripts", TaskThread::MAIN, {"content_manager"}, []()
+            {
+                App::GetSoundScriptManager()->JoinPendingScripts();
+                return true;
+            });
+#endif // USE_OPENAL
 
-        App::GetGuiManager()->SetUpMenuWallpaper();
-
-        // Add "this is obsolete" marker file to old config location
-        App::GetAppContext()->SetUpObsoleteConfMarker();
-
-        App::CreateThreadPool();
-
-        // Load inertia config file
-        App::GetGameContext()->GetActorManager()->GetInertiaConfig().LoadDefaultInertiaModels();
+        if (!startup.Run())
+        {
+            return -1; // Error already displayed
+        }
 
         // Load mod cache
         if (App::app_force_cache_purge->getBool())
@@ -249,7 +345,7 @@ int main(int argc, char *argv[])
             App::mp_server_port->setVal(App::cli_server_port->getInt());
             App::GetGameContext()->PushMessage(Message(MSG_NET_CONNECT_REQUESTED));
         }
-        else if (App::mp_join_on_startup->getBool()) // Multiplayer, conf file
+        else if (App::mp_join_on_startup->getBool() && !App::GetPerfHarness()->IsActive()) // Multiplayer, conf file
         {
             App::GetGameContext()->PushMessage(Message(MSG_NET_CONNECT_REQUESTED));
         }
@@ -329,11 +425,14 @@ int main(int argc, char *argv[])
                 // -- Application events --
 
                 case MSG_APP_SHUTDOWN_REQUESTED:
-                    if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
+                    if (!App::GetPerfHarness()->IsActive()) // Perf. test overrides cvars (e.g. FPS limit) - keep user's config
                     {
-                        App::GetGameContext()->SaveScene("autosave.sav");
+                        if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
+                        {
+                            App::GetGameContext()->SaveScene("autosave.sav");
+                        }
+                        App::GetConsole()->saveConfig(); // RoR.cfg
                     }
-                    App::GetConsole()->saveConfig(); // RoR.cfg
                     App::GetDiscordRpc()->Shutdown();
 #ifdef USE_SOCKETW
                     if (App::mp_state->getEnum<MpState>() == MpState::CONNECTED)
@@ -569,6 +668,7 @@ int main(int argc, char *argv[])
                             App::GetGameContext()->PushMessage(Message(MSG_GUI_OPEN_MENU_REQUESTED));
                         }
                         App::GetGuiManager()->LoadingWindow.SetVisible(false);
+                        App::GetPerfHarness()->Abort(fmt::format("terrain '{}' failed to load", m.description));
                         failed_m = true;
                     }
                     break;
@@ -820,6 +920,8 @@ int main(int argc, char *argv[])
 
             } // Game events block
 
+            App::GetPerfHarness()->Update();
+
             // Check FPS limit
             if (App::gfx_fps_limit->getInt() > 0)
             {
@@ -1001,6 +1103,10 @@ int main(int argc, char *argv[])
             {
                 App::GetGameContext()->PushMessage(Message(MSG_APP_SHUTDOWN_REQUESTED));
             }
+            else if (App::GetPerfHarness()->IsActive() && App::app_state->getEnum<AppState>() == AppState::SIMULATION)
+            {
+                ImGui::EndFrame(); // Render-free perf. test - just close the GUI frame
+            }
             else
             {
                 App::GetAppContext()->GetOgreRoot()->renderOneFrame();
@@ -1019,16 +1125,19 @@ int main(int argc, char *argv[])
     catch (Ogre::Exception& e)
     {
         LOG(e.getFullDescription());
+        App::GetAsyncLogger()->Flush(); // Make sure the message is in RoR.log before blocking
         ErrorUtils::ShowError(_L("An exception has occured!"), e.getFullDescription());
     }
     catch (std::runtime_error& e)
     {
         LOG(e.what());
+        App::GetAsyncLogger()->Flush(); // Make sure the message is in RoR.log before blocking
         ErrorUtils::ShowError(_L("An exception (std::runtime_error) has occured!"), e.what());
     }
 #endif
 
-    return 0;
+    App::GetAsyncLogger()->Stop();
+    return App::GetPerfHarness()->GetExitCode();
 }
 
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
@@ -48,6 +48,7 @@
 #include "Console.h"
 #include "GfxActor.h"
 #include "InputEngine.h"
+#include "IntraCollisionPairs.h"
 #include "Language.h"
 #include "MeshObject.h"
 #include "MovableText.h"
@@ -77,6 +78,22 @@ using namespace RoR;
 
 static const Ogre::Vector3 BOUNDING_BOX_PADDING(0.05f, 0.05f, 0.05f);
 
+/// Actors which have ropables and at least one node within `radius` (per the scene node index), in actor-list order.
+static std::vector<Actor*> FindActorsWithRopablesNear(Ogre::Vector3 const& pos, float radius)
+{
+    std::vector<Actor*> result;
+    std::vector<NodeSpatialIndex::NodeRef> unused;
+    App::GetGameContext()->GetActorManager()->GetNodeIndex().QueryRadius(pos, radius, unused,
+        [&result](NodeSpatialIndex::NodeRef const& ref)
+        {
+            if (!ref.actor->ar_ropables.empty() && std::find(result.begin(), result.end(), ref.actor) == result.end())
+                result.push_back(ref.actor);
+            return false; // Only the actors matter
+        });
+    std::sort(result.begin(), result.end(), [](Actor* a, Actor* b) { return a->ar_vector_index < b->ar_vector_index; });
+    return result;
+}
+
 Actor::~Actor()
 {
     TRIGGER_EVENT(SE_GENERIC_DELETED_TRUCK, ar_instance_id);
@@ -113,9 +130,7 @@ Actor::~Actor()
         ar_autopilot = nullptr;
     }
 
-    if (m_fusealge_airfoil)
-        delete m_fusealge_airfoil;
-    m_fusealge_airfoil = 0;
+    m_fusealge_airfoil = nullptr;
 
     if (m_replay_handler)
         delete m_replay_handler;
@@ -254,6 +269,12 @@ Actor::~Actor()
         m_intra_point_col_detector = nullptr;
     }
 
+    if (m_intra_collision_pairs)
+    {
+        delete m_intra_collision_pairs;
+        m_intra_collision_pairs = nullptr;
+    }
+
     if (m_inter_point_col_detector)
     {
         delete m_inter_point_col_detector;
@@ -275,11 +296,7 @@ Actor::~Actor()
             delete m_wheel_diffs[i];
     }
 
-    delete ar_nodes;
-    delete ar_beams;
-    delete ar_shocks;
-    delete ar_rotators;
-    delete ar_wings;
+    // `ar_nodes`, `ar_beams` etc. live in `m_hot_arena`/`m_cold_arena`, released with the actor.
 }
 
 // This method scales actors. Stresses should *NOT* be scaled, they describe
@@ -707,6 +724,94 @@ void Actor::RecalculateNodeMasses(Real total)
         m_total_mass += ar_nodes[i].mass;
     }
     LOG("TOTAL VEHICLE MASS: " + TOSTRING((int)m_total_mass) +" kg");
+
+    this->UpdateSubstepLimit();
+}
+
+void Actor::UpdateSubstepLimit()
+{
+    m_substep_mult_max = 1;
+
+    if (ar_integrator == SimIntegrator::IMPLICIT_BEAMS)
+    {
+        // Each beam is solved as an isolated pair (see `CalcBeams()`), which caps its effective
+        // stiffness at about 1/(dt^2*w), but a node sums the pull of all its beams. The node update
+        // is stable while dt^2*K/m + 2*dt*D/m < 4, where K and D sum the effective stiffness and
+        // damping of the node's beams. We demand a 2x margin for wheels and ground contacts.
+        const float NODE_STABILITY_LIMIT = 2.0f;
+
+        int mult = PHYSICS_MAX_SUBSTEP_MULT;
+        while (mult > 1 && mult > App::sim_implicit_substep->getInt())
+        {
+            mult /= 2;
+        }
+        std::vector<float> node_k(ar_num_nodes), node_d(ar_num_nodes);
+        for (; mult > 1; mult /= 2)
+        {
+            const float dt = mult * PHYSICS_DT;
+            std::fill(node_k.begin(), node_k.end(), 0.0f);
+            std::fill(node_d.begin(), node_d.end(), 0.0f);
+            for (int i = 0; i < ar_num_beams; i++)
+            {
+                if (ar_beams[i].bm_disabled || ar_beams[i].bm_inter_actor)
+                    continue;
+                node_t* p1 = ar_beams[i].p1;
+                node_t* p2 = ar_beams[i].p2;
+                const float w = ((p1->nd_immovable || p1->mass <= 0.0f) ? 0.0f : 1.0f / p1->mass) +
+                                ((p2->nd_immovable || p2->mass <= 0.0f) ? 0.0f : 1.0f / p2->mass);
+                const float soften = 1.0f + dt * w * (ar_beams[i].d + dt * ar_beams[i].k);
+                node_k[p1->pos] += ar_beams[i].k / soften;
+                node_k[p2->pos] += ar_beams[i].k / soften;
+                node_d[p1->pos] += ar_beams[i].d / soften;
+                node_d[p2->pos] += ar_beams[i].d / soften;
+            }
+            bool stable = true;
+            for (int i = 0; i < ar_num_nodes && stable; i++)
+            {
+                if (ar_nodes[i].nd_immovable || ar_nodes[i].mass <= 0.0f)
+                    continue;
+                const float inv_mass = 1.0f / ar_nodes[i].mass;
+                stable = (dt * dt * node_k[i] * inv_mass + 2.0f * dt * node_d[i] * inv_mass) < NODE_STABILITY_LIMIT;
+            }
+            if (stable)
+            {
+                m_substep_mult_max = mult;
+                break;
+            }
+        }
+        if (m_substep_mult_max < App::sim_implicit_substep->getInt())
+        {
+            LOG("[RoR|Physics] Actor '" + ar_design_name + "' is too stiff for the implicit substep, stepping at "
+                + TOSTRING(m_substep_mult_max) + "x PHYSICS_DT");
+        }
+        return;
+    }
+
+    // An explicit spring-damper between 2 nodes is stable while dt^2*k*w + 2*dt*d*w < 4,
+    // where 'w' is the sum of the inverse node masses. We demand a 4x margin because
+    // wheels, progressive shocks and ground contacts add stiffness this doesn't see.
+    const float STABILITY_LIMIT = 1.0f;
+
+    for (int mult = PHYSICS_MAX_SUBSTEP_MULT; mult > 1; mult /= 2)
+    {
+        const float dt = mult * PHYSICS_DT;
+        bool stable = true;
+        for (int i = 0; i < ar_num_beams && stable; i++)
+        {
+            if (ar_beams[i].bm_disabled || ar_beams[i].bm_inter_actor)
+                continue;
+            node_t* p1 = ar_beams[i].p1;
+            node_t* p2 = ar_beams[i].p2;
+            const float w = ((p1->nd_immovable || p1->mass <= 0.0f) ? 0.0f : 1.0f / p1->mass) +
+                            ((p2->nd_immovable || p2->mass <= 0.0f) ? 0.0f : 1.0f / p2->mass);
+            stable = (dt * dt * ar_beams[i].k * w + 2.0f * dt * ar_beams[i].d * w) < STABILITY_LIMIT;
+        }
+        if (stable)
+        {
+            m_substep_mult_max = mult;
+            break;
+        }
+    }
 }
 
 float Actor::getTotalMass(bool withLocked)
@@ -1741,10 +1846,15 @@ void Actor::searchBeamDefaults()
     this->applyNodeBeamScales();
 
     m_ongoing_reset = false;
+    // Settle and measure at the step the actor will run at; implicit actors cover the same time in fewer steps
+    const int mult = (ar_integrator == SimIntegrator::IMPLICIT_BEAMS) ? m_substep_mult_max : 1;
+    const int skip_steps = (ar_nb_skip_steps + mult - 1) / mult;
+    const int measure_steps = (ar_nb_measure_steps + mult - 1) / mult;
+    m_physics_dt = PHYSICS_DT * mult;
     this->CalcForcesEulerPrepare(true);
-    for (int i = 0; i < ar_nb_skip_steps; i++)
+    for (int i = 0; i < skip_steps; i++)
     {
-        this->CalcForcesEulerCompute(i == 0, ar_nb_skip_steps);
+        this->CalcForcesEulerCompute(i == 0, skip_steps);
         if (m_ongoing_reset)
             break;
     }
@@ -1757,22 +1867,22 @@ void Actor::searchBeamDefaults()
     float sum_stress = 0.0f;
     float stress = 0.0f;
     int sum_broken = 0;
-    for (int k = 0; k < ar_nb_measure_steps; k++)
+    for (int k = 0; k < measure_steps; k++)
     {
-        this->CalcForcesEulerCompute(false, ar_nb_measure_steps);
+        this->CalcForcesEulerCompute(false, measure_steps);
         for (int i = 0; i < ar_num_nodes; i++)
         {
             float v = ar_nodes[i].Velocity.length();
-            sum_movement += v / (float)ar_nb_measure_steps;
+            sum_movement += v / (float)measure_steps;
             movement = std::max(movement, v);
         }
         for (int i = 0; i < ar_num_beams; i++)
         {
             Vector3 dis = (ar_beams[i].p1->RelPosition - ar_beams[i].p2->RelPosition).normalisedCopy();
             float v = (ar_beams[i].p1->Velocity - ar_beams[i].p2->Velocity).dotProduct(dis);
-            sum_velocity += std::abs(v) / (float)ar_nb_measure_steps;
+            sum_velocity += std::abs(v) / (float)measure_steps;
             velocity = std::max(velocity, std::abs(v));
-            sum_stress += std::abs(ar_beams[i].stress) / (float)ar_nb_measure_steps;
+            sum_stress += std::abs(ar_beams[i].stress) / (float)measure_steps;
             stress = std::max(stress, std::abs(ar_beams[i].stress));
             if (k == 0 && ar_beams[i].bm_broken)
             {
@@ -2104,14 +2214,14 @@ void Actor::CalcAnimators(hydrobeam_t const& hydrobeam, float &cstate, int &div)
         if (ar_anim_shift_timer > 0.0f)
         {
             cstate = 1.0f;
-            ar_anim_shift_timer -= PHYSICS_DT;
+            ar_anim_shift_timer -= m_physics_dt;
             if (ar_anim_shift_timer < 0.0f)
                 ar_anim_shift_timer = 0.0f;
         }
         if (ar_anim_shift_timer < 0.0f)
         {
             cstate = -1.0f;
-            ar_anim_shift_timer += PHYSICS_DT;
+            ar_anim_shift_timer += m_physics_dt;
             if (ar_anim_shift_timer > 0.0f)
                 ar_anim_shift_timer = 0.0f;
         }
@@ -2404,9 +2514,9 @@ void Actor::CalcCabCollisions()
     }
     if (m_intra_point_col_detector != nullptr)
     {
-        m_intra_point_col_detector->UpdateIntraPoint();
-        ResolveIntraActorCollisions(PHYSICS_DT,
-            *m_intra_point_col_detector,
+        m_intra_collision_pairs->Update(this, *m_intra_point_col_detector);
+        ResolveIntraActorCollisions(m_physics_dt,
+            *m_intra_collision_pairs,
             ar_num_collcabs,
             ar_collcabs,
             ar_cabs,
@@ -2564,7 +2674,7 @@ void Actor::CalcTriggers(int i, Real difftoBeamL, bool trigger_hooks)
 {
     if ((ar_beams[i].shock->flags & SHOCK_FLAG_ISTRIGGER) && ar_beams[i].shock->trigger_enabled) // this is a trigger and its enabled
     {
-        const float dt = PHYSICS_DT;
+        const float dt = m_physics_dt;
 
         if (difftoBeamL > ar_beams[i].longbound * ar_beams[i].L || difftoBeamL < -ar_beams[i].shortbound * ar_beams[i].L) // that has hit boundary
         {
@@ -3338,8 +3448,8 @@ void Actor::tieToggle(int group)
                 node_t* nearest_node = 0;
                 Actor* nearest_actor = 0;
                 ropable_t* locktedto = 0;
-                // iterate over all actors
-                for (auto actor : App::GetGameContext()->GetActorManager()->GetActors())
+                // iterate over all actors in reach
+                for (auto actor : FindActorsWithRopablesNear(it->ti_beam->p1->AbsPosition, mindist))
                 {
                     if (actor->ar_state == ActorState::LOCAL_SLEEPING ||
                         (actor == this && it->ti_no_self_lock))
@@ -3467,8 +3577,8 @@ void Actor::ropeToggle(int group)
             float mindist = it->rp_beam->L;
             Actor* nearest_actor = nullptr;
             ropable_t* rop = 0;
-            // iterate over all actor_slots
-            for (auto actor : App::GetGameContext()->GetActorManager()->GetActors())
+            // iterate over all actors in reach
+            for (auto actor : FindActorsWithRopablesNear(it->rp_beam->p1->AbsPosition, mindist))
             {
                 if (actor->ar_state == ActorState::LOCAL_SLEEPING)
                     continue;
@@ -4324,6 +4434,7 @@ Actor::Actor(
     , ar_nb_wheels_d_interval(std::make_pair(1.0f, 1.0f))
     , m_inter_point_col_detector(nullptr)
     , m_intra_point_col_detector(nullptr)
+    , m_intra_collision_pairs(nullptr)
     , ar_net_last_update_time(0)
     , m_avg_node_position_prev(rq.asr_position)
     , ar_left_mirror_angle(0.52)
@@ -4371,6 +4482,7 @@ Actor::Actor(
     , m_skid_trails{} // Init array to nullptr
     , ar_collision_range(DEFAULT_COLLISION_RANGE)
     , ar_instance_id(actor_id)
+    , ar_rand_seed(static_cast<uint32_t>(actor_id) * 2u + 1u) // Odd, thus never degenerates to zero
     , ar_vector_index(vector_index)
     , ar_rescuer_flag(false)
     , m_antilockbrake(false)
@@ -4388,7 +4500,7 @@ Actor::Actor(
     , ar_num_camera_rails(0)
     , ar_aeroengines() // Zero-init array
     , ar_num_aeroengines() // Zero-init
-    , ar_wheels() // array
+    , ar_wheels(nullptr)
     , ar_num_wheels() // int
     , m_avg_proped_wheel_radius(0.2f)
     , ar_filename(rq.asr_filename)
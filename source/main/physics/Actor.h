@@ -22,9 +22,11 @@
 #pragma once
 
 #include "Application.h"
+#include "ActorPerfStats.h"
 #include "CmdKeyInertia.h"
 #include "Differentials.h"
 #include "GfxActor.h"
+#include "LinearArena.h"
 #include "PerVehicleCameraContext.h"
 #include "RigDef_Prerequisites.h"
 #include "RoRnet.h"
@@ -95,6 +97,7 @@ public:
     void              updateSlideNodeForces(const Ogre::Real delta_time_sec); //!< calculate and apply Corrective forces
     void              resetSlideNodePositions();           //!< Recalculate SlideNode positions
     void              resetSlideNodes();                   //!< Reset all the SlideNodes
+    float             IntegrateNodes(float dt, float gravity); //!< Integration + air drag pass of `CalcNodes()`, no terrain access; returns max. node speed
     /// @}
 
     /// @name Physics editing
@@ -237,6 +240,14 @@ public:
     Ogre::Real        getMinimalCameraRadius();
     float             GetFFbHydroForces() const         { return m_force_sensors.out_hydros_forces; }
     bool              isBeingReset() const              { return m_ongoing_reset; };
+    SimIntegrator     getIntegrator() const             { return ar_integrator; }
+    void              setIntegrator(SimIntegrator value) { ar_integrator = value; this->UpdateSubstepLimit(); }
+    float             getPhysicsDt() const              { return m_physics_dt; }
+    int               getSubstepMultiplier() const      { return m_substep_mult; }
+    float             getPhysicsCostMs() const          { return ar_perf_stats.last_ms_per_sec[ActorPerfStats::PHYSICS]; }   //!< CPU ms per second of wall time, see `ActorPerfStats`
+    float             getCollisionCostMs() const        { return ar_perf_stats.last_ms_per_sec[ActorPerfStats::COLLISION]; } //!< CPU ms per second of wall time, see `ActorPerfStats`
+    float             getFlexbodyCostMs() const         { return ar_perf_stats.last_ms_per_sec[ActorPerfStats::FLEXBODY]; }  //!< CPU ms per second of wall time, see `ActorPerfStats`
+    float             getWorstFrameCostMs() const       { return ar_perf_stats.last_worst_frame_ms; }
     void              UpdatePropAnimInputEvents();
 #ifdef USE_ANGELSCRIPT
     // we have to add this to be able to use the class as reference inside scripts
@@ -287,7 +298,7 @@ public:
     std::vector<Ogre::AxisAlignedBox>  ar_predicted_coll_bounding_boxes;
     int               ar_num_contactable_nodes; //!< Total number of nodes which can contact ground or cabs
     int               ar_num_contacters; //!< Total number of nodes which can selfcontact cabs
-    wheel_t           ar_wheels[MAX_WHEELS];
+    wheel_t*          ar_wheels;                //!< Carved from `m_hot_arena`, see `ActorSpawner::InitializeRig()`
     int               ar_num_wheels;
     command_t         ar_command_key[MAX_COMMANDS + 10]; // 0 for safety
     cparticle_t       ar_custom_particles[MAX_CPARTICLES];
@@ -342,6 +353,7 @@ public:
     NodeNum_t         ar_exhaust_pos_node   = 0;   //!< Old-format exhaust (one per vehicle) emitter node
     NodeNum_t         ar_exhaust_dir_node   = 0;   //!< Old-format exhaust (one per vehicle) backwards direction node
     int               ar_instance_id;              //!< Static attr; session-unique ID
+    uint32_t          ar_rand_seed;                //!< Sim state; physics noise (turbulence, antilag) - per actor so that parallel actors are reproducible
     unsigned int      ar_vector_index;             //!< Sim attr; actor element index in std::vector<m_actors>
     ActorType         ar_driveable;                //!< Sim attr; marks vehicle type and features
     EngineSim*        ar_engine;
@@ -401,9 +413,11 @@ public:
     float             ar_collision_range;             //!< Physics attr
     float             ar_top_speed;                   //!< Sim state
     ground_model_t*   ar_last_fuzzy_ground_model;     //!< GUI state
+    ActorPerfStats    ar_perf_stats;                  //!< Diagnostics; CPU time spent on this actor
 
     // Gameplay state
     ActorState        ar_state;
+    SimIntegrator     ar_integrator;                  //!< Physics attr; snapshot of cvar 'sim_integrator' on spawn
 
     // Realtime node/beam structure editing helpers
     bool                    ar_nb_initialized;
@@ -467,6 +481,7 @@ private:
 
     void              DetermineLinkedActors();
     void              RecalculateNodeMasses(Ogre::Real total); //!< Previously 'calc_masses2()'
+    void              UpdateSubstepLimit();                //!< Stiffness analysis for adaptive/implicit substepping; needs node masses
     void              calcNodeConnectivityGraph();
     void              AddInterActorBeam(beam_t* beam, Actor* a, Actor* b);
     void              RemoveInterActorBeam(beam_t* beam);
@@ -485,6 +500,8 @@ private:
 
     // -------------------- data -------------------- //
 
+    LinearArena                        m_hot_arena;        //!< Physics; backs all arrays touched every substep (nodes, beams, shocks...)
+    LinearArena                        m_cold_arena;       //!< Backs names and other diagnostic data
     std::vector<std::shared_ptr<Task>> m_flexbody_tasks;   //!< Gfx state
     RigDef::DocumentPtr      m_definition;
     std::unique_ptr<GfxActor>          m_gfx_actor;
@@ -500,6 +517,8 @@ private:
     float             m_avionic_chatter_timer;      //!< Sound fx state
     PointColDetector* m_inter_point_col_detector;   //!< Physics
     PointColDetector* m_intra_point_col_detector;   //!< Physics
+    IntraCollisionPairs* m_intra_collision_pairs;   //!< Physics; self-collision candidates, used with `m_intra_point_col_detector`
+    std::vector<Ogre::Vector3> m_turbulence;        //!< Physics; per-node air drag noise, drawn ahead of `IntegrateNodes()`'s loop
     std::vector<Actor*>  m_linked_actors;           //!< Sim state; other actors linked using 'hooks'
     Ogre::Vector3     m_avg_node_position;          //!< average node position
     Ogre::Real        m_min_camera_radius;
@@ -531,7 +550,11 @@ private:
     int               m_wheel_node_count;      //!< Static attr; filled at spawn
     int               m_previous_gear;         //!< Sim state; land vehicle shifting
     float             m_handbrake_force;       //!< Physics attr; defined in truckfile
-    Airfoil*          m_fusealge_airfoil;      //!< Physics attr; defined in truckfile
+    float             m_physics_dt;            //!< Physics state; length of this actor's substep (seconds)
+    int               m_substep_mult;          //!< Physics state; actor steps once per this many global substeps (1, 2 or 4)
+    int               m_substep_mult_max;      //!< Physics attr; stable limit of `m_substep_mult`, see `UpdateSubstepLimit()`
+    int               m_substep_calm_frames;   //!< Physics state; hysteresis before `m_substep_mult` may grow
+    std::shared_ptr<Airfoil> m_fusealge_airfoil; //!< Physics attr; defined in truckfile
     node_t*           m_fusealge_front;        //!< Physics attr; defined in truckfile
     node_t*           m_fusealge_back;         //!< Physics attr; defined in truckfile
     float             m_fusealge_width;        //!< Physics attr; defined in truckfile
@@ -37,11 +37,15 @@
 #include "ScrewProp.h"
 #include "SoundScriptManager.h"
 #include "Terrain.h"
+#include "ThreadPool.h"
 #include "Water.h"
 
 using namespace Ogre;
 using namespace RoR;
 
+static const int PARALLEL_WINGS_MIN   = 24; // Below this, task overhead outweighs the gain
+static const int PARALLEL_WINGS_CHUNK = 8;
+
 void Actor::CalcForcesEulerCompute(bool doUpdate, int num_steps)
 {
     this->CalcNodes(); // must be done directly after the inter truck collisions are handled
@@ -59,7 +63,7 @@ void Actor::CalcForcesEulerCompute(bool doUpdate, int num_steps)
     this->CalcMouse();
     this->CalcBeams(doUpdate);
     this->CalcCabCollisions();
-    this->updateSlideNodeForces(PHYSICS_DT); // must be done after the contacters are updated
+    this->updateSlideNodeForces(m_physics_dt); // must be done after the contacters are updated
     this->CalcForceFeedback(doUpdate);
 }
 
@@ -106,7 +110,7 @@ void Actor::CalcAircraftForces(bool doUpdate)
     //turboprop forces
     for (int i = 0; i < ar_num_aeroengines; i++)
         if (ar_aeroengines[i])
-            ar_aeroengines[i]->updateForces(PHYSICS_DT, doUpdate);
+            ar_aeroengines[i]->updateForces(m_physics_dt, doUpdate);
 
     //screwprop forces
     for (int i = 0; i < ar_num_screwprops; i++)
@@ -114,9 +118,25 @@ void Actor::CalcAircraftForces(bool doUpdate)
             ar_screwprops[i]->updateForces(doUpdate);
 
     //wing forces
-    for (int i = 0; i < ar_num_wings; i++)
-        if (ar_wings[i].fa)
-            ar_wings[i].fa->updateForces();
+    if (ar_num_wings >= PARALLEL_WINGS_MIN)
+    {
+        // Big aircraft: evaluate wings in parallel, then add the forces to the (shared) nodes serially
+        App::GetThreadPool()->ParallelFor(ar_num_wings, PARALLEL_WINGS_CHUNK, [this](int begin, int end)
+            {
+                for (int i = begin; i < end; i++)
+                    if (ar_wings[i].fa)
+                        ar_wings[i].fa->calcForces();
+            });
+        for (int i = 0; i < ar_num_wings; i++)
+            if (ar_wings[i].fa)
+                ar_wings[i].fa->applyForces();
+    }
+    else
+    {
+        for (int i = 0; i < ar_num_wings; i++)
+            if (ar_wings[i].fa)
+                ar_wings[i].fa->updateForces();
+    }
 }
 
 void Actor::CalcFuseDrag()
@@ -149,11 +169,7 @@ void Actor::CalcBuoyance(bool doUpdate)
 {
     if (ar_num_buoycabs && App::GetGameContext()->GetTerrain()->getWater())
     {
-        for (int i = 0; i < ar_num_buoycabs; i++)
-        {
-            int tmpv = ar_buoycabs[i] * 3;
-            m_buoyance->computeNodeForce(&ar_nodes[ar_cabs[tmpv]], &ar_nodes[ar_cabs[tmpv + 1]], &ar_nodes[ar_cabs[tmpv + 2]], doUpdate == 1, ar_buoycab_types[i]);
-        }
+        m_buoyance->computeCabForces(ar_nodes, ar_cabs, ar_buoycabs, ar_buoycab_types, ar_num_buoycabs, doUpdate);
     }
 }
 
@@ -218,7 +234,7 @@ void Actor::CalcDifferentials()
             {axle_torques[0], axle_torques[1]},
             ar_wheels[m_wheel_diffs[a_1]->di_idx_1].wh_torque + ar_wheels[m_wheel_diffs[a_1]->di_idx_2].wh_torque +
             ar_wheels[m_wheel_diffs[a_2]->di_idx_1].wh_torque + ar_wheels[m_wheel_diffs[a_2]->di_idx_2].wh_torque,
-            PHYSICS_DT
+            m_physics_dt
         };
 
         m_axle_diffs[i]->CalcAxleTorque(diff_data);
@@ -244,7 +260,7 @@ void Actor::CalcDifferentials()
             m_wheel_diffs[i]->di_delta_rotation,
             {axle_torques[0], axle_torques[1]},
             axle_wheels[0]->wh_torque + axle_wheels[1]->wh_torque,
-            PHYSICS_DT
+            m_physics_dt
         };
 
         m_wheel_diffs[i]->CalcAxleTorque(diff_data);
@@ -259,8 +275,8 @@ void Actor::CalcDifferentials()
 void Actor::CalcWheels(bool doUpdate, int num_steps)
 {
     // driving aids traction control & anti-lock brake pulse
-    tc_timer += PHYSICS_DT;
-    alb_timer += PHYSICS_DT;
+    tc_timer += m_physics_dt;
+    alb_timer += m_physics_dt;
 
     if (alb_timer >= alb_pulse_time)
     {
@@ -352,7 +368,7 @@ void Actor::CalcWheels(bool doUpdate, int num_steps)
                     m_antilockbrake = true;
                 }
 
-                float force = -ar_wheels[i].wh_avg_speed * ar_wheels[i].wh_radius * ar_wheels[i].wh_mass / PHYSICS_DT;
+                float force = -ar_wheels[i].wh_avg_speed * ar_wheels[i].wh_radius * ar_wheels[i].wh_mass / m_physics_dt;
                 force -= ar_wheels[i].wh_last_retorque;
 
                 if (ar_wheels[i].wh_speed > 0)
@@ -417,7 +433,7 @@ void Actor::CalcWheels(bool doUpdate, int num_steps)
         }
 
         ar_wheels[i].wh_speed /= (Real)ar_wheels[i].wh_num_nodes;
-        ar_wheels[i].wh_net_rp += (ar_wheels[i].wh_speed / ar_wheels[i].wh_radius) * PHYSICS_DT;
+        ar_wheels[i].wh_net_rp += (ar_wheels[i].wh_speed / ar_wheels[i].wh_radius) * m_physics_dt;
         // We overestimate the average speed on purpose in order to improve the quality of the braking force estimate
         ar_wheels[i].wh_avg_speed = ar_wheels[i].wh_avg_speed * 0.99 + ar_wheels[i].wh_speed * 0.1;
         ar_wheels[i].debug_rpm += RAD_PER_SEC_TO_RPM * ar_wheels[i].wh_speed / ar_wheels[i].wh_radius / (float)num_steps;
@@ -428,8 +444,8 @@ void Actor::CalcWheels(bool doUpdate, int num_steps)
             ar_wheel_spin  += speedacc / ar_wheels[i].wh_radius; // Accumulate the average wheel spin  (radians)
         }
 
-        expected_wheel_speed += ((ar_wheels[i].wh_last_torque / ar_wheels[i].wh_radius) / ar_wheels[i].wh_mass) * PHYSICS_DT;
-        ar_wheels[i].wh_last_retorque = ar_wheels[i].wh_mass * (ar_wheels[i].wh_speed - expected_wheel_speed) / PHYSICS_DT;
+        expected_wheel_speed += ((ar_wheels[i].wh_last_torque / ar_wheels[i].wh_radius) / ar_wheels[i].wh_mass) * m_physics_dt;
+        ar_wheels[i].wh_last_retorque = ar_wheels[i].wh_mass * (ar_wheels[i].wh_speed - expected_wheel_speed) / m_physics_dt;
 
         // reaction torque
         Vector3 rradius = ar_wheels[i].wh_arm_node->RelPosition - ar_wheels[i].wh_near_attach_node->RelPosition;
@@ -480,7 +496,7 @@ void Actor::CalcWheels(bool doUpdate, int num_steps)
     }
 
     // calculate driven distance
-    float distance_driven = fabs(ar_wheel_speed * PHYSICS_DT);
+    float distance_driven = fabs(ar_wheel_speed * m_physics_dt);
     m_odometer_total += distance_driven;
     m_odometer_user += distance_driven;
 }
@@ -491,7 +507,7 @@ void Actor::CalcShocks(bool doUpdate, int num_steps)
     if (this->ar_has_active_shocks && m_stabilizer_shock_request)
     {
         if ((m_stabilizer_shock_request == 1 && m_stabilizer_shock_ratio < 0.1) || (m_stabilizer_shock_request == -1 && m_stabilizer_shock_ratio > -0.1))
-            m_stabilizer_shock_ratio = m_stabilizer_shock_ratio + (float)m_stabilizer_shock_request * PHYSICS_DT * STAB_RATE;
+            m_stabilizer_shock_ratio = m_stabilizer_shock_ratio + (float)m_stabilizer_shock_request * m_physics_dt * STAB_RATE;
         for (int i = 0; i < ar_num_shocks; i++)
         {
             // active shocks now
@@ -504,7 +520,7 @@ void Actor::CalcShocks(bool doUpdate, int num_steps)
     //auto shock adjust
     if (this->ar_has_active_shocks && doUpdate)
     {
-        m_stabilizer_shock_sleep -= PHYSICS_DT * num_steps;
+        m_stabilizer_shock_sleep -= m_physics_dt * num_steps;
 
         float roll = asin(GetCameraRoll().dotProduct(Vector3::UNIT_Y));
         //mWindow->setDebugText("Roll:"+ TOSTRING(roll));
@@ -552,7 +568,7 @@ void Actor::CalcHydros()
             float sensitivity = Math::Clamp(App::io_analog_sensitivity->getFloat(), 0.5f, 2.0f);
             float diff = ar_hydro_dir_command - ar_hydro_dir_state;
             float rate = std::exp(-std::min(std::abs(diff), 1.0f) / sensitivity) * diff;
-            ar_hydro_dir_state += (10.0f / smoothing) * PHYSICS_DT * rate;
+            ar_hydro_dir_state += (10.0f / smoothing) * m_physics_dt * rate;
         }
         else
         {
@@ -562,21 +578,21 @@ void Actor::CalcHydros()
                 {
                     float rate = std::max(1.2f, 30.0f / (10.0f));
                     if (ar_hydro_dir_state > ar_hydro_dir_command)
-                        ar_hydro_dir_state -= PHYSICS_DT * rate;
+                        ar_hydro_dir_state -= m_physics_dt * rate;
                     else
-                        ar_hydro_dir_state += PHYSICS_DT * rate;
+                        ar_hydro_dir_state += m_physics_dt * rate;
                 }
                 else
                 {
                     // minimum rate: 20% --> enables to steer high velocity vehicles
                     float rate = std::max(1.2f, 30.0f / (10.0f + std::abs(ar_wheel_speed / 2.0f)));
                     if (ar_hydro_dir_state > ar_hydro_dir_command)
-                        ar_hydro_dir_state -= PHYSICS_DT * rate;
+                        ar_hydro_dir_state -= m_physics_dt * rate;
                     else
-                        ar_hydro_dir_state += PHYSICS_DT * rate;
+                        ar_hydro_dir_state += m_physics_dt * rate;
                 }
             }
-            float dirdelta = PHYSICS_DT;
+            float dirdelta = m_physics_dt;
             if (ar_hydro_dir_state > dirdelta)
                 ar_hydro_dir_state -= dirdelta;
             else if (ar_hydro_dir_state < -dirdelta)
@@ -591,11 +607,11 @@ void Actor::CalcHydros()
         if (ar_hydro_aileron_command != 0)
         {
             if (ar_hydro_aileron_state > ar_hydro_aileron_command)
-                ar_hydro_aileron_state -= PHYSICS_DT * 4.0;
+                ar_hydro_aileron_state -= m_physics_dt * 4.0;
             else
-                ar_hydro_aileron_state += PHYSICS_DT * 4.0;
+                ar_hydro_aileron_state += m_physics_dt * 4.0;
         }
-        float delta = PHYSICS_DT;
+        float delta = m_physics_dt;
         if (ar_hydro_aileron_state > delta)
             ar_hydro_aileron_state -= delta;
         else if (ar_hydro_aileron_state < -delta)
@@ -609,12 +625,12 @@ void Actor::CalcHydros()
         if (ar_hydro_rudder_command != 0)
         {
             if (ar_hydro_rudder_state > ar_hydro_rudder_command)
-                ar_hydro_rudder_state -= PHYSICS_DT * 4.0;
+                ar_hydro_rudder_state -= m_physics_dt * 4.0;
             else
-                ar_hydro_rudder_state += PHYSICS_DT * 4.0;
+                ar_hydro_rudder_state += m_physics_dt * 4.0;
         }
 
-        float delta = PHYSICS_DT;
+        float delta = m_physics_dt;
         if (ar_hydro_rudder_state > delta)
             ar_hydro_rudder_state -= delta;
         else if (ar_hydro_rudder_state < -delta)
@@ -628,11 +644,11 @@ void Actor::CalcHydros()
         if (ar_hydro_elevator_command != 0)
         {
             if (ar_hydro_elevator_state > ar_hydro_elevator_command)
-                ar_hydro_elevator_state -= PHYSICS_DT * 4.0;
+                ar_hydro_elevator_state -= m_physics_dt * 4.0;
             else
-                ar_hydro_elevator_state += PHYSICS_DT * 4.0;
+                ar_hydro_elevator_state += m_physics_dt * 4.0;
         }
-        float delta = PHYSICS_DT;
+        float delta = m_physics_dt;
         if (ar_hydro_elevator_state > delta)
             ar_hydro_elevator_state -= delta;
         else if (ar_hydro_elevator_state < -delta)
@@ -710,7 +726,7 @@ void Actor::CalcHydros()
         {
             cstate /= (float)div;
 
-            cstate = hydrobeam.hb_inertia.CalcCmdKeyDelay(cstate, PHYSICS_DT);
+            cstate = hydrobeam.hb_inertia.CalcCmdKeyDelay(cstate, m_physics_dt);
 
             if (!(hydrobeam.hb_flags & HYDRO_FLAG_SPEED) && !hydrobeam.hb_anim_flags)
                 ar_hydro_dir_wheel_display = cstate;
@@ -888,7 +904,7 @@ void Actor::CalcCommands(bool doUpdate)
                             }
                         }
 
-                        v = ar_command_key[i].command_inertia.CalcCmdKeyDelay(v, PHYSICS_DT);
+                        v = ar_command_key[i].command_inertia.CalcCmdKeyDelay(v, m_physics_dt);
 
                         if (bbeam_dir * cmd_beam.cmb_state->auto_moving_mode > 0)
                             v = 1;
@@ -929,9 +945,9 @@ void Actor::CalcCommands(bool doUpdate)
                             cf = crankfactor;
 
                         if (bbeam_dir > 0)
-                            ar_beams[bbeam].L *= (1.0 + cmd_beam.cmb_speed * v * cf * PHYSICS_DT / ar_beams[bbeam].L);
+                            ar_beams[bbeam].L *= (1.0 + cmd_beam.cmb_speed * v * cf * m_physics_dt / ar_beams[bbeam].L);
                         else
-                            ar_beams[bbeam].L *= (1.0 - cmd_beam.cmb_speed * v * cf * PHYSICS_DT / ar_beams[bbeam].L);
+                            ar_beams[bbeam].L *= (1.0 - cmd_beam.cmb_speed * v * cf * m_physics_dt / ar_beams[bbeam].L);
 
                         dl = fabs(dl - ar_beams[bbeam].L);
                         if (requestpower)
@@ -956,7 +972,7 @@ void Actor::CalcCommands(bool doUpdate)
                 if (ar_rotators[rota].needs_engine && ((ar_engine && !ar_engine->IsRunning()) || !ar_engine_hydraulics_ready))
                     continue;
 
-                v = ar_command_key[i].rotator_inertia.CalcCmdKeyDelay(ar_command_key[i].commandValue, PHYSICS_DT);
+                v = ar_command_key[i].rotator_inertia.CalcCmdKeyDelay(ar_command_key[i].commandValue, m_physics_dt);
 
                 if (v > 0.0f && ar_rotators[rota].engine_coupling > 0.0f)
                     requestpower = true;
@@ -967,9 +983,9 @@ void Actor::CalcCommands(bool doUpdate)
                     cf = crankfactor;
 
                 if (ar_command_key[i].rotators[j] > 0)
-                    ar_rotators[rota].angle += ar_rotators[rota].rate * v * cf * PHYSICS_DT;
+                    ar_rotators[rota].angle += ar_rotators[rota].rate * v * cf * m_physics_dt;
                 else
-                    ar_rotators[rota].angle -= ar_rotators[rota].rate * v * cf * PHYSICS_DT;
+                    ar_rotators[rota].angle -= ar_rotators[rota].rate * v * cf * m_physics_dt;
 
                 if (doUpdate || v != 0.0f)
                 {
@@ -1062,7 +1078,7 @@ void Actor::CalcTies()
         float clen = it->ti_beam->L / it->ti_beam->refL;
         if (clen > it->ti_min_length)
         {
-            it->ti_beam->L *= (1.0 - it->ti_contract_speed * PHYSICS_DT / it->ti_beam->L);
+            it->ti_beam->L *= (1.0 - it->ti_contract_speed * m_physics_dt / it->ti_beam->L);
         }
         else
         {
@@ -1081,7 +1097,7 @@ void Actor::CalcTruckEngine(bool doUpdate)
 {
     if (ar_engine)
     {
-        ar_engine->UpdateEngineSim(PHYSICS_DT, doUpdate);
+        ar_engine->UpdateEngineSim(m_physics_dt, doUpdate);
     }
 }
 
@@ -1129,6 +1145,9 @@ void LogBeamNodes(RoR::Str<L>& msg, beam_t& beam) // Internal helper
 
 void Actor::CalcBeams(bool trigger_hooks)
 {
+    const bool implicit_beams = (ar_integrator == SimIntegrator::IMPLICIT_BEAMS);
+    const float dt = m_physics_dt;
+
     for (int i = 0; i < ar_num_beams; i++)
     {
         if (!ar_beams[i].bm_disabled && !ar_beams[i].bm_inter_actor)
@@ -1377,6 +1396,17 @@ void Actor::CalcBeams(bool trigger_hooks)
                 }
             }
 
+            if (implicit_beams && slen != 0.0f)
+            {
+                // Backward Euler along the beam axis, treating the 2 nodes as an isolated pair:
+                //   F' = -k*(x + dt*v') - d*v',  v' = v + dt*w*F'  (w = inverse reduced mass)
+                // Stress and deformation above still use the explicit force, the reference for material limits.
+                const node_t* n1 = ar_beams[i].p1;
+                const node_t* n2 = ar_beams[i].p2;
+                const float w = (n1->nd_immovable ? 0.0f : 1.0f / n1->mass) + (n2->nd_immovable ? 0.0f : 1.0f / n2->mass);
+                slen = (slen - dt * k * v) / (1.0f + dt * w * (d + dt * k));
+            }
+
             // At last update the beam forces
             Vector3 f = dis;
             f *= (slen * inverted_dislen);
@@ -1523,16 +1553,17 @@ void Actor::CalcNodes()
 {
     const auto water = App::GetGameContext()->GetTerrain()->getWater();
     const float gravity = App::GetGameContext()->GetTerrain()->getGravity();
+    const float dt = m_physics_dt;
     m_water_contact = false;
 
+    // COLLISION - calls into the terrain, done first for all nodes
     for (NodeNum_t i = 0; i < ar_num_nodes; i++)
     {
-        // COLLISION
         if (!ar_nodes[i].nd_no_ground_contact)
         {
             Vector3 oripos = ar_nodes[i].AbsPosition;
-            bool contacted = App::GetGameContext()->GetTerrain()->GetCollisions()->groundCollision(&ar_nodes[i], PHYSICS_DT);
-            contacted = contacted | App::GetGameContext()->GetTerrain()->GetCollisions()->nodeCollision(&ar_nodes[i], PHYSICS_DT, false);
+            bool contacted = App::GetGameContext()->GetTerrain()->GetCollisions()->groundCollision(&ar_nodes[i], dt);
+            contacted = contacted | App::GetGameContext()->GetTerrain()->GetCollisions()->nodeCollision(&ar_nodes[i], dt, false);
             ar_nodes[i].nd_has_ground_contact = contacted;
             if (ar_nodes[i].nd_has_ground_contact || ar_nodes[i].nd_has_mesh_contact)
             {
@@ -1549,52 +1580,26 @@ void Actor::CalcNodes()
             // record g forces on cameras
             m_camera_gforces_accu += ar_nodes[i].Forces / ar_nodes[i].mass;
             // trigger script callbacks
-            App::GetGameContext()->GetTerrain()->GetCollisions()->nodeCollision(&ar_nodes[i], PHYSICS_DT, true);
+            App::GetGameContext()->GetTerrain()->GetCollisions()->nodeCollision(&ar_nodes[i], dt, true, ar_instance_id);
         }
+    }
 
-        // integration
-        if (!ar_nodes[i].nd_immovable)
-        {
-            ar_nodes[i].Velocity += ar_nodes[i].Forces / ar_nodes[i].mass * PHYSICS_DT;
-            ar_nodes[i].RelPosition += ar_nodes[i].Velocity * PHYSICS_DT;
-            ar_nodes[i].AbsPosition = ar_origin;
-            ar_nodes[i].AbsPosition += ar_nodes[i].RelPosition;
-        }
-
-        // prepare next loop (optimisation)
-        // we start forces from zero
-        // start with gravity
-        ar_nodes[i].Forces = Vector3(0, ar_nodes[i].mass * gravity, 0);
-
-        Real approx_speed = approx_sqrt(ar_nodes[i].Velocity.squaredLength());
-
-        // anti-explsion guard (mach 20)
-        if (approx_speed > 6860 && !m_ongoing_reset)
-        {
-            ActorModifyRequest* rq = new ActorModifyRequest; // actor exploded, schedule reset
-            rq->amr_actor = this;
-            rq->amr_type = ActorModifyRequest::Type::RESET_ON_SPOT;
-            App::GetGameContext()->PushMessage(Message(MSG_SIM_MODIFY_ACTOR_REQUESTED, (void*)rq));
-            m_ongoing_reset = true;
-        }
+    const float max_speed = this->IntegrateNodes(dt, gravity);
 
-        if (m_fusealge_airfoil)
-        {
-            // aerodynamics on steroids!
-            ar_nodes[i].Forces += ar_fusedrag;
-        }
-        else if (!ar_disable_aerodyn_turbulent_drag)
-        {
-            // add viscous drag (turbulent model)
-            Real defdragxspeed = DEFAULT_DRAG * approx_speed;
-            Vector3 drag = -defdragxspeed * ar_nodes[i].Velocity;
-            // plus: turbulences
-            Real maxtur = defdragxspeed * approx_speed * 0.005f;
-            drag += maxtur * Vector3(frand_11(), frand_11(), frand_11());
-            ar_nodes[i].Forces += drag;
-        }
+    // anti-explsion guard (mach 20) - a single reset request for the whole actor
+    if (max_speed > 6860 && !m_ongoing_reset)
+    {
+        ActorModifyRequest* rq = new ActorModifyRequest; // actor exploded, schedule reset
+        rq->amr_actor = this;
+        rq->amr_type = ActorModifyRequest::Type::RESET_ON_SPOT;
+        App::GetGameContext()->PushMessage(Message(MSG_SIM_MODIFY_ACTOR_REQUESTED, (void*)rq));
+        m_ongoing_reset = true;
+    }
 
-        if (water)
+    // WATER - only where there is some
+    if (water)
+    {
+        for (NodeNum_t i = 0; i < ar_num_nodes; i++)
         {
             const bool is_under_water = water->IsUnderWater(ar_nodes[i].AbsPosition);
             if (is_under_water)
@@ -1603,6 +1608,7 @@ void Actor::CalcNodes()
                 if (ar_num_buoycabs == 0)
                 {
                     // water drag (turbulent)
+                    const Real approx_speed = approx_sqrt(ar_nodes[i].Velocity.squaredLength());
                     ar_nodes[i].Forces -= (DEFAULT_WATERDRAG * approx_speed) * ar_nodes[i].Velocity;
                     // basic buoyance
                     ar_nodes[i].Forces += ar_nodes[i].buoyancy * Vector3::UNIT_Y;
@@ -1620,13 +1626,71 @@ void Actor::CalcNodes()
     this->UpdateBoundingBoxes();
 }
 
+float Actor::IntegrateNodes(float dt, float gravity)
+{
+    // Independent nodes, no calls, no data-dependent branches; the drag model is loop-invariant.
+    const bool fuse_drag = (m_fusealge_airfoil != nullptr);
+    const bool turbulent_drag = !fuse_drag && !ar_disable_aerodyn_turbulent_drag;
+
+    // The noise is drawn ahead, in node order, so the loop below has no serial dependency
+    if (turbulent_drag)
+    {
+        m_turbulence.resize(ar_num_nodes);
+        for (NodeNum_t i = 0; i < ar_num_nodes; i++)
+        {
+            m_turbulence[i].x = frand_11(ar_rand_seed);
+            m_turbulence[i].y = frand_11(ar_rand_seed);
+            m_turbulence[i].z = frand_11(ar_rand_seed);
+        }
+    }
+
+    float max_speed = 0.0f;
+    for (NodeNum_t i = 0; i < ar_num_nodes; i++)
+    {
+        node_t& n = ar_nodes[i];
+
+        // Immovable nodes are masked by selects. They may have zero mass, so their acceleration is never
+        // calculated - scaling it by a zero timestep would still turn the velocity into NaN.
+        const Vector3 acceleration = n.nd_immovable ? Vector3::ZERO : (n.Forces / n.mass);
+        const float node_dt = n.nd_immovable ? 0.0f : dt;
+        n.Velocity += acceleration * dt;
+        n.RelPosition += n.Velocity * node_dt;
+        n.AbsPosition = n.nd_immovable ? n.AbsPosition : (ar_origin + n.RelPosition);
+
+        // prepare next loop (optimisation)
+        // we start forces from zero
+        // start with gravity
+        n.Forces = Vector3(0, n.mass * gravity, 0);
+
+        const Real approx_speed = approx_sqrt(n.Velocity.squaredLength());
+        max_speed = std::max(max_speed, approx_speed);
+
+        if (fuse_drag)
+        {
+            // aerodynamics on steroids!
+            n.Forces += ar_fusedrag;
+        }
+        else if (turbulent_drag)
+        {
+            // add viscous drag (turbulent model)
+            Real defdragxspeed = DEFAULT_DRAG * approx_speed;
+            Vector3 drag = -defdragxspeed * n.Velocity;
+            // plus: turbulences
+            Real maxtur = defdragxspeed * approx_speed * 0.005f;
+            drag += maxtur * m_turbulence[i];
+            n.Forces += drag;
+        }
+    }
+    return max_speed;
+}
+
 void Actor::CalcHooks()
 {
     //locks - this is not active in network mode
     for (std::vector<hook_t>::iterator it = ar_hooks.begin(); it != ar_hooks.end(); it++)
     {
         //we need to do this here to avoid countdown speedup by triggers
-        it->hk_timer = std::max(0.0f, it->hk_timer - PHYSICS_DT);
+        it->hk_timer = std::max(0.0f, it->hk_timer - m_physics_dt);
 
         if (it->hk_lock_node && it->hk_locked == PRELOCK)
         {
@@ -27,6 +27,7 @@
 
 #include "Application.h"
 #include "Actor.h"
+#include "AsyncLogger.h"
 #include "CacheSystem.h"
 #include "ContentManager.h"
 #include "ChatSystem.h"
@@ -34,6 +35,7 @@
 #include "DashBoardManager.h"
 #include "DynamicCollisions.h"
 #include "EngineSim.h"
+#include "FlexMeshWheel.h"
 #include "GameContext.h"
 #include "GfxScene.h"
 #include "GUIManager.h"
@@ -43,6 +45,8 @@
 #include "Language.h"
 #include "MovableText.h"
 #include "Network.h"
+#include "PerfHarness.h"
+#include "PlatformUtils.h"
 #include "PointColDetector.h"
 #include "Replay.h"
 #include "RigDef_Validator.h"
@@ -54,6 +58,8 @@
 #include "Utils.h"
 #include "VehicleAI.h"
 
+#include <fmt/format.h>
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -255,14 +261,18 @@ Actor* ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr de
     {
         actor->GetGfxActor()->UpdateSimDataBuffer(); // Initial fill of sim data buffers
 
+        FlexMeshWheelBatch flexwheel_batch;
         actor->GetGfxActor()->UpdateFlexbodies(); // Push tasks to threadpool
-        actor->GetGfxActor()->UpdateWheelVisuals(); // Push tasks to threadpool
+        actor->GetGfxActor()->UpdateWheelVisuals(flexwheel_batch); // Push tasks to threadpool
+        flexwheel_batch.StartTask();
         actor->GetGfxActor()->UpdateCabMesh();
         actor->GetGfxActor()->UpdateWingMeshes();
         actor->GetGfxActor()->UpdateProps(0.f, false);
         actor->GetGfxActor()->UpdateRods(); // beam visuals
+        flexwheel_batch.FinishTask();
         actor->GetGfxActor()->FinishWheelUpdates(); // Sync tasks from threadpool
         actor->GetGfxActor()->FinishFlexbodyTasks(); // Sync tasks from threadpool
+        actor->GetGfxActor()->FinishCabMesh(); // Sync task from threadpool
     }
 
     App::GetGfxScene()->RegisterGfxActor(actor->GetGfxActor());
@@ -325,6 +335,7 @@ Actor* ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr de
     }
 
     m_actors.push_back(actor);
+    m_node_index.Rebuild(m_actors);
 
     return actor;
 }
@@ -371,12 +382,12 @@ void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_
                 RoRnet::UserInfo info;
                 if (!App::GetNetwork()->GetUserInfo(reg->origin_sourceid, info))
                 {
-                    RoR::LogFormat("[RoR] Invalid STREAM_REGISTER, user id %d does not exist", reg->origin_sourceid);
+                    LOG_RATE_LIMITED(1.f, "[RoR] Invalid STREAM_REGISTER, user id %d does not exist", reg->origin_sourceid);
                     reg->status = -1;
                 }
                 else if (filename.empty())
                 {
-                    RoR::LogFormat("[RoR] Invalid STREAM_REGISTER (user '%s', ID %d), filename is empty string", info.username, reg->origin_sourceid);
+                    LOG_RATE_LIMITED(1.f, "[RoR] Invalid STREAM_REGISTER (user '%s', ID %d), filename is empty string", info.username, reg->origin_sourceid);
                     reg->status = -1;
                 }
                 else
@@ -442,15 +453,15 @@ void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_
                     int sourceid = packet.header.source;
                     actor->ar_net_stream_results[sourceid] = reg->status;
 
-                    String message = "";
+                    const char* message = "";
                     switch (reg->status)
                     {
                         case  1: message = "successfully loaded stream"; break;
                         case -2: message = "detected mismatch stream"; break;
                         default: message = "could not load stream"; break;
                     }
-                    LOG("Client " + TOSTRING(sourceid) + " " + message + " " + TOSTRING(reg->origin_streamid) +
-                            " with name '" + reg->name + "', result code: " + TOSTRING(reg->status));
+                    LogFormat("Client %d %s %d with name '%s', result code: %d",
+                            sourceid, message, reg->origin_streamid, reg->name, reg->status);
                     break;
                 }
             }
@@ -615,27 +626,120 @@ bool ActorManager::PredictActorCollAabbIntersect(int a, int b)
     return false;
 }
 
-void ActorManager::RecursiveActivation(int j, std::vector<bool>& visited)
+void ActorManager::UpdateSleepBroadphase()
 {
-    if (visited[j] || m_actors[j]->ar_state != ActorState::LOCAL_SIMULATED)
-        return;
+    const int num_actors = static_cast<int>(m_actors.size());
 
-    visited[j] = true;
+    // The predicted box encloses the current box and all (predicted) collision boxes, so it bounds both narrow tests.
+    auto is_local = [this](int i)
+    {
+        return (m_actors[i]->ar_state == ActorState::LOCAL_SIMULATED || m_actors[i]->ar_state == ActorState::LOCAL_SLEEPING)
+            && !m_actors[i]->ar_predicted_bounding_box.isNull();
+    };
+    auto min_x = [this](int i) { return m_actors[i]->ar_predicted_bounding_box.getMinimum().x; };
 
-    for (unsigned int t = 0; t < m_actors.size(); t++)
+    // Sort-and-sweep along X. Actors barely move between frames, so the order from the last frame
+    // is almost sorted and insertion sort finishes in near-linear time.
+    if (static_cast<int>(m_sleep_sweep_order.size()) != num_actors)
     {
-        if (t == j || visited[t])
-            continue;
-        if (m_actors[t]->ar_state == ActorState::LOCAL_SIMULATED && CheckActorCollAabbIntersect(t, j))
+        m_sleep_sweep_order.resize(num_actors);
+        for (int i = 0; i < num_actors; i++)
+            m_sleep_sweep_order[i] = i;
+    }
+    m_sleep_sweep_active.clear();
+    for (int i : m_sleep_sweep_order)
+    {
+        if (is_local(i))
+            m_sleep_sweep_active.push_back(i);
+    }
+    for (size_t i = 1; i < m_sleep_sweep_active.size(); i++)
+    {
+        const int actor = m_sleep_sweep_active[i];
+        const float key = min_x(actor);
+        size_t j = i;
+        for (; j > 0 && min_x(m_sleep_sweep_active[j - 1]) > key; j--)
+            m_sleep_sweep_active[j] = m_sleep_sweep_active[j - 1];
+        m_sleep_sweep_active[j] = actor;
+    }
+    // Keep the sorted actors in front for next frame; the rest keep their relative order
+    std::copy(m_sleep_sweep_active.begin(), m_sleep_sweep_active.end(), m_sleep_sweep_order.begin());
+    size_t fill = m_sleep_sweep_active.size();
+    for (int i = 0; i < num_actors; i++)
+    {
+        if (!is_local(i))
+            m_sleep_sweep_order[fill++] = i;
+    }
+
+    // Sweep - collect overlapping pairs, counting neighbours per actor
+    m_sleep_pairs.clear();
+    m_sleep_adj_start.assign(num_actors + 1, 0);
+    for (size_t i = 0; i < m_sleep_sweep_active.size(); i++)
+    {
+        const int a = m_sleep_sweep_active[i];
+        const AxisAlignedBox& box_a = m_actors[a]->ar_predicted_bounding_box;
+        for (size_t j = i + 1; j < m_sleep_sweep_active.size(); j++)
         {
-            m_actors[t]->ar_sleep_counter = 0.0f;
-            this->RecursiveActivation(t, visited);
+            const int b = m_sleep_sweep_active[j];
+            const AxisAlignedBox& box_b = m_actors[b]->ar_predicted_bounding_box;
+            if (box_b.getMinimum().x > box_a.getMaximum().x)
+                break; // Sorted by min X - no further overlaps
+            if (box_a.intersects(box_b))
+            {
+                m_sleep_pairs.push_back(std::make_pair(a, b));
+                m_sleep_adj_start[a + 1]++;
+                m_sleep_adj_start[b + 1]++;
+            }
         }
-        if (m_actors[t]->ar_state == ActorState::LOCAL_SLEEPING && PredictActorCollAabbIntersect(t, j))
+    }
+
+    // Compressed adjacency lists
+    for (int i = 0; i < num_actors; i++)
+        m_sleep_adj_start[i + 1] += m_sleep_adj_start[i];
+    m_sleep_adj.resize(m_sleep_pairs.size() * 2);
+    m_sleep_adj_fill.assign(m_sleep_adj_start.begin(), m_sleep_adj_start.end() - 1);
+    for (auto const& pair : m_sleep_pairs)
+    {
+        m_sleep_adj[m_sleep_adj_fill[pair.first]++] = pair.second;
+        m_sleep_adj[m_sleep_adj_fill[pair.second]++] = pair.first;
+    }
+}
+
+void ActorManager::PropagateActivation(int seed)
+{
+    // Flood-fills the island of actors reachable from `seed`. Whether an actor is reachable
+    // depends only on its own state, which changes just once it's reached - so the island
+    // doesn't depend on traversal order and an explicit stack can replace recursion.
+    if (m_sleep_visited[seed] || m_actors[seed]->ar_state != ActorState::LOCAL_SIMULATED)
+        return;
+
+    m_sleep_visited[seed] = true;
+    m_sleep_stack.clear();
+    m_sleep_stack.push_back(seed);
+    while (!m_sleep_stack.empty())
+    {
+        const int j = m_sleep_stack.back();
+        m_sleep_stack.pop_back();
+
+        for (int k = m_sleep_adj_start[j]; k < m_sleep_adj_start[j + 1]; k++)
         {
-            m_actors[t]->ar_sleep_counter = 0.0f;
-            m_actors[t]->ar_state = ActorState::LOCAL_SIMULATED;
-            this->RecursiveActivation(t, visited);
+            const int t = m_sleep_adj[k];
+            if (m_sleep_visited[t])
+                continue;
+            if (m_actors[t]->ar_state == ActorState::LOCAL_SIMULATED && CheckActorCollAabbIntersect(t, j))
+            {
+                m_actors[t]->ar_sleep_counter = 0.0f;
+            }
+            else if (m_actors[t]->ar_state == ActorState::LOCAL_SLEEPING && PredictActorCollAabbIntersect(t, j))
+            {
+                m_actors[t]->ar_sleep_counter = 0.0f;
+                m_actors[t]->ar_state = ActorState::LOCAL_SIMULATED;
+            }
+            else
+            {
+                continue;
+            }
+            m_sleep_visited[t] = true;
+            m_sleep_stack.push_back(t);
         }
     }
 }
@@ -730,18 +834,19 @@ void ActorManager::UpdateSleepingState(Actor* player_actor, float dt)
         player_actor->ar_state = ActorState::LOCAL_SIMULATED;
     }
 
-    std::vector<bool> visited(m_actors.size());
-    // Recursivly activate all actors which can be reached from current actor
+    this->UpdateSleepBroadphase();
+    m_sleep_visited.assign(m_actors.size(), false);
+    // Activate all actors which can be reached from current actor
     if (player_actor && player_actor->ar_state == ActorState::LOCAL_SIMULATED)
     {
         player_actor->ar_sleep_counter = 0.0f;
-        this->RecursiveActivation(player_actor->ar_vector_index, visited);
+        this->PropagateActivation(player_actor->ar_vector_index);
     }
     // Snowball effect (activate all actors which might soon get hit by a moving actor)
     for (unsigned int t = 0; t < m_actors.size(); t++)
     {
         if (m_actors[t]->ar_state == ActorState::LOCAL_SIMULATED && m_actors[t]->ar_sleep_counter == 0.0f)
-            this->RecursiveActivation(t, visited);
+            this->PropagateActivation(t);
     }
 }
 
@@ -841,8 +946,12 @@ void ActorManager::CleanUpSimulation() // Called after simulation finishes
         delete actor;
     }
     m_actors.clear();
+    m_node_index.Clear();
 
     m_total_sim_time = 0.f;
+    m_physics_substeps.store(0, std::memory_order_relaxed);
+    m_state_checksum = 0;
+    m_checksum_substep = 0;
     m_last_simulation_speed = 0.1f;
     m_simulation_paused = false;
     m_simulation_speed = 1.f;
@@ -872,6 +981,7 @@ void ActorManager::DeleteActorInternal(Actor* actor)
 #endif // USE_SOCKETW
 
     m_actors.erase(std::remove(m_actors.begin(), m_actors.end(), actor), m_actors.end());
+    m_node_index.Rebuild(m_actors); // Drop dangling `NodeRef::actor` pointers
     delete actor;
 
     // Upate actor indices
@@ -963,6 +1073,10 @@ void ActorManager::UpdateActors(Actor* player_actor)
     // do not allow dt > 1/20
     dt = std::min(dt, 1.0f / 20.0f);
 
+    // lockstep: every frame advances the same amount of physics time, whatever the framerate
+    if (App::sim_deterministic->getBool())
+        dt = 1.0f / 60.0f;
+
     dt *= m_simulation_speed;
 
     dt += m_dt_remainder;
@@ -977,8 +1091,14 @@ void ActorManager::UpdateActors(Actor* player_actor)
 
     this->SyncWithSimThread();
 
+    this->UpdateActorPerfStats();
+
+    m_node_index.Rebuild(m_actors);
+
     this->UpdateSleepingState(player_actor, dt);
 
+    this->UpdateSubstepMultipliers();
+
     for (auto actor : m_actors)
     {
         actor->HandleInputEvents(dt);
@@ -1050,6 +1170,7 @@ void ActorManager::UpdateActors(Actor* player_actor)
 
     auto func = std::function<void()>([this]()
         {
+            PerfHarnessScope perf_scope(PerfHarness::METRIC_SUBSTEP, m_physics_steps);
             this->UpdatePhysicsSimulation();
         });
     m_sim_task = m_sim_thread_pool->RunTask(func);
@@ -1072,23 +1193,125 @@ Actor* ActorManager::GetActorById(int actor_id)
     return 0;
 }
 
+void ActorManager::UpdateSubstepMultipliers()
+{
+    // Actors which are slow, stiffness-wise simple and away from other actors may step
+    // at 2x or 4x PHYSICS_DT. Refining is immediate, coarsening needs a calm period.
+    // Implicit actors always run at their longer step (cvar 'sim_implicit_substep'),
+    // adaptive substepping only decides it for explicit ones.
+    const int   CALM_FRAMES        = 30;
+    const float CONTACT_SPEED_SLOW = 2.f;  // m/s
+    const float CONTACT_SPEED_FAST = 10.f; // m/s
+    const float FREE_SPEED_FAST    = 30.f; // m/s; contact may begin any moment
+
+    // Inter-actor contact forces are pushed into both actors' nodes on every substep either of them steps,
+    // so actors which may touch this frame must both step at 1x. Decided from this frame's predicted boxes:
+    // local pairs come from the sleep broadphase, networked actors (pseudo-collisions) are checked directly.
+    const int num_actors = static_cast<int>(m_actors.size());
+    m_substep_near_actor.assign(num_actors, false);
+    for (auto const& pair : m_sleep_pairs)
+    {
+        m_substep_near_actor[pair.first] = true;
+        m_substep_near_actor[pair.second] = true;
+    }
+    for (int i = 0; i < num_actors; i++)
+    {
+        if (m_actors[i]->ar_state != ActorState::NETWORKED_OK)
+            continue;
+        for (int j = 0; j < num_actors; j++)
+        {
+            if (m_actors[j]->ar_state == ActorState::LOCAL_SIMULATED &&
+                m_actors[j]->ar_predicted_bounding_box.intersects(m_actors[i]->ar_bounding_box))
+            {
+                m_substep_near_actor[j] = true;
+            }
+        }
+    }
+
+    for (int i = 0; i < num_actors; i++)
+    {
+        Actor* actor = m_actors[i];
+        int desired = 1;
+        if ((App::sim_adaptive_substeps->getBool() || actor->ar_integrator == SimIntegrator::IMPLICIT_BEAMS) &&
+            actor->ar_state == ActorState::LOCAL_SIMULATED &&
+            !m_substep_near_actor[i])
+        {
+            bool contact = false;
+            for (int i = 0; i < actor->ar_num_nodes && !contact; i++)
+            {
+                contact = actor->ar_nodes[i].nd_has_ground_contact || actor->ar_nodes[i].nd_has_mesh_contact;
+            }
+            const float speed = actor->m_avg_node_velocity.length();
+
+            desired = actor->m_substep_mult_max;
+            if (contact && speed > CONTACT_SPEED_FAST)
+                desired = 1;
+            else if ((contact && speed > CONTACT_SPEED_SLOW) || speed > FREE_SPEED_FAST)
+                desired = std::min(desired, 2);
+        }
+
+        if (desired < actor->m_substep_mult)
+        {
+            actor->m_substep_mult = desired;
+            actor->m_substep_calm_frames = 0;
+        }
+        else if (desired > actor->m_substep_mult && ++actor->m_substep_calm_frames >= CALM_FRAMES)
+        {
+            actor->m_substep_mult *= 2;
+            actor->m_substep_calm_frames = 0;
+        }
+        else if (desired == actor->m_substep_mult)
+        {
+            actor->m_substep_calm_frames = 0;
+        }
+    }
+
+    // Actors joined by inter-actor beams must step in lockstep - use the finest rate of the group
+    for (auto actor : m_actors)
+    {
+        for (auto linked_actor : actor->getAllLinkedActors())
+        {
+            actor->m_substep_mult = std::min(actor->m_substep_mult, linked_actor->m_substep_mult);
+        }
+    }
+}
+
 void ActorManager::UpdatePhysicsSimulation()
 {
     for (auto actor : m_actors)
     {
         actor->UpdatePhysicsOrigin();
     }
+
+    // Each actor steps once per `m_substep_mult` global substeps; the tail of the frame
+    // which doesn't fill a whole multiple is stepped at PHYSICS_DT, so that every actor
+    // ends the frame at the same point in time and no time is carried over.
+    // Because multipliers are powers of 2, actors stepping on the same substep are in sync.
+    auto coarse_end = [this](Actor* actor) { return (m_physics_steps / actor->m_substep_mult) * actor->m_substep_mult; };
+    auto num_steps  = [this, coarse_end](Actor* actor) { return coarse_end(actor) / actor->m_substep_mult + (m_physics_steps - coarse_end(actor)); };
+    auto is_due     = [coarse_end](Actor* actor, int i) { return i >= coarse_end(actor) || (i + 1) % actor->m_substep_mult == 0; };
+    auto is_first   = [coarse_end](Actor* actor, int i) { return i == ((coarse_end(actor) > 0) ? actor->m_substep_mult - 1 : 0); };
+
     for (int i = 0; i < m_physics_steps; i++)
     {
+        m_physics_substeps.fetch_add(1, std::memory_order_relaxed);
         {
             std::vector<std::function<void()>> tasks;
             for (auto actor : m_actors)
             {
-                if (actor->ar_update_physics = actor->CalcForcesEulerPrepare(i == 0))
+                if (!is_due(actor, i))
                 {
-                    auto func = std::function<void()>([this, i, actor]()
+                    continue;
+                }
+                actor->m_physics_dt = PHYSICS_DT * ((i < coarse_end(actor)) ? actor->m_substep_mult : 1);
+                const bool first = is_first(actor, i);
+                if (actor->ar_update_physics = actor->CalcForcesEulerPrepare(first))
+                {
+                    const int steps = num_steps(actor);
+                    auto func = std::function<void()>([first, steps, actor]()
                         {
-                            actor->CalcForcesEulerCompute(i == 0, m_physics_steps);
+                            ActorPerfScope perf_scope(actor->ar_perf_stats, ActorPerfStats::PHYSICS);
+                            actor->CalcForcesEulerCompute(first, steps);
                         });
                     tasks.push_back(func);
                 }
@@ -1096,7 +1319,7 @@ void ActorManager::UpdatePhysicsSimulation()
             App::GetThreadPool()->Parallelize(tasks);
             for (auto actor : m_actors)
             {
-                if (actor->ar_update_physics)
+                if (actor->ar_update_physics && is_due(actor, i))
                 {
                     actor->CalcBeamsInterActor();
                 }
@@ -1106,15 +1329,16 @@ void ActorManager::UpdatePhysicsSimulation()
             std::vector<std::function<void()>> tasks;
             for (auto actor : m_actors)
             {
-                if (actor->m_inter_point_col_detector != nullptr && (actor->ar_update_physics ||
+                if (actor->m_inter_point_col_detector != nullptr && ((actor->ar_update_physics && is_due(actor, i)) ||
                         (App::mp_pseudo_collisions->getBool() && actor->ar_state == ActorState::NETWORKED_OK)))
                 {
                     auto func = std::function<void()>([this, actor]()
                         {
+                            ActorPerfScope perf_scope(actor->ar_perf_stats, ActorPerfStats::COLLISION);
                             actor->m_inter_point_col_detector->UpdateInterPoint();
                             if (actor->ar_collision_relevant)
                             {
-                                ResolveInterActorCollisions(PHYSICS_DT,
+                                ResolveInterActorCollisions(actor->m_physics_dt,
                                     *actor->m_inter_point_col_detector,
                                     actor->ar_num_collcabs,
                                     actor->ar_collcabs,
@@ -1128,15 +1352,28 @@ void ActorManager::UpdatePhysicsSimulation()
                     tasks.push_back(func);
                 }
             }
-            App::GetThreadPool()->Parallelize(tasks);
+            // Each task also pushes nodes of other actors - in parallel, the summation order varies
+            this->RunSimTasks(tasks);
         }
+        if (App::GetGameContext()->GetTerrain())
+        {
+            App::GetGameContext()->GetTerrain()->GetCollisions()->FlushDeferredScriptCallbacks();
+        }
+        if (App::diag_sim_checksums->getBool())
+        {
+            const uint64_t checksum = this->CalcSubstepChecksum();
+            m_state_checksum = (m_state_checksum ^ checksum) * 0x100000001b3ull;
+            const uint64_t record[2] = { static_cast<uint64_t>(m_checksum_substep), checksum };
+            App::GetAsyncLogger()->PushBinary(AsyncLogger::BINSTREAM_SIM_CHECKSUM, record, sizeof(record));
+        }
+        m_checksum_substep++;
     }
     for (auto actor : m_actors)
     {
         actor->m_ongoing_reset = false;
         if (actor->ar_update_physics && m_physics_steps > 0)
         {
-            Vector3  camera_gforces = actor->m_camera_gforces_accu / m_physics_steps;
+            Vector3  camera_gforces = actor->m_camera_gforces_accu / num_steps(actor);
             actor->m_camera_gforces_accu = Vector3::ZERO;
             actor->m_camera_gforces = actor->m_camera_gforces * 0.5f + camera_gforces * 0.5f;
             actor->calculateLocalGForces();
@@ -1149,6 +1386,106 @@ void ActorManager::UpdatePhysicsSimulation()
     }
 }
 
+void ActorManager::UpdateActorPerfStats()
+{
+    const float budget_ms = App::diag_actor_budget_ms->getFloat();
+    for (Actor* actor : m_actors)
+    {
+        ActorPerfStats& stats = actor->ar_perf_stats;
+        float frame_ms[ActorPerfStats::NUM_COUNTERS];
+        float frame_total_ms = 0.f;
+        for (int i = 0; i < ActorPerfStats::NUM_COUNTERS; i++)
+        {
+            const uint64_t total = stats.totals_ns[i].load(std::memory_order_relaxed);
+            const uint64_t delta = total - stats.prev_totals_ns[i];
+            stats.prev_totals_ns[i] = total;
+            stats.window_ns[i] += delta;
+            frame_ms[i] = static_cast<float>(delta) / 1000000.f;
+            frame_total_ms += frame_ms[i];
+        }
+        stats.window_worst_frame_ms = std::max(stats.window_worst_frame_ms, frame_total_ms);
+        stats.window_frames++;
+
+        if (budget_ms > 0.f && frame_total_ms > budget_ms && !stats.window_budget_warned)
+        {
+            stats.window_budget_warned = true;
+            const std::string msg = fmt::format(
+                _L("Actor '{}' (id {}) took {:.2f} ms in one frame, budget is {:.2f} ms (physics {:.2f}, collisions {:.2f}, flexbodies {:.2f})"),
+                actor->ar_design_name, actor->ar_instance_id, frame_total_ms, budget_ms,
+                frame_ms[ActorPerfStats::PHYSICS], frame_ms[ActorPerfStats::COLLISION], frame_ms[ActorPerfStats::FLEXBODY]);
+            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_WARNING, msg);
+        }
+    }
+
+    // Publish once per second
+    const unsigned long window_ms = m_perf_timer.getMilliseconds();
+    if (window_ms < 1000)
+    {
+        return;
+    }
+    m_perf_timer.reset();
+    const float window_sec = static_cast<float>(window_ms) / 1000.f;
+    for (Actor* actor : m_actors)
+    {
+        ActorPerfStats& stats = actor->ar_perf_stats;
+        float window_total_ms = 0.f;
+        for (int i = 0; i < ActorPerfStats::NUM_COUNTERS; i++)
+        {
+            const float ms = static_cast<float>(stats.window_ns[i]) / 1000000.f;
+            stats.last_ms_per_sec[i] = ms / window_sec;
+            window_total_ms += ms;
+            stats.window_ns[i] = 0;
+        }
+        stats.last_avg_frame_ms = (stats.window_frames > 0) ? (window_total_ms / stats.window_frames) : 0.f;
+        stats.last_worst_frame_ms = stats.window_worst_frame_ms;
+        stats.window_worst_frame_ms = 0.f;
+        stats.window_frames = 0;
+        stats.window_budget_warned = false;
+    }
+}
+
+void ActorManager::RunSimTasks(std::vector<std::function<void()>>& tasks)
+{
+    if (App::sim_deterministic->getBool())
+    {
+        for (auto& task : tasks)
+            task();
+    }
+    else
+    {
+        App::GetThreadPool()->Parallelize(tasks);
+    }
+}
+
+uint64_t ActorManager::CalcSubstepChecksum()
+{
+    // FNV-1a over the raw bits - any difference, however tiny, shows up
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto hash_bytes = [&hash](const void* data, size_t len)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < len; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+    };
+
+    for (auto actor : m_actors)
+    {
+        if (actor->ar_state != ActorState::LOCAL_SIMULATED)
+            continue;
+
+        hash_bytes(&actor->ar_instance_id, sizeof(actor->ar_instance_id));
+        for (NodeNum_t i = 0; i < actor->ar_num_nodes; i++)
+        {
+            hash_bytes(actor->ar_nodes[i].AbsPosition.ptr(), sizeof(float) * 3);
+            hash_bytes(actor->ar_nodes[i].Velocity.ptr(), sizeof(float) * 3);
+        }
+    }
+    return hash;
+}
+
 void ActorManager::SyncWithSimThread()
 {
     if (m_sim_task)
@@ -1203,6 +1540,7 @@ RigDef::DocumentPtr ActorManager::FetchActorDef(std::string filename, bool prede
         }
 
         RoR::LogFormat("[RoR] Parsing truckfile '%s'", resource_filename.c_str());
+        PerfHarnessScope perf_scope(PerfHarness::METRIC_TRUCK_PARSE);
         RigDef::Parser parser;
         parser.Prepare();
         parser.ProcessOgreStream(stream.getPointer(), resource_groupname);
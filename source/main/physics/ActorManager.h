@@ -29,13 +29,16 @@
 #include "SimData.h"
 #include "CmdKeyInertia.h"
 #include "Network.h"
+#include "NodeSpatialIndex.h"
 #include "RigDef_Prerequisites.h"
 #include "ThreadPool.h"
 
+#include <atomic>
 #include <string>
 #include <vector>
 
 #define PHYSICS_DT 0.0005f // fixed dt of 0.5 ms
+#define PHYSICS_MAX_SUBSTEP_MULT 4 // coarsest substep, in multiples of PHYSICS_DT; see cvars 'sim_adaptive_substeps' and 'sim_implicit_substep'
 
 namespace RoR {
 
@@ -71,6 +74,8 @@ public:
     bool           IsSimulationPaused() const              { return m_simulation_paused; }
     void           SetSimulationPaused(bool v)             { m_simulation_paused = v; }
     float          GetTotalTime() const                    { return m_total_sim_time; }
+    double         GetPhysicsClock() const                 { return m_physics_substeps.load(std::memory_order_relaxed) * static_cast<double>(PHYSICS_DT); } //!< Simulated time of the current substep; see 'sim_deterministic'; may be called from any thread
+    uint64_t       GetStateChecksum() const                { return m_state_checksum; } //!< Running hash of node states; see 'diag_sim_checksums'
     RoR::CmdKeyInertiaConfig& GetInertiaConfig()           { return m_inertia_config; }
     Actor*         FetchNextVehicleOnList(Actor* player, Actor* prev_player);
     Actor*         FetchPreviousVehicleOnList(Actor* player, Actor* prev_player);
@@ -100,6 +105,9 @@ public:
 
     std::pair<Actor*, float> GetNearestActor(Ogre::Vector3 position);
 
+    NodeSpatialIndex const& GetNodeIndex() const           { return m_node_index; } //!< Snapshot of all node positions, refreshed every physics frame
+    void           UpdateActorPerfStats();                 //!< Per frame: collects `ActorPerfStats` counters, checks 'diag_actor_budget_ms', publishes results every second
+
     // A list of all beams interconnecting two actors
     std::map<beam_t*, std::pair<Actor*, Actor*>> inter_actor_links;
 
@@ -108,9 +116,13 @@ private:
     bool           CheckActorCollAabbIntersect(int a, int b);    //!< Returns whether or not the bounding boxes of truck a and truck b intersect. Based on the truck collision bounding boxes.
     bool           PredictActorCollAabbIntersect(int a, int b);  //!< Returns whether or not the bounding boxes of truck a and truck b might intersect during the next framestep. Based on the truck collision bounding boxes.
     void           RemoveStreamSource(int sourceid);
-    void           RecursiveActivation(int j, std::vector<bool>& visited);
+    void           UpdateSleepBroadphase();          //!< Finds actor pairs with overlapping predicted bounding boxes (sort-and-sweep)
+    void           PropagateActivation(int seed);    //!< Wakes up all actors reachable from the seed through touching bounding boxes
     void           ForwardCommands(Actor* source_actor); //!< Fowards things to trailers
     void           UpdateTruckFeatures(Actor* vehicle, float dt);
+    void           UpdateSubstepMultipliers();       //!< Picks each actor's substep length for the upcoming frame; needs `UpdateSleepBroadphase()` first
+    uint64_t       CalcSubstepChecksum();            //!< Hashes positions and velocities of all simulated nodes
+    void           RunSimTasks(std::vector<std::function<void()>>& tasks); //!< In parallel, or one by one in order if 'sim_deterministic'
 
     // Networking
     std::map<int, std::set<int>> m_stream_mismatches; //!< Networking: A set of streams without a corresponding actor in the actor-array for each stream source
@@ -127,6 +139,22 @@ private:
     float               m_simulation_time        = 0.f;   //!< Amount of time the physics simulation is going to be advanced
     bool                m_simulation_paused      = false;
     float               m_total_sim_time         = 0.f;
+    std::atomic<uint64_t> m_physics_substeps{0};          //!< Substeps simulated so far; independent of wall clock. Counted, not summed, so the clock doesn't drift.
+    uint64_t            m_state_checksum         = 0;
+    size_t              m_checksum_substep       = 0;
+    NodeSpatialIndex    m_node_index;
+    Ogre::Timer         m_perf_timer;              //!< Window of `UpdateActorPerfStats()`
+
+    // Sleep/wake broadphase; buffers are kept to avoid per-frame allocations
+    std::vector<int>    m_sleep_sweep_order;       //!< All actor indices; local ones sorted by predicted box min X as of last frame
+    std::vector<int>    m_sleep_sweep_active;      //!< Local actors, sorted
+    std::vector<std::pair<int, int>> m_sleep_pairs;
+    std::vector<int>    m_sleep_adj_start;         //!< Per-actor offsets into `m_sleep_adj`; one extra element at the end
+    std::vector<int>    m_sleep_adj;               //!< Neighbour actor indices
+    std::vector<int>    m_sleep_adj_fill;
+    std::vector<bool>   m_sleep_visited;
+    std::vector<int>    m_sleep_stack;
+    std::vector<bool>   m_substep_near_actor;      //!< Per actor; predicted box overlaps another actor this frame
 
     // Utils
     std::unique_ptr<ThreadPool> m_sim_thread_pool;
@@ -0,0 +1,85 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace RoR {
+
+/// @addtogroup Physics
+/// @{
+
+/// CPU time spent on one actor.
+/// Worker threads only add to the running totals (relaxed atomics, no locks);
+/// `ActorManager::UpdateActorPerfStats()` turns them into per-frame and per-second figures on the main thread.
+struct ActorPerfStats
+{
+    enum Counter
+    {
+        PHYSICS,    //!< `Actor::CalcForcesEulerCompute()`
+        COLLISION,  //!< Inter-actor collisions
+        FLEXBODY,   //!< Flexbody deformation + vertex buffer upload
+        NUM_COUNTERS
+    };
+
+    ActorPerfStats()
+    {
+        for (int i = 0; i < NUM_COUNTERS; i++)
+            totals_ns[i].store(0);
+    }
+
+    std::atomic<uint64_t> totals_ns[NUM_COUNTERS];
+
+    // Main thread only
+    uint64_t  prev_totals_ns[NUM_COUNTERS] = {};    //!< Totals seen at the previous frame
+    uint64_t  window_ns[NUM_COUNTERS] = {};         //!< Accumulated since the current 1-second window started
+    float     window_worst_frame_ms = 0.f;
+    int       window_frames = 0;
+    bool      window_budget_warned = false;         //!< Warn at most once per window
+
+    // Results of the last complete window
+    float     last_ms_per_sec[NUM_COUNTERS] = {};   //!< Milliseconds spent per second of wall time
+    float     last_avg_frame_ms = 0.f;              //!< All counters, per frame
+    float     last_worst_frame_ms = 0.f;
+};
+
+/// Adds the lifetime of the scope to one counter of `ActorPerfStats`.
+class ActorPerfScope
+{
+public:
+    ActorPerfScope(ActorPerfStats& stats, ActorPerfStats::Counter counter):
+        m_total(stats.totals_ns[counter]), m_start(std::chrono::steady_clock::now())
+    {}
+
+    ~ActorPerfScope()
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - m_start;
+        m_total.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()), std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t>&                 m_total;
+    std::chrono::steady_clock::time_point  m_start;
+};
+
+/// @} // addtogroup Physics
+
+} // namespace RoR
@@ -30,9 +30,27 @@
 
 using namespace RoR;
 
+static void UpdateRailGroupBounds(std::vector<RailGroup*>& railgroups)
+{
+    for (RailGroup* railgroup: railgroups)
+    {
+        if (railgroup != nullptr)
+            railgroup->UpdateBounds();
+    }
+}
+
 // ug... BAD PERFORMNCE, BAD!!
 void Actor::toggleSlideNodeLock()
 {
+    // refit all rails once, the closest segment lookups below are then logarithmic
+    if (!m_slidenodes_locked)
+    {
+        for (auto actor : App::GetGameContext()->GetActorManager()->GetActors())
+        {
+            UpdateRailGroupBounds(actor->m_railgroups);
+        }
+    }
+
     // for every slide node on this truck
     for (std::vector<SlideNode>::iterator itNode = m_slidenodes.begin(); itNode != m_slidenodes.end(); itNode++)
     {
@@ -102,17 +120,14 @@ std::pair<RailGroup*, Ogre::Real> Actor::GetClosestRailOnActor(Actor* actor, con
 
 void Actor::updateSlideNodeForces(const Ogre::Real dt)
 {
-    for (std::vector<SlideNode>::iterator it = m_slidenodes.begin(); it != m_slidenodes.end(); ++it)
-    {
-        it->UpdatePosition();
-        it->UpdateForces(dt);
-    }
+    SlideNode::UpdateSlideNodes(m_slidenodes.data(), m_slidenodes.size(), dt);
 }
 
 void Actor::resetSlideNodePositions()
 {
     if (m_slidenodes.empty())
         return;
+    UpdateRailGroupBounds(m_railgroups);
     for (std::vector<SlideNode>::iterator it = m_slidenodes.begin(); it != m_slidenodes.end(); ++it)
     {
         it->ResetPositions();
@@ -121,6 +136,7 @@ void Actor::resetSlideNodePositions()
 
 void Actor::resetSlideNodes()
 {
+    UpdateRailGroupBounds(m_railgroups);
     for (std::vector<SlideNode>::iterator it = m_slidenodes.begin(); it != m_slidenodes.end(); ++it)
     {
         it->ResetSlideNode();
@@ -55,6 +55,7 @@
 #include "GfxScene.h"
 #include "Console.h"
 #include "InputEngine.h"
+#include "IntraCollisionPairs.h"
 #include "MeshObject.h"
 #include "PointColDetector.h"
 #include "Renderdash.h"
@@ -155,6 +156,10 @@ void ActorSpawner::CalcMemoryRequirements(ActorMemoryRequirements& req, RigDef::
     // 'wings'
     req.num_wings += module_def->wings.size();
 
+    // 'wheels', 'wheels2', 'meshwheels', 'meshwheels2', 'flexbodywheels' - one `wheel_t` each
+    req.num_wheels += module_def->wheels.size() + module_def->wheels2.size() + module_def->meshwheels.size()
+        + module_def->meshwheels2.size() + module_def->flexbodywheels.size();
+
     // 'wheels'
     for (RigDef::Wheel& wheel: module_def->wheels)
     {
@@ -208,24 +213,34 @@ void ActorSpawner::InitializeRig()
         this->CalcMemoryRequirements(req, module.get());
     }
 
-    // Allocate memory as needed
-    m_actor->ar_beams = new beam_t[req.num_beams];
-    m_actor->ar_nodes = new node_t[req.num_nodes];
-    m_actor->ar_nodes_id = new int[req.num_nodes];
+    // Allocate memory as needed - all sim arrays in one block, names separately.
+    LinearArena& hot_arena = m_actor->m_hot_arena;
+    hot_arena.Reserve<node_t>(req.num_nodes);
+    hot_arena.Reserve<beam_t>(req.num_beams);
+    hot_arena.Reserve<shock_t>(req.num_shocks);
+    hot_arena.Reserve<rotator_t>(req.num_rotators);
+    hot_arena.Reserve<wing_t>(req.num_wings);
+    hot_arena.Reserve<wheel_t>(req.num_wheels);
+    hot_arena.Allocate(App::sim_arena_huge_pages->getBool());
+
+    m_actor->ar_nodes = hot_arena.NewArray<node_t>(req.num_nodes);
+    m_actor->ar_beams = hot_arena.NewArray<beam_t>(req.num_beams);
+    m_actor->ar_shocks = hot_arena.NewArray<shock_t>(req.num_shocks);
+    m_actor->ar_rotators = hot_arena.NewArray<rotator_t>(req.num_rotators);
+    m_actor->ar_wings = hot_arena.NewArray<wing_t>(req.num_wings);
+    m_actor->ar_wheels = hot_arena.NewArray<wheel_t>(req.num_wheels);
+
+    LinearArena& cold_arena = m_actor->m_cold_arena;
+    cold_arena.Reserve<int>(req.num_nodes);
+    cold_arena.Reserve<std::string>(req.num_nodes);
+    cold_arena.Allocate(/*use_huge_pages=*/false);
+
+    m_actor->ar_nodes_id = cold_arena.NewArray<int>(req.num_nodes);
     for (size_t i = 0; i < req.num_nodes; ++i)
     {
         m_actor->ar_nodes_id[i] = -1;
     }
-    m_actor->ar_nodes_name = new std::string[req.num_nodes];
-
-    if (req.num_shocks > 0)
-        m_actor->ar_shocks = new shock_t[req.num_shocks];
-
-    if (req.num_rotators > 0)
-        m_actor->ar_rotators = new rotator_t[req.num_rotators];
-
-    if (req.num_wings > 0)
-        m_actor->ar_wings = new wing_t[req.num_wings];
+    m_actor->ar_nodes_name = cold_arena.NewArray<std::string>(req.num_nodes);
 
     m_actor->ar_minimass.resize(req.num_nodes);
 
@@ -268,6 +283,10 @@ void ActorSpawner::InitializeRig()
     m_actor->m_deletion_scene_nodes.clear();
 
     m_actor->ar_state = ActorState::LOCAL_SLEEPING;
+    m_actor->ar_integrator = App::sim_integrator->getEnum<SimIntegrator>();
+    m_actor->m_physics_dt = PHYSICS_DT;
+    m_actor->m_substep_mult = 1;
+    m_actor->m_substep_mult_max = 1;
     m_actor->m_fusealge_airfoil = nullptr;
     m_actor->m_fusealge_front = nullptr;
     m_actor->m_fusealge_back = nullptr;
@@ -336,6 +355,7 @@ void ActorSpawner::InitializeRig()
     if (!App::sim_no_self_collisions->getBool())
     {
         m_actor->m_intra_point_col_detector = new PointColDetector(m_actor);
+        m_actor->m_intra_collision_pairs = new IntraCollisionPairs();
     }
 
     m_actor->ar_submesh_ground_model = App::GetGameContext()->GetTerrain()->GetCollisions()->defaultgm;
@@ -572,6 +592,112 @@ void ActorSpawner::FinalizeRig()
     m_actor->GetGfxActor()->SortFlexbodies();
 }
 
+void ActorSpawner::OptimizeBeamOrder()
+{
+    // Sort beams by their lower node index so that CalcBeams() walks `ar_nodes` mostly forward.
+    // Beams referenced from elsewhere (by index or by pointer) keep their slots;
+    // notably triggers/blockers address neighbouring beams by index.
+    // Nodes are NOT renumbered - node indices are baked into cameras, wheels, flexbodies,
+    // props, network streams and `ar_nodes_id`, so the node order stays as defined in the file.
+    beam_t* beams = m_actor->ar_beams;
+    const int num_beams = m_actor->ar_num_beams;
+
+    // Locality measure: mean distance (in nodes) between the nodes of consecutive beams
+    auto mean_node_jump = [beams, num_beams]() -> float
+        {
+            if (num_beams < 2)
+                return 0.f;
+            long long sum = 0;
+            for (int i = 1; i < num_beams; ++i)
+            {
+                sum += std::abs(beams[i].p1->pos - beams[i - 1].p1->pos) + std::abs(beams[i].p2->pos - beams[i - 1].p2->pos);
+            }
+            return static_cast<float>(sum) / (2 * (num_beams - 1));
+        };
+    const float jump_before = mean_node_jump();
+
+    std::vector<bool> pinned(num_beams, false);
+    for (int i = 0; i < num_beams; ++i)
+    {
+        pinned[i] = (beams[i].shock != nullptr);
+    }
+    for (hydrobeam_t& hydrobeam: m_actor->ar_hydros)
+    {
+        pinned[hydrobeam.hb_beam_index] = true;
+    }
+    for (command_t& command: m_actor->ar_command_key)
+    {
+        for (commandbeam_t& cmd_beam: command.beams)
+        {
+            pinned[cmd_beam.cmb_beam_index] = true;
+        }
+    }
+    for (int beam_index: m_actor->getTyrePressure().GetBeams())
+    {
+        pinned[beam_index] = true;
+    }
+    auto pin_beam = [beams, &pinned](beam_t* beam) { if (beam != nullptr) { pinned[beam - beams] = true; } };
+    for (hook_t& hook: m_actor->ar_hooks)
+    {
+        pin_beam(hook.hk_beam);
+    }
+    for (rope_t& rope: m_actor->ar_ropes)
+    {
+        pin_beam(rope.rp_beam);
+    }
+    for (tie_t& tie: m_actor->ar_ties)
+    {
+        pin_beam(tie.ti_beam);
+    }
+    for (RailGroup* railgroup: m_actor->m_railgroups)
+    {
+        for (RailSegment& segment: railgroup->rg_segments)
+        {
+            pin_beam(segment.rs_beam);
+        }
+    }
+
+    std::vector<int> free_slots;
+    for (int i = 0; i < num_beams; ++i)
+    {
+        if (!pinned[i])
+        {
+            free_slots.push_back(i);
+        }
+    }
+
+    std::vector<int> sorted_slots = free_slots;
+    std::stable_sort(sorted_slots.begin(), sorted_slots.end(), [beams](int a, int b)
+        {
+            const NodeNum_t a_lo = std::min(beams[a].p1->pos, beams[a].p2->pos);
+            const NodeNum_t b_lo = std::min(beams[b].p1->pos, beams[b].p2->pos);
+            if (a_lo != b_lo)
+                return a_lo < b_lo;
+            return std::max(beams[a].p1->pos, beams[a].p2->pos) < std::max(beams[b].p1->pos, beams[b].p2->pos);
+        });
+
+    std::vector<beam_t> sorted_beams(sorted_slots.size());
+    std::vector<int> new_index(num_beams);
+    for (int i = 0; i < num_beams; ++i)
+    {
+        new_index[i] = i;
+    }
+    for (size_t i = 0; i < sorted_slots.size(); ++i)
+    {
+        sorted_beams[i] = beams[sorted_slots[i]];
+        new_index[sorted_slots[i]] = free_slots[i];
+    }
+    for (size_t i = 0; i < free_slots.size(); ++i)
+    {
+        beams[free_slots[i]] = sorted_beams[i];
+    }
+
+    m_actor->GetGfxActor()->RemapBeamIndices(new_index);
+
+    this->AddMessage(Message::TYPE_INFO, "Beam order optimized (" + TOSTRING(free_slots.size()) + "/" + TOSTRING(num_beams)
+        + " beams movable): mean node jump between consecutive beams " + TOSTRING(jump_before) + " -> " + TOSTRING(mean_node_jump()));
+}
+
 /* -------------------------------------------------------------------------- */
 // Processing functions and utilities.
 /* -------------------------------------------------------------------------- */
@@ -698,7 +824,7 @@ void ActorSpawner::ProcessFusedrag(RigDef::Fusedrag & def)
         factor = def.area_coefficient;
         width  =  (m_fuse_z_max - m_fuse_z_min) * (m_fuse_y_max - m_fuse_y_min) * factor;
 
-        m_actor->m_fusealge_airfoil = new Airfoil(fusefoil);
+        m_actor->m_fusealge_airfoil = Airfoil::GetShared(fusefoil);
 
         m_actor->m_fusealge_front   = & m_actor->ar_nodes[front_node_idx];
         m_actor->m_fusealge_back    = & m_actor->ar_nodes[front_node_idx]; // This equals v0.38 / v0.4.0.7, but it's probably a bug
@@ -711,7 +837,7 @@ void ActorSpawner::ProcessFusedrag(RigDef::Fusedrag & def)
 
         width  = def.approximate_width;
 
-        m_actor->m_fusealge_airfoil = new Airfoil(fusefoil);
+        m_actor->m_fusealge_airfoil = Airfoil::GetShared(fusefoil);
 
         m_actor->m_fusealge_front   = & m_actor->ar_nodes[front_node_idx];
         m_actor->m_fusealge_back    = & m_actor->ar_nodes[front_node_idx]; // This equals v0.38 / v0.4.0.7, but it's probably a bug
@@ -2968,6 +3094,7 @@ RailGroup *ActorSpawner::CreateRail(std::vector<RigDef::Node::Range> & node_rang
         }
     }
 
+    rg->UpdateBounds();
     return rg; // Transfers memory ownership
 }
 
@@ -4390,6 +4517,7 @@ void ActorSpawner::BuildMeshWheelVisuals(
         WheelGfx visual_wheel;
         visual_wheel.wx_is_meshwheel = false;
         visual_wheel.wx_flex_mesh = flexmesh_wheel;
+        visual_wheel.wx_flexmesh_wheel = flexmesh_wheel;
         visual_wheel.wx_scenenode = scene_node;
         m_actor->m_gfx_actor->m_wheels.push_back(visual_wheel);
     }
@@ -4650,7 +4778,7 @@ unsigned int ActorSpawner::AddWheel(RigDef::Wheel & wheel_def)
 
 void ActorSpawner::CreateWheelSkidmarks(unsigned int wheel_index)
 {
-    // Always create, even if disabled by config
+    // Always create, even if disabled by config - cheap, the mesh is only built when the wheel first skids
     m_actor->m_skid_trails[wheel_index] = new RoR::Skidmark(
         RoR::App::GetGfxScene()->GetSkidmarkConf(), &m_actor->ar_wheels[wheel_index], m_particles_parent_scenenode, 300, 20);
 }
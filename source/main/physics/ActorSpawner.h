@@ -81,6 +81,7 @@ public:
         size_t num_shocks    = 0;
         size_t num_rotators  = 0;
         size_t num_wings     = 0;
+        size_t num_wheels    = 0;
         size_t num_airbrakes = 0;
         size_t num_fixes     = 0;
         // ... more to come ...
@@ -298,6 +299,7 @@ private:
     RailGroup*                    CreateRail(std::vector<RigDef::Node::Range> & node_ranges);
     void                          InitializeRig();
     void                          FinalizeRig();
+    void                          OptimizeBeamOrder();  //!< Optional; improves memory locality of CalcBeams()
     /// @}
 
     /// @name Actor building utilities
@@ -214,6 +214,11 @@ void ActorSpawner::ProcessNewActor(Actor* actor, ActorSpawnRequest rq, RigDef::D
 
     this->FinalizeRig();
 
+    if (App::sim_spawn_sort_beams->getBool())
+    {
+        this->OptimizeBeamOrder();
+    }
+
     if (m_oldstyle_cab_texcoords.size() > 0 && m_actor->ar_num_cabs > 0)
     {
         this->CreateCabVisual();
@@ -25,7 +25,9 @@
 
 #include "Application.h"
 
-static int mirand = 1;
+#include <cstdint>
+
+static uint32_t mirand = 1; // Unsigned - the multiplications below wrap around
 
 // Returns a random number in the range [0, 1]
 inline float frand()
@@ -63,6 +65,32 @@ inline float frand_11()
     return( *((float*)&a) - 3.0f );
 }
 
+// Variants with caller-owned state (must be non-zero), for reproducible and thread-safe sequences
+
+// Returns a random number in the range [0, 1]
+inline float frand(uint32_t& seed)
+{
+    unsigned int a;
+
+    seed *= 16807u; // Wraps around - defined for unsigned
+
+    a = (seed&0x007fffff) | 0x40000000;
+
+    return( *((float*)&a) - 2.0f )*0.5f;
+}
+
+// Returns a random number in the range [-1, 1]
+inline float frand_11(uint32_t& seed)
+{
+    unsigned int a;
+
+    seed *= 16807u; // Wraps around - defined for unsigned
+
+    a = (seed&0x007fffff) | 0x40000000;
+
+    return( *((float*)&a) - 3.0f );
+}
+
 // Calculates approximate e^x.
 // Use it in code not requiring precision
 inline float approx_exp(const float x)
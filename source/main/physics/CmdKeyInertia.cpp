@@ -21,10 +21,10 @@
 #include "CmdKeyInertia.h"
 
 #include "Application.h"
+#include "PlatformUtils.h"
 #include "Utils.h"
 
 #include <OgreDataStream.h>
-#include <OgreResourceGroupManager.h>
 #include <OgreSimpleSpline.h>
 #include <OgreVector3.h>
 
@@ -139,7 +139,13 @@ void RoR::CmdKeyInertiaConfig::LoadDefaultInertiaModels()
 {
     try
     {
-        Ogre::DataStreamPtr ds = Ogre::ResourceGroupManager::getSingleton().openResource("inertia_models.cfg", Ogre::RGN_AUTODETECT);
+        // Read directly from config dir, this runs on a worker thread during startup
+        Ogre::DataStreamPtr ds = RoR::OpenFileDirect(RoR::PathCombine(RoR::App::sys_config_dir->getStr(), "inertia_models.cfg"));
+        if (!ds)
+        {
+            RoR::Log("[RoR|Inertia] Failed to load 'inertia_models.cfg', file not found");
+            return;
+        }
         std::string current_model;
         while (!ds->eof())
         {
@@ -32,7 +32,7 @@ namespace RoR {
 class CmdKeyInertiaConfig
 {
 public:
-    void LoadDefaultInertiaModels();
+    void LoadDefaultInertiaModels(); //!< Thread safe, doesn't use OGRE resource system
     Ogre::SimpleSpline* GetSplineByName(Ogre::String model);
 
 private:
@@ -283,6 +283,12 @@ enum class ActorState
     LOCAL_SLEEPING,   //!< sleeping (local) actor
 };
 
+enum class SimIntegrator
+{
+    EULER,          //!< Reference: explicit forces, symplectic Euler node update.
+    IMPLICIT_BEAMS, //!< Beam spring/damper forces solved with backward Euler per beam; steps at cvar 'sim_implicit_substep' x PHYSICS_DT.
+};
+
 enum class AeroEngineType
 {
     AE_UNKNOWN,
@@ -110,7 +110,146 @@ void SlideNode::UpdateForces(float dt)
     m_sliding_beam->p2->Forces += perpForces * m_node_forces_ratio;
 }
 
+// RAIL GROUPS IMPLEMENTATION //////////////////////////////////////////////////
+
+static const size_t RAIL_BOUNDS_LEAF_SIZE = 4;
+static const float  RAIL_BOUNDS_MARGIN = 0.001f; // m; covers rounding in `NearestPointOnLine()`
+
+static float GetLenToBounds(const RailBoundsNode& bounds, const Ogre::Vector3& point)
+{
+    Ogre::Vector3 diff = Ogre::Vector3::ZERO;
+    for (int i = 0; i < 3; ++i)
+    {
+        if (point[i] < bounds.rbn_min[i])
+            diff[i] = bounds.rbn_min[i] - point[i];
+        else if (point[i] > bounds.rbn_max[i])
+            diff[i] = point[i] - bounds.rbn_max[i];
+    }
+    return diff.length();
+}
+
+int RailGroup::BuildBounds(size_t begin, size_t end)
+{
+    const int index = static_cast<int>(rg_bounds.size());
+    RailBoundsNode bounds;
+    bounds.rbn_begin = begin;
+    bounds.rbn_end = end;
+    bounds.rbn_left = -1;
+    bounds.rbn_right = -1;
+    rg_bounds.push_back(bounds);
+
+    // Rails are chains, so neighbouring segments are also close in space
+    if (end - begin > RAIL_BOUNDS_LEAF_SIZE)
+    {
+        const size_t mid = begin + (end - begin) / 2;
+        const int left = this->BuildBounds(begin, mid);
+        const int right = this->BuildBounds(mid, end);
+        rg_bounds[index].rbn_left = left;
+        rg_bounds[index].rbn_right = right;
+    }
+    return index;
+}
+
+void RailGroup::UpdateBounds()
+{
+    if (rg_segments.empty())
+    {
+        return;
+    }
+
+    if (rg_bounds.empty() || rg_bounds[0].rbn_end != rg_segments.size())
+    {
+        rg_bounds.clear();
+        this->BuildBounds(0, rg_segments.size());
+    }
+
+    // Children always come after their parent - refit bottom-up
+    const Ogre::Vector3 margin(RAIL_BOUNDS_MARGIN, RAIL_BOUNDS_MARGIN, RAIL_BOUNDS_MARGIN);
+    for (size_t i = rg_bounds.size(); i-- > 0; )
+    {
+        RailBoundsNode& bounds = rg_bounds[i];
+        if (bounds.rbn_left == -1)
+        {
+            bounds.rbn_min = rg_segments[bounds.rbn_begin].rs_beam->p1->AbsPosition;
+            bounds.rbn_max = bounds.rbn_min;
+            for (size_t s = bounds.rbn_begin; s < bounds.rbn_end; ++s)
+            {
+                const beam_t* beam = rg_segments[s].rs_beam;
+                bounds.rbn_min.makeFloor(beam->p1->AbsPosition);
+                bounds.rbn_min.makeFloor(beam->p2->AbsPosition);
+                bounds.rbn_max.makeCeil(beam->p1->AbsPosition);
+                bounds.rbn_max.makeCeil(beam->p2->AbsPosition);
+            }
+            bounds.rbn_min -= margin;
+            bounds.rbn_max += margin;
+        }
+        else
+        {
+            const RailBoundsNode& left = rg_bounds[bounds.rbn_left];
+            const RailBoundsNode& right = rg_bounds[bounds.rbn_right];
+            bounds.rbn_min = left.rbn_min;
+            bounds.rbn_min.makeFloor(right.rbn_min);
+            bounds.rbn_max = left.rbn_max;
+            bounds.rbn_max.makeCeil(right.rbn_max);
+        }
+    }
+}
+
 RailSegment* RailGroup::FindClosestSegment(const Ogre::Vector3& point)
+{
+    if (rg_bounds.empty())
+    {
+        return this->FindClosestSegmentLinear(point);
+    }
+
+    float closest_dist = std::numeric_limits<float>::infinity();
+    size_t closest_seg = 0;
+
+    int stack[64]; // Depth is log2 of segment count
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0)
+    {
+        const RailBoundsNode& bounds = rg_bounds[stack[--stack_size]];
+        if (GetLenToBounds(bounds, point) > closest_dist)
+        {
+            continue;
+        }
+
+        if (bounds.rbn_left == -1)
+        {
+            for (size_t i = bounds.rbn_begin; i < bounds.rbn_end; ++i)
+            {
+                // On a tie, prefer the lower index - same result as the linear search
+                const float dist = SlideNode::getLenTo(&this->rg_segments[i], point);
+                if (dist < closest_dist || (dist == closest_dist && i < closest_seg))
+                {
+                    closest_dist = dist;
+                    closest_seg = i;
+                }
+            }
+            continue;
+        }
+
+        // Push the farther child first, so the nearer one is searched first
+        const float left_dist = GetLenToBounds(rg_bounds[bounds.rbn_left], point);
+        const float right_dist = GetLenToBounds(rg_bounds[bounds.rbn_right], point);
+        if (left_dist <= right_dist)
+        {
+            stack[stack_size++] = bounds.rbn_right;
+            stack[stack_size++] = bounds.rbn_left;
+        }
+        else
+        {
+            stack[stack_size++] = bounds.rbn_left;
+            stack[stack_size++] = bounds.rbn_right;
+        }
+    }
+
+    return &this->rg_segments[closest_seg];
+}
+
+RailSegment* RailGroup::FindClosestSegmentLinear(const Ogre::Vector3& point)
 {
     float closest_dist_sq = SlideNode::getLenTo(&this->rg_segments[0], point);
     size_t closest_seg = 0;
@@ -191,6 +330,71 @@ void SlideNode::UpdatePosition()
     m_node_forces_ratio = (bLen > 0.0f) ? len / bLen : 0.0f;
 }
 
+/// Nearest point of the beam, see `NearestPointOnLine()`
+struct BeamProjection
+{
+    Ogre::Vector3 point;
+    Ogre::Real    ratio;     //!< 0.0f = p1, 1.0f = p2
+    Ogre::Real    dist_sq;
+};
+
+static inline BeamProjection ProjectOnBeam(const beam_t* beam, const Ogre::Vector3& point)
+{
+    Ogre::Vector3 b = beam->p2->AbsPosition - beam->p1->AbsPosition;
+    const Ogre::Real bLen = b.normalise();
+    const Ogre::Real len = std::max(0.0f, std::min((point - beam->p1->AbsPosition).dotProduct(b), bLen));
+
+    BeamProjection proj;
+    proj.point = beam->p1->AbsPosition + b * len;
+    proj.ratio = (bLen > 0.0f) ? len / bLen : 0.0f;
+    proj.dist_sq = proj.point.squaredDistance(point);
+    return proj;
+}
+
+void SlideNode::UpdateSlideNodes(SlideNode* slidenodes, size_t count, float dt)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        SlideNode& sn = slidenodes[i];
+        const Ogre::Vector3& pos = sn.m_sliding_node->AbsPosition;
+
+        // only do calcs if we have a beam to slide on
+        if (!sn.m_sliding_beam || sn.m_sliding_beam->bm_broken)
+        {
+            sn.m_ideal_position = pos;
+            continue;
+        }
+
+        // find which beam to use, like `RailSegment::CheckCurSlideSegment()`
+        RailSegment* seg = sn.m_cur_rail_seg;
+        BeamProjection proj = ProjectOnBeam(seg->rs_beam, pos);
+        if (sn.m_cur_rail_seg->rs_prev != nullptr)
+        {
+            const BeamProjection prev = ProjectOnBeam(sn.m_cur_rail_seg->rs_prev->rs_beam, pos);
+            if (prev.dist_sq < proj.dist_sq)
+            {
+                seg = sn.m_cur_rail_seg->rs_prev;
+                proj = prev;
+            }
+        }
+        if (sn.m_cur_rail_seg->rs_next != nullptr)
+        {
+            const BeamProjection next = ProjectOnBeam(sn.m_cur_rail_seg->rs_next->rs_beam, pos);
+            if (next.dist_sq < proj.dist_sq)
+            {
+                seg = sn.m_cur_rail_seg->rs_next;
+                proj = next;
+            }
+        }
+        sn.m_cur_rail_seg = seg;
+        sn.m_sliding_beam = seg->rs_beam;
+        sn.m_ideal_position = proj.point;
+        sn.m_node_forces_ratio = proj.ratio;
+
+        sn.UpdateForces(dt);
+    }
+}
+
 const Ogre::Vector3& SlideNode::GetSlideNodePosition() const
 {
     return m_sliding_node->AbsPosition;
@@ -49,16 +49,38 @@ struct RailSegment
     beam_t*        rs_beam;
 };
 
+/// Bounding box of a contiguous range of rail segments, see `RailGroup::UpdateBounds()`
+struct RailBoundsNode
+{
+    Ogre::Vector3  rbn_min;
+    Ogre::Vector3  rbn_max;
+    size_t         rbn_begin;  //!< First segment
+    size_t         rbn_end;    //!< One past the last segment
+    int            rbn_left;   //!< Child node index, -1 for leaf
+    int            rbn_right;  //!< Child node index, -1 for leaf
+};
+
 /// A series of RailSegment-s for SlideNode to slide along. Can be closed in a loop.
 struct RailGroup
 {
     RailGroup(): rg_id(-1) {}
 
-    /// Search for closest rail segment (the one with closest node in it) in the entire RailGroup
+    /// Search for closest rail segment (the one with closest node in it) in the entire RailGroup.
+    /// Uses the bounds from the last `UpdateBounds()` call, or checks every segment if there are none.
     RailSegment* FindClosestSegment(Ogre::Vector3 const& point );
 
-    std::vector<RailSegment> rg_segments;
-    int                      rg_id; //!< Spawn context - matching separately defined rails with slidenodes.
+    /// Refits the bounding volume hierarchy to current node positions; call before `FindClosestSegment()` when nodes moved.
+    void UpdateBounds();
+
+    /// Same as `FindClosestSegment()`, but always checks every segment.
+    RailSegment* FindClosestSegmentLinear(Ogre::Vector3 const& point);
+
+    std::vector<RailSegment>    rg_segments;
+    std::vector<RailBoundsNode> rg_bounds; //!< Hierarchy over `rg_segments`, parents before children; empty until `UpdateBounds()`
+    int                         rg_id; //!< Spawn context - matching separately defined rails with slidenodes.
+
+private:
+    int BuildBounds(size_t begin, size_t end); //!< Creates nodes for the segment range, returns index of the top one
 };
 
 class SlideNode
@@ -78,6 +100,10 @@ public:
     /// Checks for current rail segment and updates ideal position of the node
     void UpdatePosition();
 
+    /// Does `UpdatePosition()` and `UpdateForces()` for all slidenodes of an actor in one pass;
+    /// each candidate segment is projected on only once and the result is reused for the ideal position.
+    static void UpdateSlideNodes(SlideNode* slidenodes, size_t count, float dt);
+
     /// Sets rail to initially use when spawned or reset
     void SetDefaultRail(RailGroup* rail)
     {
@@ -24,9 +24,27 @@
 
 #include <Ogre.h>
 
+#include <map>
+#include <mutex>
+
 using namespace Ogre;
 using namespace RoR;
 
+static std::mutex                                   g_airfoil_cache_mutex;
+static std::map<std::string, std::weak_ptr<Airfoil>> g_airfoil_cache;
+
+std::shared_ptr<Airfoil> Airfoil::GetShared(Ogre::String const& fname)
+{
+    std::lock_guard<std::mutex> lock(g_airfoil_cache_mutex);
+    std::shared_ptr<Airfoil> airfoil = g_airfoil_cache[fname].lock();
+    if (!airfoil)
+    {
+        airfoil = std::shared_ptr<Airfoil>(new Airfoil(fname));
+        g_airfoil_cache[fname] = airfoil;
+    }
+    return airfoil;
+}
+
 Airfoil::Airfoil(Ogre::String const& fname)
 {
     for (int i = 0; i < 3601; i++) //init in case of bad things
@@ -102,7 +120,7 @@ Airfoil::~Airfoil()
 {
 }
 
-void Airfoil::getparams(float a, float cratio, float cdef, float* ocl, float* ocd, float* ocm)
+void Airfoil::getparams(float a, float cratio, float cdef, float* ocl, float* ocd, float* ocm) const
 {
     int ta = (int)(a / 360.0);
     //		float va=360.0f*fmod(a, 360.0f); FMOD IS TOTALLY UNRELIABLE HERE : fmod(-180.0f, 360.0f)=-180.0f!!!!!
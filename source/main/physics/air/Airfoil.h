@@ -22,6 +22,8 @@
 
 #include "Application.h"
 
+#include <memory>
+
 namespace RoR {
 
 /// @addtogroup Physics
@@ -37,7 +39,11 @@ public:
     Airfoil(Ogre::String const& fname);
     ~Airfoil();
 
-    void getparams(float a, float cratio, float cdef, float* ocl, float* ocd, float* ocm);
+    /// Returns the profile for the given file, loading it on first use.
+    /// Profiles are read-only once loaded, so all wings, props and fuselages share one instance per file.
+    static std::shared_ptr<Airfoil> GetShared(Ogre::String const& fname);
+
+    void getparams(float a, float cratio, float cdef, float* ocl, float* ocd, float* ocm) const;
 
 private:
 
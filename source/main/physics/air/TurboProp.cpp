@@ -114,7 +114,7 @@ Turboprop::Turboprop(
     warmupstart = 0.0;
     warmuptime = 14.0;
     warmup = false;
-    airfoil = new Airfoil(propfoilname);
+    airfoil = Airfoil::GetShared(propfoilname);
     fullpower = power;
     max_torque = 9549.3 * fullpower / 1000.0;
     indicated_torque = 0.0;
@@ -157,11 +157,6 @@ Turboprop::~Turboprop()
     SOUND_MODULATE(m_actor, mod_id, 0);
     SOUND_STOP(m_actor, src_id);
 
-    if (airfoil != nullptr)
-    {
-        delete airfoil;
-    }
-
     if (smokePS != nullptr)
     {
         smokePS->removeAllEmitters();
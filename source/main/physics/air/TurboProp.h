@@ -96,7 +96,7 @@ public:
 private:
 
     float torquedist;
-    Airfoil* airfoil;
+    std::shared_ptr<Airfoil> airfoil;
     float fullpower; //!< in kW
     float proparea;
     float airdensity;
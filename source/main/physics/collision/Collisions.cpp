@@ -35,6 +35,8 @@
 #include "ScriptEngine.h"
 #include "Terrain.h"
 
+#include <algorithm>
+
 using namespace RoR;
 
 // some gcc fixes
@@ -138,8 +140,30 @@ Collisions::~Collisions()
     if (landuse) delete landuse;
 }
 
+std::unique_ptr<Ogre::ConfigFile> Collisions::s_default_models_cfg;
+
+void Collisions::PreloadDefaultModels()
+{
+    auto cfg = std::unique_ptr<Ogre::ConfigFile>(new Ogre::ConfigFile());
+    try
+    {
+        cfg->loadDirect(PathCombine(App::sys_config_dir->getStr(), "ground_models.cfg"));
+    }
+    catch (Ogre::Exception& e)
+    {
+        // Leave it to `loadDefaultModels()` to report
+        RoR::LogFormat("[RoR] Failed to preload ground models: %s", e.getFullDescription().c_str());
+        return;
+    }
+    s_default_models_cfg = std::move(cfg);
+}
+
 int Collisions::loadDefaultModels()
 {
+    if (s_default_models_cfg)
+    {
+        return this->processGroundModelsConfig(s_default_models_cfg.get());
+    }
     return loadGroundModelsConfigFile(PathCombine(App::sys_config_dir->getStr(), "ground_models.cfg"));
 }
 
@@ -170,8 +194,13 @@ int Collisions::loadGroundModelsConfigFile(Ogre::String filename)
         return 1;
     }
 
+    return this->processGroundModelsConfig(&cfg);
+}
+
+int Collisions::processGroundModelsConfig(Ogre::ConfigFile* cfg)
+{
     // parse the whole config
-    parseGroundConfig(&cfg);
+    parseGroundConfig(cfg);
 
     // after it was parsed, resolve the dependencies
     std::map<Ogre::String, ground_model_t>::iterator it;
@@ -187,7 +216,7 @@ int Collisions::loadGroundModelsConfigFile(Ogre::String filename)
         // re-set the name
         strncpy(thisgm->name, it->first.c_str(), 255);
         // after that we need to reload the config to overwrite settings of the base
-        parseGroundConfig(&cfg, it->first);
+        parseGroundConfig(cfg, it->first);
     }
     // check the version
     if (this->collision_version != LATEST_GROUND_MODEL_VERSION)
@@ -545,15 +574,13 @@ int Collisions::addCollisionBox(SceneNode *tenode, bool rotating, bool virt, Vec
     return coll_box_index;
 }
 
-int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model_t* gm)
+static void SetupCollisionTri(collision_tri_t& tri, Vector3 p1, Vector3 p2, Vector3 p3, ground_model_t* gm)
 {
-    int new_tri_index = (int)m_collision_tris.size();
-    collision_tri_t new_tri;
-    new_tri.a=p1;
-    new_tri.b=p2;
-    new_tri.c=p3;
-    new_tri.gm=gm;
-    new_tri.enabled=true;
+    tri.a=p1;
+    tri.b=p2;
+    tri.c=p3;
+    tri.gm=gm;
+    tri.enabled=true;
     // compute transformations
     // base construction
     Vector3 bx=p2-p1;
@@ -561,42 +588,146 @@ int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model
     Vector3 bz=bx.crossProduct(by);
     bz.normalise();
     // coordinates change matrix
-    new_tri.reverse.SetColumn(0, bx);
-    new_tri.reverse.SetColumn(1, by);
-    new_tri.reverse.SetColumn(2, bz);
-    new_tri.forward=new_tri.reverse.Inverse();
+    tri.reverse.SetColumn(0, bx);
+    tri.reverse.SetColumn(1, by);
+    tri.reverse.SetColumn(2, bz);
+    tri.forward=tri.reverse.Inverse();
 
     // compute tri AAB
-    new_tri.aab.merge(p1);
-    new_tri.aab.merge(p2);
-    new_tri.aab.merge(p3);
-    new_tri.aab.setMinimum(new_tri.aab.getMinimum() - 0.1f);
-    new_tri.aab.setMaximum(new_tri.aab.getMaximum() + 0.1f);
-    
+    tri.aab.setNull();
+    tri.aab.merge(p1);
+    tri.aab.merge(p2);
+    tri.aab.merge(p3);
+    tri.aab.setMinimum(tri.aab.getMinimum() - 0.1f);
+    tri.aab.setMaximum(tri.aab.getMaximum() + 0.1f);
+}
+
+float Collisions::hash_calc_height(unsigned int pos)
+{
+    float height = 0.f; // Initial value of the zeroed table
+    for (hash_coll_element_t const& element : hashtable[pos])
+    {
+        const float top = (element.IsCollisionTri())
+            ? m_collision_tris[element.element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX].aab.getMaximum().y
+            : m_collision_boxes[element.element_index].hi.y;
+        height = std::max(height, top);
+    }
+    return height;
+}
+
+void Collisions::hash_remove_tri(int tri_index, AxisAlignedBox const& old_aab, AxisAlignedBox const& keep_area)
+{
+    Ogre::Vector3 ilo(old_aab.getMinimum() / Ogre::Real(CELL_SIZE));
+    Ogre::Vector3 ihi(old_aab.getMaximum() / Ogre::Real(CELL_SIZE));
+    ilo.makeCeil(Ogre::Vector3(0.0f));
+    ilo.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+    ihi.makeCeil(Ogre::Vector3(0.0f));
+    ihi.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+
+    int keep_lo_x = 1, keep_hi_x = 0, keep_lo_z = 1, keep_hi_z = 0;
+    if (!keep_area.isNull())
+    {
+        Ogre::Vector3 klo(keep_area.getMinimum() / Ogre::Real(CELL_SIZE));
+        Ogre::Vector3 khi(keep_area.getMaximum() / Ogre::Real(CELL_SIZE));
+        klo.makeCeil(Ogre::Vector3(0.0f));
+        klo.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+        khi.makeCeil(Ogre::Vector3(0.0f));
+        khi.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+        keep_lo_x = klo.x; keep_hi_x = khi.x;
+        keep_lo_z = klo.z; keep_hi_z = khi.z;
+    }
+
+    const int value = tri_index + hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
+    for (int i = ilo.x; i <= ihi.x; i++)
+    {
+        for (int j = ilo.z; j <= ihi.z; j++)
+        {
+            const unsigned int cell_id = (i << 16) + j;
+            const int pos = hash_find(i, j);
+            if (!(i >= keep_lo_x && i <= keep_hi_x && j >= keep_lo_z && j <= keep_hi_z))
+            {
+                std::vector<hash_coll_element_t>& entry = hashtable[pos];
+                entry.erase(std::remove_if(entry.begin(), entry.end(),
+                    [cell_id, value](hash_coll_element_t const& e) { return e.cell_id == cell_id && e.element_index == value; }),
+                    entry.end());
+            }
+            // The tri may have moved down or away; heights are shared by all cells in the entry
+            hashtable_height[pos] = this->hash_calc_height(pos);
+        }
+    }
+}
+
+void Collisions::hash_add_tri(int tri_index, AxisAlignedBox const& skip_area)
+{
+    const AxisAlignedBox& aab = m_collision_tris[tri_index].aab;
+
     // register this collision tri in the index
-    Ogre::Vector3 ilo(new_tri.aab.getMinimum() / Ogre::Real(CELL_SIZE));
-    Ogre::Vector3 ihi(new_tri.aab.getMaximum() / Ogre::Real(CELL_SIZE));
-    
+    Ogre::Vector3 ilo(aab.getMinimum() / Ogre::Real(CELL_SIZE));
+    Ogre::Vector3 ihi(aab.getMaximum() / Ogre::Real(CELL_SIZE));
+
     // clamp between 0 and MAXIMUM_CELL;
     ilo.makeCeil(Ogre::Vector3(0.0f));
     ilo.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
     ihi.makeCeil(Ogre::Vector3(0.0f));
     ihi.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
-    
+
+    // cells which are already registered (see `updateCollisionTri()`)
+    int skip_lo_x = 1, skip_hi_x = 0, skip_lo_z = 1, skip_hi_z = 0;
+    if (!skip_area.isNull())
+    {
+        Ogre::Vector3 slo(skip_area.getMinimum() / Ogre::Real(CELL_SIZE));
+        Ogre::Vector3 shi(skip_area.getMaximum() / Ogre::Real(CELL_SIZE));
+        slo.makeCeil(Ogre::Vector3(0.0f));
+        slo.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+        shi.makeCeil(Ogre::Vector3(0.0f));
+        shi.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+        skip_lo_x = slo.x; skip_hi_x = shi.x;
+        skip_lo_z = slo.z; skip_hi_z = shi.z;
+    }
+
     for (int i = ilo.x; i <= ihi.x; i++)
     {
         for (int j = ilo.z; j<=ihi.z; j++)
         {
-            hash_add(i, j, new_tri_index + hash_coll_element_t::ELEMENT_TRI_BASE_INDEX, new_tri.aab.getMaximum().y);
+            if (i >= skip_lo_x && i <= skip_hi_x && j >= skip_lo_z && j <= skip_hi_z)
+            {
+                // already listed, but the tri may have grown taller
+                const int pos = hash_find(i, j);
+                hashtable_height[pos] = std::max(hashtable_height[pos], aab.getMaximum().y);
+                continue;
+            }
+            hash_add(i, j, tri_index + hash_coll_element_t::ELEMENT_TRI_BASE_INDEX, aab.getMaximum().y);
         }
     }
+}
+
+int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model_t* gm)
+{
+    int new_tri_index = (int)m_collision_tris.size();
+    collision_tri_t new_tri;
+    SetupCollisionTri(new_tri, p1, p2, p3, gm);
 
     m_collision_aab.merge(new_tri.aab);
     m_collision_tris.push_back(new_tri);
+    hash_add_tri(new_tri_index, AxisAlignedBox::BOX_NULL);
     return new_tri_index;
 }
 
-void Collisions::envokeScriptCallback(collision_box_t *cbox, node_t *node)
+void Collisions::updateCollisionTri(int number, Vector3 p1, Vector3 p2, Vector3 p3, ground_model_t* gm)
+{
+    if (number < 0 || number >= (int)m_collision_tris.size())
+        return;
+
+    // Cells covered by both the old and the new AAB keep their entry; the others are unlisted/added.
+    const AxisAlignedBox old_aab = m_collision_tris[number].aab;
+    SetupCollisionTri(m_collision_tris[number], p1, p2, p3, gm);
+
+    m_collision_aab.merge(m_collision_tris[number].aab);
+    hash_remove_tri(number, old_aab, m_collision_tris[number].aab);
+    hash_add_tri(number, old_aab);
+}
+
+void Collisions::envokeScriptCallback(collision_box_t *cbox, node_t *node, int actor_instance_id)
 {
 #ifdef USE_ANGELSCRIPT
     // check if this box is active anymore
@@ -604,6 +735,12 @@ void Collisions::envokeScriptCallback(collision_box_t *cbox, node_t *node)
         return;
     
     std::lock_guard<std::mutex> lock(m_scriptcallback_mutex);
+    if (App::sim_deterministic->getBool())
+    {
+        // Physics threads get here in random order - see `FlushDeferredScriptCallbacks()`
+        m_deferred_callbacks.push_back({cbox, node, actor_instance_id});
+        return;
+    }
     // this prevents that the same callback gets called at 2k FPS all the time, serious hit on FPS ...
     if (std::find(std::begin(m_last_called_cboxes), std::end(m_last_called_cboxes), cbox) == m_last_called_cboxes.end())
     {
@@ -613,6 +750,48 @@ void Collisions::envokeScriptCallback(collision_box_t *cbox, node_t *node)
 #endif //USE_ANGELSCRIPT
 }
 
+void Collisions::requestEventCacheClear()
+{
+    if (App::sim_deterministic->getBool())
+        m_deferred_cache_clear = true; // Applied by `FlushDeferredScriptCallbacks()`
+    else
+        clearEventCache();
+}
+
+void Collisions::FlushDeferredScriptCallbacks()
+{
+#ifdef USE_ANGELSCRIPT
+    std::lock_guard<std::mutex> lock(m_scriptcallback_mutex);
+    if (m_deferred_cache_clear)
+    {
+        m_last_called_cboxes.clear();
+        m_deferred_cache_clear = false;
+    }
+    // Order by event source, actor and node number, so the outcome doesn't depend on thread timing
+    auto node_num = [](node_t* node) { return (node != nullptr) ? static_cast<int>(node->pos) : -1; };
+    std::stable_sort(m_deferred_callbacks.begin(), m_deferred_callbacks.end(),
+        [node_num](deferred_callback_t const& a, deferred_callback_t const& b)
+        {
+            if (a.cbox->eventsourcenum != b.cbox->eventsourcenum)
+                return a.cbox->eventsourcenum < b.cbox->eventsourcenum;
+            if (a.actor_instance_id != b.actor_instance_id)
+                return a.actor_instance_id < b.actor_instance_id;
+            return node_num(a.node) < node_num(b.node);
+        });
+    for (auto& entry : m_deferred_callbacks)
+    {
+        collision_box_t* cbox = entry.cbox;
+        if (eventsources[cbox->eventsourcenum].enabled &&
+            std::find(std::begin(m_last_called_cboxes), std::end(m_last_called_cboxes), cbox) == m_last_called_cboxes.end())
+        {
+            App::GetScriptEngine()->envokeCallback(eventsources[cbox->eventsourcenum].scripthandler, &eventsources[cbox->eventsourcenum], entry.node);
+            m_last_called_cboxes.push_back(cbox);
+        }
+    }
+    m_deferred_callbacks.clear();
+#endif //USE_ANGELSCRIPT
+}
+
 std::pair<bool, Ogre::Real> Collisions::intersectsTris(Ogre::Ray ray)
 {
     int steps = ray.getDirection().length() / (float)CELL_SIZE;
@@ -876,7 +1055,7 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
     }
 
     if (envokeScriptCallbacks && !isScriptCallbackEnvoked)
-        clearEventCache();
+        requestEventCacheClear();
 
     // process minctri collision
     if (minctri)
@@ -891,6 +1070,188 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
     return contacted;
 }
 
+/// Narrows [t0, t1] to the part of the path `p + t * d` which lies between `lo` and `hi`.
+static bool ClipPathToSlab(float p, float d, float lo, float hi, float& t0, float& t1)
+{
+    if (std::abs(d) < 1e-6f)
+    {
+        return (p >= lo && p <= hi);
+    }
+    float ta = (lo - p) / d;
+    float tb = (hi - p) / d;
+    if (ta > tb)
+    {
+        std::swap(ta, tb);
+    }
+    t0 = std::max(t0, ta);
+    t1 = std::min(t1, tb);
+    return t0 <= t1;
+}
+
+static bool ClipPathToBox(Vector3 const& p, Vector3 const& d, Vector3 const& lo, Vector3 const& hi, float& t0, float& t1)
+{
+    return ClipPathToSlab(p.x, d.x, lo.x, hi.x, t0, t1)
+        && ClipPathToSlab(p.y, d.y, lo.y, hi.y, t0, t1)
+        && ClipPathToSlab(p.z, d.z, lo.z, hi.z, t0, t1);
+}
+
+/// Transforms a world position into the refined/selfrotated frame of `cbox`, see `collisionCorrect()`
+static Vector3 ToBoxFrame(collision_box_t const* cbox, Vector3 pos)
+{
+    pos = pos - cbox->center;
+    if (cbox->refined)
+    {
+        pos = cbox->unrot * pos;
+    }
+    if (cbox->selfrotated)
+    {
+        pos = cbox->selfunrot * (pos - cbox->selfcenter) + cbox->selfcenter;
+    }
+    return pos;
+}
+
+static Vector3 FromBoxFrame(collision_box_t const* cbox, Vector3 pos)
+{
+    if (cbox->selfrotated)
+    {
+        pos = cbox->selfrot * (pos - cbox->selfcenter) + cbox->selfcenter;
+    }
+    if (cbox->refined)
+    {
+        pos = cbox->rot * pos;
+    }
+    return pos + cbox->center;
+}
+
+bool Collisions::sweepCapsule(Vector3 start, Vector3 end, float radius, float* out_t, Vector3* out_corrected)
+{
+    const Vector3 path = end - start;
+    const Vector3 inflate(radius);
+
+    // find the cells under the capsule
+    const int lo_x = (int)((std::min(start.x, end.x) - radius) / (float)CELL_SIZE);
+    const int hi_x = (int)((std::max(start.x, end.x) + radius) / (float)CELL_SIZE);
+    const int lo_z = (int)((std::min(start.z, end.z) - radius) / (float)CELL_SIZE);
+    const int hi_z = (int)((std::max(start.z, end.z) + radius) / (float)CELL_SIZE);
+    const float lowest_y = std::min(start.y, end.y) - radius;
+
+    float min_t = std::numeric_limits<float>::max();
+    int min_element = -1;
+    std::vector<int> visited_hashes;
+
+    for (int cell_x = lo_x; cell_x <= hi_x; cell_x++)
+    {
+        for (int cell_z = lo_z; cell_z <= hi_z; cell_z++)
+        {
+            int hash = hash_find(cell_x, cell_z);
+            if (lowest_y > hashtable_height[hash])
+                continue;
+            if (std::find(visited_hashes.begin(), visited_hashes.end(), hash) != visited_hashes.end())
+                continue;
+            visited_hashes.push_back(hash);
+
+            size_t num_elements = hashtable[hash].size();
+            for (size_t k = 0; k < num_elements; k++)
+            {
+                float t0 = 0.f;
+                float t1 = 1.f;
+                if (hashtable[hash][k].IsCollisionBox())
+                {
+                    collision_box_t* cbox = &m_collision_boxes[hashtable[hash][k].element_index];
+
+                    if (!cbox->enabled || cbox->virt)
+                        continue;
+                    if (!ClipPathToBox(start, path, cbox->lo - inflate, cbox->hi + inflate, t0, t1))
+                        continue;
+
+                    if (cbox->refined || cbox->selfrotated)
+                    {
+                        // the frame change is affine, so the path stays a straight line
+                        Vector3 local_start = ToBoxFrame(cbox, start);
+                        Vector3 local_path = ToBoxFrame(cbox, end) - local_start;
+                        if (!ClipPathToBox(local_start, local_path, cbox->relo - inflate, cbox->rehi + inflate, t0, t1))
+                            continue;
+                    }
+                }
+                else // The element is a triangle
+                {
+                    const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
+                    collision_tri_t *ctri = &m_collision_tris[ctri_index];
+
+                    if (!ctri->enabled)
+                        continue;
+                    if (!ClipPathToBox(start, path, ctri->aab.getMinimum() - inflate, ctri->aab.getMaximum() + inflate, t0, t1))
+                        continue;
+
+                    // clip against the tri collision volume (see `collisionCorrect()`) grown by the radius;
+                    // rows of `forward` are the in-plane gradients of the tri coordinates
+                    Vector3 local_start = ctri->forward * (start - ctri->a);
+                    Vector3 local_path = ctri->forward * path;
+                    const float grow_x = radius * Vector3(ctri->forward[0][0], ctri->forward[0][1], ctri->forward[0][2]).length();
+                    const float grow_y = radius * Vector3(ctri->forward[1][0], ctri->forward[1][1], ctri->forward[1][2]).length();
+                    const float grow_xy = radius * Vector3(ctri->forward[0][0] + ctri->forward[1][0],
+                                                           ctri->forward[0][1] + ctri->forward[1][1],
+                                                           ctri->forward[0][2] + ctri->forward[1][2]).length();
+                    const float unbounded = std::numeric_limits<float>::max();
+                    if (!ClipPathToSlab(local_start.x, local_path.x, -grow_x, unbounded, t0, t1) ||
+                        !ClipPathToSlab(local_start.y, local_path.y, -grow_y, unbounded, t0, t1) ||
+                        !ClipPathToSlab(local_start.x + local_start.y, local_path.x + local_path.y, -unbounded, 1.f + grow_xy, t0, t1) ||
+                        !ClipPathToSlab(local_start.z, local_path.z, -0.1f - radius, radius, t0, t1))
+                        continue;
+                }
+
+                if (t0 < min_t)
+                {
+                    min_t = t0;
+                    min_element = hashtable[hash][k].element_index;
+                }
+            }
+        }
+    }
+
+    if (min_element == -1)
+        return false;
+
+    if (out_t)
+    {
+        *out_t = min_t;
+    }
+
+    if (out_corrected)
+    {
+        Vector3 pos = start + path * min_t;
+        if (min_element < hash_coll_element_t::ELEMENT_TRI_BASE_INDEX)
+        {
+            collision_box_t* cbox = &m_collision_boxes[min_element];
+            if (cbox->refined || cbox->selfrotated)
+            {
+                Vector3 local = ToBoxFrame(cbox, pos);
+                if (local > cbox->relo && local < cbox->rehi)
+                {
+                    pos = FromBoxFrame(cbox, calcCollidedSide(local, cbox->relo, cbox->rehi));
+                }
+            }
+            else if (pos > cbox->lo && pos < cbox->hi)
+            {
+                pos = calcCollidedSide(pos, cbox->lo, cbox->hi);
+            }
+        }
+        else
+        {
+            collision_tri_t *ctri = &m_collision_tris[min_element - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX];
+            Vector3 local = ctri->forward * (pos - ctri->a);
+            if (local.z < 0.f)
+            {
+                local.z = 0.f;
+                pos = (ctri->reverse * local) + ctri->a;
+            }
+        }
+        *out_corrected = pos;
+    }
+
+    return true;
+}
+
 bool Collisions::permitEvent(CollisionEventFilter filter)
 {
     Actor *b = App::GetGameContext()->GetPlayerActor();
@@ -914,7 +1275,7 @@ bool Collisions::permitEvent(CollisionEventFilter filter)
     }
 }
 
-bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallbacks)
+bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallbacks, int actor_instance_id)
 {
     // find the correct cell
     int refx = (int)(node->AbsPosition.x / CELL_SIZE);
@@ -967,7 +1328,7 @@ bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallback
                     {
                         if (cbox->eventsourcenum!=-1 && permitEvent(cbox->event_filter) && envokeScriptCallbacks)
                         {
-                            envokeScriptCallback(cbox, node);
+                            envokeScriptCallback(cbox, node, actor_instance_id);
                             isScriptCallbackEnvoked = true;
                         }
                         if (cbox->camforced && !forcecam)
@@ -1007,7 +1368,7 @@ bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallback
                 {
                     if (cbox->eventsourcenum!=-1 && permitEvent(cbox->event_filter) && envokeScriptCallbacks)
                     {
-                        envokeScriptCallback(cbox, node);
+                        envokeScriptCallback(cbox, node, actor_instance_id);
                         isScriptCallbackEnvoked = true;
                     }
                     if (cbox->camforced && !forcecam)
@@ -1072,7 +1433,7 @@ bool Collisions::nodeCollision(node_t *node, float dt, bool envokeScriptCallback
     }
 
     if (envokeScriptCallbacks && !isScriptCallbackEnvoked)
-        clearEventCache();
+        requestEventCacheClear();
 
     // process minctri collision
     if (minctri && !envokeScriptCallbacks)
@@ -1412,7 +1773,7 @@ void Collisions::addCollisionMesh(Ogre::String const& srcname, Ogre::String cons
     App::GetGfxScene()->GetSceneManager()->destroyEntity(ent);
 }
 
-void Collisions::registerCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, AxisAlignedBox bounding_box, ground_model_t* gm, int ctri_start, int ctri_count)
+int Collisions::registerCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, AxisAlignedBox bounding_box, ground_model_t* gm, int ctri_start, int ctri_count)
 {
     // Submit the mesh record
     collision_mesh_t rec;
@@ -1424,6 +1785,20 @@ void Collisions::registerCollisionMesh(Ogre::String const& srcname, Ogre::String
     rec.collision_tri_count = ctri_count;
     rec.bounding_box = bounding_box;
     m_collision_meshes.push_back(rec);
+    return (int)m_collision_meshes.size() - 1;
+}
+
+void Collisions::updateCollisionMesh(int index, Ogre::Vector3 const& pos, AxisAlignedBox bounding_box, std::vector<int> const& ctris)
+{
+    if (index < 0 || index >= (int)m_collision_meshes.size())
+        return;
+
+    collision_mesh_t& rec = m_collision_meshes[index];
+    rec.position = pos;
+    rec.bounding_box = bounding_box;
+    rec.collision_tris = ctris;
+    rec.collision_tri_start = (ctris.empty()) ? -1 : *std::min_element(ctris.begin(), ctris.end());
+    rec.collision_tri_count = (int)ctris.size();
 }
 
 void Collisions::getMeshInformation(Mesh* mesh,size_t &vertex_count,Ogre::Vector3* &vertices,
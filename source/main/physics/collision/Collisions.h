@@ -25,6 +25,8 @@
 #include "Application.h"
 #include "SimData.h" // for collision_box_t
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <Ogre.h>
 
@@ -72,6 +74,7 @@ struct collision_mesh_t
     ground_model_t* ground_model = nullptr;
     int collision_tri_start = -1;
     int collision_tri_count = 0;
+    std::vector<int> collision_tris; //!< If not empty, used instead of the range above (edited meshes).
     int num_verts = 0;
     int num_indices = 0;
 };
@@ -131,6 +134,14 @@ private:
     // collision boxes pool
     CollisionBoxVec m_collision_boxes; // Formerly MAX_COLLISION_BOXES = 5000
     std::vector<collision_box_t*> m_last_called_cboxes;
+    struct deferred_callback_t
+    {
+        collision_box_t* cbox;
+        node_t* node;
+        int actor_instance_id; // Owner of `node`, -1 if none
+    };
+    std::vector<deferred_callback_t> m_deferred_callbacks; // Deterministic mode: collected by physics threads, envoked in defined order
+    std::atomic<bool> m_deferred_cache_clear{false};
 
     // collision tris pool
     CollisionTriVec m_collision_tris; // Formerly MAX_COLLISION_TRIS = 100000
@@ -150,7 +161,8 @@ private:
     int free_eventsource;
 
     bool permitEvent(CollisionEventFilter filter);
-    void envokeScriptCallback(collision_box_t* cbox, node_t* node = 0);
+    void envokeScriptCallback(collision_box_t* cbox, node_t* node = 0, int actor_instance_id = -1);
+    void requestEventCacheClear();
 
     Landusemap* landuse;
     int collision_version;
@@ -159,9 +171,15 @@ private:
     const Ogre::Vector3 m_terrain_size;
 
     void hash_add(int cell_x, int cell_z, int value, float h);
+    void hash_add_tri(int tri_index, Ogre::AxisAlignedBox const& skip_area); //!< Registers the tri's AAB cells, except those fully covered by `skip_area` cells
+    void hash_remove_tri(int tri_index, Ogre::AxisAlignedBox const& old_aab, Ogre::AxisAlignedBox const& keep_area); //!< Unlists the tri from `old_aab` cells outside `keep_area` cells; recalculates heights of all `old_aab` cells
+    float hash_calc_height(unsigned int pos); //!< Top of the tallest element in the 'hashtable' entry
     int hash_find(int cell_x, int cell_z); /// Returns index to 'hashtable'
     unsigned int hashfunc(unsigned int cellid);
     void parseGroundConfig(Ogre::ConfigFile* cfg, Ogre::String groundModel = "");
+    int processGroundModelsConfig(Ogre::ConfigFile* cfg);
+
+    static std::unique_ptr<Ogre::ConfigFile> s_default_models_cfg; //!< See `PreloadDefaultModels()`
 
     Ogre::Vector3 calcCollidedSide(const Ogre::Vector3& pos, const Ogre::Vector3& lo, const Ogre::Vector3& hi);
 
@@ -185,25 +203,35 @@ public:
     float getSurfaceHeight(float x, float z);
     float getSurfaceHeightBelow(float x, float z, float height);
     bool collisionCorrect(Ogre::Vector3* refpos, bool envokeScriptCallbacks = true);
+    /// Moves a sphere of `radius` from `start` to `end` and finds where the covered capsule first touches a solid box or tri volume.
+    /// Only the grid cells under the capsule are visited and the path is clipped against each volume analytically. No script events.
+    /// @param out_t Fraction of the path at the first contact.
+    /// @param out_corrected Contact point pushed out of the volume, like `collisionCorrect()` does.
+    /// @return False if the path is free.
+    bool sweepCapsule(Ogre::Vector3 start, Ogre::Vector3 end, float radius, float* out_t, Ogre::Vector3* out_corrected = nullptr);
     bool groundCollision(node_t* node, float dt);
     bool isInside(Ogre::Vector3 pos, const Ogre::String& inst, const Ogre::String& box, float border = 0);
     bool isInside(Ogre::Vector3 pos, collision_box_t* cbox, float border = 0);
-    bool nodeCollision(node_t* node, float dt, bool envokeScriptCallbacks = true);
+    bool nodeCollision(node_t* node, float dt, bool envokeScriptCallbacks = true, int actor_instance_id = -1); //!< @param actor_instance_id Owner of the node; orders the script callbacks in deterministic mode
 
     void finishLoadingTerrain();
 
     int addCollisionBox(Ogre::SceneNode* tenode, bool rotating, bool virt, Ogre::Vector3 pos, Ogre::Vector3 rot, Ogre::Vector3 l, Ogre::Vector3 h, Ogre::Vector3 sr, const Ogre::String& eventname, const Ogre::String& instancename, bool forcecam, Ogre::Vector3 campos, Ogre::Vector3 sc = Ogre::Vector3::UNIT_SCALE, Ogre::Vector3 dr = Ogre::Vector3::ZERO, CollisionEventFilter event_filter = EVENT_ALL, int scripthandler = -1);
     void addCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::Quaternion const& q, Ogre::Vector3 const& scale, ground_model_t* gm = 0, std::vector<int>* collTris = 0); //!< generate collision tris from existing mesh resource
-    void registerCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::AxisAlignedBox bounding_box, ground_model_t* gm, int ctri_start, int ctri_count); //!< Mark already generated collision tris as belonging to (virtual) mesh.
+    int registerCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::AxisAlignedBox bounding_box, ground_model_t* gm, int ctri_start, int ctri_count); //!< Mark already generated collision tris as belonging to (virtual) mesh. Returns index of the record.
+    void updateCollisionMesh(int index, Ogre::Vector3 const& pos, Ogre::AxisAlignedBox bounding_box, std::vector<int> const& ctris); //!< Updates a registered record after its tris were edited; `ctris` needn't be contiguous.
     int addCollisionTri(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, ground_model_t* gm);
+    void updateCollisionTri(int number, Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, ground_model_t* gm); //!< Moves an existing tri in place (re-enables it); the number stays valid.
     void createCollisionDebugVisualization(Ogre::SceneNode* root_node, Ogre::AxisAlignedBox const& area_limit, std::vector<Ogre::SceneNode*>& out_nodes);
     void removeCollisionBox(int number);
     void removeCollisionTri(int number);
     void clearEventCache() { m_last_called_cboxes.clear(); }
+    void FlushDeferredScriptCallbacks(); //!< Deterministic mode: envokes the callbacks collected during the last substep
 
     Ogre::AxisAlignedBox getCollisionAAB() { return m_collision_aab; };
 
     // ground models things
+    static void PreloadDefaultModels(); //!< Reads 'ground_models.cfg' once for all terrains; thread safe, must finish before the first `Collisions` is created.
     int loadDefaultModels();
     int loadGroundModelsConfigFile(Ogre::String filename);
     std::map<Ogre::String, ground_model_t>* getGroundModels() { return &ground_models; };
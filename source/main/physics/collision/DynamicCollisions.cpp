@@ -26,6 +26,7 @@
 #include "SimData.h"
 #include "CartesianToTriangleTransform.h"
 #include "Collisions.h"
+#include "IntraCollisionPairs.h"
 #include "PointColDetector.h"
 #include "Triangle.h"
 
@@ -197,7 +198,7 @@ void RoR::ResolveInterActorCollisions(const float dt, PointColDetector &interPoi
 }
 
 
-void RoR::ResolveIntraActorCollisions(const float dt, PointColDetector &intraPointCD,
+void RoR::ResolveIntraActorCollisions(const float dt, IntraCollisionPairs const& intraPairs,
         const int free_collcab, int collcabs[], int cabs[],
         collcab_rate_t intra_collcabrate[], node_t nodes[],
         const float collrange,
@@ -222,25 +223,35 @@ void RoR::ResolveIntraActorCollisions(const float dt, PointColDetector &intraPoi
         const auto na = &nodes[cabs[tmpv+1]];
         const auto nb = &nodes[cabs[tmpv+2]];
 
-        intraPointCD.query(no->AbsPosition
-                , na->AbsPosition
-                , nb->AbsPosition, collrange);
+        NodeNum_t const* candidates_begin = intraPairs.GetCandidatesBegin(i);
+        NodeNum_t const* candidates_end = intraPairs.GetCandidatesEnd(i);
 
         bool collision = false;
 
-        if (!intraPointCD.hit_list.empty())
+        if (candidates_begin != candidates_end)
         {
             // setup transformation of points to triangle local coordinates
             const Triangle triangle(na->AbsPosition, nb->AbsPosition, no->AbsPosition);
             const CartesianToTriangleTransform transform(triangle);
 
-            for (auto h : intraPointCD.hit_list)
+            // the candidates were gathered with a margin - narrow down to the triangle's bounding box
+            Vector3 bbmin = no->AbsPosition;
+            bbmin.makeFloor(na->AbsPosition);
+            bbmin.makeFloor(nb->AbsPosition);
+            bbmin -= collrange;
+            Vector3 bbmax = no->AbsPosition;
+            bbmax.makeCeil(na->AbsPosition);
+            bbmax.makeCeil(nb->AbsPosition);
+            bbmax += collrange;
+
+            for (NodeNum_t const* itor = candidates_begin; itor != candidates_end; ++itor)
             {
-                const auto hitnode = &nodes[h->node_id];
+                const auto hitnode = &nodes[*itor];
 
-                //ignore wheel/chassis self contact
-                if (hitnode->nd_tyre_node) continue;
-                if (no == hitnode || na == hitnode || nb == hitnode) continue;
+                const Vector3& pos = hitnode->AbsPosition;
+                if (pos.x < bbmin.x || pos.y < bbmin.y || pos.z < bbmin.z ||
+                    pos.x > bbmax.x || pos.y > bbmax.y || pos.z > bbmax.z)
+                    continue;
 
                 // transform point to triangle local coordinates
                 const auto local_point = transform(hitnode->AbsPosition);
@@ -38,7 +38,7 @@ void ResolveInterActorCollisions(const float dt, PointColDetector &interPointCD,
         const float collrange,
         ground_model_t &submesh_ground_model);
 
-void ResolveIntraActorCollisions(const float dt, PointColDetector &intraPointCD,
+void ResolveIntraActorCollisions(const float dt, IntraCollisionPairs const& intraPairs,
         const int free_collcab, int collcabs[], int cabs[],
         collcab_rate_t intra_collcabrate[], node_t nodes[],
         const float collrange,
@@ -0,0 +1,128 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "IntraCollisionPairs.h"
+
+#include "Actor.h"
+#include "PointColDetector.h"
+
+#include <algorithm>
+
+using namespace Ogre;
+using namespace RoR;
+
+const float IntraCollisionPairs::MARGIN = 0.05f;
+
+void IntraCollisionPairs::Update(Actor* actor, PointColDetector& detector)
+{
+    if (this->NeedsRefresh(actor))
+    {
+        this->Refresh(actor, detector);
+    }
+}
+
+bool IntraCollisionPairs::NeedsRefresh(Actor* actor) const
+{
+    if (actor->ar_num_collcabs != m_num_collcabs ||
+        actor->ar_num_contacters != m_num_contacters ||
+        actor->ar_collision_range != m_collrange ||
+        actor->ar_num_nodes != static_cast<int>(m_ref_positions.size()))
+    {
+        return true;
+    }
+
+    if (m_ref_positions.empty())
+    {
+        return false;
+    }
+
+    // A common translation doesn't change any pair - only check motion relative to the mean
+    Vector3 mean_motion = Vector3::ZERO;
+    for (int i = 0; i < actor->ar_num_nodes; i++)
+    {
+        mean_motion += actor->ar_nodes[i].AbsPosition - m_ref_positions[i];
+    }
+    mean_motion /= static_cast<Real>(actor->ar_num_nodes);
+
+    // Both the node and the cab vertices may move by this much, together less than the margin
+    const float limit_sq = (MARGIN * 0.5f) * (MARGIN * 0.5f);
+    for (int i = 0; i < actor->ar_num_nodes; i++)
+    {
+        const Vector3 motion = actor->ar_nodes[i].AbsPosition - m_ref_positions[i] - mean_motion;
+        if (motion.squaredLength() > limit_sq)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void IntraCollisionPairs::Refresh(Actor* actor, PointColDetector& detector)
+{
+    detector.UpdateIntraPoint();
+
+    m_offsets.resize(actor->ar_num_collcabs + 1);
+    m_candidates.clear();
+
+    // Not available for actors built outside of `ActorSpawner`
+    const bool use_connectivity = (static_cast<int>(actor->ar_node_to_node_connections.size()) == actor->ar_num_nodes);
+    auto is_connected = [actor](int node, int cab_vertex)
+    {
+        std::vector<int> const& neighbours = actor->ar_node_to_node_connections[cab_vertex];
+        return std::find(neighbours.begin(), neighbours.end(), node) != neighbours.end();
+    };
+
+    for (int i = 0; i < actor->ar_num_collcabs; i++)
+    {
+        m_offsets[i] = m_candidates.size();
+
+        const int tmpv = actor->ar_collcabs[i] * 3;
+        const int no = actor->ar_cabs[tmpv];
+        const int na = actor->ar_cabs[tmpv + 1];
+        const int nb = actor->ar_cabs[tmpv + 2];
+
+        detector.query(actor->ar_nodes[no].AbsPosition,
+            actor->ar_nodes[na].AbsPosition,
+            actor->ar_nodes[nb].AbsPosition, actor->ar_collision_range + MARGIN);
+
+        for (auto h : detector.hit_list)
+        {
+            // ignore wheel/chassis self contact, the cab's own vertices and their neighbours
+            if (actor->ar_nodes[h->node_id].nd_tyre_node)
+                continue;
+            if (h->node_id == no || h->node_id == na || h->node_id == nb)
+                continue;
+            if (use_connectivity &&
+                (is_connected(h->node_id, no) || is_connected(h->node_id, na) || is_connected(h->node_id, nb)))
+                continue;
+
+            m_candidates.push_back(static_cast<NodeNum_t>(h->node_id));
+        }
+        std::sort(m_candidates.begin() + m_offsets[i], m_candidates.end());
+    }
+    m_offsets[actor->ar_num_collcabs] = m_candidates.size();
+
+    m_ref_positions.resize(actor->ar_num_nodes);
+    for (int i = 0; i < actor->ar_num_nodes; i++)
+    {
+        m_ref_positions[i] = actor->ar_nodes[i].AbsPosition;
+    }
+    m_num_collcabs = actor->ar_num_collcabs;
+    m_num_contacters = actor->ar_num_contacters;
+    m_collrange = actor->ar_collision_range;
+}
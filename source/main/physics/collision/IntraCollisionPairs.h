@@ -0,0 +1,68 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Application.h"
+#include "SimData.h"
+
+#include <Ogre.h>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Physics
+/// @{
+
+/// @addtogroup Collisions
+/// @{
+
+/// Cached collcab/contacter candidate pairs for self-collision of one actor.
+/// The pairs are gathered by `PointColDetector` with the collision range grown by `MARGIN`
+/// and reused until some node moved more than `MARGIN / 2` relative to the mean motion of the actor,
+/// so no contact can be missed in between. Left out when gathering are tyre nodes, the vertices of the cab
+/// itself and nodes beam-connected to them (see `Actor::ar_node_to_node_connections`), which lie on or next to
+/// the cab's plane by construction. Candidates are sorted by node number, so results don't depend on the kd-tree layout.
+class IntraCollisionPairs
+{
+public:
+    static const float MARGIN; //!< Meters
+
+    /// Re-gathers the pairs if the cached ones may be stale. Call once per substep, before reading candidates.
+    void Update(Actor* actor, PointColDetector& detector);
+
+    /// Candidate contacters (node numbers) for the n-th collcab, as a [begin, end) range.
+    NodeNum_t const* GetCandidatesBegin(int collcab) const { return m_candidates.data() + m_offsets[collcab]; }
+    NodeNum_t const* GetCandidatesEnd(int collcab) const   { return m_candidates.data() + m_offsets[collcab + 1]; }
+
+private:
+    bool NeedsRefresh(Actor* actor) const;
+    void Refresh(Actor* actor, PointColDetector& detector);
+
+    std::vector<size_t>        m_offsets;        //!< Per collcab, into `m_candidates`; one extra element at the end
+    std::vector<NodeNum_t>     m_candidates;
+    std::vector<Ogre::Vector3> m_ref_positions;  //!< All nodes, at the time of the last refresh
+    int                        m_num_collcabs = -1;
+    int                        m_num_contacters = -1;
+    float                      m_collrange = 0.f;
+};
+
+/// @} // addtogroup Collisions
+/// @} // addtogroup Physics
+
+} // namespace RoR
@@ -0,0 +1,245 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NodeSpatialIndex.h"
+
+#include "Actor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Ogre;
+using namespace RoR;
+
+const float NodeSpatialIndex::CELL_SIZE = 2.f;
+
+static bool IsFinite(Vector3 const& v)
+{
+    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+}
+
+int NodeSpatialIndex::CalcCell(float coord) const
+{
+    const float cell = std::floor(coord / CELL_SIZE);
+    if (!(cell > -MAX_CELL)) // Also NaN
+        return -MAX_CELL;
+    if (cell > MAX_CELL)
+        return MAX_CELL;
+    return static_cast<int>(cell);
+}
+
+size_t NodeSpatialIndex::CalcBucket(int x, int y, int z) const
+{
+    // Classic spatial hash (Teschner et al.)
+    const size_t h = (static_cast<size_t>(x) * 73856093u) ^ (static_cast<size_t>(y) * 19349663u) ^ (static_cast<size_t>(z) * 83492791u);
+    return h & m_bucket_mask;
+}
+
+void NodeSpatialIndex::Clear()
+{
+    m_entries.clear();
+    m_bucket_start.clear();
+    m_bucket_mask = 0;
+    m_bounds.setNull();
+}
+
+void NodeSpatialIndex::Rebuild(std::vector<Actor*> const& actors)
+{
+    size_t num_nodes = 0;
+    for (Actor* actor : actors)
+    {
+        num_nodes += actor->ar_num_nodes;
+    }
+
+    // Power-of-two bucket count, ~2 buckets per node keeps the chains short
+    size_t num_buckets = 64;
+    while (num_buckets < num_nodes * 2)
+    {
+        num_buckets *= 2;
+    }
+    m_bucket_mask = num_buckets - 1;
+
+    // Counting sort by bucket; `m_bucket_start` first holds counts, then offsets
+    std::vector<Entry>& unsorted = m_rebuild_scratch;
+    unsorted.clear();
+    unsorted.reserve(num_nodes);
+    m_bucket_start.assign(num_buckets + 1, 0);
+    m_bounds.setNull();
+    for (Actor* actor : actors)
+    {
+        for (NodeNum_t i = 0; i < actor->ar_num_nodes; i++)
+        {
+            if (!IsFinite(actor->ar_nodes[i].AbsPosition))
+                continue; // Exploded actor - nothing to find there
+
+            Entry e;
+            e.ref.actor = actor;
+            e.ref.node_num = i;
+            e.ref.pos = actor->ar_nodes[i].AbsPosition;
+            e.cell_x = this->CalcCell(e.ref.pos.x);
+            e.cell_y = this->CalcCell(e.ref.pos.y);
+            e.cell_z = this->CalcCell(e.ref.pos.z);
+            m_bucket_start[this->CalcBucket(e.cell_x, e.cell_y, e.cell_z) + 1]++;
+            m_bounds.merge(e.ref.pos);
+            unsorted.push_back(e);
+        }
+    }
+    for (size_t b = 0; b < num_buckets; b++)
+    {
+        m_bucket_start[b + 1] += m_bucket_start[b];
+    }
+
+    m_entries.resize(unsorted.size());
+    std::vector<size_t> fill(m_bucket_start.begin(), m_bucket_start.end() - 1);
+    for (Entry const& e : unsorted)
+    {
+        m_entries[fill[this->CalcBucket(e.cell_x, e.cell_y, e.cell_z)]++] = e;
+    }
+}
+
+void NodeSpatialIndex::QueryRadius(Ogre::Vector3 const& center, float radius, std::vector<NodeRef>& out, NodeFilter const& filter) const
+{
+    if (m_entries.empty() || !(radius >= 0.f) || !IsFinite(center))
+        return;
+    radius = std::min(radius, MAX_CELL * CELL_SIZE);
+
+    const float radius_sq = radius * radius;
+    auto visit = [&](NodeRef const& ref)
+    {
+        if (ref.pos.squaredDistance(center) <= radius_sq && (!filter || filter(ref)))
+            out.push_back(ref);
+    };
+
+    const int x0 = this->CalcCell(center.x - radius), x1 = this->CalcCell(center.x + radius);
+    const int y0 = this->CalcCell(center.y - radius), y1 = this->CalcCell(center.y + radius);
+    const int z0 = this->CalcCell(center.z - radius), z1 = this->CalcCell(center.z + radius);
+    const size_t num_cells = size_t(x1 - x0 + 1) * size_t(y1 - y0 + 1) * size_t(z1 - z0 + 1);
+    if (num_cells > m_entries.size())
+    {
+        // Huge radius - a plain scan is cheaper than visiting mostly empty cells
+        for (Entry const& e : m_entries)
+            visit(e.ref);
+        return;
+    }
+
+    for (int x = x0; x <= x1; x++)
+        for (int y = y0; y <= y1; y++)
+            for (int z = z0; z <= z1; z++)
+                this->ForEachInCell(x, y, z, visit);
+}
+
+void NodeSpatialIndex::QueryNearest(Ogre::Vector3 const& center, size_t count, float max_radius, std::vector<NodeRef>& out, NodeFilter const& filter) const
+{
+    out.clear();
+    if (count == 0 || !(max_radius >= 0.f) || !IsFinite(center))
+        return;
+    max_radius = std::min(max_radius, MAX_CELL * CELL_SIZE);
+
+    // Grow the search sphere until it holds enough nodes
+    float radius = std::min(CELL_SIZE, max_radius);
+    while (true)
+    {
+        out.clear();
+        this->QueryRadius(center, radius, out, filter);
+        if (out.size() >= count || radius >= max_radius)
+            break;
+        radius = std::min(radius * 2.f, max_radius);
+    }
+
+    auto nearer = [&center](NodeRef const& a, NodeRef const& b) { return a.pos.squaredDistance(center) < b.pos.squaredDistance(center); };
+    if (out.size() > count)
+    {
+        std::partial_sort(out.begin(), out.begin() + count, out.end(), nearer);
+        out.resize(count);
+    }
+    else
+    {
+        std::sort(out.begin(), out.end(), nearer);
+    }
+}
+
+bool NodeSpatialIndex::QueryRay(Ogre::Ray const& ray, float max_dist, float node_radius, NodeRef& out_hit, float& out_dist, NodeFilter const& filter) const
+{
+    if (m_entries.empty() || !IsFinite(ray.getOrigin()) || !IsFinite(ray.getDirection()) || ray.getDirection().isZeroLength()
+        || !(max_dist >= 0.f) || !(node_radius >= 0.f) || !std::isfinite(node_radius))
+        return false;
+
+    const Ray nray(ray.getOrigin(), ray.getDirection().normalisedCopy());
+    const Vector3 dir = nray.getDirection();
+
+    // Only walk the part of the ray that passes the occupied space - a miss would otherwise step through `max_dist` of empty cells
+    AxisAlignedBox bounds = m_bounds;
+    bounds.setExtents(bounds.getMinimum() - Vector3(node_radius), bounds.getMaximum() + Vector3(node_radius));
+    Real t_enter = 0.f, t_exit = 0.f;
+    if (!Math::intersects(nray, bounds, &t_enter, &t_exit) || t_enter > max_dist)
+        return false;
+    const float t_end = std::min(max_dist, static_cast<float>(t_exit));
+    const Vector3 start = nray.getPoint(t_enter);
+
+    float best_dist = max_dist;
+    bool found = false;
+    auto visit = [&](NodeRef const& ref)
+    {
+        std::pair<bool, Real> hit = nray.intersects(Sphere(ref.pos, node_radius));
+        if (hit.first && hit.second < best_dist && (!filter || filter(ref)))
+        {
+            best_dist = hit.second;
+            out_hit = ref;
+            found = true;
+        }
+    };
+
+    // Walk the cells along the ray (3D DDA); a sphere may poke into the ray from neighbouring cells
+    const int reach = static_cast<int>(std::ceil(node_radius / CELL_SIZE));
+    int cell[3] = { this->CalcCell(start.x), this->CalcCell(start.y), this->CalcCell(start.z) };
+    int step[3];
+    float t_max[3], t_delta[3];
+    for (int a = 0; a < 3; a++)
+    {
+        step[a] = (dir[a] > 0.f) ? 1 : -1;
+        if (std::abs(dir[a]) < 1e-6f)
+        {
+            t_max[a] = t_delta[a] = std::numeric_limits<float>::max();
+            continue;
+        }
+        const float boundary = (cell[a] + (step[a] > 0 ? 1 : 0)) * CELL_SIZE;
+        t_max[a] = (boundary - nray.getOrigin()[a]) / dir[a];
+        t_delta[a] = CELL_SIZE / std::abs(dir[a]);
+    }
+
+    float t = t_enter;
+    const float cell_diagonal = CELL_SIZE * 1.7320508f;
+    while (t <= std::min(best_dist, t_end) + node_radius + cell_diagonal)
+    {
+        for (int x = cell[0] - reach; x <= cell[0] + reach; x++)
+            for (int y = cell[1] - reach; y <= cell[1] + reach; y++)
+                for (int z = cell[2] - reach; z <= cell[2] + reach; z++)
+                    this->ForEachInCell(x, y, z, visit);
+
+        const int a = (t_max[0] < t_max[1]) ? ((t_max[0] < t_max[2]) ? 0 : 2) : ((t_max[1] < t_max[2]) ? 1 : 2);
+        t = t_max[a];
+        if (t > t_end + node_radius + cell_diagonal)
+            break;
+        cell[a] += step[a];
+        t_max[a] += t_delta[a];
+    }
+
+    out_dist = best_dist;
+    return found;
+}
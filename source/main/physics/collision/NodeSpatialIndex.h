@@ -0,0 +1,103 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Application.h"
+#include "SimData.h"
+
+#include <Ogre.h>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Physics
+/// @{
+
+/// @addtogroup Collisions
+/// @{
+
+/// Scene-wide hash grid of all actor nodes, for picking and proximity queries.
+/// Rebuilt from the physics state once per frame by `ActorManager::UpdateActors()`;
+/// node positions are a snapshot from that moment. Queries are const and may run concurrently,
+/// but never together with `Rebuild()`/`Clear()`.
+class NodeSpatialIndex
+{
+public:
+    static const float CELL_SIZE; //!< Meters
+
+    struct NodeRef
+    {
+        Actor*        actor;
+        NodeNum_t     node_num;
+        Ogre::Vector3 pos;      //!< Snapshot of `node_t::AbsPosition`
+    };
+
+    typedef std::function<bool(NodeRef const&)> NodeFilter; //!< Return false to skip the node
+
+    void Rebuild(std::vector<Actor*> const& actors);
+    void Clear();
+
+    /// Appends all nodes within `radius` of `center` to `out`, in no particular order.
+    void QueryRadius(Ogre::Vector3 const& center, float radius, std::vector<NodeRef>& out, NodeFilter const& filter = nullptr) const;
+
+    /// Fills `out` with up to `count` nodes nearest to `center` (at most `max_radius` away), nearest first.
+    void QueryNearest(Ogre::Vector3 const& center, size_t count, float max_radius, std::vector<NodeRef>& out, NodeFilter const& filter = nullptr) const;
+
+    /// Finds the first node whose sphere (of `node_radius`) is hit by the ray within `max_dist`.
+    bool QueryRay(Ogre::Ray const& ray, float max_dist, float node_radius, NodeRef& out_hit, float& out_dist, NodeFilter const& filter = nullptr) const;
+
+    size_t GetNumNodes() const { return m_entries.size(); }
+
+private:
+    struct Entry
+    {
+        NodeRef ref;
+        int     cell_x, cell_y, cell_z;
+    };
+
+    static const int MAX_CELL = 1 << 20; //!< Cell coordinates are clamped to +/- this, keeping the conversion to int defined
+
+    int    CalcCell(float coord) const;
+    size_t CalcBucket(int x, int y, int z) const;
+
+    /// Visits entries of one cell (not the whole bucket - hash collisions are filtered out).
+    template <typename F> void ForEachInCell(int x, int y, int z, F func) const
+    {
+        const size_t bucket = this->CalcBucket(x, y, z);
+        for (size_t i = m_bucket_start[bucket]; i < m_bucket_start[bucket + 1]; i++)
+        {
+            const Entry& e = m_entries[i];
+            if (e.cell_x == x && e.cell_y == y && e.cell_z == z)
+                func(e.ref);
+        }
+    }
+
+    std::vector<Entry>  m_entries;       //!< Sorted by bucket
+    std::vector<size_t> m_bucket_start;  //!< Prefix sums into `m_entries`; one extra element at the end
+    size_t              m_bucket_mask = 0;
+    Ogre::AxisAlignedBox m_bounds;       //!< Around all nodes
+    std::vector<Entry>  m_rebuild_scratch; //!< Kept to avoid reallocating every frame
+};
+
+/// @} // addtogroup Collisions
+/// @} // addtogroup Physics
+
+} // namespace RoR
@@ -103,7 +103,7 @@ FlexAirfoil::FlexAirfoil(Ogre::String const & name, Actor* actor, NodeNum_t pnfl
 
     mindef=mind;
     maxdef=maxd;
-    airfoil=new Airfoil(afname);
+    airfoil=Airfoil::GetShared(afname);
     int i;
     for (i=0; i<90; i++) airfoilpos[i]=refairfoilpos[i];
     type=mtype;
@@ -589,6 +589,13 @@ void FlexAirfoil::addwash(int propid, float ratio)
 
 void FlexAirfoil::updateForces()
 {
+    this->calcForces();
+    this->applyForces();
+}
+
+void FlexAirfoil::calcForces()
+{
+    has_forces=false;
     if (!airfoil) return;
     if (broken) return;
 
@@ -643,18 +650,7 @@ void FlexAirfoil::updateForces()
     //induced drag
     if (useInducedDrag)
     {
-        Vector3 idf=(cx*cx*0.25*airdensity*wspeed*idArea*idArea/(3.14159*idSpan*idSpan))*wind;
-
-        if (idLeft)
-        {
-            nodes[nblu].Forces+=idf;
-            nodes[nbld].Forces+=idf;
-        }
-        else
-        {
-            nodes[nbru].Forces+=idf;
-            nodes[nbrd].Forces+=idf;
-        }
+        force_induced=(cx*cx*0.25*airdensity*wspeed*idArea*idArea/(3.14159*idSpan*idSpan))*wind;
     }
 
     //lift
@@ -664,24 +660,42 @@ void FlexAirfoil::updateForces()
     float moment=-cm*0.5*airdensity*wspeed*wspeed*s;//*chord;
     //apply forces
 
-    Vector3 f1=wforce*(liftcoef * 0.75/4.0f)+normv*(liftcoef *moment/(4.0f*0.25f));
-    Vector3 f2=wforce*(liftcoef *0.25/4.0f)-normv*(liftcoef *moment/(4.0f*0.75f));
+    force_front=wforce*(liftcoef * 0.75/4.0f)+normv*(liftcoef *moment/(4.0f*0.25f));
+    force_back=wforce*(liftcoef *0.25/4.0f)-normv*(liftcoef *moment/(4.0f*0.75f));
+    has_forces=true;
+}
 
-    //focal at 0.25 chord
-    nodes[nfld].Forces+=f1;
-    nodes[nflu].Forces+=f1;
-    nodes[nfrd].Forces+=f1;
-    nodes[nfru].Forces+=f1;
-    nodes[nbld].Forces+=f2;
-    nodes[nblu].Forces+=f2;
-    nodes[nbrd].Forces+=f2;
-    nodes[nbru].Forces+=f2;
+void FlexAirfoil::applyForces()
+{
+    if (!has_forces) return;
+
+    if (useInducedDrag)
+    {
+        if (idLeft)
+        {
+            nodes[nblu].Forces+=force_induced;
+            nodes[nbld].Forces+=force_induced;
+        }
+        else
+        {
+            nodes[nbru].Forces+=force_induced;
+            nodes[nbrd].Forces+=force_induced;
+        }
+    }
 
+    //focal at 0.25 chord
+    nodes[nfld].Forces+=force_front;
+    nodes[nflu].Forces+=force_front;
+    nodes[nfrd].Forces+=force_front;
+    nodes[nfru].Forces+=force_front;
+    nodes[nbld].Forces+=force_back;
+    nodes[nblu].Forces+=force_back;
+    nodes[nbrd].Forces+=force_back;
+    nodes[nbru].Forces+=force_back;
 }
 
 FlexAirfoil::~FlexAirfoil()
 {
-    if (airfoil) delete airfoil;
     if (!msh.isNull())
     {
         msh->unload();
@@ -52,7 +52,9 @@ public:
 
     void addwash(int propid, float ratio);
 
-    void updateForces();
+    void updateForces();  //!< Equals `calcForces()` + `applyForces()`
+    void calcForces();    //!< Only reads node state - wings may be computed in parallel
+    void applyForces();   //!< Adds results of `calcForces()` to nodes; wings share nodes, so run serially
 
     float aoa;
     char type;
@@ -127,7 +129,11 @@ private:
     float idArea;
     bool idLeft;
 
-    Airfoil* airfoil;
+    std::shared_ptr<Airfoil> airfoil;
+    bool has_forces;               //!< Output of `calcForces()`
+    Ogre::Vector3 force_front;     //!< Output of `calcForces()`; per leading edge node
+    Ogre::Vector3 force_back;      //!< Output of `calcForces()`; per trailing edge node
+    Ogre::Vector3 force_induced;   //!< Output of `calcForces()`; induced drag per wingtip trailing node
     AeroEngine** aeroengines;
     int free_wash;
     int washpropnum[MAX_AEROENGINES];
@@ -25,12 +25,208 @@
 #include "SimData.h"
 #include "GfxActor.h"
 #include "GfxScene.h"
+#include "ThreadPool.h"
 
 #include <Ogre.h>
+#include <cstring>
 
 using namespace Ogre;
 using namespace RoR;
 
+static inline Vector3 GetVertexPos(const float* vertices, size_t index)
+{
+    const float* v = vertices + index * 8;
+    return Vector3(v[0], v[1], v[2]);
+}
+
+static inline void SetVertex(float* vertices, size_t index, Vector3 const& position, Vector3 const& normal)
+{
+    float* v = vertices + index * 8;
+    v[0] = position.x; v[1] = position.y; v[2] = position.z;
+    v[3] = normal.x;   v[4] = normal.y;   v[5] = normal.z;
+}
+
+void RoR::CalcFlexMeshWheelVertices(FlexMeshWheelJob* jobs, size_t num_jobs, Vector3 const* positions)
+{
+    for (size_t j = 0; j < num_jobs; j++)
+    {
+        FlexMeshWheelJob& job = jobs[j];
+        const Vector3* p = positions + job.positions_offset;
+        const Vector3& axis_node0 = p[0];
+        const Vector3& axis_node1 = p[1];
+        const size_t num_rays = job.num_rays;
+        float* vertices = job.vertices;
+
+        const Vector3 center = (axis_node0 + axis_node1) / 2.0;
+        Vector3 axis = axis_node0 - axis_node1;
+        axis.normalise();
+        const Plane plane0(axis, axis_node0);
+        const Plane plane1(-axis, axis_node1);
+
+        for (size_t i = 0; i < num_rays; i++)
+        {
+            const Vector3& tire_node0 = p[2 + i*2];
+            const Vector3& tire_node1 = p[3 + i*2];
+
+            Vector3 ray0 = plane0.projectVector(tire_node0 - axis_node0);
+            ray0.normalise();
+            Vector3 ray1 = plane1.projectVector(tire_node1 - axis_node1);
+            ray1.normalise();
+
+            const Vector3 pos0 = axis_node0 + job.rim_radius*ray0 - center;
+            const Vector3 pos1 = tire_node0 - 0.05*(tire_node0 - axis_node0) - center;
+            const Vector3 pos2 = tire_node0 - 0.1 *(tire_node0 - tire_node1) - center;
+            const Vector3 pos3 = tire_node1 - 0.1 *(tire_node1 - tire_node0) - center;
+            const Vector3 pos4 = tire_node1 - 0.05*(tire_node1 - axis_node1) - center;
+            const Vector3 pos5 = axis_node1 + job.rim_radius*ray1 - center;
+
+            // Like the per-wheel path, the next ray's vertices are still from the previous update (except for the last ray)
+            const size_t next = ((i+1)%num_rays)*6;
+            const Vector3 next_pos1 = GetVertexPos(vertices, next+1);
+            const Vector3 next_pos4 = GetVertexPos(vertices, next+4);
+            const Vector3 normal1 = (pos0 - pos1).crossProduct(pos0 - next_pos1)/job.norm_y;
+            const Vector3 normal4 = (pos4 - pos5).crossProduct(pos4 - next_pos4)/job.norm_y;
+
+            SetVertex(vertices, i*6,   pos0, axis);
+            SetVertex(vertices, i*6+1, pos1, normal1);
+            SetVertex(vertices, i*6+2, pos2, ray1);
+            SetVertex(vertices, i*6+3, pos3, ray1);
+            SetVertex(vertices, i*6+4, pos4, normal4);
+            SetVertex(vertices, i*6+5, pos5, -axis);
+        }
+        for (size_t i = 0; i < 6; i++)
+        {
+            std::memcpy(vertices + (num_rays*6 + i) * 8, vertices + i * 8, 6 * sizeof(float));
+        }
+
+        job.out_center = center;
+    }
+}
+
+Vector3 RoR::CalcFlexMeshWheelVerticesReference(NodeSB const* all_nodes, int axis_node0_idx, int axis_node1_idx, int start_node_idx,
+                                                 size_t num_rays, float rim_radius, float norm_y, float* out_vertices)
+{
+    struct Vertex
+    {
+        Vector3 position;
+        Vector3 normal;
+        Vector2 texcoord;
+    };
+    Vertex* vertices = reinterpret_cast<Vertex*>(out_vertices);
+
+    Vector3 center = (all_nodes[axis_node0_idx].AbsPosition + all_nodes[axis_node1_idx].AbsPosition) / 2.0;
+    Vector3 ray = all_nodes[start_node_idx].AbsPosition - all_nodes[axis_node0_idx].AbsPosition;
+    Vector3 axis = all_nodes[axis_node0_idx].AbsPosition - all_nodes[axis_node1_idx].AbsPosition;
+
+    axis.normalise();
+    
+    for (size_t i=0; i<num_rays; i++)
+    {
+        Plane pl=Plane(axis, all_nodes[axis_node0_idx].AbsPosition);
+        ray=all_nodes[start_node_idx+i*2].AbsPosition-all_nodes[axis_node0_idx].AbsPosition;
+        ray=pl.projectVector(ray);
+        ray.normalise();
+        vertices[i*6  ].position=all_nodes[axis_node0_idx].AbsPosition+rim_radius*ray-center;
+
+        vertices[i*6+1].position=all_nodes[start_node_idx+i*2].AbsPosition-0.05  *(all_nodes[start_node_idx+i*2].AbsPosition-all_nodes[axis_node0_idx].AbsPosition)-center;
+        vertices[i*6+2].position=all_nodes[start_node_idx+i*2].AbsPosition-0.1   *(all_nodes[start_node_idx+i*2].AbsPosition-all_nodes[start_node_idx+i*2+1].AbsPosition)-center;
+        vertices[i*6+3].position=all_nodes[start_node_idx+i*2+1].AbsPosition-0.1 *(all_nodes[start_node_idx+i*2+1].AbsPosition-all_nodes[start_node_idx+i*2].AbsPosition)-center;
+        vertices[i*6+4].position=all_nodes[start_node_idx+i*2+1].AbsPosition-0.05*(all_nodes[start_node_idx+i*2+1].AbsPosition-all_nodes[axis_node1_idx].AbsPosition)-center;
+
+        pl=Plane(-axis, all_nodes[axis_node1_idx].AbsPosition);
+        ray=all_nodes[start_node_idx+i*2+1].AbsPosition-all_nodes[axis_node1_idx].AbsPosition;
+        ray=pl.projectVector(ray);
+        ray.normalise();
+        vertices[i*6+5].position=all_nodes[axis_node1_idx].AbsPosition+rim_radius*ray-center;
+
+        //normals
+        vertices[i*6  ].normal=axis;
+        vertices[i*6+1].normal=(vertices[i*6].position-vertices[i*6+1].position).crossProduct(vertices[i*6].position-vertices[((i+1)%num_rays)*6+1].position)/norm_y;
+        vertices[i*6+2].normal=ray;
+        vertices[i*6+3].normal=ray;
+        vertices[i*6+4].normal=(vertices[i*6+4].position-vertices[i*6+5].position).crossProduct(vertices[i*6+4].position-vertices[((i+1)%num_rays)*6+4].position)/norm_y;
+        vertices[i*6+5].normal=-axis;
+    }
+    for (int i=0; i<6; i++)
+    {
+        vertices[num_rays*6+i].position=vertices[i].position;
+        vertices[num_rays*6+i].normal=vertices[i].normal;
+    }
+
+    return center;
+}
+
+void FlexMeshWheelBatch::Clear()
+{
+    ROR_ASSERT(!m_task);
+    m_wheels.clear();
+    m_jobs.clear();
+    m_positions.clear();
+}
+
+bool FlexMeshWheelBatch::AddWheel(FlexMeshWheel* wheel)
+{
+    // Only skip hidden tires - the main camera's frustum says nothing about mirrors, videocameras or envmap
+    if (wheel->m_tire_entity == nullptr || !wheel->m_tire_entity->isVisible())
+    {
+        return false;
+    }
+
+    RoR::NodeSB* all_nodes = wheel->m_gfx_actor->GetSimNodeBuffer();
+    const Vector3& axis_node0 = all_nodes[wheel->m_axis_node0_idx].AbsPosition;
+    const Vector3& axis_node1 = all_nodes[wheel->m_axis_node1_idx].AbsPosition;
+
+    FlexMeshWheelJob job;
+    job.positions_offset = m_positions.size();
+    job.num_rays = wheel->m_num_rays;
+    job.rim_radius = wheel->m_rim_radius;
+    job.norm_y = wheel->m_norm_y;
+    job.vertices = reinterpret_cast<float*>(wheel->m_vertices);
+
+    m_positions.push_back(axis_node0);
+    m_positions.push_back(axis_node1);
+    for (size_t i = 0; i < wheel->m_num_rays * 2; i++)
+    {
+        m_positions.push_back(all_nodes[wheel->m_start_node_idx + i].AbsPosition);
+    }
+
+    m_jobs.push_back(job);
+    m_wheels.push_back(wheel);
+    return true;
+}
+
+void FlexMeshWheelBatch::StartTask()
+{
+    if (m_jobs.empty())
+    {
+        return;
+    }
+
+    m_task = App::GetThreadPool()->RunTask([this]()
+        {
+            App::GetThreadPool()->ParallelFor(static_cast<int>(m_jobs.size()), CHUNK_SIZE, [this](int begin, int end)
+                {
+                    CalcFlexMeshWheelVertices(&m_jobs[begin], static_cast<size_t>(end - begin), m_positions.data());
+                });
+        });
+}
+
+void FlexMeshWheelBatch::FinishTask()
+{
+    if (m_task)
+    {
+        m_task->join();
+        m_task.reset();
+    }
+
+    for (size_t i = 0; i < m_wheels.size(); i++)
+    {
+        m_wheels[i]->m_flexit_center = m_jobs[i].out_center;
+        m_wheels[i]->m_vertices_updated = true;
+    }
+    m_wheels.clear();
+}
+
 FlexMeshWheel::FlexMeshWheel(
     Ogre::Entity* rim_prop_entity,
     RoR::GfxActor* gfx_actor,
@@ -185,47 +381,8 @@ FlexMeshWheel::~FlexMeshWheel()
 
 Vector3 FlexMeshWheel::updateVertices()
 {
-    RoR::NodeSB* all_nodes = m_gfx_actor->GetSimNodeBuffer();
-    Vector3 center = (all_nodes[m_axis_node0_idx].AbsPosition + all_nodes[m_axis_node1_idx].AbsPosition) / 2.0;
-    Vector3 ray = all_nodes[m_start_node_idx].AbsPosition - all_nodes[m_axis_node0_idx].AbsPosition;
-    Vector3 axis = all_nodes[m_axis_node0_idx].AbsPosition - all_nodes[m_axis_node1_idx].AbsPosition;
-
-    axis.normalise();
-    
-    for (size_t i=0; i<m_num_rays; i++)
-    {
-        Plane pl=Plane(axis, all_nodes[m_axis_node0_idx].AbsPosition);
-        ray=all_nodes[m_start_node_idx+i*2].AbsPosition-all_nodes[m_axis_node0_idx].AbsPosition;
-        ray=pl.projectVector(ray);
-        ray.normalise();
-        m_vertices[i*6  ].position=all_nodes[m_axis_node0_idx].AbsPosition+m_rim_radius*ray-center;
-
-        m_vertices[i*6+1].position=all_nodes[m_start_node_idx+i*2].AbsPosition-0.05  *(all_nodes[m_start_node_idx+i*2].AbsPosition-all_nodes[m_axis_node0_idx].AbsPosition)-center;
-        m_vertices[i*6+2].position=all_nodes[m_start_node_idx+i*2].AbsPosition-0.1   *(all_nodes[m_start_node_idx+i*2].AbsPosition-all_nodes[m_start_node_idx+i*2+1].AbsPosition)-center;
-        m_vertices[i*6+3].position=all_nodes[m_start_node_idx+i*2+1].AbsPosition-0.1 *(all_nodes[m_start_node_idx+i*2+1].AbsPosition-all_nodes[m_start_node_idx+i*2].AbsPosition)-center;
-        m_vertices[i*6+4].position=all_nodes[m_start_node_idx+i*2+1].AbsPosition-0.05*(all_nodes[m_start_node_idx+i*2+1].AbsPosition-all_nodes[m_axis_node1_idx].AbsPosition)-center;
-
-        pl=Plane(-axis, all_nodes[m_axis_node1_idx].AbsPosition);
-        ray=all_nodes[m_start_node_idx+i*2+1].AbsPosition-all_nodes[m_axis_node1_idx].AbsPosition;
-        ray=pl.projectVector(ray);
-        ray.normalise();
-        m_vertices[i*6+5].position=all_nodes[m_axis_node1_idx].AbsPosition+m_rim_radius*ray-center;
-
-        //normals
-        m_vertices[i*6  ].normal=axis;
-        m_vertices[i*6+1].normal=(m_vertices[i*6].position-m_vertices[i*6+1].position).crossProduct(m_vertices[i*6].position-m_vertices[((i+1)%m_num_rays)*6+1].position)/m_norm_y;
-        m_vertices[i*6+2].normal=ray;
-        m_vertices[i*6+3].normal=ray;
-        m_vertices[i*6+4].normal=(m_vertices[i*6+4].position-m_vertices[i*6+5].position).crossProduct(m_vertices[i*6+4].position-m_vertices[((i+1)%m_num_rays)*6+4].position)/m_norm_y;
-        m_vertices[i*6+5].normal=-axis;
-    }
-    for (int i=0; i<6; i++)
-    {
-        m_vertices[m_num_rays*6+i].position=m_vertices[i].position;
-        m_vertices[m_num_rays*6+i].normal=m_vertices[i].normal;
-    }
-
-    return center;
+    return CalcFlexMeshWheelVerticesReference(m_gfx_actor->GetSimNodeBuffer(), m_axis_node0_idx, m_axis_node1_idx, m_start_node_idx,
+        m_num_rays, m_rim_radius, m_norm_y, reinterpret_cast<float*>(m_vertices));
 }
 
 void FlexMeshWheel::setVisible(bool visible)
@@ -255,10 +412,15 @@ bool FlexMeshWheel::flexitPrepare()
 void FlexMeshWheel::flexitCompute()
 {
     m_flexit_center = updateVertices();
+    m_vertices_updated = true;
 }
 
 Vector3 FlexMeshWheel::flexitFinal()
 {
-    m_hw_vbuf->writeData(0, m_hw_vbuf->getSizeInBytes(), m_vertices, true);
+    if (m_vertices_updated)
+    {
+        m_hw_vbuf->writeData(0, m_hw_vbuf->getSizeInBytes(), m_vertices, true);
+        m_vertices_updated = false;
+    }
     return m_flexit_center;
 }
@@ -25,7 +25,9 @@
 #include "FlexMesh.h"
 
 #include <Ogre.h>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace RoR {
 
@@ -35,10 +37,50 @@ namespace RoR {
 /// @addtogroup Flex
 /// @{
 
+/// One wheel's share of a `FlexMeshWheelBatch`
+struct FlexMeshWheelJob
+{
+    size_t         positions_offset = 0;   //!< Axis node 0, axis node 1, then 2 tire nodes per ray
+    size_t         num_rays = 0;
+    float          rim_radius = 0.f;
+    float          norm_y = 1.f;
+    float*         vertices = nullptr;     //!< Interleaved position, normal and texcoord (8 floats per vertex); texcoords are left untouched
+    Ogre::Vector3  out_center;
+};
+
+/// Computes tire vertices for a range of wheels, reading node positions from one contiguous array.
+/// Produces the same output as `FlexMeshWheel::updateVertices()`. Touches no OGRE objects, so it may run on a worker thread.
+void CalcFlexMeshWheelVertices(FlexMeshWheelJob* jobs, size_t num_jobs, Ogre::Vector3 const* positions);
+
+/// Per-wheel variant reading the node buffer directly; this is `FlexMeshWheel::updateVertices()`, kept apart as reference for tests.
+/// @param out_vertices Interleaved position, normal and texcoord (8 floats per vertex), `6*(num_rays+1)` vertices; texcoords are left untouched.
+Ogre::Vector3 CalcFlexMeshWheelVerticesReference(NodeSB const* all_nodes, int axis_node0_idx, int axis_node1_idx, int start_node_idx,
+                                                 size_t num_rays, float rim_radius, float norm_y, float* out_vertices);
+
+/// Computes the tire meshes of all visible flexmesh wheels in the scene at once, spread over the thread pool.
+/// Usage: `Clear()`, `AddWheel()` for each wheel, `StartTask()`, ..., `FinishTask()`, then `FlexMeshWheel::flexitFinal()`.
+class FlexMeshWheelBatch
+{
+public:
+    void Clear();
+    bool AddWheel(FlexMeshWheel* wheel); //!< Gathers the node positions; returns false if the tire entity is hidden and was skipped.
+    void StartTask();
+    void FinishTask(); //!< Waits for the computation and hands the results to the wheels.
+
+private:
+    static const int CHUNK_SIZE = 4; //!< Wheels per thread pool chunk
+
+    std::vector<FlexMeshWheel*>    m_wheels;
+    std::vector<FlexMeshWheelJob>  m_jobs;
+    std::vector<Ogre::Vector3>     m_positions;
+    std::shared_ptr<Task>          m_task;
+};
+
 /// Consists of static mesh, representing the rim, and dynamic mesh, representing the tire.
 class FlexMeshWheel: public Flexable
 {
     friend class RoR::FlexFactory;
+    friend class RoR::FlexMeshWheelBatch;
 
 public:
 
@@ -99,6 +141,7 @@ private:
     float            m_norm_y;
     size_t           m_vertex_count;
     FlexMeshWheelVertex* m_vertices;
+    bool             m_vertices_updated = false; //!< Computed but not uploaded yet
     Ogre::VertexDeclaration* m_vertex_format;
     Ogre::HardwareVertexBufferSharedPtr m_hw_vbuf;
 
@@ -25,10 +25,146 @@
 #include "GfxActor.h"
 
 #include <Ogre.h>
+#include <algorithm>
+#include <cstring>
 
 using namespace Ogre;
 using namespace RoR;
 
+Vector3 RoR::CalcCabMeshVertices(CabMeshLayout const& layout, NodeSB const* nodes, CabMeshScratch& scratch, float* out_vertices)
+{
+    const size_t STRIDE = 8; // Floats per output vertex
+    const size_t vertex_count = layout.vertex_count;
+    const size_t triangle_count = layout.triangle_count;
+    const int* vertex_nodes = layout.vertex_nodes;
+    const unsigned short* indices = layout.indices;
+
+    scratch.abs_x.resize(vertex_count);
+    scratch.abs_y.resize(vertex_count);
+    scratch.abs_z.resize(vertex_count);
+    scratch.face_x.resize(triangle_count);
+    scratch.face_y.resize(triangle_count);
+    scratch.face_z.resize(triangle_count);
+    scratch.face_len.resize(triangle_count);
+    float* abs_x = scratch.abs_x.data();
+    float* abs_y = scratch.abs_y.data();
+    float* abs_z = scratch.abs_z.data();
+    float* face_x = scratch.face_x.data();
+    float* face_y = scratch.face_y.data();
+    float* face_z = scratch.face_z.data();
+    float* face_len = scratch.face_len.data();
+
+    // gather node positions
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        const Vector3& pos = nodes[vertex_nodes[i]].AbsPosition;
+        abs_x[i] = pos.x;
+        abs_y[i] = pos.y;
+        abs_z[i] = pos.z;
+    }
+
+    // triangle normals - no branches and no shared writes, so this loop can be vectorised
+    for (size_t t = 0; t < triangle_count; t++)
+    {
+        const unsigned short i0 = indices[t*3];
+        const unsigned short i1 = indices[t*3+1];
+        const unsigned short i2 = indices[t*3+2];
+        const float e1x = abs_x[i1] - abs_x[i0];
+        const float e1y = abs_y[i1] - abs_y[i0];
+        const float e1z = abs_z[i1] - abs_z[i0];
+        const float e2x = abs_x[i2] - abs_x[i0];
+        const float e2y = abs_y[i2] - abs_y[i0];
+        const float e2z = abs_z[i2] - abs_z[i0];
+        const float nx = e1y * e2z - e1z * e2y;
+        const float ny = e1z * e2x - e1x * e2z;
+        const float nz = e1x * e2y - e1y * e2x;
+        face_x[t] = nx;
+        face_y[t] = ny;
+        face_z[t] = nz;
+        face_len[t] = std::sqrt(nx * nx + ny * ny + nz * nz);
+    }
+
+    // set positions, reset normals
+    const Vector3 center = (nodes[vertex_nodes[0]].AbsPosition + nodes[vertex_nodes[1]].AbsPosition) / 2.0;
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        float* v = out_vertices + i * STRIDE;
+        v[0] = abs_x[i] - center.x;
+        v[1] = abs_y[i] - center.y;
+        v[2] = abs_z[i] - center.z;
+        v[3] = 0.f;
+        v[4] = 0.f;
+        v[5] = 0.f;
+    }
+
+    // accumulate normals per triangle - triangles share vertices, so this stays serial
+    for (size_t t = 0; t < triangle_count; t++)
+    {
+        float* v0 = out_vertices + indices[t*3] * STRIDE;
+        float* v1 = out_vertices + indices[t*3+1] * STRIDE;
+        float* v2 = out_vertices + indices[t*3+2] * STRIDE;
+        const float len = face_len[t];
+
+        //avoid large tris
+        if (len > layout.s_ref[t])
+        {
+            v1[0] = v0[0] + 0.1f;
+            v1[1] = v0[1];
+            v1[2] = v0[2];
+            v2[0] = v0[0];
+            v2[1] = v0[1];
+            v2[2] = v0[2] + 0.1f;
+        }
+
+        if (len == 0.f)
+            continue;
+
+        const float inv_len = 1.0f / len;
+        const float nx = face_x[t] * inv_len;
+        const float ny = face_y[t] * inv_len;
+        const float nz = face_z[t] * inv_len;
+        v0[3] += nx; v0[4] += ny; v0[5] += nz;
+        v1[3] += nx; v1[4] += ny; v1[5] += nz;
+        v2[3] += nx; v2[4] += ny; v2[5] += nz;
+    }
+
+    //normalize
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        float* v = out_vertices + i * STRIDE;
+        const Vector3 normal = approx_normalise(Vector3(v[3], v[4], v[5]));
+        v[3] = normal.x;
+        v[4] = normal.y;
+        v[5] = normal.z;
+    }
+
+    return center;
+}
+
+bool RoR::FindCabMeshDirtyRange(float const* prev_vertices, float const* vertices, size_t vertex_count, size_t& out_begin, size_t& out_end)
+{
+    const size_t STRIDE = 8; // Floats per vertex
+    size_t begin = 0;
+    while (begin < vertex_count && std::memcmp(vertices + begin * STRIDE, prev_vertices + begin * STRIDE, STRIDE * sizeof(float)) == 0)
+    {
+        begin++;
+    }
+    if (begin == vertex_count)
+    {
+        return false;
+    }
+
+    size_t end = vertex_count;
+    while (end > begin && std::memcmp(vertices + (end - 1) * STRIDE, prev_vertices + (end - 1) * STRIDE, STRIDE * sizeof(float)) == 0)
+    {
+        end--;
+    }
+
+    out_begin = begin;
+    out_end = end;
+    return true;
+}
+
 FlexObj::FlexObj(RoR::GfxActor* gfx_actor, node_t* all_nodes, std::vector<CabTexcoord>& texcoords, int numtriangles, 
                  int* triangles, std::vector<CabSubmesh>& submesh_defs, 
                  char* texname, const char* name, char* backtexname, char* transtexname):
@@ -56,12 +192,14 @@ FlexObj::FlexObj(RoR::GfxActor* gfx_actor, node_t* all_nodes, std::vector<CabTex
     // Define the m_vertices_raw (8 vertices, each consisting of 3 groups of 3 floats
     m_vertex_count = texcoords.size();
     m_vertices_raw=(float*)malloc(((2*3+2)*m_vertex_count)*sizeof(float));
+    m_next_vertices_raw=(float*)malloc(((2*3+2)*m_vertex_count)*sizeof(float));
     m_vertex_nodes=(int*)malloc(m_vertex_count*sizeof(int));
     
     for (size_t i=0; i<m_vertex_count; i++)
     {
         m_vertex_nodes[i] = texcoords[i].node_id; //define node ids
         m_vertices[i].texcoord=Vector2(texcoords[i].texcoord_u, texcoords[i].texcoord_v); //textures coordinates
+        m_next_vertices[i].texcoord=m_vertices[i].texcoord;
     }
 
     // Define triangles
@@ -83,7 +221,13 @@ FlexObj::FlexObj(RoR::GfxActor* gfx_actor, node_t* all_nodes, std::vector<CabTex
         m_s_ref[i]=v1.crossProduct(v2).length()*2.0;
     }
 
-    this->UpdateMesh(); // Initialize the dynamic mesh
+    m_layout.vertex_count = m_vertex_count;
+    m_layout.vertex_nodes = m_vertex_nodes;
+    m_layout.triangle_count = static_cast<size_t>(numtriangles);
+    m_layout.indices = m_indices;
+    m_layout.s_ref = m_s_ref;
+
+    this->ComputeFlexObj(); // Initialize the dynamic mesh
 
     // Create vertex data structure for vertices shared between submeshes
     m_mesh->sharedVertexData = new VertexData();
@@ -101,11 +245,12 @@ FlexObj::FlexObj(RoR::GfxActor* gfx_actor, node_t* all_nodes, std::vector<CabTex
 
     // Allocate vertex buffer of the requested number of vertices (vertexCount)
     // and bytes per vertex (offset)
+    // Partial updates go to the shadow copy; OGRE uploads the written range once, when the buffer is next used.
     m_hw_vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
-        offset, m_mesh->sharedVertexData->vertexCount, HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
+        offset, m_mesh->sharedVertexData->vertexCount, HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE, /*useShadowBuffer:*/true);
 
     // Upload the vertex data to the card
-    m_hw_vbuf->writeData(0, m_hw_vbuf->getSizeInBytes(), m_vertices_raw, true);
+    this->UpdateFlexObjBuffers();
 
     // Set vertex buffer binding so buffer 0 is bound to our vertex buffer
     VertexBufferBinding* bind = m_mesh->sharedVertexData->vertexBufferBinding;
@@ -183,55 +328,44 @@ int FlexObj::ComputeVertexPos(int tidx, int v, std::vector<CabSubmesh>& submeshe
     return 0;
 }
 
-Vector3 FlexObj::UpdateMesh()
+void FlexObj::ComputeFlexObj()
 {
-    RoR::NodeSB* all_nodes = m_gfx_actor->GetSimNodeBuffer();
-    Ogre::Vector3 center=(all_nodes[m_vertex_nodes[0]].AbsPosition+all_nodes[m_vertex_nodes[1]].AbsPosition)/2.0;
-    for (size_t i=0; i<m_vertex_count; i++)
+    const Vector3 prev_center = m_center;
+    m_center = CalcCabMeshVertices(m_layout, m_gfx_actor->GetSimNodeBuffer(), m_scratch, m_next_vertices_raw);
+
+    // Positions are relative to the center - if it moved, every vertex changed and comparing is a waste
+    if (m_center != prev_center)
     {
-        //set position
-        m_vertices[i].position=all_nodes[m_vertex_nodes[i]].AbsPosition-center;
-        //reset normals
-        m_vertices[i].normal=Vector3::ZERO;
+        m_upload_all = true;
     }
-    //accumulate normals per triangle
-    for (size_t i=0; i<m_index_count/3; i++)
-    {
-        Vector3 v1, v2;
-        v1=all_nodes[m_vertex_nodes[m_indices[i*3+1]]].AbsPosition-all_nodes[m_vertex_nodes[m_indices[i*3]]].AbsPosition;
-        v2=all_nodes[m_vertex_nodes[m_indices[i*3+2]]].AbsPosition-all_nodes[m_vertex_nodes[m_indices[i*3]]].AbsPosition;
-        v1=v1.crossProduct(v2);
-        float s=v1.length();
 
-        //avoid large tris
-        if (s>m_s_ref[i])
-        {
-            m_vertices[m_indices[i*3+1]].position=m_vertices[m_indices[i*3]].position+Vector3(0.1,0,0);
-            m_vertices[m_indices[i*3+2]].position=m_vertices[m_indices[i*3]].position+Vector3(0,0,0.1);
-        }
-
-        if (s == 0)
-            continue;
-
-        v1=v1/s;
-        m_vertices[m_indices[i*3]].normal+=v1;
-        m_vertices[m_indices[i*3+1]].normal+=v1;
-        m_vertices[m_indices[i*3+2]].normal+=v1;
-    }
-    //normalize
-    for (size_t i=0; i<m_vertex_count; i++)
+    // The range is widened until uploaded, the GPU copy may be more than one computation behind
+    size_t begin, end;
+    if (!m_upload_all && FindCabMeshDirtyRange(m_vertices_raw, m_next_vertices_raw, m_vertex_count, begin, end))
     {
-        m_vertices[i].normal = approx_normalise(m_vertices[i].normal);
+        m_dirty_begin = std::min(m_dirty_begin, begin);
+        m_dirty_end = std::max(m_dirty_end, end);
     }
 
-    return center;
+    std::swap(m_vertices_raw, m_next_vertices_raw);
 }
 
-Vector3 FlexObj::UpdateFlexObj()
+Vector3 FlexObj::UpdateFlexObjBuffers()
 {
-    Ogre::Vector3 center = this->UpdateMesh();
-    m_hw_vbuf->writeData(0, m_hw_vbuf->getSizeInBytes(), m_vertices_raw, true);
-    return center;
+    if (m_upload_all || (m_dirty_end - m_dirty_begin) * 2 > m_vertex_count)
+    {
+        m_hw_vbuf->writeData(0, m_hw_vbuf->getSizeInBytes(), m_vertices_raw, true);
+    }
+    else if (m_dirty_end > m_dirty_begin)
+    {
+        m_hw_vbuf->writeData(m_dirty_begin * sizeof(FlexObjVertex), (m_dirty_end - m_dirty_begin) * sizeof(FlexObjVertex),
+            &m_vertices[m_dirty_begin], false);
+    }
+
+    m_dirty_begin = m_vertex_count;
+    m_dirty_end = 0;
+    m_upload_all = false;
+    return m_center;
 }
 
 FlexObj::~FlexObj()
@@ -243,6 +377,7 @@ FlexObj::~FlexObj()
     }
 
     if (m_vertices_raw != nullptr) { free (m_vertices_raw); }
+    if (m_next_vertices_raw != nullptr) { free (m_next_vertices_raw); }
     if (m_vertex_nodes != nullptr) { free (m_vertex_nodes); }
     if (m_indices      != nullptr) { free (m_indices);      }
     if (m_s_ref        != nullptr) { free (m_s_ref);        }
@@ -25,6 +25,8 @@
 #include "SimData.h"
 
 #include <Ogre.h>
+#include <utility>
+#include <vector>
 
 namespace RoR {
 
@@ -54,6 +56,33 @@ struct CabSubmesh
     size_t        cabs_pos;
 };
 
+/// Flat description of a cab mesh, input of `CalcCabMeshVertices()`
+struct CabMeshLayout
+{
+    size_t                 vertex_count = 0;
+    int const*             vertex_nodes = nullptr; //!< Node number of each vertex
+    size_t                 triangle_count = 0;
+    unsigned short const*  indices = nullptr;      //!< 3 vertex numbers per triangle
+    float const*           s_ref = nullptr;        //!< Per triangle; larger triangles get collapsed
+};
+
+/// Working memory of `CalcCabMeshVertices()`, kept between frames
+struct CabMeshScratch
+{
+    std::vector<float> abs_x, abs_y, abs_z;    //!< Node position of each vertex
+    std::vector<float> face_x, face_y, face_z; //!< Unnormalised normal of each triangle
+    std::vector<float> face_len;
+};
+
+/// Computes positions (relative to the returned center) and normals of all cab mesh vertices.
+/// Works on flat arrays only and touches no OGRE objects, so it may run on a worker thread.
+/// @param out_vertices Interleaved position, normal and texcoord (8 floats per vertex); texcoords are left untouched.
+Ogre::Vector3 CalcCabMeshVertices(CabMeshLayout const& layout, NodeSB const* nodes, CabMeshScratch& scratch, float* out_vertices);
+
+/// Finds the smallest [begin, end) range of vertices which differ between two outputs of `CalcCabMeshVertices()`.
+/// @return False if nothing changed.
+bool FindCabMeshDirtyRange(float const* prev_vertices, float const* vertices, size_t vertex_count, size_t& out_begin, size_t& out_end);
+
 /// A visual mesh, forming a chassis for softbody actor
 /// At most one instance is created per actor.
 class FlexObj : public ZeroedMemoryAllocator
@@ -74,7 +103,8 @@ public:
 
     ~FlexObj();
 
-    Ogre::Vector3   UpdateFlexObj();
+    void            ComputeFlexObj();          //!< Computes vertices and finds the changed range; may run on a worker thread
+    Ogre::Vector3   UpdateFlexObjBuffers();    //!< Uploads the changed range; main thread only. Returns mesh center.
     void            ScaleFlexObj(float factor);
 
 private:
@@ -88,7 +118,6 @@ private:
 
     /// Compute vertex position in the vertexbuffer (0-based offset) for node `v` of triangle `tidx`
     int             ComputeVertexPos(int tidx, int v, std::vector<CabSubmesh>& submeshes);
-    Ogre::Vector3   UpdateMesh();
 
     Ogre::MeshPtr               m_mesh;
     std::vector<Ogre::SubMesh*> m_submeshes;
@@ -104,6 +133,17 @@ private:
         float*              m_vertices_raw;
         FlexObjVertex*      m_vertices;
     };
+    union
+    {
+        float*              m_next_vertices_raw; //!< Output of `ComputeFlexObj()`, swapped with `m_vertices_raw` afterwards
+        FlexObjVertex*      m_next_vertices;
+    };
+    CabMeshLayout               m_layout;
+    CabMeshScratch              m_scratch;
+    Ogre::Vector3               m_center = Ogre::Vector3::ZERO;
+    size_t                      m_dirty_begin = 0;   //!< [begin, end) vertex range to upload; empty if `begin >= end`
+    size_t                      m_dirty_end = 0;
+    bool                        m_upload_all = true;
 
     size_t                      m_index_count;
     unsigned short*             m_indices;
@@ -44,14 +44,19 @@ Buoyance::~Buoyance()
 {
 }
 
-//compute tetrahedron volume
-inline float Buoyance::computeVolume(Vector3 o, Vector3 a, Vector3 b, Vector3 c)
+//compute pressure and drag force on a submerged triangle
+Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vector3 vel, int type)
 {
-    return ((a - o).dotProduct((b - o).crossProduct(c - o))) / 6.0;
+    IWater* water = App::GetGameContext()->GetTerrain()->getWater();
+    if (type != BUOY_DRAGLESS)
+    {
+        //take in account the wave speed
+        vel = vel - water->CalcWavesVelocity((a + b + c) / 3.0);
+    }
+    return computePressureForceSub(a, b, c, water->CalcWavesHeight(a), water->CalcWavesHeight(b), water->CalcWavesHeight(c), vel, type);
 }
 
-//compute pressure and drag force on a submerged triangle
-Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vector3 vel, int type)
+Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, float wha, float whb, float whc, Vector3 vel, int type)
 {
     //compute normal vector
     Vector3 normal = (b - a).crossProduct(c - a);
@@ -63,30 +68,14 @@ Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vecto
     float vol = 0.0;
     if (type != BUOY_DRAGONLY)
     {
-        //compute pression prism points
-        Vector3 ap = a + (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(a) - a.y) * 9810 * normal;
-        Vector3 bp = b + (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(b) - b.y) * 9810 * normal;
-        Vector3 cp = c + (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(c) - c.y) * 9810 * normal;
-        //find centroid
-        Vector3 ctd = (a + b + c + ap + bp + cp) / 6.0;
-        //compute volume
-        vol += computeVolume(ctd, a, b, c);
-        vol += computeVolume(ctd, a, ap, bp);
-        vol += computeVolume(ctd, a, bp, b);
-        vol += computeVolume(ctd, b, bp, cp);
-        vol += computeVolume(ctd, b, cp, c);
-        vol += computeVolume(ctd, c, cp, ap);
-        vol += computeVolume(ctd, c, ap, a);
-        vol += computeVolume(ctd, ap, cp, bp);
+        //volume of the pression prism (vertices pushed along the normal by 9810 * depth);
+        //closed form of the 8 tetrahedra around the prism's centroid
+        vol = -surf * 9810.0f * ((wha - a.y) + (whb - b.y) + (whc - c.y)) / 3.0f;
     };
     Vector3 drg = Vector3::ZERO;
     if (type != BUOY_DRAGLESS)
     {
         //now, the drag
-        //take in account the wave speed
-        //compute center
-        Vector3 tc = (a + b + c) / 3.0;
-        vel = vel - App::GetGameContext()->GetTerrain()->getWater()->CalcWavesVelocity(tc);
         float vell = vel.length();
         if (vell > 0.01)
         {
@@ -104,13 +93,13 @@ Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vecto
                     if (fxdir.y < 0)
                         fxdir.y = -fxdir.y;
 
-                    if (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(a) - a.y < 0.1)
+                    if (wha - a.y < 0.1)
                         splashp->malloc(a, fxdir);
 
-                    else if (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(b) - b.y < 0.1)
+                    else if (whb - b.y < 0.1)
                         splashp->malloc(b, fxdir);
 
-                    else if (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(c) - c.y < 0.1)
+                    else if (whc - c.y < 0.1)
                         splashp->malloc(c, fxdir);
                 }
             }
@@ -210,3 +199,62 @@ void Buoyance::computeNodeForce(node_t* a, node_t* b, node_t* c, bool doUpdate,
     b->Forces += computePressureForce(b->AbsPosition, mbc, m, vel, type) + computePressureForce(b->AbsPosition, m, mab, vel, type);
     c->Forces += computePressureForce(c->AbsPosition, mca, m, vel, type) + computePressureForce(c->AbsPosition, m, mbc, vel, type);
 }
+
+void Buoyance::computeCabForces(node_t* nodes, int const* cabs, int const* buoycabs, int const* buoycab_types, int num_buoycabs, bool doUpdate)
+{
+    IWater* water = App::GetGameContext()->GetTerrain()->getWater();
+    update = doUpdate;
+
+    // Sample points per cab: corners, edge midpoints, center - the same as `computeNodeForce()` uses
+    enum { S_A, S_B, S_C, S_AB, S_BC, S_CA, S_M, NUM_SAMPLES };
+    m_sample_pos.resize(num_buoycabs * NUM_SAMPLES);
+    m_sample_height.resize(num_buoycabs * NUM_SAMPLES);
+    for (int i = 0; i < num_buoycabs; i++)
+    {
+        Vector3* s = &m_sample_pos[i * NUM_SAMPLES];
+        s[S_A]  = nodes[cabs[buoycabs[i] * 3 + 0]].AbsPosition;
+        s[S_B]  = nodes[cabs[buoycabs[i] * 3 + 1]].AbsPosition;
+        s[S_C]  = nodes[cabs[buoycabs[i] * 3 + 2]].AbsPosition;
+        s[S_AB] = (s[S_A] + s[S_B]) / 2.0;
+        s[S_BC] = (s[S_B] + s[S_C]) / 2.0;
+        s[S_CA] = (s[S_C] + s[S_A]) / 2.0;
+        s[S_M]  = (s[S_A] + s[S_B] + s[S_C]) / 3.0;
+    }
+    water->CalcWavesHeightBatch(m_sample_pos.data(), m_sample_height.data(), m_sample_pos.size());
+
+    for (int i = 0; i < num_buoycabs; i++)
+    {
+        const Vector3* s = &m_sample_pos[i * NUM_SAMPLES];
+        const float* h = &m_sample_height[i * NUM_SAMPLES];
+
+        // Fully emerged
+        if (s[S_A].y > h[S_A] && s[S_B].y > h[S_B] && s[S_C].y > h[S_C])
+            continue;
+
+        node_t* a = &nodes[cabs[buoycabs[i] * 3 + 0]];
+        node_t* b = &nodes[cabs[buoycabs[i] * 3 + 1]];
+        node_t* c = &nodes[cabs[buoycabs[i] * 3 + 2]];
+        const int type = buoycab_types[i];
+        const Vector3 vel = (a->Velocity + b->Velocity + c->Velocity) / 3.0;
+
+        bool submerged = true;
+        for (int k = 0; k < NUM_SAMPLES && submerged; k++)
+            submerged = s[k].y < h[k];
+
+        if (submerged)
+        {
+            // Fully submerged: no waterline clipping, water heights already known, one wave velocity sample for the cab
+            const Vector3 rel_vel = (type != BUOY_DRAGLESS) ? vel - water->CalcWavesVelocity(s[S_M]) : vel;
+            a->Forces += computePressureForceSub(s[S_A], s[S_AB], s[S_M], h[S_A], h[S_AB], h[S_M], rel_vel, type) + computePressureForceSub(s[S_A], s[S_M], s[S_CA], h[S_A], h[S_M], h[S_CA], rel_vel, type);
+            b->Forces += computePressureForceSub(s[S_B], s[S_BC], s[S_M], h[S_B], h[S_BC], h[S_M], rel_vel, type) + computePressureForceSub(s[S_B], s[S_M], s[S_AB], h[S_B], h[S_M], h[S_AB], rel_vel, type);
+            c->Forces += computePressureForceSub(s[S_C], s[S_CA], s[S_M], h[S_C], h[S_CA], h[S_M], rel_vel, type) + computePressureForceSub(s[S_C], s[S_M], s[S_BC], h[S_C], h[S_M], h[S_BC], rel_vel, type);
+        }
+        else
+        {
+            // Crossing the waterline: subdivide exactly like `computeNodeForce()`
+            a->Forces += computePressureForce(s[S_A], s[S_AB], s[S_M], vel, type) + computePressureForce(s[S_A], s[S_M], s[S_CA], vel, type);
+            b->Forces += computePressureForce(s[S_B], s[S_BC], s[S_M], vel, type) + computePressureForce(s[S_B], s[S_M], s[S_AB], vel, type);
+            c->Forces += computePressureForce(s[S_C], s[S_CA], s[S_M], vel, type) + computePressureForce(s[S_C], s[S_M], s[S_BC], vel, type);
+        }
+    }
+}
@@ -22,6 +22,8 @@
 
 #include "Application.h"
 
+#include <vector>
+
 namespace RoR {
 
 /// @addtogroup Physics
@@ -36,23 +38,32 @@ public:
 
     void computeNodeForce(node_t *a, node_t *b, node_t *c, bool doUpdate, int type);
 
+    /// Batched `computeNodeForce()` over all buoyant cabs of an actor.
+    /// Water heights for all sample points are queried at once; triangles fully above or below
+    /// the surface take fast paths and only those crossing the waterline are subdivided further.
+    void computeCabForces(node_t* nodes, int const* cabs, int const* buoycabs, int const* buoycab_types, int num_buoycabs, bool doUpdate);
+
     enum { BUOY_NORMAL, BUOY_DRAGONLY, BUOY_DRAGLESS };
 
     bool sink;
 
 private:
 
-    //compute tetrahedron volume
-    inline float computeVolume(Ogre::Vector3 o, Ogre::Vector3 a, Ogre::Vector3 b, Ogre::Vector3 c);
-
     //compute pressure and drag force on a submerged triangle
     Ogre::Vector3 computePressureForceSub(Ogre::Vector3 a, Ogre::Vector3 b, Ogre::Vector3 c, Ogre::Vector3 vel, int type);
+
+    //same, with known water heights at the vertices and velocity relative to the water
+    Ogre::Vector3 computePressureForceSub(Ogre::Vector3 a, Ogre::Vector3 b, Ogre::Vector3 c, float wha, float whb, float whc, Ogre::Vector3 rel_vel, int type);
     
     //compute pressure and drag forces on a random triangle
     Ogre::Vector3 computePressureForce(Ogre::Vector3 a, Ogre::Vector3 b, Ogre::Vector3 c, Ogre::Vector3 vel, int type);
     
     DustPool *splashp, *ripplep;
     bool update;
+
+    // Scratch for `computeCabForces()`; 7 samples per cab
+    std::vector<Ogre::Vector3> m_sample_pos;
+    std::vector<float> m_sample_height;
 };
 
 /// @} // addtogroup Physics
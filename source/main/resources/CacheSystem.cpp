@@ -298,13 +298,44 @@ void CacheSystem::ImportEntryFromJson(rapidjson::Value& j_entry, CacheEntry & ou
     }
 }
 
+void CacheSystem::PrefetchCacheFile()
+{
+    // Not using `ContentManager::LoadAndParseJson()` - OGRE resource system isn't thread safe
+    Ogre::DataStreamPtr stream = OpenFileDirect(PathCombine(App::sys_cache_dir->getStr(), CACHE_FILE));
+    if (!stream)
+    {
+        return; // `LoadCacheFileJson()` will report
+    }
+
+    auto j_doc = std::unique_ptr<rapidjson::Document>(new rapidjson::Document());
+    Ogre::String json_str = stream->getAsString();
+    rapidjson::MemoryStream j_stream(json_str.data(), json_str.length());
+    j_doc->ParseStream<rapidjson::kParseNanAndInfFlag>(j_stream);
+    if (!j_doc->HasParseError())
+    {
+        m_prefetched_cache_doc = std::move(j_doc);
+    }
+}
+
 CacheValidity CacheSystem::LoadCacheFileJson()
 {
     // Clear existing entries
     m_entries.clear();
 
     rapidjson::Document j_doc;
-    if (!App::GetContentManager()->LoadAndParseJson(CACHE_FILE, RGN_CACHE, j_doc) ||
+    bool loaded = false;
+    if (m_prefetched_cache_doc)
+    {
+        j_doc.Swap(*m_prefetched_cache_doc);
+        m_prefetched_cache_doc.reset();
+        loaded = true;
+    }
+    else
+    {
+        loaded = App::GetContentManager()->LoadAndParseJson(CACHE_FILE, RGN_CACHE, j_doc);
+    }
+
+    if (!loaded ||
         !j_doc.IsObject() || !j_doc.HasMember("entries") || !j_doc["entries"].IsArray())
     {
         RoR::Log("[RoR|ModCache] Error, cache file still invalid after check/update, content selector will be empty.");
@@ -564,6 +595,8 @@ void CacheSystem::ExportEntryToJson(rapidjson::Value& j_entries, rapidjson::Docu
 
 void CacheSystem::WriteCacheFileJson()
 {
+    m_prefetched_cache_doc.reset();
+
     // Basic file structure
     rapidjson::Document j_doc;
     j_doc.SetObject();
@@ -590,6 +623,7 @@ void CacheSystem::WriteCacheFileJson()
 
 void CacheSystem::ClearCache()
 {
+    m_prefetched_cache_doc.reset();
     App::GetContentManager()->DeleteDiskFile(CACHE_FILE, RGN_CACHE);
     for (auto& entry : m_entries)
     {
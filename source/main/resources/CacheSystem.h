@@ -32,6 +32,7 @@
 #include "SimData.h"
 
 #include <Ogre.h>
+#include <memory>
 #include <rapidjson/document.h>
 #include <string>
 
@@ -197,6 +198,7 @@ public:
     CacheEntry*           FindEntryByFilename(RoR::LoaderType type, bool partial, std::string filename); //!< Returns NULL if none found
     CacheEntry*           FetchSkinByName(std::string const & skin_name);
     CacheValidity         EvaluateCacheValidity();
+    void                  PrefetchCacheFile(); //!< Reads + parses CACHE_FILE ahead of time (on a worker thread during startup); used by the next load.
     size_t                Query(CacheQuery& query);
 
     void LoadResource(CacheEntry& t); //!< Loads the associated resource bundle if not already done.
@@ -248,6 +250,7 @@ private:
 
     std::time_t                          m_update_time;      //!< Ensures that all inserted files share the same timestamp
     std::string                          m_filenames_hash_loaded;   //!< hash from cachefile, for quick update detection
+    std::unique_ptr<rapidjson::Document> m_prefetched_cache_doc;    //!< See `PrefetchCacheFile()`; discarded when the file is rewritten
     std::string                          m_filenames_hash_generated;   //!< stores hash over the content, for quick update detection
     std::vector<CacheEntry>              m_entries;
     std::vector<Ogre::String>            m_known_extensions; //!< the extensions we track in the cache system
@@ -87,6 +87,7 @@ public:
     void               InitManagedMaterials(std::string const & rg_name);
     void               InitContentManager();
     void               InitModCache(CacheValidity validity);
+    void               PrefetchModCache() { m_mod_cache.PrefetchCacheFile(); } //!< Thread safe, see `CacheSystem::PrefetchCacheFile()`
     void               LoadGameplayResources();  //!< Checks GVar settings and loads required resources.
     std::string        ListAllUserContent(); //!< Used by ModCache for quick detection of added/removed content
     bool               DeleteDiskFile(std::string const& filename, std::string const& rg_name);
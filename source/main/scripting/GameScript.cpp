@@ -921,6 +921,54 @@ VehicleAI* GameScript::getTruckAIByNum(int num)
     return result;
 }
 
+static int FillNodeRefArrays(std::vector<NodeSpatialIndex::NodeRef> const& refs, AngelScript::CScriptArray* out_actor_ids, AngelScript::CScriptArray* out_node_ids)
+{
+    out_actor_ids->Resize(static_cast<AngelScript::asUINT>(refs.size()));
+    out_node_ids->Resize(static_cast<AngelScript::asUINT>(refs.size()));
+    for (AngelScript::asUINT i = 0; i < refs.size(); i++)
+    {
+        int actor_id = refs[i].actor->ar_instance_id;
+        int node_id = static_cast<int>(refs[i].node_num);
+        out_actor_ids->SetValue(i, &actor_id);
+        out_node_ids->SetValue(i, &node_id);
+    }
+    return static_cast<int>(refs.size());
+}
+
+int GameScript::findNodesInRadius(Ogre::Vector3 const& center, float radius, AngelScript::CScriptArray* out_actor_ids, AngelScript::CScriptArray* out_node_ids)
+{
+    std::vector<NodeSpatialIndex::NodeRef> refs;
+    App::GetGameContext()->GetActorManager()->GetNodeIndex().QueryRadius(center, radius, refs);
+    return FillNodeRefArrays(refs, out_actor_ids, out_node_ids);
+}
+
+int GameScript::findNearestNodes(Ogre::Vector3 const& center, int count, float max_radius, AngelScript::CScriptArray* out_actor_ids, AngelScript::CScriptArray* out_node_ids)
+{
+    std::vector<NodeSpatialIndex::NodeRef> refs;
+    if (count > 0)
+    {
+        App::GetGameContext()->GetActorManager()->GetNodeIndex().QueryNearest(center, static_cast<size_t>(count), max_radius, refs);
+    }
+    return FillNodeRefArrays(refs, out_actor_ids, out_node_ids);
+}
+
+bool GameScript::pickNode(Ogre::Vector3 const& origin, Ogre::Vector3 const& direction, float max_dist, float node_radius, int& out_actor_id, int& out_node_id)
+{
+    out_actor_id = -1;
+    out_node_id = -1;
+    if (direction.isZeroLength())
+        return false;
+
+    NodeSpatialIndex::NodeRef hit;
+    float hit_dist = 0.f;
+    if (!App::GetGameContext()->GetActorManager()->GetNodeIndex().QueryRay(Ogre::Ray(origin, direction), max_dist, node_radius, hit, hit_dist))
+        return false;
+
+    out_actor_id = hit.actor->ar_instance_id;
+    out_node_id = static_cast<int>(hit.node_num);
+    return true;
+}
+
 Actor* GameScript::spawnTruck(Ogre::String& truckName, Ogre::Vector3& pos, Ogre::Vector3& rot)
 {
     ActorSpawnRequest rq;
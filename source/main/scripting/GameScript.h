@@ -368,6 +368,26 @@ public:
     VehicleAI* getCurrentTruckAI();
     VehicleAI* getTruckAIByNum(int num);
 
+    /**
+     * Finds all actor nodes within radius, using the scene node index (positions are refreshed every physics frame).
+     * @param out_actor_ids Receives actor instance IDs, paired with `out_node_ids`
+     * @param out_node_ids Receives node numbers
+     * @return number of nodes found
+     */
+    int findNodesInRadius(Ogre::Vector3 const& center, float radius, AngelScript::CScriptArray* out_actor_ids, AngelScript::CScriptArray* out_node_ids);
+
+    /**
+     * Like `findNodesInRadius()`, but only the `count` nearest nodes, nearest first.
+     * @return number of nodes found
+     */
+    int findNearestNodes(Ogre::Vector3 const& center, int count, float max_radius, AngelScript::CScriptArray* out_actor_ids, AngelScript::CScriptArray* out_node_ids);
+
+    /**
+     * Casts a ray against actor nodes (treated as spheres), like mouse grabbing does.
+     * @return true if a node was hit
+     */
+    bool pickNode(Ogre::Vector3 const& origin, Ogre::Vector3 const& direction, float max_dist, float node_radius, int& out_actor_id, int& out_node_id);
+
     ///@}
 
     /// @name Camera
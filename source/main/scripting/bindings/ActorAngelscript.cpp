@@ -60,6 +60,11 @@ void RoR::RegisterActor(asIScriptEngine *engine)
     result = engine->RegisterEnumValue("FlareType", "FLARE_TYPE_USER", (int)FlareType::USER); ROR_ASSERT(result >= 0);
     result = engine->RegisterEnumValue("FlareType", "FLARE_TYPE_DASHBOARD", (int)FlareType::DASHBOARD); ROR_ASSERT(result >= 0);
 
+    // enum SimIntegrator
+    result = engine->RegisterEnum("SimIntegrator"); ROR_ASSERT(result >= 0);
+    result = engine->RegisterEnumValue("SimIntegrator", "SIM_INTEGRATOR_EULER", (int)SimIntegrator::EULER); ROR_ASSERT(result >= 0);
+    result = engine->RegisterEnumValue("SimIntegrator", "SIM_INTEGRATOR_IMPLICIT_BEAMS", (int)SimIntegrator::IMPLICIT_BEAMS); ROR_ASSERT(result >= 0);
+
 
     // class Actor (historically Beam)
     result = engine->RegisterObjectType("BeamClass", sizeof(Actor), asOBJ_REF); ROR_ASSERT(result>=0);
@@ -83,7 +88,13 @@ void RoR::RegisterActor(asIScriptEngine *engine)
     result = engine->RegisterObjectMethod("BeamClass", "bool isLocked()", asMETHOD(Actor,isLocked), asCALL_THISCALL); ROR_ASSERT(result>=0);
     result = engine->RegisterObjectMethod("BeamClass", "float getWheelSpeed()", asMETHOD(Actor,getWheelSpeed), asCALL_THISCALL); ROR_ASSERT(result>=0);
     result = engine->RegisterObjectMethod("BeamClass", "float getSpeed()", asMETHOD(Actor,getSpeed), asCALL_THISCALL); ROR_ASSERT(result>=0);
+    result = engine->RegisterObjectMethod("BeamClass", "SimIntegrator getIntegrator()", asMETHOD(Actor,getIntegrator), asCALL_THISCALL); ROR_ASSERT(result>=0);
+    result = engine->RegisterObjectMethod("BeamClass", "void setIntegrator(SimIntegrator)", asMETHOD(Actor,setIntegrator), asCALL_THISCALL); ROR_ASSERT(result>=0);
     result = engine->RegisterObjectMethod("BeamClass", "vector3 getGForces()", asMETHOD(Actor,getGForces), asCALL_THISCALL); ROR_ASSERT(result>=0);
+    result = engine->RegisterObjectMethod("BeamClass", "float getPhysicsCostMs()", asMETHOD(Actor,getPhysicsCostMs), asCALL_THISCALL); ROR_ASSERT(result>=0);
+    result = engine->RegisterObjectMethod("BeamClass", "float getCollisionCostMs()", asMETHOD(Actor,getCollisionCostMs), asCALL_THISCALL); ROR_ASSERT(result>=0);
+    result = engine->RegisterObjectMethod("BeamClass", "float getFlexbodyCostMs()", asMETHOD(Actor,getFlexbodyCostMs), asCALL_THISCALL); ROR_ASSERT(result>=0);
+    result = engine->RegisterObjectMethod("BeamClass", "float getWorstFrameCostMs()", asMETHOD(Actor,getWorstFrameCostMs), asCALL_THISCALL); ROR_ASSERT(result>=0);
 
     result = engine->RegisterObjectMethod("BeamClass", "float getRotation()", asMETHOD(Actor,getRotation), asCALL_THISCALL); ROR_ASSERT(result>=0);
     result = engine->RegisterObjectMethod("BeamClass", "vector3 getVehiclePosition()", asMETHOD(Actor,getPosition), asCALL_THISCALL); ROR_ASSERT(result>=0);
@@ -46,7 +46,11 @@ enum {
     OPT_TRUCKCONFIG,
     OPT_RUNSCRIPT,
     OPT_ENTERTRUCK,
-    OPT_JOINMPSERVER
+    OPT_JOINMPSERVER,
+    OPT_PERFTEST,
+    OPT_PERFTIME,
+    OPT_PERFBASELINE,
+    OPT_PERFREPORT
 };
 
 // option array
@@ -65,6 +69,10 @@ CSimpleOpt::SOption cmdline_options[] = {
     { OPT_CHECKCACHE,     ("-checkcache"),  SO_NONE    },
     { OPT_VER,            ("-version"),     SO_NONE    },
     { OPT_JOINMPSERVER,   ("-joinserver"),  SO_REQ_CMB },
+    { OPT_PERFTEST,       ("-perftest"),    SO_REQ_SEP },
+    { OPT_PERFTIME,       ("-perftime"),    SO_REQ_SEP },
+    { OPT_PERFBASELINE,   ("-perfbaseline"),SO_REQ_SEP },
+    { OPT_PERFREPORT,     ("-perfreport"),  SO_REQ_SEP },
     SO_END_OF_OPTIONS
 };
 
@@ -134,6 +142,22 @@ void Console::processCommandLine(int argc, char *argv[])
         {
             App::cli_preset_veh_enter->setVal(true);
         }
+        else if (args.OptionId() == OPT_PERFTEST)
+        {
+            App::cli_perftest_vehicles->setStr(args.OptionArg());
+        }
+        else if (args.OptionId() == OPT_PERFTIME)
+        {
+            App::cli_perftest_seconds->setVal(Ogre::StringConverter::parseReal(args.OptionArg()));
+        }
+        else if (args.OptionId() == OPT_PERFBASELINE)
+        {
+            App::cli_perftest_baseline->setStr(args.OptionArg());
+        }
+        else if (args.OptionId() == OPT_PERFREPORT)
+        {
+            App::cli_perftest_report->setStr(args.OptionArg());
+        }
         else if (args.OptionId() == OPT_JOINMPSERVER)
         {
             std::string server_args = args.OptionArg();
@@ -175,6 +199,10 @@ void Console::showCommandLineUsage()
             "-version shows the version information"                "\n"
             "-joinserver=<server>:<port> (join multiplayer server)" "\n"
             "-runscript <filename> (load script, can be repeated)"  "\n"
+            "-perftest <truck,truck...> (unattended performance run)" "\n"
+            "-perftime <seconds> (simulated time of the run)"       "\n"
+            "-perfbaseline <file> (report to compare against)"      "\n"
+            "-perfreport <file> (where to write JSON results)"      "\n"
             "For example: RoR.exe -map simple2 -pos '518 0 518' -rot 45 -truck semi.truck -enter"));
 }
 
@@ -57,6 +57,12 @@ void Console::cVarSetupBuiltins()
     App::sim_gearbox_mode        = this->cVarCreate("sim_gearbox_mode",        "GearboxMode",                CVAR_ARCHIVE | CVAR_TYPE_INT);
     App::sim_soft_reset_mode     = this->cVarCreate("sim_soft_reset_mode",     "",                                          CVAR_TYPE_BOOL,    "false");
     App::sim_quickload_dialog    = this->cVarCreate("sim_quickload_dialog",    "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
+    App::sim_arena_huge_pages    = this->cVarCreate("sim_arena_huge_pages",    "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::sim_spawn_sort_beams    = this->cVarCreate("sim_spawn_sort_beams",    "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::sim_integrator          = this->cVarCreate("sim_integrator",          "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "0"/*(int)SimIntegrator::EULER*/);
+    App::sim_implicit_substep    = this->cVarCreate("sim_implicit_substep",    "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "4"/*PHYSICS_MAX_SUBSTEP_MULT*/);
+    App::sim_adaptive_substeps   = this->cVarCreate("sim_adaptive_substeps",   "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::sim_deterministic       = this->cVarCreate("sim_deterministic",       "",                                          CVAR_TYPE_BOOL,    "false");
 
     App::mp_state                = this->cVarCreate("mp_state",                "",                                          CVAR_TYPE_INT,     "0"/*(int)MpState::DISABLED*/);
     App::mp_join_on_startup      = this->cVarCreate("mp_join_on_startup",      "Auto connect",               CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
@@ -86,6 +92,7 @@ void Console::cVarSetupBuiltins()
     App::diag_preset_veh_config  = this->cVarCreate("diag_preset_veh_config",  "Preselected TruckConfig",    CVAR_ARCHIVE);
     App::diag_preset_veh_enter   = this->cVarCreate("diag_preset_veh_enter",   "Enter Preselected Truck",    CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::diag_log_console_echo   = this->cVarCreate("diag_log_console_echo",   "Enable Ingame Console",      CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::diag_log_async          = this->cVarCreate("diag_log_async",          "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::diag_log_beam_break     = this->cVarCreate("diag_log_beam_break",     "Beam Break Debug",           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::diag_log_beam_deform    = this->cVarCreate("diag_log_beam_deform",    "Beam Deform Debug",          CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::diag_log_beam_trigger   = this->cVarCreate("diag_log_beam_trigger",   "Trigger Debug",              CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
@@ -98,6 +105,8 @@ void Console::cVarSetupBuiltins()
     App::diag_hide_nodes         = this->cVarCreate("diag_hide_nodes",         "Hide nodes",                 CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::diag_terrn_log_roads    = this->cVarCreate("diag_terrn_log_roads",    "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::diag_actor_dump         = this->cVarCreate("diag_actor_dump",         "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::diag_sim_checksums      = this->cVarCreate("diag_sim_checksums",      "",                                          CVAR_TYPE_BOOL,    "false");
+    App::diag_actor_budget_ms    = this->cVarCreate("diag_actor_budget_ms",    "",                           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "0");
 
     App::sys_process_dir         = this->cVarCreate("sys_process_dir",         "",                           0);
     App::sys_user_dir            = this->cVarCreate("sys_user_dir",            "",                           0);
@@ -121,6 +130,10 @@ void Console::cVarSetupBuiltins()
     App::cli_force_cache_update  = this->cVarCreate("cli_force_cache_update",  "",                                          CVAR_TYPE_BOOL,    "false");
     App::cli_resume_autosave     = this->cVarCreate("cli_resume_autosave",     "",                                          CVAR_TYPE_BOOL,    "false");
     App::cli_custom_scripts      = this->cVarCreate("cli_custom_scripts",      "",                           0,                                "");
+    App::cli_perftest_vehicles   = this->cVarCreate("cli_perftest_vehicles",   "",                           0,                                "");
+    App::cli_perftest_seconds    = this->cVarCreate("cli_perftest_seconds",    "",                                          CVAR_TYPE_FLOAT,   "30");
+    App::cli_perftest_baseline   = this->cVarCreate("cli_perftest_baseline",   "",                           0,                                "");
+    App::cli_perftest_report     = this->cVarCreate("cli_perftest_report",     "",                           0,                                "");
 
     App::io_analog_smoothing     = this->cVarCreate("io_analog_smoothing",     "Analog Input Smoothing",     CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "1.0");
     App::io_analog_sensitivity   = this->cVarCreate("io_analog_sensitivity",   "Analog Input Sensitivity",   CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "1.0");
@@ -642,6 +642,38 @@ public:
     }
 };
 
+class ActorPerfCmd: public ConsoleCmd
+{
+public:
+    ActorPerfCmd(): ConsoleCmd("actorperf", "[<count>]", _L("actorperf - lists the most CPU-expensive actors (ms per second, last second)")) {}
+
+    void Run(Ogre::StringVector const& args) override
+    {
+        if (!this->CheckAppState(AppState::SIMULATION))
+            return;
+
+        size_t count = 10;
+        if (args.size() > 1)
+        {
+            count = static_cast<size_t>(std::max(1, Ogre::StringConverter::parseInt(args[1], 10)));
+        }
+
+        std::vector<Actor*> actors = App::GetGameContext()->GetActorManager()->GetActors();
+        auto total_cost = [](Actor* a) { return a->getPhysicsCostMs() + a->getCollisionCostMs() + a->getFlexbodyCostMs(); };
+        std::sort(actors.begin(), actors.end(), [&](Actor* a, Actor* b) { return total_cost(a) > total_cost(b); });
+
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_REPLY,
+            fmt::format(_L("{}: {} actors, physics / collisions / flexbodies / worst frame [ms]"), m_name, actors.size()));
+        for (size_t i = 0; i < actors.size() && i < count; i++)
+        {
+            Actor* a = actors[i];
+            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_REPLY,
+                fmt::format("#{} {}: {:.2f} / {:.2f} / {:.2f} / {:.2f}", a->ar_instance_id, a->ar_design_name,
+                    a->getPhysicsCostMs(), a->getCollisionCostMs(), a->getFlexbodyCostMs(), a->getWorstFrameCostMs()));
+        }
+    }
+};
+
 /// @} // addtogroup ConsoleCmd
 
 // -------------------------------------------------------------------------------------
@@ -666,6 +698,7 @@ void Console::regBuiltinCommands()
     // Additions
     cmd = new ClearCmd();                 m_commands.insert(std::make_pair(cmd->getName(), cmd));
     cmd = new LoadScriptCmd();            m_commands.insert(std::make_pair(cmd->getName(), cmd));
+    cmd = new ActorPerfCmd();             m_commands.insert(std::make_pair(cmd->getName(), cmd));
     // CVars
     cmd = new SetCmd();                   m_commands.insert(std::make_pair(cmd->getName(), cmd));
     cmd = new SetstringCmd();             m_commands.insert(std::make_pair(cmd->getName(), cmd));
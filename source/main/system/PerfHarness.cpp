@@ -0,0 +1,355 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PerfHarness.h"
+
+#include "Actor.h"
+#include "ActorManager.h"
+#include "AppContext.h"
+#include "CacheSystem.h"
+#include "Character.h"
+#include "GameContext.h"
+#include "PlatformUtils.h"
+#include "RoRVersion.h"
+
+#include <algorithm>
+#include <ctime>
+#include <fmt/format.h>
+#include <fstream>
+#include <sstream>
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+using namespace RoR;
+
+static const char*  DEFAULT_TERRAIN     = "simple2.terrn2";
+static const float  DEFAULT_TOLERANCE   = 0.2f;  // Relative; may be overriden by the baseline file
+static const double TOLERANCE_FLOOR_MS  = 0.01;  // Tiny values are mostly noise
+static const float  VEHICLE_SPACING     = 20.f;  // Meters
+
+static const int    EXIT_REGRESSION     = 1;
+static const int    EXIT_ERROR          = 2;
+
+const char* PerfHarness::GetMetricName(Metric metric)
+{
+    switch (metric)
+    {
+    case METRIC_TRUCK_PARSE: return "truck_parse";
+    case METRIC_ACTOR_SPAWN: return "actor_spawn";
+    case METRIC_SUBSTEP:     return "physics_substep";
+    case METRIC_FRAME:       return "frame";
+    case METRIC_PHYSICS:     return "actor_physics_per_sim_second";
+    case METRIC_COLLISION:   return "actor_collision_per_sim_second";
+    case METRIC_FLEXBODY:    return "actor_flexbody_per_sim_second";
+    default:                 return "";
+    }
+}
+
+void PerfHarness::Configure()
+{
+    if (App::cli_perftest_vehicles->getStr() == "")
+        return;
+
+    m_vehicles = Ogre::StringUtil::split(App::cli_perftest_vehicles->getStr(), ",");
+    for (std::string& vehicle : m_vehicles)
+        Ogre::StringUtil::trim(vehicle);
+    m_sim_seconds = std::max(1.f, App::cli_perftest_seconds->getFloat());
+
+    if (App::cli_preset_terrain->getStr() == "")
+    {
+        App::cli_preset_terrain->setStr(DEFAULT_TERRAIN);
+    }
+
+    // Every frame advances 1/60s of simulation, whatever the (unthrottled) framerate - the workload is the same on every run.
+    App::sim_deterministic->setVal(true);
+    App::gfx_fps_limit->setVal(0);
+
+    RoR::LogFormat("[RoR|PerfTest] Running %.1f simulated seconds on terrain '%s' with %d vehicles",
+        m_sim_seconds, App::cli_preset_terrain->getStr().c_str(), (int)m_vehicles.size());
+    m_state = State::WAITING_FOR_TERRAIN;
+}
+
+void PerfHarness::AddSample(Metric metric, float ms, int count)
+{
+    if (m_state == State::INACTIVE || count <= 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_metrics_mutex);
+    MetricData& data = m_metrics[metric];
+    data.total_ms += ms;
+    data.max_ms = std::max(data.max_ms, static_cast<double>(ms) / count);
+    data.count += count;
+}
+
+void PerfHarness::Abort(std::string const& reason)
+{
+    if (m_state == State::INACTIVE || m_state == State::FINISHED)
+        return;
+
+    RoR::LogFormat("[RoR|PerfTest] Aborted: %s", reason.c_str());
+    m_exit_code = EXIT_ERROR;
+    m_state = State::FINISHED;
+    App::GetGameContext()->PushMessage(Message(MSG_APP_SHUTDOWN_REQUESTED));
+}
+
+void PerfHarness::Update()
+{
+    switch (m_state.load())
+    {
+    case State::WAITING_FOR_TERRAIN:
+        if (App::app_state->getEnum<AppState>() == AppState::SIMULATION && App::GetGameContext()->GetPlayerCharacter())
+        {
+            this->SpawnVehicles();
+            if (m_state != State::WAITING_FOR_TERRAIN)
+                return; // Aborted
+
+            // Render-free: the window must exist for OGRE to load resources, but no frames are drawn.
+            App::GetAppContext()->GetRenderWindow()->setHidden(true);
+
+            for (Actor* actor : App::GetGameContext()->GetActorManager()->GetActors())
+            {
+                for (int i = 0; i < ActorPerfStats::NUM_COUNTERS; i++)
+                    m_start_totals_ns[i] += actor->ar_perf_stats.totals_ns[i].load(std::memory_order_relaxed);
+            }
+            m_start_sim_time = App::GetGameContext()->GetActorManager()->GetTotalTime();
+            m_last_frame_time = std::chrono::steady_clock::now();
+            m_state = State::RUNNING;
+        }
+        break;
+
+    case State::RUNNING:
+    {
+        const auto now = std::chrono::steady_clock::now();
+        this->AddSample(METRIC_FRAME, std::chrono::duration<float, std::milli>(now - m_last_frame_time).count());
+        m_last_frame_time = now;
+        m_num_frames++;
+
+        if (App::GetGameContext()->GetActorManager()->GetTotalTime() - m_start_sim_time >= m_sim_seconds)
+        {
+            this->Finish();
+        }
+        break;
+    }
+
+    default:;
+    }
+}
+
+void PerfHarness::SpawnVehicles()
+{
+    Character* character = App::GetGameContext()->GetPlayerCharacter();
+    const Ogre::Quaternion rotation(Ogre::Degree(180) - character->getRotation(), Ogre::Vector3::UNIT_Y);
+    const Ogre::Vector3 side = rotation * Ogre::Vector3::UNIT_X;
+
+    for (size_t i = 0; i < m_vehicles.size(); i++)
+    {
+        CacheEntry* entry = App::GetCacheSystem()->FindEntryByFilename(LT_AllBeam, /*partial=*/false, m_vehicles[i]);
+        if (!entry)
+        {
+            this->Abort(fmt::format("vehicle '{}' not found in mod cache", m_vehicles[i]));
+            return;
+        }
+
+        ActorSpawnRequest rq;
+        rq.asr_cache_entry = entry;
+        rq.asr_position    = character->getPosition() + side * (VEHICLE_SPACING * i);
+        rq.asr_rotation    = rotation;
+        rq.asr_origin      = ActorSpawnRequest::Origin::CONFIG_FILE;
+        if (!entry->sectionconfigs.empty())
+        {
+            rq.asr_config = entry->sectionconfigs[0];
+        }
+
+        if (!App::GetGameContext()->SpawnActor(rq)) // Timed inside
+        {
+            this->Abort(fmt::format("vehicle '{}' failed to spawn", m_vehicles[i]));
+            return;
+        }
+    }
+}
+
+void PerfHarness::Finish()
+{
+    // Per-actor counters, summed over the whole scene
+    const float sim_seconds = App::GetGameContext()->GetActorManager()->GetTotalTime() - m_start_sim_time;
+    uint64_t totals_ns[ActorPerfStats::NUM_COUNTERS] = {};
+    for (Actor* actor : App::GetGameContext()->GetActorManager()->GetActors())
+    {
+        for (int i = 0; i < ActorPerfStats::NUM_COUNTERS; i++)
+            totals_ns[i] += actor->ar_perf_stats.totals_ns[i].load(std::memory_order_relaxed);
+    }
+    const Metric counter_metrics[ActorPerfStats::NUM_COUNTERS] = { METRIC_PHYSICS, METRIC_COLLISION, METRIC_FLEXBODY };
+    for (int i = 0; i < ActorPerfStats::NUM_COUNTERS; i++)
+    {
+        this->AddSample(counter_metrics[i], static_cast<float>((totals_ns[i] - m_start_totals_ns[i]) / 1e6 / sim_seconds));
+    }
+
+    std::string report_path = App::cli_perftest_report->getStr();
+    if (report_path == "")
+    {
+        report_path = PathCombine(App::sys_user_dir->getStr(), "perftest.json");
+    }
+    if (!this->WriteReport(report_path))
+    {
+        m_exit_code = EXIT_ERROR;
+    }
+
+    m_state = State::FINISHED;
+    App::GetGameContext()->PushMessage(Message(MSG_APP_SHUTDOWN_REQUESTED));
+}
+
+PerfHarness::BaselineResult PerfHarness::CompareWithBaseline(std::string const& filename, rapidjson::Value& j_out, rapidjson::Document::AllocatorType& allocator)
+{
+    std::ifstream file(filename);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    rapidjson::Document j_baseline;
+    j_baseline.Parse(contents.str().c_str());
+    if (!file.is_open() || j_baseline.HasParseError() || !j_baseline.IsObject() ||
+        !j_baseline.HasMember("metrics") || !j_baseline["metrics"].IsObject())
+    {
+        RoR::LogFormat("[RoR|PerfTest] Cannot read baseline '%s'", filename.c_str());
+        j_out.AddMember("baseline", rapidjson::Value(filename.c_str(), allocator), allocator);
+        j_out.AddMember("error", "unreadable baseline", allocator);
+        return BaselineResult::UNREADABLE;
+    }
+
+    float default_tolerance = DEFAULT_TOLERANCE;
+    if (j_baseline.HasMember("tolerance") && j_baseline["tolerance"].IsNumber())
+    {
+        default_tolerance = j_baseline["tolerance"].GetFloat();
+    }
+
+    bool passed = true;
+    int num_compared = 0;
+    rapidjson::Value j_metrics(rapidjson::kObjectType);
+    for (int i = 0; i < METRIC_COUNT; i++)
+    {
+        const char* name = GetMetricName(static_cast<Metric>(i));
+        if (!j_baseline["metrics"].HasMember(name) || m_metrics[i].count == 0)
+            continue;
+        rapidjson::Value& j_base_metric = j_baseline["metrics"][name];
+        if (!j_base_metric.IsObject() || !j_base_metric.HasMember("mean_ms") || !j_base_metric["mean_ms"].IsNumber())
+            continue;
+
+        float tolerance = default_tolerance;
+        if (j_base_metric.HasMember("tolerance") && j_base_metric["tolerance"].IsNumber())
+        {
+            tolerance = j_base_metric["tolerance"].GetFloat();
+        }
+
+        const double base_ms = j_base_metric["mean_ms"].GetDouble();
+        num_compared++;
+        const double value_ms = m_metrics[i].total_ms / m_metrics[i].count;
+        const double band_ms = std::max(base_ms * tolerance, TOLERANCE_FLOOR_MS);
+        const char* status = "ok";
+        if (value_ms > base_ms + band_ms)
+        {
+            status = "regressed";
+            passed = false;
+        }
+        else if (value_ms < base_ms - band_ms)
+        {
+            status = "improved";
+        }
+        RoR::LogFormat("[RoR|PerfTest] %-32s %10.3f ms (baseline %10.3f ms +/- %.0f%%): %s",
+            name, value_ms, base_ms, tolerance * 100.f, status);
+
+        rapidjson::Value j_metric(rapidjson::kObjectType);
+        j_metric.AddMember("baseline_mean_ms", base_ms, allocator);
+        j_metric.AddMember("tolerance", tolerance, allocator);
+        j_metric.AddMember("status", rapidjson::StringRef(status), allocator);
+        j_metrics.AddMember(rapidjson::StringRef(name), j_metric, allocator);
+    }
+
+    j_out.AddMember("baseline", rapidjson::Value(filename.c_str(), allocator), allocator);
+    if (num_compared == 0)
+    {
+        // A baseline that checks nothing must not pass silently
+        RoR::LogFormat("[RoR|PerfTest] Baseline '%s' has no metric in common with this run", filename.c_str());
+        j_out.AddMember("error", "no comparable metrics", allocator);
+        return BaselineResult::UNREADABLE;
+    }
+    j_out.AddMember("passed", passed, allocator);
+    j_out.AddMember("metrics", j_metrics, allocator);
+    return (passed) ? BaselineResult::PASSED : BaselineResult::REGRESSED;
+}
+
+bool PerfHarness::WriteReport(std::string const& filename)
+{
+    rapidjson::Document j_doc;
+    j_doc.SetObject();
+    rapidjson::Document::AllocatorType& allocator = j_doc.GetAllocator();
+
+    j_doc.AddMember("format_version", 1, allocator);
+    j_doc.AddMember("version", rapidjson::StringRef(ROR_VERSION_STRING), allocator);
+    j_doc.AddMember("build_date", rapidjson::StringRef(ROR_BUILD_DATE), allocator);
+    j_doc.AddMember("timestamp", static_cast<int64_t>(std::time(nullptr)), allocator);
+    j_doc.AddMember("terrain", rapidjson::Value(App::cli_preset_terrain->getStr().c_str(), allocator), allocator);
+    rapidjson::Value j_vehicles(rapidjson::kArrayType);
+    for (std::string const& vehicle : m_vehicles)
+    {
+        j_vehicles.PushBack(rapidjson::Value(vehicle.c_str(), allocator), allocator);
+    }
+    j_doc.AddMember("vehicles", j_vehicles, allocator);
+    j_doc.AddMember("sim_seconds", m_sim_seconds, allocator);
+    j_doc.AddMember("frames", m_num_frames, allocator);
+
+    rapidjson::Value j_metrics(rapidjson::kObjectType);
+    for (int i = 0; i < METRIC_COUNT; i++)
+    {
+        MetricData const& data = m_metrics[i];
+        if (data.count == 0)
+            continue;
+
+        rapidjson::Value j_metric(rapidjson::kObjectType);
+        j_metric.AddMember("mean_ms", data.total_ms / data.count, allocator);
+        j_metric.AddMember("max_ms", data.max_ms, allocator);
+        j_metric.AddMember("total_ms", data.total_ms, allocator);
+        j_metric.AddMember("count", data.count, allocator);
+        j_metrics.AddMember(rapidjson::StringRef(GetMetricName(static_cast<Metric>(i))), j_metric, allocator);
+    }
+    j_doc.AddMember("metrics", j_metrics, allocator);
+
+    if (App::cli_perftest_baseline->getStr() != "")
+    {
+        rapidjson::Value j_comparison(rapidjson::kObjectType);
+        switch (this->CompareWithBaseline(App::cli_perftest_baseline->getStr(), j_comparison, allocator))
+        {
+        case BaselineResult::REGRESSED:  m_exit_code = EXIT_REGRESSION; break;
+        case BaselineResult::UNREADABLE: m_exit_code = EXIT_ERROR;      break;
+        default:;
+        }
+        j_doc.AddMember("comparison", j_comparison, allocator);
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    j_doc.Accept(writer);
+
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    file << buffer.GetString();
+    if (!file.good())
+    {
+        RoR::LogFormat("[RoR|PerfTest] Error writing report '%s'", filename.c_str());
+        return false;
+    }
+    RoR::LogFormat("[RoR|PerfTest] Report written to '%s'", filename.c_str());
+    return true;
+}
@@ -0,0 +1,139 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+
+#pragma once
+
+#include "Application.h"
+#include "ActorPerfStats.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <rapidjson/document.h>
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Application
+/// @{
+
+/// Unattended performance run for CI, started by command line argument `-perftest <vehicles>`.
+/// Loads the terrain (`-map`), spawns the listed vehicles, simulates `-perftime` seconds in lockstep
+/// without rendering any frames, writes a JSON report (`-perfreport`) and compares it
+/// against a previous report (`-perfbaseline`). The process exit code is 1 on regression
+/// and 2 on error, including an unreadable baseline.
+class PerfHarness
+{
+public:
+    enum Metric
+    {
+        METRIC_TRUCK_PARSE,   //!< Parsing + validating a truckfile
+        METRIC_ACTOR_SPAWN,   //!< Whole `GameContext::SpawnActor()`, including parsing
+        METRIC_SUBSTEP,       //!< `ActorManager::UpdatePhysicsSimulation()`, per substep
+        METRIC_FRAME,         //!< Main loop iteration
+        METRIC_PHYSICS,       //!< Sum of `ActorPerfStats::PHYSICS`, per simulated second
+        METRIC_COLLISION,     //!< Sum of `ActorPerfStats::COLLISION`, per simulated second
+        METRIC_FLEXBODY,      //!< Sum of `ActorPerfStats::FLEXBODY`, per simulated second
+        METRIC_COUNT
+    };
+
+    /// Reads 'cli_perftest_*' cvars; call after processing command line.
+    void Configure();
+    bool IsActive() const { return m_state.load() != State::INACTIVE; }
+
+    /// Thread safe; ignored unless active. Samples covering zero events (`count == 0`) are dropped.
+    void AddSample(Metric metric, float ms, int count = 1);
+
+    /// Call every frame from the main loop; spawns vehicles once the terrain is loaded and ends the run.
+    void Update();
+
+    /// Ends the run with an error, e.g. when the terrain fails to load.
+    void Abort(std::string const& reason);
+
+    int GetExitCode() const { return m_exit_code; }
+
+private:
+    enum class State
+    {
+        INACTIVE,
+        WAITING_FOR_TERRAIN,
+        RUNNING,
+        FINISHED
+    };
+
+    enum class BaselineResult
+    {
+        PASSED,
+        REGRESSED,
+        UNREADABLE    //!< Missing or malformed file, or no metric in common with this run
+    };
+
+    struct MetricData
+    {
+        double total_ms = 0.0;
+        double max_ms = 0.0;
+        int    count = 0;
+    };
+
+    void SpawnVehicles();
+    void Finish();
+    bool WriteReport(std::string const& filename);
+    BaselineResult CompareWithBaseline(std::string const& filename, rapidjson::Value& j_out, rapidjson::Document::AllocatorType& allocator);
+
+    static const char* GetMetricName(Metric metric);
+
+    std::atomic<State>        m_state{State::INACTIVE};  //!< Also read by `AddSample()` from the sim thread
+    std::vector<std::string>  m_vehicles;
+    float                     m_sim_seconds = 0.f;
+    float                     m_start_sim_time = 0.f;
+    int                       m_num_frames = 0;
+    std::chrono::steady_clock::time_point m_last_frame_time;
+    uint64_t                  m_start_totals_ns[ActorPerfStats::NUM_COUNTERS] = {};
+    MetricData                m_metrics[METRIC_COUNT];
+    std::mutex                m_metrics_mutex;
+    int                       m_exit_code = 0;
+};
+
+/// Adds the lifetime of the scope as one sample of `PerfHarness` metric.
+class PerfHarnessScope
+{
+public:
+    PerfHarnessScope(PerfHarness::Metric metric, int count = 1):
+        m_metric(metric), m_count(count), m_start(std::chrono::steady_clock::now())
+    {}
+
+    ~PerfHarnessScope()
+    {
+        const std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - m_start;
+        App::GetPerfHarness()->AddSample(m_metric, elapsed.count(), m_count);
+    }
+
+    void SetCount(int count) { m_count = count; }
+
+private:
+    PerfHarness::Metric                    m_metric;
+    int                                    m_count;
+    std::chrono::steady_clock::time_point  m_start;
+};
+
+/// @} // addtogroup Application
+
+} // namespace RoR
@@ -0,0 +1,199 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "StartupGraph.h"
+
+#include "ThreadPool.h"
+
+#include <Ogre.h>
+#include <algorithm>
+
+using namespace RoR;
+
+StartupGraph::~StartupGraph()
+{
+    // Only relevant if a main thread task threw - workers reference `m_tasks`
+    for (TaskInfo& task : m_tasks)
+    {
+        if (task.handle)
+            task.handle->join();
+    }
+}
+
+void StartupGraph::AddTask(std::string const& name, TaskThread thread, std::vector<std::string> const& deps, TaskFunc func)
+{
+    TaskInfo task;
+    task.name = name;
+    task.thread = thread;
+    task.func = func;
+    for (std::string const& dep_name : deps)
+    {
+        auto itor = std::find_if(m_tasks.begin(), m_tasks.end(),
+            [&dep_name](TaskInfo const& t) { return t.name == dep_name; });
+        ROR_ASSERT(itor != m_tasks.end()); // Dependencies must be added first - this also rules out cycles
+        if (itor != m_tasks.end())
+            task.deps.push_back(static_cast<int>(itor - m_tasks.begin()));
+    }
+    m_tasks.push_back(task);
+}
+
+bool StartupGraph::IsReady(TaskInfo const& task) const
+{
+    if (task.state != TaskState::PENDING)
+        return false;
+
+    for (int dep : task.deps)
+    {
+        if (m_tasks[dep].state != TaskState::DONE)
+            return false;
+    }
+    return true;
+}
+
+bool StartupGraph::Execute(TaskInfo& task)
+{
+    if (task.thread == TaskThread::MAIN)
+    {
+        return task.func(); // Exceptions are handled by `main()`
+    }
+
+    try
+    {
+        return task.func();
+    }
+    catch (std::exception& e)
+    {
+        RoR::LogFormat("[RoR|Startup] Task '%s' failed with exception: %s", task.name.c_str(), e.what());
+        return false;
+    }
+}
+
+bool StartupGraph::Run()
+{
+    const TimePoint start_time = std::chrono::steady_clock::now();
+    bool failed = false;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        // Start all ready worker tasks
+        for (TaskInfo& task : m_tasks)
+        {
+            if (failed || task.thread != TaskThread::WORKER || !this->IsReady(task))
+                continue;
+
+            task.state = TaskState::RUNNING;
+            task.start_time = std::chrono::steady_clock::now();
+            TaskInfo* task_ptr = &task; // Stable - no tasks are added while running
+            auto task_func = [this, task_ptr]()
+            {
+                const bool ok = this->Execute(*task_ptr);
+                std::lock_guard<std::mutex> task_lock(m_mutex);
+                task_ptr->end_time = std::chrono::steady_clock::now();
+                task_ptr->state = (ok) ? TaskState::DONE : TaskState::FAILED;
+                m_worker_done_cv.notify_all();
+            };
+            if (App::GetThreadPool())
+            {
+                task.handle = App::GetThreadPool()->RunTask(task_func);
+            }
+            else
+            {
+                lock.unlock();
+                task_func();
+                lock.lock();
+            }
+        }
+
+        // Run the first ready main thread task
+        auto main_itor = std::find_if(m_tasks.begin(), m_tasks.end(),
+            [this](TaskInfo const& t) { return t.thread == TaskThread::MAIN && this->IsReady(t); });
+        if (!failed && main_itor != m_tasks.end())
+        {
+            TaskInfo& task = *main_itor;
+            task.state = TaskState::RUNNING;
+            task.start_time = std::chrono::steady_clock::now();
+            lock.unlock();
+            const bool ok = this->Execute(task);
+            lock.lock();
+            task.end_time = std::chrono::steady_clock::now();
+            task.state = (ok) ? TaskState::DONE : TaskState::FAILED;
+            failed = failed || !ok;
+            continue;
+        }
+
+        // Nothing to run on main thread - wait for workers, or finish
+        const bool any_running = std::any_of(m_tasks.begin(), m_tasks.end(),
+            [](TaskInfo const& t) { return t.state == TaskState::RUNNING; });
+        if (!any_running)
+        {
+            break;
+        }
+        m_worker_done_cv.wait(lock);
+        failed = failed || std::any_of(m_tasks.begin(), m_tasks.end(),
+            [](TaskInfo const& t) { return t.state == TaskState::FAILED; });
+    }
+
+    for (TaskInfo& task : m_tasks)
+    {
+        if (task.state == TaskState::PENDING)
+        {
+            RoR::LogFormat("[RoR|Startup] Task '%s' was not run", task.name.c_str());
+            failed = true;
+        }
+    }
+
+    lock.unlock();
+    this->LogTimeline(start_time);
+    return !failed;
+}
+
+void StartupGraph::LogTimeline(TimePoint start_time)
+{
+    typedef std::chrono::duration<float, std::milli> MilliSec;
+
+    std::vector<TaskInfo*> sorted;
+    for (TaskInfo& task : m_tasks)
+    {
+        if (task.state == TaskState::DONE || task.state == TaskState::FAILED)
+            sorted.push_back(&task);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](TaskInfo* a, TaskInfo* b) { return a->start_time < b->start_time; });
+
+    float total_ms = 0.f;
+    float main_thread_ms = 0.f;
+    float worker_ms = 0.f;
+    RoR::Log("[RoR|Startup] Timeline (milliseconds from start):");
+    for (TaskInfo* task : sorted)
+    {
+        const float begin_ms = MilliSec(task->start_time - start_time).count();
+        const float end_ms = MilliSec(task->end_time - start_time).count();
+        RoR::LogFormat("[RoR|Startup]   %-20s %-6s %8.1f - %8.1f (%7.1f)%s",
+            task->name.c_str(), (task->thread == TaskThread::MAIN) ? "main" : "worker",
+            begin_ms, end_ms, end_ms - begin_ms, (task->state == TaskState::FAILED) ? " FAILED" : "");
+
+        total_ms = std::max(total_ms, end_ms);
+        if (task->thread == TaskThread::MAIN)
+            main_thread_ms += end_ms - begin_ms;
+        else
+            worker_ms += end_ms - begin_ms;
+    }
+    RoR::LogFormat("[RoR|Startup] Total %.1f ms (main thread busy %.1f ms, workers %.1f ms)",
+        total_ms, main_thread_ms, worker_ms);
+}
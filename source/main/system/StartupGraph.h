@@ -0,0 +1,97 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+
+#pragma once
+
+#include "Application.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Application
+/// @{
+
+/// Application startup as a dependency graph of init tasks.
+/// Worker tasks run on the `ThreadPool` as soon as their dependencies are done; they must not touch
+/// OGRE resource system, rendering, GUI or '_L()'. Main thread tasks run one at a time, the earliest added ready task first -
+/// a task waiting for a worker gets overtaken by later ones, so every task must list all its dependencies.
+/// When finished, a timeline of all tasks is written to RoR.log.
+class StartupGraph
+{
+public:
+    enum class TaskThread
+    {
+        MAIN,
+        WORKER
+    };
+
+    typedef std::function<bool()> TaskFunc; //!< Returns false on fatal error (already reported to user)
+
+    ~StartupGraph();
+
+    /// @param deps Names of previously added tasks.
+    void AddTask(std::string const& name, TaskThread thread, std::vector<std::string> const& deps, TaskFunc func);
+
+    /// Blocks until all tasks finished. If a task fails, no further tasks are started.
+    /// @return False if any task failed.
+    bool Run();
+
+private:
+    enum class TaskState
+    {
+        PENDING,
+        RUNNING,
+        DONE,
+        FAILED
+    };
+
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    struct TaskInfo
+    {
+        std::string       name;
+        TaskThread        thread;
+        std::vector<int>  deps;
+        TaskFunc          func;
+        TaskState         state = TaskState::PENDING;
+        TimePoint         start_time;
+        TimePoint         end_time;
+        std::shared_ptr<Task> handle; //!< Worker tasks only
+    };
+
+    bool IsReady(TaskInfo const& task) const; //!< Caller must hold `m_mutex`
+    bool Execute(TaskInfo& task);             //!< Runs the func, catching exceptions on worker threads
+    void LogTimeline(TimePoint start_time);
+
+    std::vector<TaskInfo>    m_tasks;
+    std::mutex               m_mutex;
+    std::condition_variable  m_worker_done_cv;
+};
+
+/// @} // addtogroup Application
+
+} // namespace RoR
@@ -107,15 +107,18 @@ void ProceduralManager::removeObject(ProceduralObjectPtr po)
     }
 }
 
-void ProceduralManager::updateObject(ProceduralObjectPtr po)
+/// Inputs of one `ProceduralRoad::addBlock()` call
+struct RoadBlockDef
+{
+    Ogre::Vector3 pos;
+    Ogre::Quaternion rot;
+    RoadType type;
+    float width, bwidth, bheight;
+    int pillartype;
+};
+
+static void GenerateRoadBlocks(ProceduralObjectPtr po, std::vector<RoadBlockDef>& out)
 {
-    if (po->road)
-        this->deleteObject(po);
-
-    po->road = ProceduralRoadPtr::Bind(new ProceduralRoad());
-    // In diagnostic mode, disable collisions (speeds up terrain loading)
-    po->road->setCollisionEnabled(!App::diag_terrn_log_roads->getBool());
-
     Ogre::SimpleSpline spline;
     if (po->smoothing_num_splits > 0)
     {
@@ -140,7 +143,7 @@ void ProceduralManager::updateObject(ProceduralObjectPtr po)
             {
                 if (i_point == 0)
                 {
-                    po->road->addBlock(pp->position, pp->rotation, pp->type, pp->width, pp->bwidth, pp->bheight, pp->pillartype);
+                    out.push_back({pp->position, pp->rotation, pp->type, pp->width, pp->bwidth, pp->bheight, pp->pillartype});
                 }
                 else
                 {
@@ -153,15 +156,46 @@ void ProceduralManager::updateObject(ProceduralObjectPtr po)
                     const float smooth_bwidth = Math::lerp(prev_pp->bwidth, pp->bwidth, progress);
                     const float smooth_bheight = Math::lerp(prev_pp->bheight, pp->bheight, progress);
 
-                    po->road->addBlock(smooth_pos, smooth_rot, pp->type, smooth_width, smooth_bwidth, smooth_bheight, pp->pillartype);
+                    out.push_back({smooth_pos, smooth_rot, pp->type, smooth_width, smooth_bwidth, smooth_bheight, pp->pillartype});
                 }
             }
         }
         else
         {
             // smoothing off
-            po->road->addBlock(pp->position, pp->rotation, pp->type, pp->width, pp->bwidth, pp->bheight, pp->pillartype);
+            out.push_back({pp->position, pp->rotation, pp->type, pp->width, pp->bwidth, pp->bheight, pp->pillartype});
+        }
+    }
+}
+
+void ProceduralManager::updateObject(ProceduralObjectPtr po)
+{
+    std::vector<RoadBlockDef> blocks;
+    GenerateRoadBlocks(po, blocks);
+
+    if (po->road && po->road->isEditable() && po->road->getNumBlocks() == (int)blocks.size())
+    {
+        // Same layout (points were only moved/reshaped) - regenerate just the affected segments.
+        // With smoothing on, the spline tangents spread the change to neighbouring blocks; the diff catches that.
+        for (int i = 0; i < (int)blocks.size(); i++)
+        {
+            const RoadBlockDef& b = blocks[i];
+            po->road->updateBlock(i, b.pos, b.rot, b.type, b.width, b.bwidth, b.bheight, b.pillartype);
         }
+        po->road->applyBlockUpdates();
+        return;
+    }
+
+    if (po->road)
+        this->deleteObject(po);
+
+    po->road = ProceduralRoadPtr::Bind(new ProceduralRoad());
+    // In diagnostic mode, disable collisions (speeds up terrain loading)
+    po->road->setCollisionEnabled(!App::diag_terrn_log_roads->getBool());
+
+    for (const RoadBlockDef& b : blocks)
+    {
+        po->road->addBlock(b.pos, b.rot, b.type, b.width, b.bwidth, b.bheight, b.pillartype);
     }
     po->road->finish();
 }
@@ -65,7 +65,8 @@ class ProceduralManager: public RefCountingObject<ProceduralManager>
 public:
     ~ProceduralManager();
 
-    /// Generates road mesh and adds to internal list
+    /// Generates road mesh and adds to internal list.
+    /// If the object already has a road with the same number of blocks, only the changed segments are regenerated.
     void addObject(ProceduralObjectPtr po);
 
     /// Clears road mesh and removes from internal list
@@ -80,7 +81,7 @@ public:
     void removeAllObjects();
 
 private:
-    /// Rebuilds the road mesh
+    /// Rebuilds the road mesh, incrementally if possible
     void updateObject(ProceduralObjectPtr po);
     /// Deletes the road mesh
     void deleteObject(ProceduralObjectPtr po);
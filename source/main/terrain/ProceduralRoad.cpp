@@ -55,15 +55,23 @@ ProceduralRoad::~ProceduralRoad()
     {
         App::GetGameContext()->GetTerrain()->GetCollisions()->removeCollisionTri(number);
     }
+    for (Segment& seg : segments)
+    {
+        for (int number : seg.coll_tris)
+        {
+            App::GetGameContext()->GetTerrain()->GetCollisions()->removeCollisionTri(number);
+        }
+    }
 }
 
 void ProceduralRoad::finish()
 {
-    Vector3 pts[8];
-    computePoints(pts, lastpos, lastrot, lasttype, lastwidth, lastbwidth, lastbheight);
-    addQuad(pts[7], pts[6], pts[5], pts[4], TextureFit::TEXFIT_NONE, lastpos, lastpos, lastwidth);
-    addQuad(pts[7], pts[4], pts[3], pts[0], TextureFit::TEXFIT_NONE, lastpos, lastpos, lastwidth);
-    addQuad(pts[3], pts[2], pts[1], pts[0], TextureFit::TEXFIT_NONE, lastpos, lastpos, lastwidth);
+    if (!blocks.empty())
+    {
+        // end cap
+        segments.emplace_back();
+        this->generateSegment((int)segments.size() - 1);
+    }
 
     createMesh();
     String entity_name = String("RoadSystem_Instance-").append(StringConverter::toString(mid));
@@ -72,14 +80,165 @@ void ProceduralRoad::finish()
     snode = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
     snode->attachObject(ec);
 
-    App::GetGameContext()->GetTerrain()->GetCollisions()->registerCollisionMesh(
+    // Initially the segment tris are allocated in one run
+    int ctri_start = -1;
+    int ctri_count = 0;
+    for (Segment& seg : segments)
+    {
+        if (ctri_start == -1 && !seg.coll_tris.empty())
+            ctri_start = seg.coll_tris[0];
+        ctri_count += (int)seg.coll_tris.size();
+    }
+    if (ctri_start == -1 && !registeredCollTris.empty())
+        ctri_start = registeredCollTris[0];
+    ctri_count += (int)registeredCollTris.size();
+
+    collMeshIndex = App::GetGameContext()->GetTerrain()->GetCollisions()->registerCollisionMesh(
         "RoadSystem", mesh_name, 
         ec->getBoundingBox().getCenter(), ec->getMesh()->getBounds(),
-        /*groundmodel:*/nullptr, registeredCollTris[0], (int)registeredCollTris.size());
+        /*groundmodel:*/nullptr, ctri_start, ctri_count);
 }
 
 void ProceduralRoad::addBlock(Vector3 pos, Quaternion rot, RoadType type, float width, float bwidth, float bheight, int pillartype)
 {
+    Block b;
+    b.in_pos = pos;
+    b.in_rot = rot;
+    b.in_type = type;
+    b.in_width = width;
+    b.in_bwidth = bwidth;
+    b.in_bheight = bheight;
+    b.pillartype = pillartype;
+    this->resolveBlock(b, blocks.empty());
+    blocks.push_back(b);
+
+    segments.emplace_back();
+    this->generateSegment((int)blocks.size() - 1);
+
+    if (App::diag_terrn_log_roads->getBool())
+    {
+        Vector3 pts[8];
+        computePoints(pts, b.pos, b.in_rot, b.type, b.width, b.bwidth, b.bheight);
+        Str<2000> msg; msg << "[RoR] Road Block |";
+        msg << " pos=(" << b.pos.x << " " << b.pos.y << " " << b.pos.z << ")";
+        msg << " rot=(" << rot.x << " " << rot.y << " " << rot.z << ")";
+        msg << " width=" << b.width;
+        msg << " bwidth=" << b.bwidth;
+        msg << " bheight=" << b.bheight;
+        msg << " type=" << (int)b.type;
+        for (int i = 0; i < 8; ++i)
+        {
+            msg << "\n\t Point#" << i << ": " << pts[i].x << " " << pts[i].y << " " << pts[i].z;
+        }
+        Log(msg.ToCStr());
+    }
+}
+
+bool ProceduralRoad::updateBlock(int index, Vector3 pos, Quaternion rot, RoadType type, float width, float bwidth, float bheight, int pillartype)
+{
+    if (index < 0 || index >= (int)blocks.size())
+        return false;
+
+    Block& b = blocks[index];
+    if (b.in_pos == pos && b.in_rot == rot && b.in_type == type && b.in_width == width
+        && b.in_bwidth == bwidth && b.in_bheight == bheight && b.pillartype == pillartype)
+    {
+        return false;
+    }
+
+    b.in_pos = pos;
+    b.in_rot = rot;
+    b.in_type = type;
+    b.in_width = width;
+    b.in_bwidth = bwidth;
+    b.in_bheight = bheight;
+    b.pillartype = pillartype;
+    this->resolveBlock(b, index == 0);
+
+    // The block's own segment and the one which connects it to the next block (or the end cap)
+    segments[index].dirty = true;
+    if (index + 1 < (int)segments.size())
+        segments[index + 1].dirty = true;
+    return true;
+}
+
+void ProceduralRoad::applyBlockUpdates()
+{
+    if (!this->isEditable())
+        return;
+
+    bool fits = true;
+    int num_dirty = 0;
+    for (int i = 0; i < (int)segments.size(); i++)
+    {
+        if (segments[i].dirty)
+        {
+            this->generateSegment(i);
+            fits = fits && ((int)segments[i].quads.size() <= segments[i].slot_count);
+            num_dirty++;
+        }
+    }
+    if (num_dirty == 0)
+        return;
+
+    if (fits)
+    {
+        HardwareVertexBufferSharedPtr vbuf = msh->sharedVertexData->vertexBufferBinding->getBuffer(0);
+        HardwareIndexBufferSharedPtr ibuf = mainsub->indexData->indexBuffer;
+        std::vector<CoVertice_t> vertices;
+        std::vector<uint32_t> indices;
+        for (Segment& seg : segments)
+        {
+            if (!seg.dirty)
+                continue;
+
+            vertices.resize(seg.slot_count * 4);
+            indices.resize(seg.slot_count * 6);
+            this->fillSegment(seg, vertices.data(), indices.data());
+            vbuf->writeData(seg.slot_start * 4 * sizeof(CoVertice_t), vertices.size() * sizeof(CoVertice_t), vertices.data(), false);
+            ibuf->writeData(seg.slot_start * 6 * sizeof(uint32_t), indices.size() * sizeof(uint32_t), indices.data(), false);
+        }
+
+        AxisAlignedBox aab;
+        for (Segment& seg : segments)
+        {
+            aab.merge(seg.aab);
+        }
+        msh->_setBounds(aab, true);
+    }
+    else
+    {
+        // A segment outgrew its slots - re-layout everything
+        this->buildBuffers();
+    }
+    snode->needUpdate();
+
+    for (Segment& seg : segments)
+    {
+        if (seg.dirty)
+        {
+            this->syncSegmentCollision(seg);
+            seg.dirty = false;
+        }
+    }
+    this->syncCollisionMeshRecord();
+
+    if (App::diag_terrn_log_roads->getBool())
+    {
+        LOG(fmt::format("[RoR] Road '{}': regenerated {}/{} segments{}",
+            msh->getName(), num_dirty, segments.size(), (fits) ? "" : " (buffers re-created)"));
+    }
+}
+
+void ProceduralRoad::resolveBlock(Block& b, bool first)
+{
+    Vector3 pos = b.in_pos;
+    Quaternion rot = b.in_rot;
+    RoadType type = b.in_type;
+    float width = b.in_width;
+    float bwidth = b.in_bwidth;
+    float bheight = b.in_bheight;
+
     if (type == RoadType::ROAD_AUTOMATIC)
     {
         width = 10.0;
@@ -108,53 +267,95 @@ void ProceduralRoad::addBlock(Vector3 pos, Quaternion rot, RoadType type, float
         };
     }
 
+    // the start cap is not raised, historically
+    if (!first && type == RoadType::ROAD_MONORAIL)
+        pos.y += 2;
+
+    b.pos = pos;
+    b.type = type;
+    b.width = width;
+    b.bwidth = bwidth;
+    b.bheight = bheight;
+}
+
+void ProceduralRoad::generateSegment(int index)
+{
+    Segment& seg = segments[index];
+    seg.quads.clear();
+
     Vector3 pts[8];
-    if (!first)
+    if (index == 0)
     {
-        Vector3 lpts[8];
-        if (type == RoadType::ROAD_MONORAIL)
-            pos.y += 2;
+        // start cap
+        const Block& b = blocks[0];
+        computePoints(pts, b.pos, b.in_rot, b.type, b.width, b.bwidth, b.bheight);
+        pushQuad(seg, pts[0], pts[1], pts[2], pts[3], TextureFit::TEXFIT_NONE, b.pos, b.pos, b.width);
+        pushQuad(seg, pts[0], pts[3], pts[4], pts[7], TextureFit::TEXFIT_NONE, b.pos, b.pos, b.width);
+        pushQuad(seg, pts[4], pts[5], pts[6], pts[7], TextureFit::TEXFIT_NONE, b.pos, b.pos, b.width);
+    }
+    else if (index == (int)blocks.size())
+    {
+        // end cap
+        const Block& b = blocks.back();
+        computePoints(pts, b.pos, b.in_rot, b.type, b.width, b.bwidth, b.bheight);
+        pushQuad(seg, pts[7], pts[6], pts[5], pts[4], TextureFit::TEXFIT_NONE, b.pos, b.pos, b.width);
+        pushQuad(seg, pts[7], pts[4], pts[3], pts[0], TextureFit::TEXFIT_NONE, b.pos, b.pos, b.width);
+        pushQuad(seg, pts[3], pts[2], pts[1], pts[0], TextureFit::TEXFIT_NONE, b.pos, b.pos, b.width);
+    }
+    else
+    {
+        const Block& b = blocks[index];
+        const Block& lb = blocks[index - 1];
+        const Vector3 pos = b.pos;
+        const Quaternion rot = b.in_rot;
+        const RoadType type = b.type;
+        const float width = b.width;
+        const float bwidth = b.bwidth;
+        const int pillartype = b.pillartype;
+        const Vector3 lastpos = lb.pos;
+        const RoadType lasttype = lb.type;
 
-        computePoints(pts, pos, rot, type, width, bwidth, bheight);
-        computePoints(lpts, lastpos, lastrot, lasttype, lastwidth, lastbwidth, lastbheight);
+        Vector3 lpts[8];
+        computePoints(pts, pos, rot, type, width, bwidth, b.bheight);
+        computePoints(lpts, lastpos, lb.in_rot, lasttype, lb.width, lb.bwidth, lb.bheight);
 
         //tarmac
         if (type == RoadType::ROAD_MONORAIL)
-            addQuad(pts[4], lpts[4], lpts[3], pts[3], TextureFit::TEXFIT_CONCRETETOP, pos, lastpos, width);
+            pushQuad(seg, pts[4], lpts[4], lpts[3], pts[3], TextureFit::TEXFIT_CONCRETETOP, pos, lastpos, width);
         else
-            addQuad(pts[4], lpts[4], lpts[3], pts[3], TextureFit::TEXFIT_ROAD, pos, lastpos, width);
+            pushQuad(seg, pts[4], lpts[4], lpts[3], pts[3], TextureFit::TEXFIT_ROAD, pos, lastpos, width);
 
         if (type == RoadType::ROAD_FLAT && lasttype == RoadType::ROAD_FLAT)
         {
             //sides (close)
-            addQuad(pts[5], lpts[5], lpts[4], pts[4], TextureFit::TEXFIT_ROADS3, pos, lastpos, width);
-            addQuad(pts[3], lpts[3], lpts[2], pts[2], TextureFit::TEXFIT_ROADS2, pos, lastpos, width);
+            pushQuad(seg, pts[5], lpts[5], lpts[4], pts[4], TextureFit::TEXFIT_ROADS3, pos, lastpos, width);
+            pushQuad(seg, pts[3], lpts[3], lpts[2], pts[2], TextureFit::TEXFIT_ROADS2, pos, lastpos, width);
             //sides (far)
-            addQuad(pts[6], lpts[6], lpts[5], pts[5], TextureFit::TEXFIT_ROADS4, pos, lastpos, width);
-            addQuad(pts[2], lpts[2], lpts[1], pts[1], TextureFit::TEXFIT_ROADS1, pos, lastpos, width);
+            pushQuad(seg, pts[6], lpts[6], lpts[5], pts[5], TextureFit::TEXFIT_ROADS4, pos, lastpos, width);
+            pushQuad(seg, pts[2], lpts[2], lpts[1], pts[1], TextureFit::TEXFIT_ROADS1, pos, lastpos, width);
         }
         else
         {
             //sides (close)
-            addQuad(pts[5], lpts[5], lpts[4], pts[4], TextureFit::TEXFIT_CONCRETEWALLI, pos, lastpos, width, (type == RoadType::ROAD_FLAT || type == RoadType::ROAD_LEFT));
-            addQuad(pts[3], lpts[3], lpts[2], pts[2], TextureFit::TEXFIT_CONCRETEWALLI, pos, lastpos, width, !(type == RoadType::ROAD_FLAT || type == RoadType::ROAD_RIGHT));
+            pushQuad(seg, pts[5], lpts[5], lpts[4], pts[4], TextureFit::TEXFIT_CONCRETEWALLI, pos, lastpos, width, (type == RoadType::ROAD_FLAT || type == RoadType::ROAD_LEFT));
+            pushQuad(seg, pts[3], lpts[3], lpts[2], pts[2], TextureFit::TEXFIT_CONCRETEWALLI, pos, lastpos, width, !(type == RoadType::ROAD_FLAT || type == RoadType::ROAD_RIGHT));
             //sides (far)
-            addQuad(pts[6], lpts[6], lpts[5], pts[5], TextureFit::TEXFIT_CONCRETETOP, pos, lastpos, width, (type == RoadType::ROAD_FLAT || type == RoadType::ROAD_LEFT));
-            addQuad(pts[2], lpts[2], lpts[1], pts[1], TextureFit::TEXFIT_CONCRETETOP, pos, lastpos, width, !(type == RoadType::ROAD_FLAT || type == RoadType::ROAD_RIGHT));
+            pushQuad(seg, pts[6], lpts[6], lpts[5], pts[5], TextureFit::TEXFIT_CONCRETETOP, pos, lastpos, width, (type == RoadType::ROAD_FLAT || type == RoadType::ROAD_LEFT));
+            pushQuad(seg, pts[2], lpts[2], lpts[1], pts[1], TextureFit::TEXFIT_CONCRETETOP, pos, lastpos, width, !(type == RoadType::ROAD_FLAT || type == RoadType::ROAD_RIGHT));
         }
         if (type == RoadType::ROAD_BRIDGE || lasttype == RoadType::ROAD_BRIDGE || type == RoadType::ROAD_MONORAIL || lasttype == RoadType::ROAD_MONORAIL)
         {
             //walls
-            addQuad(pts[1], lpts[1], lpts[0], pts[0], TextureFit::TEXFIT_CONCRETEWALL, pos, lastpos, width);
-            addQuad(lpts[6], pts[6], pts[7], lpts[7], TextureFit::TEXFIT_CONCRETEWALL, pos, lastpos, width);
+            pushQuad(seg, pts[1], lpts[1], lpts[0], pts[0], TextureFit::TEXFIT_CONCRETEWALL, pos, lastpos, width);
+            pushQuad(seg, lpts[6], pts[6], pts[7], lpts[7], TextureFit::TEXFIT_CONCRETEWALL, pos, lastpos, width);
             //underside - we flip the underside so it folds gracefully with the top
-            addQuad(pts[0], lpts[0], lpts[7], pts[7], TextureFit::TEXFIT_CONCRETEUNDER, pos, lastpos, width, true);
+            pushQuad(seg, pts[0], lpts[0], lpts[7], pts[7], TextureFit::TEXFIT_CONCRETEUNDER, pos, lastpos, width, true);
         }
         else
         {
             //walls
-            addQuad(pts[1], lpts[1], lpts[0], pts[0], TextureFit::TEXFIT_BRICKWALL, pos, lastpos, width);
-            addQuad(lpts[6], pts[6], pts[7], lpts[7], TextureFit::TEXFIT_BRICKWALL, pos, lastpos, width);
+            pushQuad(seg, pts[1], lpts[1], lpts[0], pts[0], TextureFit::TEXFIT_BRICKWALL, pos, lastpos, width);
+            pushQuad(seg, lpts[6], pts[6], pts[7], lpts[7], TextureFit::TEXFIT_BRICKWALL, pos, lastpos, width);
         }
         if ((type == RoadType::ROAD_BRIDGE || type == RoadType::ROAD_MONORAIL) && pillartype > 0)
         {
@@ -184,15 +385,12 @@ void ProceduralRoad::addBlock(Vector3 pos, Quaternion rot, RoadType type, float
                     sidefactor = 0.2;
             }
 
-            static int pillarcounter = 0;
-            pillarcounter++;
-
             if (pillartype == 2)
             {
                 // always in the middle
                 sidefactor = 0.5;
-                // only build every fifth pillar
-                if (pillarcounter % 5)
+                // only build every fifth pillar (counted by segment, so regenerating one doesn't shift the rest)
+                if (index % 5)
                     builtpillars = false;
             }
 
@@ -215,25 +413,25 @@ void ProceduralRoad::addBlock(Vector3 pos, Quaternion rot, RoadType type, float
             if (width2 >= 0.2 && builtpillars)
             {
                 //sides
-                addQuad(middle + Vector3(-width2, -len, -width2),
+                pushQuad(seg, middle + Vector3(-width2, -len, -width2),
                     middle + Vector3(-width2, 0, -width2),
                     middle + Vector3(width2, 0, -width2),
                     middle + Vector3(width2, -len, -width2),
                     TextureFit::TEXFIT_CONCRETETOP, pos, lastpos, width2);
 
-                addQuad(middle + Vector3(width2, -len, width2),
+                pushQuad(seg, middle + Vector3(width2, -len, width2),
                     middle + Vector3(width2, 0, width2),
                     middle + Vector3(-width2, 0, width2),
                     middle + Vector3(-width2, -len, width2),
                     TextureFit::TEXFIT_CONCRETETOP, pos, lastpos, width2);
 
-                addQuad(middle + Vector3(-width2, -len, width2),
+                pushQuad(seg, middle + Vector3(-width2, -len, width2),
                     middle + Vector3(-width2, 0, width2),
                     middle + Vector3(-width2, 0, -width2),
                     middle + Vector3(-width2, -len, -width2),
                     TextureFit::TEXFIT_CONCRETETOP, pos, lastpos, width2);
 
-                addQuad(middle + Vector3(width2, -len, -width2),
+                pushQuad(seg, middle + Vector3(width2, -len, -width2),
                     middle + Vector3(width2, 0, -width2),
                     middle + Vector3(width2, 0, width2),
                     middle + Vector3(width2, -len, width2),
@@ -241,36 +439,10 @@ void ProceduralRoad::addBlock(Vector3 pos, Quaternion rot, RoadType type, float
             }
         }
     }
-    else
-    {
-        first = false;
-        computePoints(pts, pos, rot, type, width, bwidth, bheight);
-        addQuad(pts[0], pts[1], pts[2], pts[3], TextureFit::TEXFIT_NONE, pos, pos, width);
-        addQuad(pts[0], pts[3], pts[4], pts[7], TextureFit::TEXFIT_NONE, pos, pos, width);
-        addQuad(pts[4], pts[5], pts[6], pts[7], TextureFit::TEXFIT_NONE, pos, pos, width);
-    }
-    lastpos = pos;
-    lastrot = rot;
-    lastwidth = width;
-    lastbwidth = bwidth;
-    lastbheight = bheight;
-    lasttype = type;
 
-    if (App::diag_terrn_log_roads->getBool())
-    {
-        Str<2000> msg; msg << "[RoR] Road Block |";
-        msg << " pos=(" << pos.x << " " << pos.y << " " << pos.z << ")";
-        msg << " rot=(" << rot.x << " " << rot.y << " " << rot.z << ")";
-        msg << " width=" << width;
-        msg << " bwidth=" << bwidth;
-        msg << " bheight=" << bheight;
-        msg << " type=" << (int)type;
-        for (int i = 0; i < 8; ++i)
-        {
-            msg << "\n\t Point#" << i << ": " << pts[i].x << " " << pts[i].y << " " << pts[i].z;
-        }
-        Log(msg.ToCStr());
-    }
+    // The initial build registers collisions right away, edits do it in `applyBlockUpdates()`
+    if (!seg.dirty)
+        this->syncSegmentCollision(seg);
 }
 
 void ProceduralRoad::computePoints(Vector3* pts, Vector3 pos, Quaternion rot, RoadType type, float width, float bwidth, float bheight)
@@ -357,47 +529,95 @@ inline Vector3 ProceduralRoad::baseOf(Vector3 p)
 
 void ProceduralRoad::addQuad(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, TextureFit texfit, Vector3 pos, Vector3 lastpos, float width, bool flip)
 {
-    if (vertexcount + 3 >= MAX_VERTEX || tricount * 3 + 3 + 2 >= MAX_TRIS * 3)
+    if (segments.empty())
+        segments.emplace_back();
+
+    customQuads = true;
+    pushQuad(segments.back(), p1, p2, p3, p4, texfit, pos, lastpos, width, flip);
+    this->syncSegmentCollision(segments.back());
+}
+
+void ProceduralRoad::pushQuad(Segment& seg, Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, TextureFit texfit, Vector3 pos, Vector3 lastpos, float width, bool flip)
+{
+    Quad quad;
+    quad.pts[0] = p1;
+    quad.pts[1] = p2;
+    quad.pts[2] = p3;
+    quad.pts[3] = p4;
+    textureFit(p1, p2, p3, p4, texfit, quad.tex, pos, lastpos, width);
+    quad.flip = flip;
+    quad.gm = nullptr;
+    if (collision)
+    {
+        quad.gm = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString("concrete");
+        if (texfit == TextureFit::TEXFIT_ROAD || texfit == TextureFit::TEXFIT_ROADS1 || texfit == TextureFit::TEXFIT_ROADS2 || texfit == TextureFit::TEXFIT_ROADS3 || texfit == TextureFit::TEXFIT_ROADS4)
+            quad.gm = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString("asphalt");
+    }
+    seg.quads.push_back(quad);
+}
+
+void ProceduralRoad::syncSegmentCollision(Segment& seg)
+{
+    if (!collision)
         return;
-    Vector2 texf[4];
-    textureFit(p1, p2, p3, p4, texfit, texf, pos, lastpos, width);
-    //vertexes
-    vertex[vertexcount] = p1;
-    tex[vertexcount] = texf[0];
-    vertex[vertexcount + 1] = p2;
-    tex[vertexcount + 1] = texf[1];
-    vertex[vertexcount + 2] = p3;
-    tex[vertexcount + 2] = texf[2];
-    vertex[vertexcount + 3] = p4;
-    tex[vertexcount + 3] = texf[3];
-    //tris
-    if (flip)
+
+    Collisions* collisions = App::GetGameContext()->GetTerrain()->GetCollisions();
+    size_t num_tris = 0;
+    auto set_tri = [&](Vector3 a, Vector3 b, Vector3 c, ground_model_t* gm)
+    {
+        if (num_tris < seg.coll_tris.size())
+        {
+            collisions->updateCollisionTri(seg.coll_tris[num_tris], a, b, c, gm);
+            num_tris++;
+        }
+        else
+        {
+            int triID = collisions->addCollisionTri(a, b, c, gm);
+            if (triID >= 0)
+            {
+                seg.coll_tris.push_back(triID);
+                num_tris++;
+            }
+        }
+    };
+
+    for (Quad& q : seg.quads)
     {
-        tris[tricount * 3] = vertexcount;
-        tris[tricount * 3 + 1] = vertexcount + 1;
-        tris[tricount * 3 + 2] = vertexcount + 3;
-        tris[tricount * 3 + 3] = vertexcount + 1;
-        tris[tricount * 3 + 3 + 1] = vertexcount + 2;
-        tris[tricount * 3 + 3 + 2] = vertexcount + 3;
+        if (q.flip)
+        {
+            set_tri(q.pts[0], q.pts[1], q.pts[3], q.gm);
+            set_tri(q.pts[3], q.pts[1], q.pts[2], q.gm);
+        }
+        else
+        {
+            set_tri(q.pts[0], q.pts[1], q.pts[2], q.gm);
+            set_tri(q.pts[0], q.pts[2], q.pts[3], q.gm);
+        }
     }
-    else
+
+    // leftovers stay reserved for the next regeneration
+    for (size_t i = num_tris; i < seg.coll_tris.size(); i++)
     {
-        tris[tricount * 3] = vertexcount;
-        tris[tricount * 3 + 1] = vertexcount + 1;
-        tris[tricount * 3 + 2] = vertexcount + 2;
-        tris[tricount * 3 + 3] = vertexcount;
-        tris[tricount * 3 + 3 + 1] = vertexcount + 2;
-        tris[tricount * 3 + 3 + 2] = vertexcount + 3;
+        collisions->removeCollisionTri(seg.coll_tris[i]);
     }
-    if (collision)
+}
+
+void ProceduralRoad::syncCollisionMeshRecord()
+{
+    if (!collision || collMeshIndex == -1)
+        return;
+
+    // Tris added by edits are appended to the pool, so the range from `finish()` may no longer be contiguous
+    std::vector<int> ctris;
+    for (Segment& seg : segments)
     {
-        ground_model_t* gm = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString("concrete");
-        if (texfit == TextureFit::TEXFIT_ROAD || texfit == TextureFit::TEXFIT_ROADS1 || texfit == TextureFit::TEXFIT_ROADS2 || texfit == TextureFit::TEXFIT_ROADS3 || texfit == TextureFit::TEXFIT_ROADS4)
-            gm = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString("asphalt");
-        addCollisionQuad(p1, p2, p3, p4, gm, flip);
+        const size_t num_used = std::min(seg.coll_tris.size(), seg.quads.size() * 2); // Leftovers are disabled
+        ctris.insert(ctris.end(), seg.coll_tris.begin(), seg.coll_tris.begin() + num_used);
     }
-    tricount += 2;
-    vertexcount += 4;
+    ctris.insert(ctris.end(), registeredCollTris.begin(), registeredCollTris.end());
+
+    App::GetGameContext()->GetTerrain()->GetCollisions()->updateCollisionMesh(
+        collMeshIndex, msh->getBounds().getCenter(), msh->getBounds(), ctris);
 }
 
 void ProceduralRoad::textureFit(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, TextureFit texfit, Vector2* texc, Vector3 pos, Vector3 lastpos, float width)
@@ -576,12 +796,6 @@ void ProceduralRoad::addCollisionQuad(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::
 
 void ProceduralRoad::createMesh()
 {
-    AxisAlignedBox aab;
-    union
-    {
-        float* vertices;
-        CoVertice_t* covertices;
-    };
     /// Create the mesh via the MeshManager
     Ogre::String mesh_name = Ogre::String("RoadSystem-").append(Ogre::StringConverter::toString(mid));
     msh = MeshManager::getSingleton().createManual(mesh_name, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
@@ -589,44 +803,8 @@ void ProceduralRoad::createMesh()
     mainsub = msh->createSubMesh();
     mainsub->setMaterialName("road2");
 
-    /// Define the vertices
-    size_t vbufCount = (2 * 3 + 2) * vertexcount;
-    vertices = (float*)malloc(vbufCount * sizeof(float));
-    int i;
-    //fill values
-    for (i = 0; i < vertexcount; i++)
-    {
-        covertices[i].texcoord = tex[i];
-        covertices[i].vertex = vertex[i];
-        //normals are computed later
-        covertices[i].normal = Vector3::ZERO;
-        aab.merge(vertex[i]);
-    }
-
-    /// Define triangles
-    size_t ibufCount = 3 * tricount;
-
-    //compute normals
-    for (i = 0; i < tricount && i * 3 + 2 < MAX_TRIS * 3; i++)
-    {
-        Vector3 v1, v2;
-        v1 = covertices[tris[i * 3 + 1]].vertex - covertices[tris[i * 3]].vertex;
-        v2 = covertices[tris[i * 3 + 2]].vertex - covertices[tris[i * 3]].vertex;
-        v1 = v1.crossProduct(v2);
-        v1.normalise();
-        covertices[tris[i * 3]].normal += v1;
-        covertices[tris[i * 3 + 1]].normal += v1;
-        covertices[tris[i * 3 + 2]].normal += v1;
-    }
-    //normalize
-    for (i = 0; i < vertexcount; i++)
-    {
-        covertices[i].normal.normalise();
-    }
-
     /// Create vertex data structure for vertices shared between sub meshes
     msh->sharedVertexData = new VertexData();
-    msh->sharedVertexData->vertexCount = vertexcount;
 
     /// Create declaration (memory format) of vertex data
     VertexDeclaration* decl = msh->sharedVertexData->vertexDeclaration;
@@ -638,14 +816,43 @@ void ProceduralRoad::createMesh()
     decl->addElement(0, offset, VET_FLOAT2, VES_TEXTURE_COORDINATES, 0);
     offset += VertexElement::getTypeSize(VET_FLOAT2);
 
+    this->buildBuffers();
+
+    /// Notify Mesh object that it has been loaded
+    msh->load();
+}
+
+void ProceduralRoad::buildBuffers()
+{
+    // Lay out the segments; block connections get spare slots so they can change shape in place
+    int num_slots = 0;
+    for (int i = 0; i < (int)segments.size(); i++)
+    {
+        const bool is_connection = (i > 0 && i < (int)blocks.size());
+        segments[i].slot_start = num_slots;
+        segments[i].slot_count = std::max((int)segments[i].quads.size(), (is_connection) ? BLOCK_QUAD_CAPACITY : 0);
+        num_slots += segments[i].slot_count;
+    }
+
+    std::vector<CoVertice_t> vertices(num_slots * 4);
+    std::vector<uint32_t> indices(num_slots * 6);
+    AxisAlignedBox aab;
+    for (Segment& seg : segments)
+    {
+        this->fillSegment(seg, &vertices[seg.slot_start * 4], &indices[seg.slot_start * 6]);
+        aab.merge(seg.aab);
+    }
+
+    msh->sharedVertexData->vertexCount = vertices.size();
+
     /// Allocate vertex buffer of the requested number of vertices (vertexCount)
-    /// and bytes per vertex (offset)
+    /// and bytes per vertex; dynamic because `applyBlockUpdates()` rewrites parts of it
     HardwareVertexBufferSharedPtr vbuf =
         HardwareBufferManager::getSingleton().createVertexBuffer(
-            offset, msh->sharedVertexData->vertexCount, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+            sizeof(CoVertice_t), msh->sharedVertexData->vertexCount, HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY);
 
     /// Upload the vertex data to the card
-    vbuf->writeData(0, vbuf->getSizeInBytes(), vertices, true);
+    vbuf->writeData(0, vbuf->getSizeInBytes(), vertices.data(), true);
 
     /// Set vertex buffer binding so buffer 0 is bound to our vertex buffer
     VertexBufferBinding* bind = msh->sharedVertexData->vertexBufferBinding;
@@ -655,23 +862,78 @@ void ProceduralRoad::createMesh()
     /// Allocate index buffer of the requested number of vertices (ibufCount)
     HardwareIndexBufferSharedPtr ibuf = HardwareBufferManager::getSingleton().
         createIndexBuffer(
-            HardwareIndexBuffer::IT_16BIT,
-            ibufCount,
-            HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+            HardwareIndexBuffer::IT_32BIT,
+            indices.size(),
+            HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY);
 
     /// Upload the index data to the card
-    ibuf->writeData(0, ibuf->getSizeInBytes(), tris, true);
+    ibuf->writeData(0, ibuf->getSizeInBytes(), indices.data(), true);
 
     /// Set parameters of the submesh
     mainsub->useSharedVertices = true;
     mainsub->indexData->indexBuffer = ibuf;
-    mainsub->indexData->indexCount = ibufCount;
+    mainsub->indexData->indexCount = indices.size();
     mainsub->indexData->indexStart = 0;
 
     msh->_setBounds(aab, true);
+}
 
-    /// Notify Mesh object that it has been loaded
-    msh->load();
+void ProceduralRoad::fillSegment(Segment& seg, CoVertice_t* vertices, uint32_t* indices)
+{
+    seg.aab.setNull();
+    const uint32_t base = seg.slot_start * 4;
+    for (int i = 0; i < seg.slot_count; i++)
+    {
+        CoVertice_t* v = &vertices[i * 4];
+        uint32_t* t = &indices[i * 6];
+        if (i >= (int)seg.quads.size())
+        {
+            // unused slot - degenerate tris
+            for (int k = 0; k < 4; k++)
+                v[k] = CoVertice_t{ Vector3::ZERO, Vector3::UNIT_Y, Vector2::ZERO };
+            for (int k = 0; k < 6; k++)
+                t[k] = base;
+            continue;
+        }
+
+        const Quad& q = seg.quads[i];
+        const uint32_t vi = base + i * 4;
+        if (q.flip)
+        {
+            t[0] = vi;     t[1] = vi + 1; t[2] = vi + 3;
+            t[3] = vi + 1; t[4] = vi + 2; t[5] = vi + 3;
+        }
+        else
+        {
+            t[0] = vi;     t[1] = vi + 1; t[2] = vi + 2;
+            t[3] = vi;     t[4] = vi + 2; t[5] = vi + 3;
+        }
+
+        for (int k = 0; k < 4; k++)
+        {
+            v[k].vertex = q.pts[k];
+            v[k].texcoord = q.tex[k];
+            //normals are computed below
+            v[k].normal = Vector3::ZERO;
+            seg.aab.merge(q.pts[k]);
+        }
 
-    free(vertices);
-};
+        //compute normals - vertices are never shared between quads
+        for (int k = 0; k < 6; k += 3)
+        {
+            Vector3 v1, v2;
+            v1 = vertices[t[k + 1] - base].vertex - vertices[t[k] - base].vertex;
+            v2 = vertices[t[k + 2] - base].vertex - vertices[t[k] - base].vertex;
+            v1 = v1.crossProduct(v2);
+            v1.normalise();
+            vertices[t[k] - base].normal += v1;
+            vertices[t[k + 1] - base].normal += v1;
+            vertices[t[k + 2] - base].normal += v1;
+        }
+        //normalize
+        for (int k = 0; k < 4; k++)
+        {
+            v[k].normal.normalise();
+        }
+    }
+}
@@ -56,7 +56,9 @@ enum class TextureFit
     TEXFIT_CONCRETEUNDER
 };
 
-// dynamic roads
+/// Dynamic road; the mesh is split into segments (one per `addBlock()` plus the end cap),
+/// each owning a fixed range of the vertex/index buffers and its own collision tris,
+/// so an edited block only regenerates the (up to 2) segments which touch it.
 class ProceduralRoad : public RefCountingObject<ProceduralRoad>
 {
 public:
@@ -76,14 +78,54 @@ public:
     void finish();
     void setCollisionEnabled(bool v) { collision = v; }
 
-    static const unsigned int MAX_VERTEX = 50000;
-    static const unsigned int MAX_TRIS = 50000;
+    // Incremental editing
+
+    int getNumBlocks() const { return (int)blocks.size(); }
+    /// Only finished roads built purely by `addBlock()` can be edited; custom quads would be lost.
+    bool isEditable() const { return snode != nullptr && !customQuads; }
+    /// Changes the inputs of an existing block; the mesh is only touched by `applyBlockUpdates()`.
+    /// @return False if the block is unchanged (or doesn't exist).
+    bool updateBlock(int index, Ogre::Vector3 pos, Ogre::Quaternion rot, RoadType type, float width, float bwidth, float bheight, int pillartype = 1);
+    /// Regenerates segments of blocks changed by `updateBlock()`: rewrites their vertex/index ranges
+    /// and moves their collision tris in place. Buffers are only re-created if a segment outgrows its range.
+    void applyBlockUpdates();
+
+    static const int BLOCK_QUAD_CAPACITY = 12; //!< Max quads between 2 blocks: tarmac, 4 sides, 2 walls, underside, 4 pillar sides.
 
 private:
 
-    inline Ogre::Vector3 baseOf(Ogre::Vector3 p);
-    void computePoints(Ogre::Vector3* pts, Ogre::Vector3 pos, Ogre::Quaternion rot, RoadType type, float width, float bwidth, float bheight);
-    void textureFit(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, TextureFit texfit, Ogre::Vector2* texc, Ogre::Vector3 pos, Ogre::Vector3 lastpos, float width);
+    /// Inputs of `addBlock()` + the values actually used for the geometry
+    struct Block
+    {
+        Ogre::Vector3 in_pos;
+        Ogre::Quaternion in_rot;
+        RoadType in_type;
+        float in_width, in_bwidth, in_bheight;
+        int pillartype;
+
+        Ogre::Vector3 pos;    //!< Monorails are raised
+        RoadType type;        //!< Never ROAD_AUTOMATIC
+        float width, bwidth, bheight;
+    };
+
+    struct Quad
+    {
+        Ogre::Vector3 pts[4];
+        Ogre::Vector2 tex[4];
+        bool flip;
+        ground_model_t* gm;   //!< nullptr if collision is disabled
+    };
+
+    /// Segment 0 is the start cap, segment N connects blocks N-1 and N, the last one is the end cap.
+    struct Segment
+    {
+        std::vector<Quad> quads;
+        int slot_start = 0;          //!< First quad slot in the hardware buffers (4 vertices, 6 indices per slot)
+        int slot_count = 0;
+        std::vector<int> coll_tris;  //!< Tris beyond the current quads are kept disabled for reuse.
+        Ogre::AxisAlignedBox aab;
+        bool dirty = false;
+    };
 
     struct CoVertice_t
     {
@@ -92,26 +134,29 @@ private:
         Ogre::Vector2 texcoord;
     };
 
+    inline Ogre::Vector3 baseOf(Ogre::Vector3 p);
+    void computePoints(Ogre::Vector3* pts, Ogre::Vector3 pos, Ogre::Quaternion rot, RoadType type, float width, float bwidth, float bheight);
+    void textureFit(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, TextureFit texfit, Ogre::Vector2* texc, Ogre::Vector3 pos, Ogre::Vector3 lastpos, float width);
+    void resolveBlock(Block& b, bool first);
+    void generateSegment(int index);
+    void pushQuad(Segment& seg, Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, TextureFit texfit, Ogre::Vector3 pos, Ogre::Vector3 lastpos, float width, bool flip = false);
+    void syncSegmentCollision(Segment& seg);
+    void syncCollisionMeshRecord(); //!< Updates the record from `finish()` after edits
+    void buildBuffers();
+    void fillSegment(Segment& seg, CoVertice_t* vertices, uint32_t* indices);
+
     Ogre::MeshPtr msh;
     Ogre::SubMesh* mainsub = nullptr;
 
-    Ogre::Vector2 tex[MAX_VERTEX] = {};
-    Ogre::Vector3 vertex[MAX_VERTEX] = {};
-    int tricount = 0;
-    int vertexcount = 0;
-    uint16_t tris[MAX_TRIS * 3] = {};
+    std::vector<Block> blocks;
+    std::vector<Segment> segments;
+    bool customQuads = false; //!< `addQuad()` was used directly
 
-    Ogre::Quaternion lastrot;
     Ogre::SceneNode* snode = nullptr;
-    Ogre::Vector3 lastpos;
-    bool first = true;
-    float lastbheight = 0.f;
-    float lastbwidth = 0.f;
-    float lastwidth = 0.f;
-    RoadType lasttype;
     int mid = 0;
     bool collision = true; //!< Register collision triangles?
-    std::vector<int> registeredCollTris;
+    std::vector<int> registeredCollTris; //!< Only from `addCollisionQuad()`; segments keep their own.
+    int collMeshIndex = -1; //!< Record registered by `finish()`, see `Collisions::registerCollisionMesh()`
 };
 
 /// @} // addtogroup Terrain
@@ -21,6 +21,7 @@ along with Rigs of Rods.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "Application.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <functional>
@@ -210,6 +211,47 @@ public:
         for(const auto &h : handles) { h->join(); }
     }
 
+    /** \brief Run `func(begin, end)` over [0, count) in chunks, using idle workers and the current thread.
+     *
+     * Unlike `Parallelize()`, this never waits for a task which did not start yet - chunks are claimed
+     * from a shared counter and the current thread keeps claiming until none are left. It is therefore
+     * safe to call from within a task running on this same pool (no deadlock if all workers are busy).
+     */
+    void ParallelFor(int count, int chunk_size, const std::function<void(int, int)> &func)
+    {
+        ROR_ASSERT(chunk_size > 0);
+        const int num_chunks = (count + chunk_size - 1) / chunk_size;
+        if (num_chunks <= 0) return;
+
+        struct ChunkCounters
+        {
+            std::atomic<int> next{0};
+            std::atomic<int> done{0};
+        };
+        // Shared ownership - helper tasks may start after this function returned; they will find no chunks left.
+        auto counters = std::make_shared<ChunkCounters>();
+        const std::function<void(int, int)>* func_ptr = &func; // Only dereferenced while a chunk is claimed, i.e. before we return.
+        auto work = [counters, func_ptr, count, chunk_size, num_chunks]
+        {
+            int chunk;
+            while ((chunk = counters->next.fetch_add(1)) < num_chunks)
+            {
+                (*func_ptr)(chunk * chunk_size, std::min(count, (chunk + 1) * chunk_size));
+                counters->done.fetch_add(1);
+            }
+        };
+
+        const int num_helpers = std::min(static_cast<int>(m_threads.size()), num_chunks - 1);
+        for (int i = 0; i < num_helpers; ++i)
+        {
+            this->RunTask(work);
+        }
+        work();
+
+        // Only chunks which are already running may remain
+        while (counters->done.load() < num_chunks) { std::this_thread::yield(); }
+    }
+
     std::atomic_bool m_terminate{false};            //!< Indicates destruction of ThreadPool instance to worker threads
     std::vector<std::thread> m_threads;             //!< Collection of worker threads to run tasks
     std::queue<std::shared_ptr<Task>> m_taskqueue;  //!< Queue of submitted tasks pending for execution
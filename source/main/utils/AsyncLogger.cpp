@@ -0,0 +1,679 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "AsyncLogger.h"
+
+#include "PlatformUtils.h"
+
+#include <Ogre.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+
+using namespace RoR;
+
+static const std::chrono::milliseconds WRITER_INTERVAL(5);
+static const size_t STAGING_SIZE   = 4096; // Max. captured `LogFormat()` payload
+static const size_t MAX_STRING_ARG = 2000; // Longer '%s' arguments are truncated (the old `LogFormat()` buffer had 2000 chars total)
+static const char   BINARY_FILE_MAGIC[8] = { 'R', 'o', 'R', 'd', 'i', 'a', 'g', '1' };
+
+static thread_local bool t_is_draining = false; // Log listeners invoked by `Drain()` must not recurse into it
+
+// -------------------------------------------------------------------------------------------------
+// printf-style format handling; the same parser runs when capturing arguments and when expanding them.
+
+enum FormatArgTag: uint8_t
+{
+    FORMAT_ARG_INT,
+    FORMAT_ARG_UINT,
+    FORMAT_ARG_DOUBLE,
+    FORMAT_ARG_STRING,
+    FORMAT_ARG_POINTER
+};
+
+enum FormatLength
+{
+    FORMAT_LEN_NONE, FORMAT_LEN_HH, FORMAT_LEN_H, FORMAT_LEN_L, FORMAT_LEN_LL,
+    FORMAT_LEN_J, FORMAT_LEN_Z, FORMAT_LEN_T, FORMAT_LEN_BIG_L
+};
+
+struct FormatSpec
+{
+    const char*  flags_begin;
+    const char*  flags_end;
+    const char*  width_begin;  //!< Digits, unless `width_star`
+    const char*  width_end;
+    const char*  prec_begin;   //!< Digits, unless `prec_star`
+    const char*  prec_end;
+    bool         width_star;
+    bool         has_prec;
+    bool         prec_star;
+    FormatLength length;
+    char         conv;
+    const char*  end;          //!< One past the conversion char
+};
+
+/// @param p Points just past the '%'
+static bool ParseFormatSpec(const char* p, FormatSpec& spec)
+{
+    spec.flags_begin = p;
+    while (*p != '\0' && strchr("-+ #0", *p) != nullptr)
+        p++;
+    spec.flags_end = p;
+
+    spec.width_star = (*p == '*');
+    spec.width_begin = (spec.width_star) ? ++p : p;
+    while (*p >= '0' && *p <= '9')
+        p++;
+    spec.width_end = p;
+
+    spec.has_prec = (*p == '.');
+    spec.prec_star = false;
+    if (spec.has_prec)
+    {
+        p++;
+        spec.prec_star = (*p == '*');
+        if (spec.prec_star)
+            p++;
+    }
+    spec.prec_begin = p;
+    while (*p >= '0' && *p <= '9')
+        p++;
+    spec.prec_end = p;
+
+    spec.length = FORMAT_LEN_NONE;
+    switch (*p)
+    {
+    case 'h': spec.length = (p[1] == 'h') ? FORMAT_LEN_HH : FORMAT_LEN_H; p += (p[1] == 'h') ? 2 : 1; break;
+    case 'l': spec.length = (p[1] == 'l') ? FORMAT_LEN_LL : FORMAT_LEN_L; p += (p[1] == 'l') ? 2 : 1; break;
+    case 'j': spec.length = FORMAT_LEN_J;     p++; break;
+    case 'z': spec.length = FORMAT_LEN_Z;     p++; break;
+    case 't': spec.length = FORMAT_LEN_T;     p++; break;
+    case 'L': spec.length = FORMAT_LEN_BIG_L; p++; break;
+    default:;
+    }
+
+    spec.conv = *p;
+    spec.end = p + 1;
+    return strchr("%diuoxXcfFeEgGaAspn", spec.conv) != nullptr && spec.conv != '\0';
+}
+
+class FormatArgWriter
+{
+public:
+    FormatArgWriter(char* out, size_t size): m_pos(out), m_end(out + size) {}
+
+    bool PutString(const char* str)
+    {
+        const size_t len = std::min(strlen(str), MAX_STRING_ARG);
+        const uint16_t len16 = static_cast<uint16_t>(len);
+        if (!this->Fits(1 + sizeof(len16) + len))
+            return false;
+        *m_pos++ = FORMAT_ARG_STRING;
+        memcpy(m_pos, &len16, sizeof(len16)); m_pos += sizeof(len16);
+        memcpy(m_pos, str, len);              m_pos += len;
+        return true;
+    }
+
+    template<typename T> bool Put(FormatArgTag tag, T value)
+    {
+        if (!this->Fits(1 + sizeof(T)))
+            return false;
+        *m_pos++ = tag;
+        memcpy(m_pos, &value, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool PutRaw(const char* data, size_t size)
+    {
+        if (!this->Fits(size))
+            return false;
+        memcpy(m_pos, data, size);
+        m_pos += size;
+        return true;
+    }
+
+    char* GetPos() const { return m_pos; }
+
+private:
+    bool Fits(size_t size) const { return m_pos + size <= m_end; }
+
+    char* m_pos;
+    char* m_end;
+};
+
+class FormatArgReader
+{
+public:
+    FormatArgReader(const char* data, const char* end): m_pos(data), m_end(end) {}
+
+    template<typename T> bool Get(FormatArgTag tag, T& out)
+    {
+        if (m_pos + 1 + sizeof(T) > m_end || *m_pos != tag)
+            return false;
+        memcpy(&out, m_pos + 1, sizeof(T));
+        m_pos += 1 + sizeof(T);
+        return true;
+    }
+
+    bool GetString(std::string& out)
+    {
+        uint16_t len = 0;
+        if (m_pos + 1 + sizeof(len) > m_end || *m_pos != FORMAT_ARG_STRING)
+            return false;
+        memcpy(&len, m_pos + 1, sizeof(len));
+        m_pos += 1 + sizeof(len);
+        if (m_pos + len > m_end)
+            return false;
+        out.assign(m_pos, len);
+        m_pos += len;
+        return true;
+    }
+
+private:
+    const char* m_pos;
+    const char* m_end;
+};
+
+template<typename T> static void AppendFormatted(std::string& out, std::string const& spec, T value)
+{
+    char buf[256];
+    const int len = snprintf(buf, sizeof(buf), spec.c_str(), value);
+    if (len < 0)
+        return;
+    if (static_cast<size_t>(len) < sizeof(buf))
+    {
+        out.append(buf, len);
+    }
+    else
+    {
+        std::vector<char> big(len + 1);
+        snprintf(big.data(), big.size(), spec.c_str(), value);
+        out.append(big.data(), len);
+    }
+}
+
+size_t AsyncLogger::CaptureFormatArgs(const char* format, va_list args, char* out, size_t out_size)
+{
+    typedef std::make_signed<size_t>::type    ssize;
+    typedef std::make_unsigned<ptrdiff_t>::type uptrdiff;
+
+    FormatArgWriter writer(out, out_size);
+    if (!writer.PutRaw(format, strlen(format) + 1))
+        return 0;
+
+    for (const char* p = format; *p != '\0'; p++)
+    {
+        if (*p != '%')
+            continue;
+
+        FormatSpec spec;
+        if (!ParseFormatSpec(p + 1, spec))
+            return 0; // Malformed - let the caller format it synchronously
+        p = spec.end - 1;
+
+        bool ok = true;
+        if (spec.width_star)
+            ok = ok && writer.Put<int64_t>(FORMAT_ARG_INT, va_arg(args, int));
+        if (spec.prec_star)
+            ok = ok && writer.Put<int64_t>(FORMAT_ARG_INT, va_arg(args, int));
+
+        switch (spec.conv)
+        {
+        case 'd': case 'i':
+        {
+            int64_t value;
+            switch (spec.length)
+            {
+            case FORMAT_LEN_L:  value = va_arg(args, long);      break;
+            case FORMAT_LEN_LL: value = va_arg(args, long long); break;
+            case FORMAT_LEN_J:  value = va_arg(args, intmax_t);  break;
+            case FORMAT_LEN_Z:  value = va_arg(args, ssize);     break;
+            case FORMAT_LEN_T:  value = va_arg(args, ptrdiff_t); break;
+            default:            value = va_arg(args, int);       break;
+            }
+            ok = ok && writer.Put<int64_t>(FORMAT_ARG_INT, value);
+            break;
+        }
+        case 'u': case 'o': case 'x': case 'X':
+        {
+            uint64_t value;
+            switch (spec.length)
+            {
+            case FORMAT_LEN_L:  value = va_arg(args, unsigned long);      break;
+            case FORMAT_LEN_LL: value = va_arg(args, unsigned long long); break;
+            case FORMAT_LEN_J:  value = va_arg(args, uintmax_t);          break;
+            case FORMAT_LEN_Z:  value = va_arg(args, size_t);             break;
+            case FORMAT_LEN_T:  value = va_arg(args, uptrdiff);           break;
+            default:            value = va_arg(args, unsigned int);       break;
+            }
+            ok = ok && writer.Put<uint64_t>(FORMAT_ARG_UINT, value);
+            break;
+        }
+        case 'c':
+            ok = ok && writer.Put<int64_t>(FORMAT_ARG_INT, va_arg(args, int));
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        {
+            const double value = (spec.length == FORMAT_LEN_BIG_L) ? static_cast<double>(va_arg(args, long double)) : va_arg(args, double);
+            ok = ok && writer.Put<double>(FORMAT_ARG_DOUBLE, value);
+            break;
+        }
+        case 's':
+        {
+            const char* str = va_arg(args, const char*);
+            ok = ok && writer.PutString((str != nullptr) ? str : "(null)");
+            break;
+        }
+        case 'p':
+            ok = ok && writer.Put<uint64_t>(FORMAT_ARG_POINTER, reinterpret_cast<uintptr_t>(va_arg(args, void*)));
+            break;
+        case 'n':
+            va_arg(args, void*); // Not supported, just skip
+            break;
+        default: // '%'
+            break;
+        }
+
+        if (!ok)
+            return 0; // Doesn't fit
+    }
+
+    return writer.GetPos() - out;
+}
+
+std::string AsyncLogger::ExpandFormat(const char* payload, size_t payload_size)
+{
+    const char* format = payload;
+    FormatArgReader reader(payload + strlen(format) + 1, payload + payload_size);
+
+    std::string out;
+    out.reserve(256);
+    for (const char* p = format; *p != '\0'; p++)
+    {
+        if (*p != '%')
+        {
+            out += *p;
+            continue;
+        }
+
+        FormatSpec spec;
+        ParseFormatSpec(p + 1, spec); // Already validated by `CaptureFormatArgs()`
+        p = spec.end - 1;
+        if (spec.conv == '%')
+        {
+            out += '%';
+            continue;
+        }
+
+        // Rebuild the spec with '*' resolved and a length modifier matching the stored type
+        std::string spec_str = "%";
+        spec_str.append(spec.flags_begin, spec.flags_end);
+        int64_t star_value = 0;
+        if (spec.width_star && reader.Get(FORMAT_ARG_INT, star_value))
+            spec_str += std::to_string(star_value);
+        else
+            spec_str.append(spec.width_begin, spec.width_end);
+        if (spec.has_prec)
+        {
+            spec_str += '.';
+            if (spec.prec_star && reader.Get(FORMAT_ARG_INT, star_value))
+                spec_str += std::to_string(star_value);
+            else
+                spec_str.append(spec.prec_begin, spec.prec_end);
+        }
+
+        int64_t  int_value;
+        uint64_t uint_value;
+        double   double_value;
+        std::string str_value;
+        switch (spec.conv)
+        {
+        case 'd': case 'i':
+            if (reader.Get(FORMAT_ARG_INT, int_value))
+                AppendFormatted(out, spec_str + "ll" + spec.conv, static_cast<long long>(int_value));
+            break;
+        case 'u': case 'o': case 'x': case 'X':
+            if (reader.Get(FORMAT_ARG_UINT, uint_value))
+                AppendFormatted(out, spec_str + "ll" + spec.conv, static_cast<unsigned long long>(uint_value));
+            break;
+        case 'c':
+            if (reader.Get(FORMAT_ARG_INT, int_value))
+                AppendFormatted(out, spec_str + 'c', static_cast<int>(int_value));
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            if (reader.Get(FORMAT_ARG_DOUBLE, double_value))
+                AppendFormatted(out, spec_str + spec.conv, double_value);
+            break;
+        case 's':
+            if (reader.GetString(str_value))
+                AppendFormatted(out, spec_str + 's', str_value.c_str());
+            break;
+        case 'p':
+            if (reader.Get(FORMAT_ARG_POINTER, uint_value))
+                AppendFormatted(out, spec_str + 'p', reinterpret_cast<void*>(static_cast<uintptr_t>(uint_value)));
+            break;
+        default:;
+        }
+    }
+    return out;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Producer side
+
+uint64_t AsyncLogger::GetTimestampNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+AsyncLogger::ThreadBuffer* AsyncLogger::GetThreadBuffer()
+{
+    // Registration happens once per thread; the buffer outlives the thread until drained.
+    struct Holder
+    {
+        ~Holder() { if (buf) buf->abandoned.store(true, std::memory_order_release); buf = nullptr; }
+        ThreadBuffer* buf = nullptr;
+    };
+    static thread_local Holder holder;
+
+    if (!holder.buf)
+    {
+        holder.buf = new ThreadBuffer();
+        std::lock_guard<std::mutex> lock(m_buffers_mutex);
+        m_buffers.push_back(holder.buf);
+    }
+    return holder.buf;
+}
+
+size_t AsyncLogger::GetRecordSize(size_t payload_size)
+{
+    return (sizeof(RecordHeader) + payload_size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+
+AsyncLogger::RecordHeader* AsyncLogger::Reserve(ThreadBuffer* buf, size_t payload_size)
+{
+    const size_t size = GetRecordSize(payload_size);
+    const size_t head = buf->head.load(std::memory_order_relaxed);
+    const size_t tail = buf->tail.load(std::memory_order_acquire);
+    const size_t offset = head & (RING_SIZE - 1);
+    const size_t padding = (RING_SIZE - offset < size) ? (RING_SIZE - offset) : 0;
+
+    if (!FitsInRing(payload_size) || head + padding + size - tail > RING_SIZE)
+        return nullptr;
+
+    if (padding > 0)
+    {
+        RecordHeader* pad = reinterpret_cast<RecordHeader*>(buf->data.get() + offset);
+        pad->size = static_cast<uint32_t>(padding);
+        pad->kind = RECORD_PADDING;
+        buf->head.store(head + padding, std::memory_order_release);
+    }
+
+    RecordHeader* header = reinterpret_cast<RecordHeader*>(buf->data.get() + ((head + padding) & (RING_SIZE - 1)));
+    header->size = static_cast<uint32_t>(size);
+    return header;
+}
+
+void AsyncLogger::Commit(ThreadBuffer* buf, RecordHeader* header, RecordKind kind, uint16_t stream)
+{
+    header->kind = kind;
+    header->stream = stream;
+    header->timestamp_ns = GetTimestampNs();
+    buf->head.store(buf->head.load(std::memory_order_relaxed) + header->size, std::memory_order_release);
+}
+
+AsyncLogger::RecordHeader* AsyncLogger::ReserveOrDrain(ThreadBuffer* buf, size_t payload_size)
+{
+    RecordHeader* header = this->Reserve(buf, payload_size);
+    if (!header)
+    {
+        // Help out only if nobody is draining - waiting for the writer would stall e.g. the physics thread
+        std::unique_lock<std::mutex> lock(m_drain_mutex, std::try_to_lock);
+        if (lock.owns_lock())
+        {
+            this->Drain();
+            header = this->Reserve(buf, payload_size);
+        }
+    }
+    if (!header)
+    {
+        m_dropped_text.fetch_add(1, std::memory_order_relaxed);
+    }
+    return header;
+}
+
+void AsyncLogger::PushText(const char* msg)
+{
+    const size_t len = strlen(msg);
+    if (!t_is_draining && FitsInRing(len + 1))
+    {
+        ThreadBuffer* buf = this->GetThreadBuffer();
+        RecordHeader* header = this->ReserveOrDrain(buf, len + 1);
+        if (header)
+        {
+            memcpy(header + 1, msg, len + 1);
+            this->Commit(buf, header, RECORD_TEXT);
+        }
+        return;
+    }
+    Ogre::LogManager::getSingleton().logMessage(msg); // Too big, or re-entered from a log listener - write synchronously
+}
+
+void AsyncLogger::PushFormat(const char* format, va_list args)
+{
+    if (!t_is_draining)
+    {
+        char staging[STAGING_SIZE];
+        va_list args_copy;
+        va_copy(args_copy, args);
+        const size_t payload_size = CaptureFormatArgs(format, args_copy, staging, sizeof(staging));
+        va_end(args_copy);
+
+        if (payload_size > 0) // Otherwise malformed or too big - format synchronously
+        {
+            ThreadBuffer* buf = this->GetThreadBuffer();
+            RecordHeader* header = this->ReserveOrDrain(buf, payload_size);
+            if (header)
+            {
+                memcpy(header + 1, staging, payload_size);
+                this->Commit(buf, header, RECORD_FORMAT);
+            }
+            return;
+        }
+    }
+
+    char buffer[2000] = {};
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    Ogre::LogManager::getSingleton().logMessage(buffer);
+}
+
+void AsyncLogger::PushBinary(BinaryStream stream, const void* data, uint32_t size)
+{
+    ThreadBuffer* buf = this->GetThreadBuffer();
+    RecordHeader* header = this->Reserve(buf, sizeof(size) + size);
+    if (!header)
+    {
+        m_dropped_binary.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    char* payload = reinterpret_cast<char*>(header + 1);
+    memcpy(payload, &size, sizeof(size)); // The record size is padded, keep the real one
+    memcpy(payload + sizeof(size), data, size);
+    this->Commit(buf, header, RECORD_BINARY, stream);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Consumer side
+
+void AsyncLogger::Start(std::string const& logs_dir)
+{
+    if (m_running)
+        return;
+
+    m_binary_path = PathCombine(logs_dir, "RoR_diag.bin");
+    m_running = true;
+    m_writer_thread = std::thread(&AsyncLogger::WriterThreadMain, this);
+}
+
+void AsyncLogger::Stop()
+{
+    if (!m_running)
+        return;
+
+    m_running = false;
+    m_writer_thread.join();
+    this->Flush();
+
+    if (m_binary_file)
+    {
+        fclose(m_binary_file);
+        m_binary_file = nullptr;
+    }
+}
+
+void AsyncLogger::Flush()
+{
+    std::lock_guard<std::mutex> lock(m_drain_mutex);
+    this->Drain();
+}
+
+void AsyncLogger::WriterThreadMain()
+{
+    while (m_running)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_drain_mutex);
+            this->Drain();
+        }
+        std::this_thread::sleep_for(WRITER_INTERVAL);
+    }
+}
+
+void AsyncLogger::WriteBinaryRecord(RecordHeader const* header)
+{
+    if (!m_binary_file)
+    {
+        m_binary_file = fopen(m_binary_path.c_str(), "wb");
+        if (!m_binary_file)
+            return;
+        fwrite(BINARY_FILE_MAGIC, sizeof(BINARY_FILE_MAGIC), 1, m_binary_file);
+    }
+
+    // Padding to `RECORD_ALIGN` is not written out, so the record stores its real size.
+    const char* payload = reinterpret_cast<const char*>(header + 1);
+    const uint32_t payload_size = *reinterpret_cast<const uint32_t*>(payload);
+    const uint16_t reserved = 0;
+    fwrite(&header->timestamp_ns, sizeof(header->timestamp_ns), 1, m_binary_file);
+    fwrite(&header->stream, sizeof(header->stream), 1, m_binary_file);
+    fwrite(&reserved, sizeof(reserved), 1, m_binary_file);
+    fwrite(payload, sizeof(payload_size) + payload_size, 1, m_binary_file);
+}
+
+void AsyncLogger::Drain()
+{
+    t_is_draining = true;
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_buffers_mutex);
+        buffers = m_buffers;
+    }
+
+    m_pending.clear();
+    bool wrote_binary = false;
+    for (ThreadBuffer* buf : buffers)
+    {
+        // Check before reading `head`, so that no record can be pushed after we decide to delete.
+        const bool abandoned = buf->abandoned.load(std::memory_order_acquire);
+        size_t tail = buf->tail.load(std::memory_order_relaxed);
+        const size_t head = buf->head.load(std::memory_order_acquire);
+        while (tail != head)
+        {
+            const RecordHeader* header = reinterpret_cast<const RecordHeader*>(buf->data.get() + (tail & (RING_SIZE - 1)));
+            const char* payload = reinterpret_cast<const char*>(header + 1);
+            switch (header->kind)
+            {
+            case RECORD_TEXT:
+                m_pending.push_back(PendingLine{ header->timestamp_ns, payload });
+                break;
+            case RECORD_FORMAT:
+                m_pending.push_back(PendingLine{ header->timestamp_ns, ExpandFormat(payload, header->size - sizeof(RecordHeader)) });
+                break;
+            case RECORD_BINARY:
+                this->WriteBinaryRecord(header);
+                wrote_binary = true;
+                break;
+            default:; // Padding
+            }
+            tail += header->size;
+        }
+        buf->tail.store(tail, std::memory_order_release);
+
+        if (abandoned)
+        {
+            std::lock_guard<std::mutex> lock(m_buffers_mutex);
+            m_buffers.erase(std::remove(m_buffers.begin(), m_buffers.end(), buf), m_buffers.end());
+            delete buf;
+        }
+    }
+
+    // Each buffer is ordered already; merge them by time
+    std::stable_sort(m_pending.begin(), m_pending.end(),
+        [](PendingLine const& a, PendingLine const& b) { return a.timestamp_ns < b.timestamp_ns; });
+    for (PendingLine const& line : m_pending)
+    {
+        Ogre::LogManager::getSingleton().logMessage(line.text);
+    }
+
+    const uint32_t dropped_text = m_dropped_text.exchange(0, std::memory_order_relaxed);
+    if (dropped_text > 0)
+    {
+        Ogre::LogManager::getSingleton().logMessage(
+            "[RoR|Log] " + std::to_string(dropped_text) + " log messages dropped (buffer full)", Ogre::LML_WARNING);
+    }
+    const uint32_t dropped = m_dropped_binary.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0)
+    {
+        Ogre::LogManager::getSingleton().logMessage(
+            "[RoR|Log] " + std::to_string(dropped) + " binary diagnostic records dropped (buffer full)", Ogre::LML_WARNING);
+    }
+    if (wrote_binary && m_binary_file)
+    {
+        fflush(m_binary_file);
+    }
+    t_is_draining = false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool LogRateLimiter::Allow(uint32_t& out_suppressed)
+{
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t next = m_next_allowed_ns.load(std::memory_order_relaxed);
+    if (now < next || !m_next_allowed_ns.compare_exchange_strong(next, now + m_interval_ns, std::memory_order_relaxed))
+    {
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    out_suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,160 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Backend of `RoR::Log()`/`RoR::LogFormat()` which keeps formatting and file I/O off the calling thread.
+///
+/// Every thread which logs gets its own single-producer ring buffer; pushing a message is a memcpy
+/// plus an atomic store. `LogFormat()` arguments are captured raw and the printf-style formatting
+/// happens on the writer thread, which drains all buffers every few milliseconds, orders
+/// the messages by time and passes them to `Ogre::LogManager` (file + console listeners).
+/// If a buffer is full, the calling thread drains it itself unless the writer is busy doing so - then the message
+/// is dropped and counted, the producer never waits. Call `Flush()` before anything fatal.
+/// Binary records go to a separate file 'RoR_diag.bin' and are dropped when full.
+
+#pragma once
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Application
+/// @{
+
+class AsyncLogger
+{
+public:
+    /// Identifies a binary diagnostic stream in 'RoR_diag.bin'
+    enum BinaryStream: uint16_t
+    {
+        BINSTREAM_SIM_CHECKSUM = 1, //!< {uint64 substep, uint64 checksum} per physics substep, see 'diag_sim_checksums'
+    };
+
+    ~AsyncLogger() { this->Stop(); }
+
+    void Start(std::string const& logs_dir);
+    void Stop();  //!< Writes out everything pending and joins the writer thread.
+    void Flush(); //!< Writes out everything pending, on the calling thread.
+    bool IsRunning() const { return m_running.load(std::memory_order_relaxed); }
+
+    void PushText(const char* msg);
+    void PushFormat(const char* format, va_list args);
+    void PushBinary(BinaryStream stream, const void* data, uint32_t size);
+
+private:
+    enum RecordKind: uint16_t
+    {
+        RECORD_PADDING,  //!< Fills the end of the ring so that a record doesn't wrap
+        RECORD_TEXT,     //!< Ready string
+        RECORD_FORMAT,   //!< printf-style format + captured arguments
+        RECORD_BINARY
+    };
+
+    struct RecordHeader
+    {
+        uint32_t size;          //!< Including header, multiple of `RECORD_ALIGN`
+        uint16_t kind;
+        uint16_t stream;        //!< Only binary records
+        uint64_t timestamp_ns;
+    };
+
+    static const size_t RECORD_ALIGN = sizeof(RecordHeader);
+    static const size_t RING_SIZE = 256 * 1024; //!< Per thread, power of 2
+
+    /// Single producer (the owner thread), single consumer (whoever holds `m_drain_mutex`)
+    struct ThreadBuffer
+    {
+        ThreadBuffer(): data(new char[RING_SIZE]) {}
+
+        std::unique_ptr<char[]> data;
+        std::atomic<size_t>     head{0};            //!< Bytes ever written; producer-owned
+        std::atomic<size_t>     tail{0};            //!< Bytes ever consumed; consumer-owned
+        std::atomic<bool>       abandoned{false};   //!< Owner thread exited; delete once drained
+    };
+
+    struct PendingLine
+    {
+        uint64_t    timestamp_ns;
+        std::string text;
+    };
+
+    ThreadBuffer* GetThreadBuffer();
+    RecordHeader* Reserve(ThreadBuffer* buf, size_t payload_size); //!< Returns nullptr if full
+    RecordHeader* ReserveOrDrain(ThreadBuffer* buf, size_t payload_size); //!< If full, drains on the calling thread unless the writer is at it; counts drops
+    void          Commit(ThreadBuffer* buf, RecordHeader* header, RecordKind kind, uint16_t stream = 0);
+    void          WriteBinaryRecord(RecordHeader const* header);
+    void          Drain(); //!< Caller must hold `m_drain_mutex`
+    void          WriterThreadMain();
+
+    static size_t      GetRecordSize(size_t payload_size);
+    static bool        FitsInRing(size_t payload_size) { return GetRecordSize(payload_size) <= RING_SIZE / 2; }
+    static uint64_t    GetTimestampNs();
+    static size_t      CaptureFormatArgs(const char* format, va_list args, char* out, size_t out_size);
+    static std::string ExpandFormat(const char* payload, size_t payload_size);
+
+    std::vector<ThreadBuffer*> m_buffers;           //!< Guarded by `m_buffers_mutex`
+    std::mutex                 m_buffers_mutex;
+    std::mutex                 m_drain_mutex;
+    std::vector<PendingLine>   m_pending;           //!< Reused by `Drain()`
+    std::thread                m_writer_thread;
+    std::atomic<bool>          m_running{false};
+    std::atomic<uint32_t>      m_dropped_text{0};
+    std::atomic<uint32_t>      m_dropped_binary{0};
+    std::string                m_binary_path;
+    FILE*                      m_binary_file = nullptr;
+};
+
+/// Lets through at most one message per interval; counts the rest.
+class LogRateLimiter
+{
+public:
+    explicit LogRateLimiter(float interval_sec): m_interval_ns(static_cast<int64_t>(interval_sec * 1e9)) {}
+
+    /// @param out_suppressed Number of messages swallowed since the last one let through.
+    bool Allow(uint32_t& out_suppressed);
+
+private:
+    int64_t               m_interval_ns;
+    std::atomic<int64_t>  m_next_allowed_ns{0};
+    std::atomic<uint32_t> m_suppressed{0};
+};
+
+/// @} // addtogroup Application
+
+} // namespace RoR
+
+/// `RoR::LogFormat()` with a per-call-site rate limit, for messages which may repeat every frame.
+#define LOG_RATE_LIMITED(_INTERVAL_SEC_, ...)                                                   \
+    do {                                                                                        \
+        static RoR::LogRateLimiter _rate_limiter(_INTERVAL_SEC_);                               \
+        uint32_t _suppressed = 0;                                                               \
+        if (_rate_limiter.Allow(_suppressed))                                                   \
+        {                                                                                       \
+            if (_suppressed > 0)                                                                \
+                RoR::LogFormat("[RoR] (%u similar messages suppressed)", _suppressed);          \
+            RoR::LogFormat(__VA_ARGS__);                                                        \
+        }                                                                                       \
+    } while (0)
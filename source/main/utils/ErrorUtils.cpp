@@ -27,6 +27,9 @@
 
 #include "ErrorUtils.h"
 
+#include "Application.h"
+#include "AsyncLogger.h"
+
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
 #include <windows.h>
 #include <shlobj.h>
@@ -42,6 +45,7 @@ using namespace Ogre;
 
 int ErrorUtils::ShowError(Ogre::UTFString title, Ogre::UTFString err)
 {
+    RoR::App::GetAsyncLogger()->Flush(); // The game may not survive the dialog - get pending messages into RoR.log first
     Ogre::UTFString infoText = _L("An internal error occured in Rigs of Rods.\n\nTechnical details below: \n\n");
     return ErrorUtils::ShowMsgBox(_L("FATAL ERROR"), infoText + err, 0);
 }
@@ -27,6 +27,8 @@
 #include "Application.h"
 #include "PlatformUtils.h"
 
+#include <OgreFileSystem.h>
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -47,31 +49,42 @@ std::pair<std::string, std::string> extractLang(const std::string& info)
 
 void LanguageEngine::setup()
 {
-    // load language, must happen after initializing Settings class and Ogre Root!
+    this->scanLanguages();
+    this->loadActiveLanguage();
+}
 
-    languages = { {"English", "en"} };
-    auto& moFileReader = moFileLib::moFileReaderSingleton::GetInstance();
+void LanguageEngine::scanLanguages()
+{
+    // Uses a private reader and doesn't touch OGRE resource system, so that it can run on a worker thread during startup.
+    std::vector<std::pair<std::string, std::string>> found = { {"English", "en"} };
+    moFileLib::moFileReader moFileReader;
 
     String base_path = PathCombine(App::sys_process_dir->getStr(), "languages");
-    ResourceGroupManager::getSingleton().addResourceLocation(base_path, "FileSystem", "LngRG");
-    FileInfoListPtr fl = ResourceGroupManager::getSingleton().findResourceFileInfo("LngRG", "*", true);
-    if (!fl->empty())
+    FileSystemArchive archive(base_path, "FileSystem", /*readOnly=*/true);
+    StringVectorPtr dirs = archive.list(/*recursive=*/false, /*dirs=*/true);
+    for (const String& dir : *dirs)
     {
-        for (const auto& file : *fl)
+        String locale_path = PathCombine(base_path, dir);
+        String mo_path = PathCombine(locale_path, "ror.mo");
+        if (moFileReader.ReadFile(mo_path.c_str()) == moFileLib::moFileReader::EC_SUCCESS)
         {
-            String locale_path = PathCombine(base_path, file.filename);
-            String mo_path = PathCombine(locale_path, "ror.mo");
-            if (moFileReader.ReadFile(mo_path.c_str()) == moFileLib::moFileReader::EC_SUCCESS)
-            {
-                String info = moFileLib::moFileReaderSingleton::GetInstance().Lookup("");
-                languages.push_back(extractLang(info));
-            }
+            String info = moFileReader.Lookup("");
+            found.push_back(extractLang(info));
         }
-        std::sort(languages.begin() + 1, languages.end());
         moFileReader.ClearTable();
     }
-    ResourceGroupManager::getSingleton().destroyResourceGroup("LngRG");
+    std::sort(found.begin() + 1, found.end());
+    languages = found;
+}
 
+void LanguageEngine::loadActiveLanguage()
+{
+    // load language, must happen after initializing Settings class and Ogre Root!
+
+    auto& moFileReader = moFileLib::moFileReaderSingleton::GetInstance();
+    moFileReader.ClearTable();
+
+    String base_path = PathCombine(App::sys_process_dir->getStr(), "languages");
     String locale_path = PathCombine(base_path, App::app_language->getStr().substr(0, 2));
     String mo_path = PathCombine(locale_path, "ror.mo");
 
@@ -50,6 +50,8 @@ class LanguageEngine
 {
 public:
     void setup();
+    void scanLanguages();      //!< Finds available translations; doesn't touch '_L()' so it can run on a worker thread.
+    void loadActiveLanguage(); //!< Loads translation selected by 'app_language'; main thread only.
 
     std::vector<std::pair<std::string, std::string>> getLanguages() { return languages; };
 
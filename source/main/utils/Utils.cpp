@@ -27,6 +27,7 @@
 #include "Application.h"
 
 #include <Ogre.h>
+#include <fstream>
 
 #ifndef _WIN32
 #   include <iconv.h>
@@ -141,11 +142,51 @@ std::string RoR::Sha1Hash(std::string const & input)
     return sha1.ReportHash();
 }
 
+Ogre::DataStreamPtr RoR::OpenFileDirect(std::string const& path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return Ogre::DataStreamPtr();
+    }
+
+    const size_t size = static_cast<size_t>(file.tellg());
+    MemoryDataStream* stream = OGRE_NEW MemoryDataStream(path, size);
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(stream->getPtr()), size);
+    return Ogre::DataStreamPtr(stream);
+}
+
 bool RoR::IsDistanceWithin(Ogre::Vector3 const& a, Ogre::Vector3 const& b, float max)
 {
     return a.squaredDistance(b) <= max * max;
 }
 
+void RoR::World2ScreenConverter::ConvertBatch(const Ogre::Vector3* world_pos, size_t count, size_t stride, Ogre::Vector3* out) const
+{
+    const Matrix4 vp = m_projection_matrix * m_view_matrix;
+
+    // Keep the coefficients in locals so the compiler can keep them in registers and vectorize
+    const float c00 = vp[0][0], c01 = vp[0][1], c02 = vp[0][2], c03 = vp[0][3];
+    const float c10 = vp[1][0], c11 = vp[1][1], c12 = vp[1][2], c13 = vp[1][3];
+    const float c30 = vp[3][0], c31 = vp[3][1], c32 = vp[3][2], c33 = vp[3][3];
+    const float v20 = m_view_matrix[2][0], v21 = m_view_matrix[2][1], v22 = m_view_matrix[2][2], v23 = m_view_matrix[2][3];
+    const float half_w = m_screen_size.x * 0.5f;
+    const float half_h = m_screen_size.y * 0.5f;
+
+    const char* src = reinterpret_cast<const char*>(world_pos);
+    for (size_t i = 0; i < count; ++i, src += stride)
+    {
+        const Ogre::Vector3& p = *reinterpret_cast<const Ogre::Vector3*>(src);
+        const float clip_x = c00 * p.x + c01 * p.y + c02 * p.z + c03;
+        const float clip_y = c10 * p.x + c11 * p.y + c12 * p.z + c13;
+        const float inv_w = 1.f / (c30 * p.x + c31 * p.y + c32 * p.z + c33);
+        out[i].x = (clip_x * inv_w + 1.f) * half_w;
+        out[i].y = (1.f - clip_y * inv_w) * half_h;
+        out[i].z = v20 * p.x + v21 * p.y + v22 * p.z + v23;
+    }
+}
+
 void formatVertexDeclInfo(RoR::Str<4000>& text, Ogre::VertexDeclaration* vertexDeclaration, int j)
 {
     const VertexElement* ve = vertexDeclaration->getElement(j);
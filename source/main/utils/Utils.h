@@ -67,6 +67,10 @@ std::string SanitizeUtf8CString(const char* start, const char* end = nullptr);
 inline std::string& TrimStr(std::string& s) { Ogre::StringUtil::trim(s); return s; }
 std::string Sha1Hash(std::string const & data);
 
+/// Reads a whole file into memory, bypassing OGRE resource system - safe to use from worker threads.
+/// @return Null stream if the file can't be opened.
+Ogre::DataStreamPtr OpenFileDirect(std::string const& path);
+
 
 /// @author http://www.ogre3d.org/forums/viewtopic.php?p=463232#p463232
 /// @author http://www.ogre3d.org/tikiwiki/tiki-index.php?page=GetScreenspaceCoords&structure=Cookbook
@@ -87,6 +91,10 @@ public:
         return Ogre::Vector3(screen_x, screen_y, view_space_pos.z);
     }
 
+    /// Same as `Convert()` for `count` positions, `stride` bytes apart (i.e. a member of a struct array).
+    /// The matrices are pre-multiplied so each point costs a single branch-free 4x4 transform.
+    void ConvertBatch(const Ogre::Vector3* world_pos, size_t count, size_t stride, Ogre::Vector3* out) const;
+
 private:
     Ogre::Matrix4 m_view_matrix;
     Ogre::Matrix4 m_projection_matrix;
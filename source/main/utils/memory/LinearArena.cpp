@@ -0,0 +1,129 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LinearArena.h"
+
+#include "Application.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#   include <windows.h>
+#   include <malloc.h>
+#else
+#   include <sys/mman.h>
+#endif
+
+using namespace RoR;
+
+#ifndef _WIN32
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024; // Typical x86-64 transparent huge page
+#endif
+
+void LinearArena::Allocate(bool use_huge_pages)
+{
+    ROR_ASSERT(m_data == nullptr);
+    if (m_capacity == 0)
+        return;
+
+#ifdef _WIN32
+    if (use_huge_pages && GetLargePageMinimum() > 0)
+    {
+        // Requires 'SeLockMemoryPrivilege'; silently fall back if not granted.
+        const size_t page = GetLargePageMinimum();
+        const size_t size = (m_capacity + page - 1) & ~(page - 1);
+        m_data = static_cast<char*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE));
+        m_huge_pages = (m_data != nullptr);
+    }
+    if (m_data == nullptr)
+    {
+        m_data = static_cast<char*>(_aligned_malloc(m_capacity, CACHE_LINE_SIZE));
+    }
+#else
+    void* ptr = nullptr;
+    if (use_huge_pages && m_capacity >= HUGE_PAGE_SIZE)
+    {
+        const size_t size = (m_capacity + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+        if (posix_memalign(&ptr, HUGE_PAGE_SIZE, size) == 0)
+        {
+#   ifdef MADV_HUGEPAGE
+            madvise(ptr, size, MADV_HUGEPAGE); // Only a hint - failure is harmless
+#   endif
+            m_huge_pages = true;
+        }
+        else
+        {
+            ptr = nullptr;
+        }
+    }
+    if (ptr == nullptr && posix_memalign(&ptr, CACHE_LINE_SIZE, m_capacity) != 0)
+    {
+        ptr = nullptr;
+    }
+    m_data = static_cast<char*>(ptr);
+#endif
+
+    if (m_data == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    memset(m_data, 0, m_capacity);
+}
+
+void* LinearArena::Carve(size_t size)
+{
+    const size_t aligned_size = AlignSize(size);
+    ROR_ASSERT(m_data != nullptr);
+    ROR_ASSERT(m_used + aligned_size <= m_capacity); // Programmer error - missing `Reserve()`
+    if (m_data == nullptr || m_used + aligned_size > m_capacity)
+    {
+        throw std::bad_alloc();
+    }
+
+    void* ptr = m_data + m_used;
+    m_used += aligned_size;
+    return ptr;
+}
+
+void LinearArena::Release()
+{
+    // Destroy in reverse order of construction
+    for (auto itor = m_destructors.rbegin(); itor != m_destructors.rend(); ++itor)
+    {
+        (*itor)();
+    }
+    m_destructors.clear();
+
+    if (m_data != nullptr)
+    {
+#ifdef _WIN32
+        if (m_huge_pages)
+            VirtualFree(m_data, 0, MEM_RELEASE);
+        else
+            _aligned_free(m_data);
+#else
+        free(m_data);
+#endif
+    }
+
+    m_data = nullptr;
+    m_capacity = 0;
+    m_used = 0;
+    m_huge_pages = false;
+}
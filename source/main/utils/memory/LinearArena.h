@@ -0,0 +1,94 @@
+/*
+    This source file is part of Rigs of Rods
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Single-block bump allocator for per-actor simulation arrays.
+///
+/// Usage is two-phase: first `Reserve<T>()` every array, then call `Allocate()` once
+/// and carve the arrays out with `NewArray<T>()`. Every array starts on a cache line.
+/// Objects are constructed in place and destroyed (if needed) when the arena is released.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace RoR {
+
+class LinearArena
+{
+public:
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    LinearArena() {}
+    ~LinearArena() { this->Release(); }
+
+    LinearArena(LinearArena const&) = delete;
+    LinearArena& operator=(LinearArena const&) = delete;
+
+    /// Phase 1: Account for an array; must be called before `Allocate()`.
+    template <typename T> void Reserve(size_t count)
+    {
+        m_capacity += AlignSize(sizeof(T) * count);
+    }
+
+    /// Phase 2: Acquire the whole block at once; memory is zeroed.
+    /// @param use_huge_pages Hint to back the block with huge/large pages if the OS allows.
+    void Allocate(bool use_huge_pages);
+
+    /// Phase 3: Carve out a default-constructed array. Returns nullptr for empty arrays.
+    template <typename T> T* NewArray(size_t count)
+    {
+        if (count == 0)
+            return nullptr;
+
+        T* arr = static_cast<T*>(this->Carve(sizeof(T) * count));
+        for (size_t i = 0; i < count; ++i)
+        {
+            new (&arr[i]) T();
+        }
+        if (!std::is_trivially_destructible<T>::value)
+        {
+            m_destructors.push_back([arr, count]() { for (size_t i = 0; i < count; ++i) { arr[i].~T(); } });
+        }
+        return arr;
+    }
+
+    /// Destroys all carved objects and returns the block to the OS.
+    void Release();
+
+    size_t GetCapacity() const      { return m_capacity; }
+    size_t GetUsedSize() const      { return m_used; }
+    bool   IsHugePageBacked() const { return m_huge_pages; }
+
+private:
+    static size_t AlignSize(size_t size) { return (size + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1); }
+
+    void* Carve(size_t size);
+
+    char*                              m_data = nullptr;
+    size_t                             m_capacity = 0;
+    size_t                             m_used = 0;
+    bool                               m_huge_pages = false;  //!< Block came from the large-page allocator (needs matching free).
+    std::vector<std::function<void()>> m_destructors;
+};
+
+} // namespace RoR
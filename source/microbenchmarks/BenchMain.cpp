@@ -0,0 +1,30 @@
+#include "BenchMain.h"
+
+#include "benchmark/benchmark.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    using namespace std;
+
+    // verify
+    cout << "Verifying..." << endl;
+    if (!BenchVerify())
+    {
+        return 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "--verify-only") == 0)
+    {
+        return 0;
+    }
+
+    // benchmark
+    ::benchmark::Initialize(&argc, argv);
+    ::benchmark::RunSpecifiedBenchmarks();
+#ifdef _MSC_VER
+    system("pause");
+#endif
+    return 0;
+}
@@ -0,0 +1,12 @@
+/// @file
+/// @brief Shared entry point of the micro-benchmarks which use game code, see README.txt.
+///
+/// Each Bench_*.cpp defines `BenchVerify()`; `main()` in BenchMain.cpp runs it before
+/// any benchmark and exits with code 1 if it fails. With `--verify-only` it stops there,
+/// which is how CTest runs the benchmarks.
+
+#pragma once
+
+/// Prepares shared state and checks the optimized code against its reference.
+/// @return False if the results differ; details go to stdout.
+bool BenchVerify();
@@ -0,0 +1,150 @@
+#include "benchmark/benchmark.h"
+#include "BenchMain.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Actor.h"
+#include "ActorManager.h"
+#include "ApproxMath.h"
+#include "SimConstants.h"
+
+// Node integration + air drag, the per-substep arithmetic of `Actor::CalcNodes()`:
+//  the former fused loop (immovable branch, noise drawn inline) vs. `Actor::IntegrateNodes()` (selects, noise drawn ahead).
+// Every 16th node is immovable and massless, as fixed nodes of terrain objects may be; the split loop must not produce NaN there.
+// After 500 steps, node states of both variants must match to 1e-5 (relative).
+
+using namespace RoR;
+
+static const float DT      = PHYSICS_DT;
+static const float GRAVITY = -9.81f;
+
+struct NodeScene
+{
+    Actor*              actor = nullptr;
+    std::vector<node_t> nodes;
+};
+
+static void BuildNodeScene(NodeScene& scene, int num_nodes)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> pos(-5.f, 5.f);
+    std::uniform_real_distribution<float> mass(5.f, 50.f);
+    std::uniform_real_distribution<float> force(-2000.f, 2000.f);
+
+    scene.nodes.resize(num_nodes);
+    for (int i = 0; i < num_nodes; i++)
+    {
+        node_t& n = scene.nodes[i];
+        n = node_t(i);
+        n.RelPosition = Ogre::Vector3(pos(rng), pos(rng) + 5.f, pos(rng));
+        n.AbsPosition = n.RelPosition;
+        n.nd_immovable = (i % 16 == 0);
+        n.mass = (n.nd_immovable) ? 0.f : mass(rng);
+        n.Forces = Ogre::Vector3(force(rng), force(rng), force(rng));
+    }
+
+    scene.actor = new Actor(0, 0, RigDef::DocumentPtr(), ActorSpawnRequest());
+    scene.actor->ar_nodes = scene.nodes.data();
+    scene.actor->ar_num_nodes = num_nodes;
+    scene.actor->ar_origin = Ogre::Vector3::ZERO;
+}
+
+/// The loop as it was before `IntegrateNodes()`, without the collision and water parts
+static float IntegrateNodesFused(Actor* actor, uint32_t& seed)
+{
+    float max_speed = 0.f;
+    for (int i = 0; i < actor->ar_num_nodes; i++)
+    {
+        node_t& n = actor->ar_nodes[i];
+        if (!n.nd_immovable)
+        {
+            n.Velocity += n.Forces / n.mass * DT;
+            n.RelPosition += n.Velocity * DT;
+            n.AbsPosition = actor->ar_origin;
+            n.AbsPosition += n.RelPosition;
+        }
+        n.Forces = Ogre::Vector3(0, n.mass * GRAVITY, 0);
+
+        const float approx_speed = approx_sqrt(n.Velocity.squaredLength());
+        max_speed = std::max(max_speed, approx_speed);
+
+        const float defdragxspeed = DEFAULT_DRAG * approx_speed;
+        Ogre::Vector3 drag = -defdragxspeed * n.Velocity;
+        const float maxtur = defdragxspeed * approx_speed * 0.005f;
+        const float rx = frand_11(seed); // Sequenced, the new code draws in this order too
+        const float ry = frand_11(seed);
+        const float rz = frand_11(seed);
+        drag += maxtur * Ogre::Vector3(rx, ry, rz);
+        n.Forces += drag;
+    }
+    return max_speed;
+}
+
+static bool IsClose(Ogre::Vector3 const& a, Ogre::Vector3 const& b)
+{
+    return (a - b).length() <= 1e-5f * std::max(1.f, a.length());
+}
+
+static bool VerifyIntegrateNodes()
+{
+    NodeScene fused, split;
+    BuildNodeScene(fused, 1000);
+    BuildNodeScene(split, 1000);
+    uint32_t seed = split.actor->ar_rand_seed;
+
+    for (int step = 0; step < 500; step++)
+    {
+        const float fused_speed = IntegrateNodesFused(fused.actor, seed);
+        const float split_speed = split.actor->IntegrateNodes(DT, GRAVITY);
+        if (std::abs(fused_speed - split_speed) > 1e-5f * std::max(1.f, fused_speed))
+        {
+            std::cout << "IntegrateNodes: max. speed differs at step " << step << std::endl;
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < split.nodes.size(); i++)
+    {
+        node_t const& a = fused.nodes[i];
+        node_t const& b = split.nodes[i];
+        if (std::isnan(b.Velocity.x) || !IsClose(a.Velocity, b.Velocity) ||
+            !IsClose(a.AbsPosition, b.AbsPosition) || !IsClose(a.Forces, b.Forces))
+        {
+            std::cout << "IntegrateNodes: node " << i << " differs" << (b.nd_immovable ? " (immovable)" : "") << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static void Bench_IntegrateNodes_Fused(benchmark::State& state)
+{
+    NodeScene scene;
+    BuildNodeScene(scene, static_cast<int>(state.range(0)));
+    uint32_t seed = 1;
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(IntegrateNodesFused(scene.actor, seed));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Bench_IntegrateNodes_Fused)->Arg(200)->Arg(1000)->Arg(5000);
+
+static void Bench_IntegrateNodes_Split(benchmark::State& state)
+{
+    NodeScene scene;
+    BuildNodeScene(scene, static_cast<int>(state.range(0)));
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(scene.actor->IntegrateNodes(DT, GRAVITY));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Bench_IntegrateNodes_Split)->Arg(200)->Arg(1000)->Arg(5000);
+
+bool BenchVerify()
+{
+    return VerifyIntegrateNodes();
+}
@@ -0,0 +1,330 @@
+#include "benchmark/benchmark.h"
+#include "BenchMain.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "Actor.h"
+#include "Application.h"
+#include "Character.h"
+#include "Collisions.h"
+#include "Console.h"
+#include "PlatformUtils.h"
+
+// On-foot character movement against terrain collisions (boxes and tris) and actor cabs.
+// Verification walks a real `Character` (`Character::ResolveCollisions()`, the part of `update()`
+// without input, heightmap and water) along scripted routes and checks where each ends,
+// and that its knees never end up inside a solid box.
+// The benchmark compares the former probing with `collisionCorrect()` (100 points along the step for obstacles,
+// 1mm steps down for the step-up depth, no cabs) with the real character on the terrain routes.
+
+using namespace RoR;
+
+static const float DT        = 1.f / 60.f;
+static const float WALK      = 3.f;    // m/s, `Character::m_character_h_speed * 1.5`
+static const float KNEE      = 0.25f;  // Obstacles below this are stepped onto
+
+struct Route
+{
+    const char*   name;
+    Ogre::Vector3 start;
+    float         heading;    // Radians
+    float         turn_rate;  // Radians per second
+    float         duration;   // Seconds
+    bool          (*check_end)(Ogre::Vector3 const& end); // nullptr = no expectation besides not passing through boxes
+};
+
+/// Scripted geometry, placed away from the origin - cells with negative coordinates aren't hashed
+static const Route TERRAIN_ROUTES[] =
+{
+    { "wall (climbs over)",  Ogre::Vector3(195.f, 0.f, 200.f), 0.f,   0.f, 6.f,  nullptr },
+    { "low step",            Ogre::Vector3(195.f, 0.f, 212.f), 0.f,   0.f, 4.f,  [](Ogre::Vector3 const& end) { return end.x > 204.f; } },
+    { "ramp (tris)",         Ogre::Vector3(195.f, 0.f, 222.f), 0.f,   0.f, 3.f,  [](Ogre::Vector3 const& end) { return end.x > 200.f && std::abs(end.y - (end.x - 200.f) / 5.f) < 0.15f; } },
+    { "rotated wall",        Ogre::Vector3(195.f, 0.f, 235.f), 0.35f, 0.f, 4.f,  nullptr },
+    { "circle",              Ogre::Vector3(195.f, 0.f, 250.f), 0.f,   0.5f, 12.f, nullptr },
+};
+
+static const Route CAB_ROUTES[] =
+{
+    { "along truck bed",     Ogre::Vector3(201.f, 0.8f, 266.f), 0.f,  0.f, 0.8f, [](Ogre::Vector3 const& end) { return std::abs(end.y - 0.8f) < 0.1f; } },
+    { "into truck side",     Ogre::Vector3(205.f, 0.f, 276.f),  0.f,  0.f, 2.f,  [](Ogre::Vector3 const& end) { return end.x < 210.f; } },
+};
+
+static void WriteGroundModels(std::string const& dir)
+{
+    CreateFolder(dir);
+    std::ofstream cfg(PathCombine(dir, "ground_models.cfg"));
+    cfg << "[general]\n"
+        << "version=3\n" // `Collisions::LATEST_GROUND_MODEL_VERSION`
+        << "[concrete]\n"
+        << "adhesion velocity=5.0\n"
+        << "[gravel]\n"
+        << "adhesion velocity=5.0\n";
+}
+
+static std::unique_ptr<Collisions> BuildScene()
+{
+    std::unique_ptr<Collisions> coll(new Collisions(Ogre::Vector3(1000.f, 100.f, 1000.f)));
+    const Ogre::Vector3 no_rot = Ogre::Vector3::ZERO;
+
+    // Ground, top at Y=0, under all routes
+    coll->addCollisionBox(nullptr, false, false, Ogre::Vector3(200.f, 0.f, 240.f), no_rot,
+        Ogre::Vector3(-20.f, -1.f, -50.f), Ogre::Vector3(20.f, 0.f, 50.f), no_rot, "", "", false, Ogre::Vector3::ZERO);
+
+    // Wall, 2m tall
+    coll->addCollisionBox(nullptr, false, false, Ogre::Vector3(205.f, 0.f, 200.f), no_rot,
+        Ogre::Vector3(0.f, 0.f, -5.f), Ogre::Vector3(1.f, 2.f, 5.f), no_rot, "", "", false, Ogre::Vector3::ZERO);
+
+    // Low step, below the obstacle probe (0.25m above the feet)
+    coll->addCollisionBox(nullptr, false, false, Ogre::Vector3(200.f, 0.f, 212.f), no_rot,
+        Ogre::Vector3(0.f, 0.f, -2.f), Ogre::Vector3(4.f, 0.15f, 2.f), no_rot, "", "", false, Ogre::Vector3::ZERO);
+
+    // Ramp from the ground up to 1m, normals up
+    const Ogre::Vector3 r0(200.f, 0.f, 220.f), r1(200.f, 0.f, 224.f), r2(205.f, 1.f, 220.f), r3(205.f, 1.f, 224.f);
+    coll->addCollisionTri(r0, r1, r2, coll->defaultgm);
+    coll->addCollisionTri(r1, r3, r2, coll->defaultgm);
+
+    // Wall rotated around Y (refined box) and a self-rotated crate next to it
+    coll->addCollisionBox(nullptr, false, false, Ogre::Vector3(203.f, 0.f, 238.f), Ogre::Vector3(0.f, 30.f, 0.f),
+        Ogre::Vector3(-0.5f, 0.f, -3.f), Ogre::Vector3(0.5f, 2.f, 3.f), no_rot, "", "", false, Ogre::Vector3::ZERO);
+    coll->addCollisionBox(nullptr, true, false, Ogre::Vector3(199.f, 0.f, 244.f), no_rot,
+        Ogre::Vector3(-1.f, 0.f, -1.f), Ogre::Vector3(1.f, 0.2f, 1.f), Ogre::Vector3(0.f, 45.f, 0.f), "", "", false, Ogre::Vector3::ZERO);
+
+    // On the circle: a step, a block and a virtual (event-only) box which must be ignored
+    coll->addCollisionBox(nullptr, false, false, Ogre::Vector3(201.f, 0.f, 256.f), no_rot,
+        Ogre::Vector3(-1.f, 0.f, -1.f), Ogre::Vector3(1.f, 0.1f, 1.f), no_rot, "", "", false, Ogre::Vector3::ZERO);
+    coll->addCollisionBox(nullptr, false, false, Ogre::Vector3(199.2f, 0.f, 251.8f), no_rot,
+        Ogre::Vector3(-0.5f, 0.f, -0.5f), Ogre::Vector3(0.5f, 1.f, 0.5f), no_rot, "", "", false, Ogre::Vector3::ZERO);
+    coll->addCollisionBox(nullptr, false, true, Ogre::Vector3(189.f, 0.f, 256.f), no_rot,
+        Ogre::Vector3(-1.f, 0.f, -1.f), Ogre::Vector3(1.f, 2.f, 1.f), no_rot, "", "", false, Ogre::Vector3::ZERO);
+
+    return coll;
+}
+
+/// A parked truck: a flat bed 0.8m high and a 1.5m tall side panel, both collision cabs
+struct CabScene
+{
+    Actor*              actor = nullptr;
+    std::vector<node_t> nodes;
+};
+
+static void BuildCabScene(CabScene& scene)
+{
+    const Ogre::Vector3 corners[] =
+    {
+        Ogre::Vector3(200.f, 0.8f, 264.f), Ogre::Vector3(204.f, 0.8f, 264.f), Ogre::Vector3(204.f, 0.8f, 268.f), Ogre::Vector3(200.f, 0.8f, 268.f), // bed
+        Ogre::Vector3(210.f, 0.0f, 274.f), Ogre::Vector3(210.f, 0.0f, 278.f), Ogre::Vector3(210.f, 1.5f, 278.f), Ogre::Vector3(210.f, 1.5f, 274.f), // side
+    };
+    const int cabs[][3] = { {0, 1, 2}, {0, 2, 3}, {4, 5, 6}, {4, 6, 7} };
+
+    scene.nodes.resize(8);
+    Ogre::AxisAlignedBox box;
+    for (int i = 0; i < 8; i++)
+    {
+        scene.nodes[i] = node_t(i);
+        scene.nodes[i].AbsPosition = corners[i];
+        scene.nodes[i].RelPosition = corners[i];
+        box.merge(corners[i]);
+    }
+
+    scene.actor = new Actor(0, 0, RigDef::DocumentPtr(), ActorSpawnRequest());
+    scene.actor->ar_nodes = scene.nodes.data();
+    scene.actor->ar_num_nodes = 8;
+    for (int i = 0; i < 4; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            scene.actor->ar_cabs[i * 3 + j] = cabs[i][j];
+        }
+        scene.actor->ar_collcabs[i] = i;
+    }
+    scene.actor->ar_num_cabs = 4;
+    scene.actor->ar_num_collcabs = 4;
+    scene.actor->ar_bounding_box = box;
+}
+
+// ---------------- Former probing (before `sweepCapsule()`) ----------------
+
+struct ProbeState
+{
+    Ogre::Vector3 position;
+    Ogre::Vector3 prev_position;
+    float         v_speed = 0.f;
+};
+
+static float CollisionDepthProbe(Collisions& coll, Ogre::Vector3 pos)
+{
+    Ogre::Vector3 query = pos + 0.3f * Ogre::Vector3::UNIT_Y;
+    while (query.y > pos.y)
+    {
+        if (coll.collisionCorrect(&query, false))
+            break;
+        query.y -= 0.001f;
+    }
+    return query.y - pos.y;
+}
+
+static bool ObstacleProbe(Collisions& coll, Ogre::Vector3 const& prev_position, Ogre::Vector3 const& diff, float* out_fraction)
+{
+    const int numstep = 100;
+    Ogre::Vector3 base = prev_position + Ogre::Vector3::UNIT_Y * KNEE;
+    for (int i = 1; i < numstep; i++)
+    {
+        Ogre::Vector3 query = base + diff * ((float)i / numstep);
+        if (coll.collisionCorrect(&query, false))
+        {
+            *out_fraction = (float)(i - 1) / numstep;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// `Character::update()` as it was, without input, heightmap and water
+static void StepProbe(Collisions& coll, ProbeState& ch)
+{
+    Ogre::Vector3 position = ch.position;
+
+    position.y += ch.v_speed * DT;
+    ch.v_speed += DT * -9.8f;
+
+    float depth = CollisionDepthProbe(coll, position);
+    if (depth > 0.0f)
+    {
+        ch.v_speed = std::max(0.0f, ch.v_speed);
+        position.y += std::min(depth, 2.0f * DT);
+    }
+
+    if (position != ch.prev_position)
+    {
+        Ogre::Vector3 diff = position - ch.prev_position;
+        float fraction = 0.f;
+        if (ObstacleProbe(coll, ch.prev_position, diff, &fraction))
+        {
+            ch.v_speed = std::max(0.0f, ch.v_speed);
+            position = ch.prev_position + diff * fraction;
+            position.y += 0.025f;
+        }
+    }
+
+    ch.prev_position = position;
+    ch.position = position;
+}
+
+static Ogre::Vector3 WalkDirection(Route const& route, int frame)
+{
+    const float heading = route.heading + route.turn_rate * DT * frame;
+    return DT * WALK * Ogre::Vector3(std::cos(heading), 0.0f, std::sin(heading));
+}
+
+static Ogre::Vector3 WalkRouteProbe(Collisions& coll, Route const& route)
+{
+    ProbeState ch;
+    ch.position = route.start;
+    ch.prev_position = route.start;
+    const int num_frames = static_cast<int>(route.duration / DT);
+    for (int frame = 0; frame < num_frames; frame++)
+    {
+        StepProbe(coll, ch);
+        ch.position += WalkDirection(route, frame);
+    }
+    return ch.position;
+}
+
+// ---------------- Character ----------------
+
+/// @param out_inside Set if the knees were inside a solid box after any frame
+static Ogre::Vector3 WalkRoute(Collisions& coll, std::vector<Actor*> const& actors, Route const& route, bool* out_inside = nullptr)
+{
+    Character character(-1, 0, "", 0, /*is_remote=*/false);
+    character.setPosition(route.start);
+    const int num_frames = static_cast<int>(route.duration / DT);
+    for (int frame = 0; frame < num_frames; frame++)
+    {
+        character.ResolveCollisions(DT, &coll, actors);
+        if (out_inside)
+        {
+            Ogre::Vector3 knee = character.getPosition() + KNEE * Ogre::Vector3::UNIT_Y;
+            *out_inside = *out_inside || coll.collisionCorrect(&knee, false);
+        }
+        character.move(WalkDirection(route, frame));
+    }
+    return character.getPosition();
+}
+
+static bool VerifyRoute(Collisions& coll, std::vector<Actor*> const& actors, Route const& route)
+{
+    bool inside = false;
+    const Ogre::Vector3 end = WalkRoute(coll, actors, route, &inside);
+    if (inside)
+    {
+        std::cout << "Character route '" << route.name << "' passes through a box" << std::endl;
+        return false;
+    }
+    if (route.check_end && !route.check_end(end))
+    {
+        std::cout << "Character route '" << route.name << "' ends at unexpected " << end << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool VerifyCharacterSweep(Collisions& coll, std::vector<Actor*> const& actors)
+{
+    for (Route const& route : TERRAIN_ROUTES)
+    {
+        if (!VerifyRoute(coll, actors, route))
+            return false;
+    }
+    for (Route const& route : CAB_ROUTES)
+    {
+        if (!VerifyRoute(coll, actors, route))
+            return false;
+    }
+    return true;
+}
+
+static std::unique_ptr<Collisions> g_scene;
+static std::vector<Actor*>         g_actors; // Terrain routes don't get near the truck; it only costs the bounding box test
+
+static void Bench_CharacterRoutes_Probe(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        for (Route const& route : TERRAIN_ROUTES)
+        {
+            benchmark::DoNotOptimize(WalkRouteProbe(*g_scene, route));
+        }
+    }
+}
+BENCHMARK(Bench_CharacterRoutes_Probe);
+
+static void Bench_CharacterRoutes_Sweep(benchmark::State& state)
+{
+    while (state.KeepRunning())
+    {
+        for (Route const& route : TERRAIN_ROUTES)
+        {
+            benchmark::DoNotOptimize(WalkRoute(*g_scene, g_actors, route));
+        }
+    }
+}
+BENCHMARK(Bench_CharacterRoutes_Sweep);
+
+bool BenchVerify()
+{
+    // `Collisions` reads the ground models from the config dir
+    App::GetConsole()->cVarSetupBuiltins();
+    App::sys_config_dir->setStr("bench_character_sweep");
+    WriteGroundModels(App::sys_config_dir->getStr());
+    Collisions::PreloadDefaultModels();
+    g_scene = BuildScene();
+    static CabScene truck;
+    BuildCabScene(truck);
+    g_actors.push_back(truck.actor);
+
+    return VerifyCharacterSweep(*g_scene, g_actors);
+}
@@ -0,0 +1,220 @@
+#include "benchmark/benchmark.h"
+#include "BenchMain.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "FlexMeshWheel.h"
+#include "SimBuffers.h"
+
+// Flexmesh wheel tire vertices:
+//  `CalcFlexMeshWheelVertices()` (batched, positions gathered into one array) vs. `CalcFlexMeshWheelVerticesReference()` (`FlexMeshWheel::updateVertices()`)
+// on generated wheels with various ray counts, including degenerate ones (zero-length axis, tire nodes on the axis).
+// Degenerate wheels produce NaN normals in both variants, so the comparison treats NaN as equal to NaN.
+
+using namespace RoR;
+
+static const float RIM_RADIUS  = 0.3f;
+static const float TIRE_RADIUS = 0.5f;
+static const float HALF_WIDTH  = 0.15f;
+
+enum class WheelShape
+{
+    REGULAR,
+    ZERO_AXIS,         //!< Both axis nodes at the same position
+    TIRE_ON_AXIS,      //!< Every 3rd pair of tire nodes lies on the axis line (not the first two, `norm_y` is computed from those)
+};
+
+/// Nodes like `ActorSpawner` lays out a flexbodywheel: axis node 0, axis node 1, then 2 tire nodes per ray
+struct WheelScene
+{
+    size_t                     num_rays = 0;
+    size_t                     num_wheels = 0;
+    WheelShape                 shape = WheelShape::REGULAR;
+    std::vector<RoR::NodeSB>   nodes;               // Per wheel: 2 + 2 * num_rays
+    std::vector<float>         norm_y;              // Per wheel
+    std::vector<float>         ref_vertices;        // Per wheel: 6 * (num_rays + 1) * 8 floats
+    std::vector<float>         batch_vertices;
+    std::vector<Ogre::Vector3> positions;           // Gathered like `FlexMeshWheelBatch::AddWheel()`
+    std::vector<FlexMeshWheelJob> jobs;
+};
+
+static size_t NodesPerWheel(WheelScene const& scene)    { return 2 + 2 * scene.num_rays; }
+static size_t FloatsPerWheel(WheelScene const& scene)   { return 6 * (scene.num_rays + 1) * 8; }
+
+static void MoveWheels(WheelScene& scene, float time)
+{
+    for (size_t w = 0; w < scene.num_wheels; w++)
+    {
+        RoR::NodeSB* nodes = &scene.nodes[w * NodesPerWheel(scene)];
+        const Ogre::Vector3 center(static_cast<float>(w) * 2.f, 0.5f, 0.1f * time);
+        const float half_width = (scene.shape == WheelShape::ZERO_AXIS) ? 0.f : HALF_WIDTH;
+        nodes[0].AbsPosition = center + Ogre::Vector3(0.f, 0.f, -half_width);
+        nodes[1].AbsPosition = center + Ogre::Vector3(0.f, 0.f, half_width);
+
+        const float spin = time * 3.f + static_cast<float>(w);
+        const float step = Ogre::Math::TWO_PI / static_cast<float>(scene.num_rays);
+        for (size_t i = 0; i < scene.num_rays; i++)
+        {
+            const float a0 = spin + step * i;
+            const float a1 = a0 + step * 0.5f;
+            const float squash = 1.f - 0.05f * std::max(0.f, -std::sin(a0)); // Flattened at the bottom
+            const float radius = (scene.shape == WheelShape::TIRE_ON_AXIS && i % 3 == 2) ? 0.f : TIRE_RADIUS * squash;
+            nodes[2 + i*2].AbsPosition = nodes[0].AbsPosition + Ogre::Vector3(std::cos(a0), std::sin(a0), 0.f) * radius;
+            nodes[3 + i*2].AbsPosition = nodes[1].AbsPosition + Ogre::Vector3(std::cos(a1), std::sin(a1), 0.f) * radius;
+        }
+    }
+}
+
+static void GatherPositions(WheelScene& scene)
+{
+    // Same as `FlexMeshWheelBatch::AddWheel()`
+    scene.positions.clear();
+    for (size_t w = 0; w < scene.num_wheels; w++)
+    {
+        const RoR::NodeSB* nodes = &scene.nodes[w * NodesPerWheel(scene)];
+        scene.positions.push_back(nodes[0].AbsPosition);
+        scene.positions.push_back(nodes[1].AbsPosition);
+        for (size_t i = 0; i < scene.num_rays * 2; i++)
+        {
+            scene.positions.push_back(nodes[2 + i].AbsPosition);
+        }
+    }
+}
+
+static void RunReference(WheelScene& scene)
+{
+    for (size_t w = 0; w < scene.num_wheels; w++)
+    {
+        const int first_node = static_cast<int>(w * NodesPerWheel(scene));
+        CalcFlexMeshWheelVerticesReference(scene.nodes.data(), first_node, first_node + 1, first_node + 2,
+            scene.num_rays, RIM_RADIUS, scene.norm_y[w], &scene.ref_vertices[w * FloatsPerWheel(scene)]);
+    }
+}
+
+static void RunBatch(WheelScene& scene)
+{
+    GatherPositions(scene);
+    CalcFlexMeshWheelVertices(scene.jobs.data(), scene.jobs.size(), scene.positions.data());
+}
+
+static void BuildWheelScene(WheelScene& scene, size_t num_rays, size_t num_wheels, WheelShape shape)
+{
+    scene.num_rays = num_rays;
+    scene.num_wheels = num_wheels;
+    scene.shape = shape;
+    scene.nodes.resize(num_wheels * NodesPerWheel(scene));
+    scene.norm_y.assign(num_wheels, 1.f);
+    scene.ref_vertices.assign(num_wheels * FloatsPerWheel(scene), 0.f);
+    MoveWheels(scene, 0.f);
+
+    // Like the `FlexMeshWheel` constructor: update, compute `m_norm_y`, update again
+    RunReference(scene);
+    for (size_t w = 0; w < num_wheels; w++)
+    {
+        const float* v = &scene.ref_vertices[w * FloatsPerWheel(scene)];
+        const Ogre::Vector3 p0(v[0], v[1], v[2]);
+        const Ogre::Vector3 p1(v[8], v[9], v[10]);
+        const Ogre::Vector3 p7(v[7*8], v[7*8+1], v[7*8+2]);
+        scene.norm_y[w] = ((p0 - p1).crossProduct(p1 - p7)).length();
+    }
+    RunReference(scene);
+    scene.batch_vertices = scene.ref_vertices;
+
+    scene.jobs.resize(num_wheels);
+    for (size_t w = 0; w < num_wheels; w++)
+    {
+        scene.jobs[w].positions_offset = w * NodesPerWheel(scene);
+        scene.jobs[w].num_rays = num_rays;
+        scene.jobs[w].rim_radius = RIM_RADIUS;
+        scene.jobs[w].norm_y = scene.norm_y[w];
+        scene.jobs[w].vertices = &scene.batch_vertices[w * FloatsPerWheel(scene)];
+    }
+}
+
+static bool SameFloat(float a, float b)
+{
+    if (std::isnan(a) || std::isnan(b))
+        return std::isnan(a) && std::isnan(b);
+    if (std::isinf(a) || std::isinf(b))
+        return a == b;
+    return std::abs(a - b) <= 1e-5f * std::max(1.f, std::abs(a));
+}
+
+static bool VerifyFlexMeshWheelBatch()
+{
+    for (WheelShape shape : { WheelShape::REGULAR, WheelShape::ZERO_AXIS, WheelShape::TIRE_ON_AXIS })
+    {
+        for (size_t num_rays : { 3, 8, 16, 48 })
+        {
+            WheelScene scene;
+            BuildWheelScene(scene, num_rays, 4, shape);
+            for (int frame = 1; frame <= 20; frame++)
+            {
+                MoveWheels(scene, frame * 0.05f);
+                RunReference(scene);
+                RunBatch(scene);
+
+                for (size_t w = 0; w < scene.num_wheels; w++)
+                {
+                    const RoR::NodeSB* nodes = &scene.nodes[w * NodesPerWheel(scene)];
+                    const Ogre::Vector3 center = (nodes[0].AbsPosition + nodes[1].AbsPosition) / 2.0;
+                    if (scene.jobs[w].out_center != center)
+                    {
+                        std::cout << "CalcFlexMeshWheelVertices() center differs: shape " << static_cast<int>(shape)
+                            << ", " << num_rays << " rays, frame " << frame << ", wheel " << w << std::endl;
+                        return false;
+                    }
+                }
+                for (size_t i = 0; i < scene.ref_vertices.size(); i++)
+                {
+                    if (!SameFloat(scene.ref_vertices[i], scene.batch_vertices[i]))
+                    {
+                        std::cout << "CalcFlexMeshWheelVertices() differs: shape " << static_cast<int>(shape)
+                            << ", " << num_rays << " rays, frame " << frame << ", float " << i << ": "
+                            << scene.ref_vertices[i] << " vs. " << scene.batch_vertices[i] << std::endl;
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static void Bench_FlexMeshWheel_PerWheel(benchmark::State& state)
+{
+    WheelScene scene;
+    BuildWheelScene(scene, static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)), WheelShape::REGULAR);
+    float time = 0.f;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        MoveWheels(scene, time += 0.01f);
+        state.ResumeTiming();
+        RunReference(scene);
+    }
+}
+BENCHMARK(Bench_FlexMeshWheel_PerWheel)->Args({12, 4})->Args({48, 4})->Args({12, 40})->Args({48, 40});
+
+static void Bench_FlexMeshWheel_Batched(benchmark::State& state)
+{
+    // Includes gathering the positions, as `FlexMeshWheelBatch::AddWheel()` does on the main thread
+    WheelScene scene;
+    BuildWheelScene(scene, static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)), WheelShape::REGULAR);
+    float time = 0.f;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        MoveWheels(scene, time += 0.01f);
+        state.ResumeTiming();
+        RunBatch(scene);
+    }
+}
+BENCHMARK(Bench_FlexMeshWheel_Batched)->Args({12, 4})->Args({48, 4})->Args({12, 40})->Args({48, 40});
+
+bool BenchVerify()
+{
+    return VerifyFlexMeshWheelBatch();
+}
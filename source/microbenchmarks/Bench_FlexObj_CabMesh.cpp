@@ -0,0 +1,286 @@
+#include "benchmark/benchmark.h"
+#include "BenchMain.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "ApproxMath.h"
+#include "FlexObj.h"
+#include "SimBuffers.h"
+
+// Cab mesh (old-style actor body) vertex computation:
+//  `CalcCabMeshVertices()` (gathered positions, vectorisable face normals) vs. `CalcCabMeshVerticesReference()` (the former `FlexObj::UpdateMesh()`)
+// on a synthetic cab - a wavy sheet with a backmesh, like `cab` + `backmesh` in a truck file.
+// Also measures what `FlexObj` uploads per frame, for a parked cab with one flapping door and for a driving cab.
+
+using namespace RoR;
+
+/// The former `FlexObj::UpdateMesh()`, one vertex and one triangle at a time
+static Ogre::Vector3 CalcCabMeshVerticesReference(CabMeshLayout const& layout, NodeSB const* nodes, float* out_vertices)
+{
+    struct Vertex
+    {
+        Ogre::Vector3 position;
+        Ogre::Vector3 normal;
+        Ogre::Vector2 texcoord;
+    };
+    Vertex* vertices = reinterpret_cast<Vertex*>(out_vertices);
+
+    Ogre::Vector3 center=(nodes[layout.vertex_nodes[0]].AbsPosition+nodes[layout.vertex_nodes[1]].AbsPosition)/2.0;
+    for (size_t i=0; i<layout.vertex_count; i++)
+    {
+        //set position
+        vertices[i].position=nodes[layout.vertex_nodes[i]].AbsPosition-center;
+        //reset normals
+        vertices[i].normal=Ogre::Vector3::ZERO;
+    }
+    //accumulate normals per triangle
+    for (size_t i=0; i<layout.triangle_count; i++)
+    {
+        const unsigned short* tri = layout.indices + i*3;
+        Ogre::Vector3 v1, v2;
+        v1=nodes[layout.vertex_nodes[tri[1]]].AbsPosition-nodes[layout.vertex_nodes[tri[0]]].AbsPosition;
+        v2=nodes[layout.vertex_nodes[tri[2]]].AbsPosition-nodes[layout.vertex_nodes[tri[0]]].AbsPosition;
+        v1=v1.crossProduct(v2);
+        float s=v1.length();
+
+        //avoid large tris
+        if (s>layout.s_ref[i])
+        {
+            vertices[tri[1]].position=vertices[tri[0]].position+Ogre::Vector3(0.1,0,0);
+            vertices[tri[2]].position=vertices[tri[0]].position+Ogre::Vector3(0,0,0.1);
+        }
+
+        if (s == 0)
+            continue;
+
+        v1=v1/s;
+        vertices[tri[0]].normal+=v1;
+        vertices[tri[1]].normal+=v1;
+        vertices[tri[2]].normal+=v1;
+    }
+    //normalize
+    for (size_t i=0; i<layout.vertex_count; i++)
+    {
+        vertices[i].normal = approx_normalise(vertices[i].normal);
+    }
+
+    return center;
+}
+
+struct SyntheticCab
+{
+    size_t                       grid_w = 0;
+    size_t                       grid_h = 0;
+    std::vector<RoR::NodeSB>     nodes;
+    std::vector<int>             vertex_nodes;
+    std::vector<unsigned short>  indices;
+    std::vector<float>           s_ref;
+    CabMeshLayout                layout;
+};
+
+static void MoveCabNodes(SyntheticCab& cab, float time)
+{
+    for (size_t y = 0; y < cab.grid_h; y++)
+    {
+        for (size_t x = 0; x < cab.grid_w; x++)
+        {
+            const float fx = static_cast<float>(x) * 0.1f;
+            const float fy = static_cast<float>(y) * 0.1f;
+            cab.nodes[y * cab.grid_w + x].AbsPosition = Ogre::Vector3(
+                100.f + fx, 5.f + 0.2f * std::sin(fx * 3.f + time), 50.f + fy + 0.1f * std::cos(fy * 2.f + time));
+        }
+    }
+}
+
+static void BuildSyntheticCab(SyntheticCab& cab, size_t grid_w, size_t grid_h)
+{
+    cab.grid_w = grid_w;
+    cab.grid_h = grid_h;
+    cab.nodes.resize(grid_w * grid_h);
+    MoveCabNodes(cab, 0.f);
+
+    // Front vertices, then backmesh vertices - same nodes, as `FlexObj` does for submeshes
+    const size_t num_nodes = grid_w * grid_h;
+    cab.vertex_nodes.resize(num_nodes * 2);
+    for (size_t i = 0; i < num_nodes; i++)
+    {
+        cab.vertex_nodes[i] = static_cast<int>(i);
+        cab.vertex_nodes[num_nodes + i] = static_cast<int>(i);
+    }
+
+    for (size_t side = 0; side < 2; side++)
+    {
+        const unsigned short base = static_cast<unsigned short>(side * num_nodes);
+        for (size_t y = 0; y + 1 < grid_h; y++)
+        {
+            for (size_t x = 0; x + 1 < grid_w; x++)
+            {
+                const unsigned short a = static_cast<unsigned short>(base + y * grid_w + x);
+                const unsigned short b = static_cast<unsigned short>(a + 1);
+                const unsigned short c = static_cast<unsigned short>(a + grid_w);
+                const unsigned short d = static_cast<unsigned short>(c + 1);
+                if (side == 0)
+                {
+                    cab.indices.insert(cab.indices.end(), { a, b, c, b, d, c });
+                }
+                else
+                {
+                    cab.indices.insert(cab.indices.end(), { a, c, b, b, c, d }); // Backmesh - reversed
+                }
+            }
+        }
+    }
+
+    // Like `FlexObj::FlexObj()`
+    const size_t num_triangles = cab.indices.size() / 3;
+    cab.s_ref.resize(num_triangles);
+    for (size_t i = 0; i < num_triangles; i++)
+    {
+        const Ogre::Vector3 p0 = cab.nodes[cab.vertex_nodes[cab.indices[i*3]]].AbsPosition;
+        const Ogre::Vector3 v1 = cab.nodes[cab.vertex_nodes[cab.indices[i*3+1]]].AbsPosition - p0;
+        const Ogre::Vector3 v2 = cab.nodes[cab.vertex_nodes[cab.indices[i*3+2]]].AbsPosition - p0;
+        cab.s_ref[i] = v1.crossProduct(v2).length() * 2.0;
+    }
+
+    cab.layout.vertex_count = cab.vertex_nodes.size();
+    cab.layout.vertex_nodes = cab.vertex_nodes.data();
+    cab.layout.triangle_count = num_triangles;
+    cab.layout.indices = cab.indices.data();
+    cab.layout.s_ref = cab.s_ref.data();
+}
+
+static bool VerifyCabMesh()
+{
+    SyntheticCab cab;
+    BuildSyntheticCab(cab, 40, 30);
+    std::vector<float> expected(cab.layout.vertex_count * 8, 0.f);
+    std::vector<float> actual(cab.layout.vertex_count * 8, 0.f);
+    CabMeshScratch scratch;
+
+    for (int frame = 0; frame < 50; frame++)
+    {
+        MoveCabNodes(cab, frame * 0.1f);
+        if (frame % 10 == 5)
+        {
+            cab.nodes[frame * 7].AbsPosition.y += 3.f; // Stretched tris get collapsed
+        }
+        if (frame % 10 == 7)
+        {
+            cab.nodes[frame * 3].AbsPosition = cab.nodes[frame * 3 + 1].AbsPosition; // Zero-area tris
+        }
+
+        const Ogre::Vector3 expected_center = CalcCabMeshVerticesReference(cab.layout, cab.nodes.data(), expected.data());
+        const Ogre::Vector3 actual_center = CalcCabMeshVertices(cab.layout, cab.nodes.data(), scratch, actual.data());
+        if (expected_center != actual_center)
+        {
+            std::cout << "CalcCabMeshVertices() center differs: frame " << frame << std::endl;
+            return false;
+        }
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            if (i % 8 >= 6)
+                continue; // Texcoords are left untouched
+
+            if (std::abs(expected[i] - actual[i]) > 1e-4f)
+            {
+                std::cout << "CalcCabMeshVertices() differs: frame " << frame << ", vertex " << i / 8
+                    << ", component " << i % 8 << ": " << expected[i] << " vs. " << actual[i] << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void Bench_CabMesh_Reference(benchmark::State& state)
+{
+    SyntheticCab cab;
+    BuildSyntheticCab(cab, static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(0)));
+    std::vector<float> vertices(cab.layout.vertex_count * 8, 0.f);
+    float time = 0.f;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        MoveCabNodes(cab, time += 0.01f);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(CalcCabMeshVerticesReference(cab.layout, cab.nodes.data(), vertices.data()));
+    }
+}
+BENCHMARK(Bench_CabMesh_Reference)->Arg(10)->Arg(40)->Arg(120);
+
+static void Bench_CabMesh_Gathered(benchmark::State& state)
+{
+    SyntheticCab cab;
+    BuildSyntheticCab(cab, static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(0)));
+    std::vector<float> vertices(cab.layout.vertex_count * 8, 0.f);
+    CabMeshScratch scratch;
+    float time = 0.f;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        MoveCabNodes(cab, time += 0.01f);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(CalcCabMeshVertices(cab.layout, cab.nodes.data(), scratch, vertices.data()));
+    }
+}
+BENCHMARK(Bench_CabMesh_Gathered)->Arg(10)->Arg(40)->Arg(120);
+
+/// Like `FlexObj::ComputeFlexObj()` followed by `FlexObj::UpdateFlexObjBuffers()`, with a plain array standing in for the shadow buffer.
+/// Arg 0 = parked (only a door's worth of nodes moves), 1 = driving (the whole cab moves, so does the center).
+static void Bench_CabMesh_Upload(benchmark::State& state)
+{
+    const bool driving = (state.range(0) != 0);
+    SyntheticCab cab;
+    BuildSyntheticCab(cab, 40, 30);
+    std::vector<float> vertices(cab.layout.vertex_count * 8, 0.f);
+    std::vector<float> next_vertices(cab.layout.vertex_count * 8, 0.f);
+    std::vector<float> gpu_copy(cab.layout.vertex_count * 8, 0.f);
+    CabMeshScratch scratch;
+    Ogre::Vector3 center = CalcCabMeshVertices(cab.layout, cab.nodes.data(), scratch, vertices.data());
+    int64_t uploaded_bytes = 0;
+    float time = 0.f;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        time += 0.01f;
+        if (driving)
+        {
+            MoveCabNodes(cab, 0.f);
+            for (RoR::NodeSB& node: cab.nodes)
+            {
+                node.AbsPosition.z += time * 20.f;
+            }
+        }
+        else
+        {
+            for (size_t i = cab.nodes.size() / 2; i < cab.nodes.size() / 2 + 40; i++)
+            {
+                cab.nodes[i].AbsPosition.y += 0.01f * std::sin(time * 7.f);
+            }
+        }
+        state.ResumeTiming();
+
+        const Ogre::Vector3 prev_center = center;
+        center = CalcCabMeshVertices(cab.layout, cab.nodes.data(), scratch, next_vertices.data());
+        size_t begin = 0, end = cab.layout.vertex_count;
+        if (center == prev_center)
+        {
+            if (!FindCabMeshDirtyRange(vertices.data(), next_vertices.data(), cab.layout.vertex_count, begin, end))
+            {
+                begin = end = 0;
+            }
+        }
+        std::swap(vertices, next_vertices);
+        std::copy(vertices.begin() + begin * 8, vertices.begin() + end * 8, gpu_copy.begin() + begin * 8);
+        uploaded_bytes += static_cast<int64_t>((end - begin) * 8 * sizeof(float));
+    }
+    state.SetBytesProcessed(uploaded_bytes);
+}
+BENCHMARK(Bench_CabMesh_Upload)->Arg(0)->Arg(1);
+
+bool BenchVerify()
+{
+    return VerifyCabMesh();
+}
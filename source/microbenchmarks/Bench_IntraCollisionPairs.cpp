@@ -0,0 +1,288 @@
+#include "benchmark/benchmark.h"
+#include "BenchMain.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "Actor.h"
+#include "CartesianToTriangleTransform.h"
+#include "IntraCollisionPairs.h"
+#include "PointColDetector.h"
+#include "SimConstants.h"
+#include "Triangle.h"
+
+// Self-collision of an actor's cab (collcabs vs. contacters), narrow phase without forces:
+//  kd-tree query per collcab per substep (the former `ResolveIntraActorCollisions()`) vs. candidate pairs cached by `IntraCollisionPairs`
+// on a generated tube-shaped cab with contacters just inside the walls, which travels and wobbles.
+// The cab is capped by MAX_CABS, i.e. 3000 triangles. The scene has no beams, so the filter for nodes
+// beam-connected to the cab is inactive and the kd-tree variant needs no equivalent of it.
+// Both variants must report identical contact lists on each of 2000 substeps.
+
+using namespace RoR;
+
+typedef std::vector<std::pair<int, int>> ContactList; // collcab, node
+
+static const int   TUBE_SEGMENTS = 30;    // Around
+static const float TUBE_RADIUS   = 1.f;   // Meters
+static const float RING_SPACING  = 0.2f;  // Meters
+
+struct TubeScene
+{
+    Actor*                     actor = nullptr;
+    std::vector<node_t>        nodes;
+    std::vector<Ogre::Vector3> rest_positions;
+    std::vector<Ogre::Vector3> inward;       // Unit vectors; zero for cab nodes
+    size_t                     num_cab_nodes = 0;
+};
+
+/// Same as in DynamicCollisions.cpp
+static bool InsideTriangleTest(const CartesianToTriangleTransform::TriangleCoord &local, const float margin)
+{
+    const auto coord    = local.barycentric;
+    const auto distance = local.distance;
+    return (coord.alpha >= 0) && (coord.beta >= 0) && (coord.gamma >= 0) && (std::abs(distance) <= margin);
+}
+
+static Ogre::Vector3 TubePoint(int ring, int segment, float radius)
+{
+    const float angle = static_cast<float>(segment) * Ogre::Math::TWO_PI / TUBE_SEGMENTS;
+    return Ogre::Vector3(static_cast<float>(ring) * RING_SPACING, std::cos(angle) * radius, std::sin(angle) * radius);
+}
+
+/// The actor is only filled in as far as self-collision needs; it's leaked, the destructor expects a fully spawned actor.
+static void BuildTubeScene(TubeScene& scene, int num_rings)
+{
+    const int num_triangles = std::min(num_rings * TUBE_SEGMENTS * 2, MAX_CABS);
+    const int num_quads = num_triangles / 2;
+
+    scene.num_cab_nodes = static_cast<size_t>((num_rings + 1) * TUBE_SEGMENTS);
+    scene.nodes.resize(scene.num_cab_nodes + num_quads);
+    scene.rest_positions.resize(scene.nodes.size());
+    scene.inward.resize(scene.nodes.size(), Ogre::Vector3::ZERO);
+
+    // Cab nodes - contacters too, like in most truck files
+    for (int ring = 0; ring <= num_rings; ring++)
+    {
+        for (int seg = 0; seg < TUBE_SEGMENTS; seg++)
+        {
+            const size_t i = ring * TUBE_SEGMENTS + seg;
+            scene.nodes[i] = node_t(i);
+            scene.nodes[i].nd_contacter = true;
+            scene.rest_positions[i] = TubePoint(ring, seg, TUBE_RADIUS);
+        }
+    }
+
+    scene.actor = new Actor(0, 0, RigDef::DocumentPtr(), ActorSpawnRequest());
+    scene.actor->ar_num_cabs = 0;
+    for (int q = 0; q < num_quads; q++)
+    {
+        const int ring = q / TUBE_SEGMENTS;
+        const int seg = q % TUBE_SEGMENTS;
+        const int a = ring * TUBE_SEGMENTS + seg;
+        const int b = ring * TUBE_SEGMENTS + (seg + 1) % TUBE_SEGMENTS;
+        const int c = a + TUBE_SEGMENTS;
+        const int d = b + TUBE_SEGMENTS;
+        const int tris[6] = { a, b, c, b, d, c };
+        for (int t = 0; t < 2; t++)
+        {
+            const int cab = scene.actor->ar_num_cabs++;
+            scene.actor->ar_cabs[cab * 3 + 0] = tris[t * 3 + 0];
+            scene.actor->ar_cabs[cab * 3 + 1] = tris[t * 3 + 1];
+            scene.actor->ar_cabs[cab * 3 + 2] = tris[t * 3 + 2];
+            scene.actor->ar_collcabs[cab] = cab;
+        }
+
+        // Interior contacter at the centroid of the quad's first triangle, close to the wall.
+        // Every 7th one is a tyre node, which must be ignored.
+        const size_t i = scene.num_cab_nodes + q;
+        const Ogre::Vector3 centroid = (scene.rest_positions[a] + scene.rest_positions[b] + scene.rest_positions[c]) / 3.f;
+        scene.inward[i] = -Ogre::Vector3(0.f, centroid.y, centroid.z).normalisedCopy();
+        scene.nodes[i] = node_t(i);
+        scene.nodes[i].nd_contacter = true;
+        scene.nodes[i].nd_tyre_node = (q % 7 == 0);
+        scene.rest_positions[i] = centroid;
+    }
+
+    scene.actor->ar_nodes = scene.nodes.data();
+    scene.actor->ar_num_nodes = static_cast<int>(scene.nodes.size());
+    scene.actor->ar_num_collcabs = scene.actor->ar_num_cabs;
+    scene.actor->ar_num_contacters = static_cast<int>(scene.nodes.size());
+    scene.actor->ar_collision_range = DEFAULT_COLLISION_RANGE;
+}
+
+/// The whole tube drives along X at 20 m/s; nodes jitter a little and the interior contacters slowly
+/// move in and out through the collision range of the walls.
+static void MoveTubeScene(TubeScene& scene, size_t step)
+{
+    const float dt = 0.0005f;
+    const Ogre::Vector3 travel(20.f * dt * step, 0.f, 0.f);
+    for (size_t i = 0; i < scene.nodes.size(); i++)
+    {
+        const float fi = static_cast<float>(i);
+        const float fs = static_cast<float>(step);
+        const Ogre::Vector3 jitter(
+            std::sin(fi * 12.9898f + fs * 0.78233f),
+            std::sin(fi * 39.3468f + fs * 0.11135f),
+            std::sin(fi * 73.1560f + fs * 0.52913f));
+        const float depth = 0.03f * std::sin(fs * 0.01f + fi * 0.37f); // Positive = inwards
+        scene.nodes[i].AbsPosition = scene.rest_positions[i] + travel + jitter * 0.002f + scene.inward[i] * depth;
+    }
+}
+
+static void GatherContactsKdTree(Actor* actor, PointColDetector& detector, ContactList& contacts)
+{
+    contacts.clear();
+    detector.UpdateIntraPoint();
+    const float collrange = actor->ar_collision_range;
+    node_t* nodes = actor->ar_nodes;
+
+    for (int i = 0; i < actor->ar_num_collcabs; i++)
+    {
+        const int tmpv = actor->ar_collcabs[i] * 3;
+        const auto no = &nodes[actor->ar_cabs[tmpv]];
+        const auto na = &nodes[actor->ar_cabs[tmpv + 1]];
+        const auto nb = &nodes[actor->ar_cabs[tmpv + 2]];
+
+        detector.query(no->AbsPosition, na->AbsPosition, nb->AbsPosition, collrange);
+        if (detector.hit_list.empty())
+            continue;
+
+        const Triangle triangle(na->AbsPosition, nb->AbsPosition, no->AbsPosition);
+        const CartesianToTriangleTransform transform(triangle);
+        for (auto h : detector.hit_list)
+        {
+            const auto hitnode = &nodes[h->node_id];
+            if (hitnode->nd_tyre_node)
+                continue;
+            if (no == hitnode || na == hitnode || nb == hitnode)
+                continue;
+
+            if (InsideTriangleTest(transform(hitnode->AbsPosition), collrange))
+            {
+                contacts.push_back(std::make_pair(i, static_cast<int>(h->node_id)));
+            }
+        }
+    }
+}
+
+static void GatherContactsCachedPairs(Actor* actor, IntraCollisionPairs& pairs, PointColDetector& detector, ContactList& contacts)
+{
+    contacts.clear();
+    pairs.Update(actor, detector);
+    const float collrange = actor->ar_collision_range;
+    node_t* nodes = actor->ar_nodes;
+
+    for (int i = 0; i < actor->ar_num_collcabs; i++)
+    {
+        NodeNum_t const* candidates_begin = pairs.GetCandidatesBegin(i);
+        NodeNum_t const* candidates_end = pairs.GetCandidatesEnd(i);
+        if (candidates_begin == candidates_end)
+            continue;
+
+        const int tmpv = actor->ar_collcabs[i] * 3;
+        const auto no = &nodes[actor->ar_cabs[tmpv]];
+        const auto na = &nodes[actor->ar_cabs[tmpv + 1]];
+        const auto nb = &nodes[actor->ar_cabs[tmpv + 2]];
+
+        const Triangle triangle(na->AbsPosition, nb->AbsPosition, no->AbsPosition);
+        const CartesianToTriangleTransform transform(triangle);
+
+        Ogre::Vector3 bbmin = no->AbsPosition;
+        bbmin.makeFloor(na->AbsPosition);
+        bbmin.makeFloor(nb->AbsPosition);
+        bbmin -= collrange;
+        Ogre::Vector3 bbmax = no->AbsPosition;
+        bbmax.makeCeil(na->AbsPosition);
+        bbmax.makeCeil(nb->AbsPosition);
+        bbmax += collrange;
+
+        for (NodeNum_t const* itor = candidates_begin; itor != candidates_end; ++itor)
+        {
+            const Ogre::Vector3& pos = nodes[*itor].AbsPosition;
+            if (pos.x < bbmin.x || pos.y < bbmin.y || pos.z < bbmin.z ||
+                pos.x > bbmax.x || pos.y > bbmax.y || pos.z > bbmax.z)
+                continue;
+
+            if (InsideTriangleTest(transform(pos), collrange))
+            {
+                contacts.push_back(std::make_pair(i, static_cast<int>(*itor)));
+            }
+        }
+    }
+}
+
+static bool VerifyIntraCollisionPairs()
+{
+    TubeScene scene;
+    BuildTubeScene(scene, 50);
+    PointColDetector kdtree_detector(scene.actor);
+    PointColDetector pairs_detector(scene.actor);
+    IntraCollisionPairs pairs;
+    ContactList expected, actual;
+    size_t total_contacts = 0;
+
+    for (size_t step = 0; step < 2000; step++)
+    {
+        MoveTubeScene(scene, step);
+        GatherContactsKdTree(scene.actor, kdtree_detector, expected);
+        GatherContactsCachedPairs(scene.actor, pairs, pairs_detector, actual);
+
+        std::sort(expected.begin(), expected.end()); // kd-tree order is arbitrary
+        if (expected != actual)
+        {
+            std::cout << "IntraCollisionPairs contacts differ: step " << step << ", "
+                << expected.size() << " vs. " << actual.size() << " contacts" << std::endl;
+            return false;
+        }
+        total_contacts += actual.size();
+    }
+
+    if (total_contacts == 0)
+    {
+        std::cout << "IntraCollisionPairs: the scene produced no contacts, nothing was verified" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static void Bench_IntraCollision_KdTree(benchmark::State& state)
+{
+    TubeScene scene;
+    BuildTubeScene(scene, static_cast<int>(state.range(0)));
+    PointColDetector detector(scene.actor);
+    ContactList contacts;
+    size_t step = 0;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        MoveTubeScene(scene, step++);
+        state.ResumeTiming();
+        GatherContactsKdTree(scene.actor, detector, contacts);
+    }
+}
+BENCHMARK(Bench_IntraCollision_KdTree)->Arg(5)->Arg(20)->Arg(50);
+
+static void Bench_IntraCollision_CachedPairs(benchmark::State& state)
+{
+    TubeScene scene;
+    BuildTubeScene(scene, static_cast<int>(state.range(0)));
+    PointColDetector detector(scene.actor);
+    IntraCollisionPairs pairs;
+    ContactList contacts;
+    size_t step = 0;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        MoveTubeScene(scene, step++);
+        state.ResumeTiming();
+        GatherContactsCachedPairs(scene.actor, pairs, detector, contacts);
+    }
+}
+BENCHMARK(Bench_IntraCollision_CachedPairs)->Arg(5)->Arg(20)->Arg(50);
+
+bool BenchVerify()
+{
+    return VerifyIntraCollisionPairs();
+}
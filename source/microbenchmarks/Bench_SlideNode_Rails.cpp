@@ -0,0 +1,236 @@
+#include "benchmark/benchmark.h"
+#include "BenchMain.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "SimData.h"
+#include "SlideNode.h"
+
+// Slidenodes on long rails (cranes, trains):
+//  * closest segment lookup - bounding volume hierarchy vs. linear scan of all segments
+//  * per-substep update - `SlideNode::UpdateSlideNodes()` vs. `UpdatePosition()`+`UpdateForces()` per slidenode
+// The lookup is checked on deformed rails of 2 to 1000 segments, the update over 2000 substeps of 200 moving slidenodes.
+
+using namespace RoR;
+
+struct RailScene
+{
+    std::vector<node_t>     rail_nodes;
+    std::vector<beam_t>     rail_beams;
+    RailGroup               rail;
+    std::vector<node_t>     slide_nodes;
+    std::vector<SlideNode>  slidenodes;
+};
+
+static Ogre::Vector3 RailPoint(float s)
+{
+    // Winding in all 3 axes, ~0.5m between nodes
+    return Ogre::Vector3(s * 0.5f, std::sin(s * 0.05f) * 8.f, std::cos(s * 0.03f) * 12.f);
+}
+
+/// Rail is linked the same way as `ActorSpawner::CreateRail()` does
+static std::unique_ptr<RailScene> BuildRailScene(size_t num_segments, size_t num_slidenodes, unsigned seed)
+{
+    std::unique_ptr<RailScene> scene(new RailScene());
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+
+    scene->rail_nodes.resize(num_segments + 1);
+    for (size_t i = 0; i <= num_segments; ++i)
+    {
+        scene->rail_nodes[i] = node_t(i);
+        scene->rail_nodes[i].AbsPosition = RailPoint(static_cast<float>(i)) + Ogre::Vector3(jitter(rng), jitter(rng), jitter(rng));
+    }
+
+    scene->rail_beams.resize(num_segments);
+    for (size_t i = 0; i < num_segments; ++i)
+    {
+        scene->rail_beams[i].p1 = &scene->rail_nodes[i];
+        scene->rail_beams[i].p2 = &scene->rail_nodes[i + 1];
+        scene->rail.rg_segments.emplace_back(&scene->rail_beams[i]);
+    }
+    for (size_t i = 1; i < (num_segments - 1); ++i)
+    {
+        scene->rail.rg_segments[i].rs_prev = &scene->rail.rg_segments[i - 1];
+        scene->rail.rg_segments[i].rs_next = &scene->rail.rg_segments[i + 1];
+    }
+    scene->rail.rg_segments[0].rs_next = &scene->rail.rg_segments[1];
+    scene->rail.rg_segments[num_segments - 1].rs_prev = &scene->rail.rg_segments[num_segments - 2];
+    scene->rail.UpdateBounds();
+
+    // Slidenodes spread along the rail, slightly off it
+    scene->slide_nodes.resize(num_slidenodes);
+    std::uniform_real_distribution<float> along(0.f, static_cast<float>(num_segments));
+    for (size_t i = 0; i < num_slidenodes; ++i)
+    {
+        scene->slide_nodes[i] = node_t(i);
+        scene->slide_nodes[i].AbsPosition = RailPoint(along(rng)) + Ogre::Vector3(jitter(rng), jitter(rng), jitter(rng)) * 4.f;
+    }
+    for (size_t i = 0; i < num_slidenodes; ++i)
+    {
+        scene->slidenodes.emplace_back(&scene->slide_nodes[i], &scene->rail);
+        scene->slidenodes.back().SetDefaultRail(&scene->rail);
+    }
+
+    return scene;
+}
+
+/// Moves the slidenodes along the rail, like a train does
+static void MoveSlideNodes(RailScene& scene, size_t step)
+{
+    for (size_t i = 0; i < scene.slide_nodes.size(); ++i)
+    {
+        scene.slide_nodes[i].AbsPosition += Ogre::Vector3(0.01f, 0.002f * std::sin(float(step + i)), 0.f);
+        scene.slide_nodes[i].Forces = Ogre::Vector3::ZERO;
+    }
+    for (node_t& node : scene.rail_nodes)
+    {
+        node.Forces = Ogre::Vector3::ZERO;
+    }
+}
+
+static bool VerifyFindClosestSegment()
+{
+    for (size_t num_segments : { 2, 3, 7, 100, 1000 })
+    {
+        std::unique_ptr<RailScene> scene = BuildRailScene(num_segments, 1, 1234);
+
+        // Deform the rail, then refit
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> jitter(-0.3f, 0.3f);
+        for (node_t& node : scene->rail_nodes)
+        {
+            node.AbsPosition += Ogre::Vector3(jitter(rng), jitter(rng), jitter(rng));
+        }
+        scene->rail.UpdateBounds();
+
+        const Ogre::Vector3 lo = RailPoint(0.f) - Ogre::Vector3(5.f, 15.f, 20.f);
+        const Ogre::Vector3 hi = RailPoint(static_cast<float>(num_segments)) + Ogre::Vector3(5.f, 15.f, 20.f);
+        std::uniform_real_distribution<float> rx(lo.x, hi.x), ry(lo.y, hi.y), rz(lo.z, hi.z);
+        for (int q = 0; q < 10000; ++q)
+        {
+            const Ogre::Vector3 point(rx(rng), ry(rng), rz(rng));
+            if (scene->rail.FindClosestSegment(point) != scene->rail.FindClosestSegmentLinear(point))
+            {
+                std::cout << "FindClosestSegment() differs from linear search: "
+                    << num_segments << " segments, point " << point << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool VerifyUpdateSlideNodes()
+{
+    std::unique_ptr<RailScene> per_node = BuildRailScene(1000, 200, 99);
+    std::unique_ptr<RailScene> batched = BuildRailScene(1000, 200, 99);
+    const float dt = 0.0005f;
+
+    for (size_t step = 0; step < 2000; ++step)
+    {
+        MoveSlideNodes(*per_node, step);
+        MoveSlideNodes(*batched, step);
+
+        for (SlideNode& sn : per_node->slidenodes)
+        {
+            sn.UpdatePosition();
+            sn.UpdateForces(dt);
+        }
+        SlideNode::UpdateSlideNodes(batched->slidenodes.data(), batched->slidenodes.size(), dt);
+
+        for (size_t i = 0; i < per_node->slide_nodes.size(); ++i)
+        {
+            const Ogre::Vector3 a = per_node->slide_nodes[i].Forces;
+            const Ogre::Vector3 b = batched->slide_nodes[i].Forces;
+            if (a.distance(b) > 1e-4f * std::max(1.f, a.length()))
+            {
+                std::cout << "UpdateSlideNodes() differs: step " << step << ", slidenode " << i
+                    << ", forces " << a << " vs. " << b << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void Bench_FindClosestSegment_Linear(benchmark::State& state)
+{
+    std::unique_ptr<RailScene> scene = BuildRailScene(static_cast<size_t>(state.range(0)), 1, 7);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> along(0.f, static_cast<float>(state.range(0)));
+    while (state.KeepRunning())
+    {
+        const Ogre::Vector3 point = RailPoint(along(rng)) + Ogre::Vector3(0.f, 0.5f, 0.f);
+        benchmark::DoNotOptimize(scene->rail.FindClosestSegmentLinear(point));
+    }
+}
+BENCHMARK(Bench_FindClosestSegment_Linear)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
+static void Bench_FindClosestSegment_Bvh(benchmark::State& state)
+{
+    std::unique_ptr<RailScene> scene = BuildRailScene(static_cast<size_t>(state.range(0)), 1, 7);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> along(0.f, static_cast<float>(state.range(0)));
+    while (state.KeepRunning())
+    {
+        const Ogre::Vector3 point = RailPoint(along(rng)) + Ogre::Vector3(0.f, 0.5f, 0.f);
+        benchmark::DoNotOptimize(scene->rail.FindClosestSegment(point));
+    }
+}
+BENCHMARK(Bench_FindClosestSegment_Bvh)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
+static void Bench_FindClosestSegment_BvhWithRefit(benchmark::State& state)
+{
+    // One refit per attach toggle, then a lookup for each of 20 slidenodes
+    std::unique_ptr<RailScene> scene = BuildRailScene(static_cast<size_t>(state.range(0)), 1, 7);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> along(0.f, static_cast<float>(state.range(0)));
+    while (state.KeepRunning())
+    {
+        scene->rail.UpdateBounds();
+        for (int i = 0; i < 20; ++i)
+        {
+            const Ogre::Vector3 point = RailPoint(along(rng)) + Ogre::Vector3(0.f, 0.5f, 0.f);
+            benchmark::DoNotOptimize(scene->rail.FindClosestSegment(point));
+        }
+    }
+}
+BENCHMARK(Bench_FindClosestSegment_BvhWithRefit)->Arg(100)->Arg(1000)->Arg(10000);
+
+static void Bench_SlideNodeSubstep_PerNode(benchmark::State& state)
+{
+    std::unique_ptr<RailScene> scene = BuildRailScene(1000, static_cast<size_t>(state.range(0)), 11);
+    size_t step = 0;
+    while (state.KeepRunning())
+    {
+        MoveSlideNodes(*scene, step++);
+        for (SlideNode& sn : scene->slidenodes)
+        {
+            sn.UpdatePosition();
+            sn.UpdateForces(0.0005f);
+        }
+    }
+}
+BENCHMARK(Bench_SlideNodeSubstep_PerNode)->Arg(10)->Arg(100)->Arg(1000);
+
+static void Bench_SlideNodeSubstep_Batched(benchmark::State& state)
+{
+    std::unique_ptr<RailScene> scene = BuildRailScene(1000, static_cast<size_t>(state.range(0)), 11);
+    size_t step = 0;
+    while (state.KeepRunning())
+    {
+        MoveSlideNodes(*scene, step++);
+        SlideNode::UpdateSlideNodes(scene->slidenodes.data(), scene->slidenodes.size(), 0.0005f);
+    }
+}
+BENCHMARK(Bench_SlideNodeSubstep_Batched)->Arg(10)->Arg(100)->Arg(1000);
+
+bool BenchVerify()
+{
+    return VerifyFindClosestSegment() && VerifyUpdateSlideNodes();
+}